@@ -0,0 +1,212 @@
+/**
+ * @file   bench_compressors.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for each compressor in `tiledb/sm/compressors`, on
+ * `int32` and `int64` values. The argument is the input size in bytes.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/buffer/preallocated_buffer.h"
+#include "tiledb/sm/compressors/bzip_compressor.h"
+#include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/gzip_compressor.h"
+#include "tiledb/sm/compressors/lz4_compressor.h"
+#include "tiledb/sm/compressors/rle_compressor.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+/** Compress/decompress entry points and overhead of a single codec. */
+struct Codec {
+  std::string name;
+  std::function<Status(Datatype, uint64_t, ConstBuffer*, Buffer*)> compress;
+  std::function<Status(Datatype, uint64_t, ConstBuffer*, PreallocatedBuffer*)>
+      decompress;
+  std::function<uint64_t(uint64_t, uint64_t)> overhead;
+};
+
+std::vector<Codec> codecs() {
+  std::vector<Codec> ret;
+  ret.push_back(
+      {"gzip",
+       [](Datatype, uint64_t, ConstBuffer* in, Buffer* out) {
+         return GZip::compress(-1, in, out);
+       },
+       [](Datatype, uint64_t, ConstBuffer* in, PreallocatedBuffer* out) {
+         return GZip::decompress(in, out);
+       },
+       [](uint64_t n, uint64_t) { return GZip::overhead(n); }});
+  ret.push_back(
+      {"zstd",
+       [](Datatype, uint64_t, ConstBuffer* in, Buffer* out) {
+         return ZStd::compress(-1, in, out);
+       },
+       [](Datatype, uint64_t, ConstBuffer* in, PreallocatedBuffer* out) {
+         return ZStd::decompress(in, out);
+       },
+       [](uint64_t n, uint64_t) { return ZStd::overhead(n); }});
+  ret.push_back(
+      {"lz4",
+       [](Datatype, uint64_t, ConstBuffer* in, Buffer* out) {
+         return LZ4::compress(-1, in, out);
+       },
+       [](Datatype, uint64_t, ConstBuffer* in, PreallocatedBuffer* out) {
+         return LZ4::decompress(in, out);
+       },
+       [](uint64_t n, uint64_t) { return LZ4::overhead(n); }});
+  ret.push_back(
+      {"rle",
+       [](Datatype, uint64_t cell_size, ConstBuffer* in, Buffer* out) {
+         return RLE::compress(cell_size, in, out);
+       },
+       [](Datatype,
+          uint64_t cell_size,
+          ConstBuffer* in,
+          PreallocatedBuffer* out) {
+         return RLE::decompress(cell_size, in, out);
+       },
+       [](uint64_t n, uint64_t cell_size) {
+         return RLE::overhead(n, cell_size);
+       }});
+  ret.push_back(
+      {"bzip2",
+       [](Datatype, uint64_t, ConstBuffer* in, Buffer* out) {
+         return BZip::compress(-1, in, out);
+       },
+       [](Datatype, uint64_t, ConstBuffer* in, PreallocatedBuffer* out) {
+         return BZip::decompress(in, out);
+       },
+       [](uint64_t n, uint64_t) { return BZip::overhead(n); }});
+  ret.push_back(
+      {"double_delta",
+       [](Datatype type, uint64_t, ConstBuffer* in, Buffer* out) {
+         return DoubleDelta::compress(type, in, out);
+       },
+       [](Datatype type, uint64_t, ConstBuffer* in, PreallocatedBuffer* out) {
+         return DoubleDelta::decompress(type, in, out);
+       },
+       [](uint64_t n, uint64_t) { return DoubleDelta::overhead(n); }});
+  return ret;
+}
+
+template <class T>
+Datatype datatype();
+
+template <>
+Datatype datatype<int32_t>() {
+  return Datatype::INT32;
+}
+
+template <>
+Datatype datatype<int64_t>() {
+  return Datatype::INT64;
+}
+
+template <class T>
+void bench_compress(State& state, const Codec& codec) {
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = sensor_values<T>(nbytes / sizeof(T));
+  nbytes = data.size() * sizeof(T);
+
+  Buffer out;
+  out.realloc(nbytes + codec.overhead(nbytes, sizeof(T)));
+
+  while (state.keep_running()) {
+    ConstBuffer in(data.data(), nbytes);
+    out.reset_offset();
+    out.reset_size();
+    if (!codec.compress(datatype<T>(), sizeof(T), &in, &out).ok()) {
+      state.skip_with_error("compress failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(nbytes);
+}
+
+template <class T>
+void bench_decompress(State& state, const Codec& codec) {
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = sensor_values<T>(nbytes / sizeof(T));
+  nbytes = data.size() * sizeof(T);
+
+  Buffer compressed;
+  compressed.realloc(nbytes + codec.overhead(nbytes, sizeof(T)));
+  ConstBuffer in(data.data(), nbytes);
+  if (!codec.compress(datatype<T>(), sizeof(T), &in, &compressed).ok()) {
+    state.skip_with_error("compress failed");
+    return;
+  }
+
+  std::vector<T> decompressed(data.size());
+  while (state.keep_running()) {
+    ConstBuffer cin(compressed.data(), compressed.size());
+    PreallocatedBuffer out(decompressed.data(), nbytes);
+    if (!codec.decompress(datatype<T>(), sizeof(T), &cin, &out).ok()) {
+      state.skip_with_error("decompress failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(nbytes);
+}
+
+bool register_all() {
+  for (const auto& codec : codecs()) {
+    register_benchmark(
+        "Compressor/" + codec.name + "/compress/int32",
+        [codec](State& state) { bench_compress<int32_t>(state, codec); })
+        ->range(64 << 10, 4 << 20);
+    register_benchmark(
+        "Compressor/" + codec.name + "/compress/int64",
+        [codec](State& state) { bench_compress<int64_t>(state, codec); })
+        ->range(64 << 10, 4 << 20);
+    register_benchmark(
+        "Compressor/" + codec.name + "/decompress/int32",
+        [codec](State& state) { bench_decompress<int32_t>(state, codec); })
+        ->range(64 << 10, 4 << 20);
+    register_benchmark(
+        "Compressor/" + codec.name + "/decompress/int64",
+        [codec](State& state) { bench_decompress<int64_t>(state, codec); })
+        ->range(64 << 10, 4 << 20);
+  }
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
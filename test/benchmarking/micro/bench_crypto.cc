@@ -0,0 +1,118 @@
+/**
+ * @file   bench_crypto.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for the AES-256-GCM encryption of `tiledb/sm/crypto`,
+ * which runs on every tile chunk of encrypted arrays. The argument is the
+ * input size in bytes; the smallest sizes are those of `unit-crypto.cc`.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/buffer/preallocated_buffer.h"
+#include "tiledb/sm/crypto/crypto.h"
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+const char key_bytes[] = "0123456789abcdeF0123456789abcdeF";
+
+void bench_encrypt(State& state) {
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = random_values<uint8_t>(nbytes, (uint8_t)0, (uint8_t)255);
+  ConstBuffer key(key_bytes, Crypto::AES256GCM_KEY_BYTES);
+  char iv_array[Crypto::AES256GCM_IV_BYTES];
+  char tag_array[Crypto::AES256GCM_TAG_BYTES];
+
+  Buffer out;
+  while (state.keep_running()) {
+    ConstBuffer in(data.data(), nbytes);
+    PreallocatedBuffer output_iv(iv_array, sizeof(iv_array));
+    PreallocatedBuffer output_tag(tag_array, sizeof(tag_array));
+    out.reset_offset();
+    out.reset_size();
+    if (!Crypto::encrypt_aes256gcm(
+             &key, nullptr, &in, &out, &output_iv, &output_tag)
+             .ok()) {
+      state.skip_with_error("encrypt failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(nbytes);
+}
+
+void bench_decrypt(State& state) {
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = random_values<uint8_t>(nbytes, (uint8_t)0, (uint8_t)255);
+  ConstBuffer key(key_bytes, Crypto::AES256GCM_KEY_BYTES);
+  char iv_array[Crypto::AES256GCM_IV_BYTES];
+  char tag_array[Crypto::AES256GCM_TAG_BYTES];
+
+  Buffer encrypted;
+  ConstBuffer in(data.data(), nbytes);
+  PreallocatedBuffer output_iv(iv_array, sizeof(iv_array));
+  PreallocatedBuffer output_tag(tag_array, sizeof(tag_array));
+  if (!Crypto::encrypt_aes256gcm(
+           &key, nullptr, &in, &encrypted, &output_iv, &output_tag)
+           .ok()) {
+    state.skip_with_error("encrypt failed");
+    return;
+  }
+
+  ConstBuffer iv(iv_array, sizeof(iv_array));
+  ConstBuffer tag(tag_array, sizeof(tag_array));
+  std::vector<uint8_t> decrypted(nbytes);
+  while (state.keep_running()) {
+    ConstBuffer cin(encrypted.data(), encrypted.size());
+    Buffer out(decrypted.data(), nbytes);
+    if (!Crypto::decrypt_aes256gcm(&key, &iv, &tag, &cin, &out).ok()) {
+      state.skip_with_error("decrypt failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(nbytes);
+}
+
+bool register_all() {
+  register_benchmark("Crypto/aes256gcm/encrypt", bench_encrypt)
+      ->range(492, 492 << 9);
+  register_benchmark("Crypto/aes256gcm/decrypt", bench_decrypt)
+      ->range(492, 492 << 9);
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
@@ -0,0 +1,161 @@
+/**
+ * @file   bench_filter_kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for the filter kernels of `simd_kernels.h`, comparing the
+ * dispatched (AVX2 or SSE4.2 when available) implementations with the
+ * portable ones where both exist. The argument is the number of values, or
+ * the number of bytes for the CRC32C checksum.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/filter/simd_kernels.h"
+
+#include <algorithm>
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+template <class T>
+void bench_min_max(State& state) {
+  const uint64_t num = (uint64_t)state.arg(0);
+  auto values = sensor_values<T>(num);
+
+  T min = 0, max = 0;
+  while (state.keep_running()) {
+    simd::min_max(values.data(), num, &min, &max);
+    do_not_optimize(min);
+    do_not_optimize(max);
+  }
+
+  state.set_bytes_per_iteration(num * sizeof(T));
+}
+
+template <class T, bool Generic>
+void bench_delta_encode(State& state) {
+  const uint64_t num = (uint64_t)state.arg(0);
+  auto values = sensor_values<T>(num);
+  std::sort(values.begin(), values.end());
+  std::vector<T> deltas(num);
+
+  while (state.keep_running()) {
+    bool ok = Generic ? simd::generic::delta_encode(
+                            values.data(), num, values[0], deltas.data()) :
+                        simd::delta_encode(
+                            values.data(), num, values[0], deltas.data());
+    do_not_optimize(ok);
+  }
+
+  state.set_bytes_per_iteration(num * sizeof(T));
+}
+
+template <class T, bool Generic>
+void bench_prefix_sum(State& state) {
+  const uint64_t num = (uint64_t)state.arg(0);
+  auto deltas = random_values<T>(num, (T)0, (T)16);
+  std::vector<T> values(num);
+
+  while (state.keep_running()) {
+    if (Generic)
+      simd::generic::prefix_sum(deltas.data(), num, (T)0, values.data());
+    else
+      simd::prefix_sum(deltas.data(), num, (T)0, values.data());
+    do_not_optimize(values[num - 1]);
+  }
+
+  state.set_bytes_per_iteration(num * sizeof(T));
+}
+
+template <class T, class U>
+void bench_narrow(State& state) {
+  const uint64_t num = (uint64_t)state.arg(0);
+  auto values = sensor_values<T>(num);
+  std::vector<U> narrowed(num);
+
+  while (state.keep_running()) {
+    simd::narrow(values.data(), num, (T)1000, narrowed.data());
+    do_not_optimize(narrowed[num - 1]);
+  }
+
+  state.set_bytes_per_iteration(num * sizeof(T));
+}
+
+template <bool Generic>
+void bench_crc32c(State& state) {
+  const uint64_t num = (uint64_t)state.arg(0);
+  auto bytes = random_values<uint8_t>(num, (uint8_t)0, (uint8_t)255);
+
+  while (state.keep_running()) {
+    uint32_t crc = Generic ? simd::generic::crc32c(0, bytes.data(), num) :
+                             simd::crc32c(0, bytes.data(), num);
+    do_not_optimize(crc);
+  }
+
+  state.set_bytes_per_iteration(num);
+}
+
+/** Registers the generic and dispatched versions of a kernel benchmark. */
+template <void (*Generic)(State&), void (*Dispatched)(State&)>
+void register_pair(const std::string& name) {
+  register_benchmark("FilterKernels/" + name + "/generic", Generic)
+      ->range(1 << 10, 1 << 20);
+  register_benchmark("FilterKernels/" + name + "/dispatched", Dispatched)
+      ->range(1 << 10, 1 << 20);
+}
+
+bool register_all() {
+  register_benchmark("FilterKernels/min_max/int32", bench_min_max<int32_t>)
+      ->range(1 << 10, 1 << 20);
+  register_benchmark("FilterKernels/min_max/uint64", bench_min_max<uint64_t>)
+      ->range(1 << 10, 1 << 20);
+  register_pair<
+      bench_delta_encode<int32_t, true>,
+      bench_delta_encode<int32_t, false>>("delta_encode/int32");
+  register_pair<
+      bench_delta_encode<uint64_t, true>,
+      bench_delta_encode<uint64_t, false>>("delta_encode/uint64");
+  register_pair<
+      bench_prefix_sum<int32_t, true>,
+      bench_prefix_sum<int32_t, false>>("prefix_sum/int32");
+  register_pair<
+      bench_prefix_sum<uint64_t, true>,
+      bench_prefix_sum<uint64_t, false>>("prefix_sum/uint64");
+  register_benchmark(
+      "FilterKernels/narrow/uint64_uint8", bench_narrow<uint64_t, uint8_t>)
+      ->range(1 << 10, 1 << 20);
+  register_pair<bench_crc32c<true>, bench_crc32c<false>>("crc32c");
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
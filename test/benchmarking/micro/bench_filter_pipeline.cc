@@ -0,0 +1,159 @@
+/**
+ * @file   bench_filter_pipeline.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `FilterPipeline::run_forward` and
+ * `FilterPipeline::run_reverse`. The argument is the tile size in bytes.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/enums/compressor.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/filter/bit_width_reduction_filter.h"
+#include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_md5_filter.h"
+#include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/positive_delta_filter.h"
+#include "tiledb/sm/tile/tile.h"
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+/** Builds the filter pipeline with the given name. */
+bool make_pipeline(const std::string& name, FilterPipeline* pipeline) {
+  if (name == "none") {
+    return true;
+  } else if (name == "lz4") {
+    return pipeline->add_filter(CompressionFilter(Compressor::LZ4, -1)).ok();
+  } else if (name == "zstd") {
+    return pipeline->add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok();
+  } else if (name == "byteshuffle_zstd") {
+    return pipeline->add_filter(ByteshuffleFilter()).ok() &&
+           pipeline->add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok();
+  } else if (name == "delta_bitwidth_zstd") {
+    return pipeline->add_filter(PositiveDeltaFilter()).ok() &&
+           pipeline->add_filter(BitWidthReductionFilter()).ok() &&
+           pipeline->add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok();
+  } else if (name == "md5") {
+    return pipeline->add_filter(ChecksumMD5Filter()).ok();
+  }
+  return false;
+}
+
+void bench_run_forward(State& state, const std::string& name) {
+  FilterPipeline pipeline;
+  if (!make_pipeline(name, &pipeline)) {
+    state.skip_with_error("cannot create pipeline " + name);
+    return;
+  }
+
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = sensor_values<uint64_t>(nbytes / sizeof(uint64_t));
+
+  while (state.keep_running()) {
+    state.pause_timing();
+    Buffer buff;
+    buff.write(data.data(), data.size() * sizeof(uint64_t));
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+    state.resume_timing();
+
+    if (!pipeline.run_forward(&tile).ok()) {
+      state.skip_with_error("run_forward failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(data.size() * sizeof(uint64_t));
+}
+
+void bench_run_reverse(State& state, const std::string& name) {
+  FilterPipeline pipeline;
+  if (!make_pipeline(name, &pipeline)) {
+    state.skip_with_error("cannot create pipeline " + name);
+    return;
+  }
+
+  // Filter the data once, the timed loop only unfilters it.
+  uint64_t nbytes = (uint64_t)state.arg(0);
+  auto data = sensor_values<uint64_t>(nbytes / sizeof(uint64_t));
+  Buffer filtered;
+  filtered.write(data.data(), data.size() * sizeof(uint64_t));
+  {
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &filtered, false);
+    if (!pipeline.run_forward(&tile).ok()) {
+      state.skip_with_error("run_forward failed");
+      return;
+    }
+  }
+
+  while (state.keep_running()) {
+    state.pause_timing();
+    Buffer buff;
+    buff.write(filtered.data(), filtered.size());
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+    state.resume_timing();
+
+    if (!pipeline.run_reverse(&tile).ok()) {
+      state.skip_with_error("run_reverse failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(data.size() * sizeof(uint64_t));
+}
+
+bool register_all() {
+  const char* pipelines[] = {"none",
+                             "lz4",
+                             "zstd",
+                             "byteshuffle_zstd",
+                             "delta_bitwidth_zstd",
+                             "md5"};
+  for (auto p : pipelines) {
+    std::string name(p);
+    register_benchmark(
+        "FilterPipeline/run_forward/" + name,
+        [name](State& state) { bench_run_forward(state, name); })
+        ->range(64 << 10, 4 << 20);
+    register_benchmark(
+        "FilterPipeline/run_reverse/" + name,
+        [name](State& state) { bench_run_reverse(state, name); })
+        ->range(64 << 10, 4 << 20);
+  }
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
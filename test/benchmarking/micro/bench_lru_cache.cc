@@ -0,0 +1,110 @@
+/**
+ * @file   bench_lru_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `LRUCache` insertion (with eviction) and reads. The
+ * argument is the size in bytes of each cached object.
+ */
+
+#include "micro_benchmark.h"
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/lru_cache.h"
+
+#include <cstdlib>
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+/** Number of distinct keys used by the benchmarks. */
+const uint64_t key_num = 1024;
+
+std::vector<std::string> make_keys() {
+  std::vector<std::string> keys;
+  for (uint64_t i = 0; i < key_num; ++i)
+    keys.push_back("file:///array/__fragment_" + std::to_string(i) + "/a.tdb");
+  return keys;
+}
+
+void bench_insert(State& state) {
+  const uint64_t object_size = (uint64_t)state.arg(0);
+  auto keys = make_keys();
+
+  // The cache holds a quarter of the keys, so inserts also evict. Cached
+  // objects are released by the cache with `std::free`.
+  LRUCache cache(object_size * key_num / 4);
+  uint64_t i = 0;
+  while (state.keep_running()) {
+    void* object = std::malloc(object_size);
+    if (!cache.insert(keys[i++ % key_num], object, object_size).ok()) {
+      state.skip_with_error("insert failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(object_size);
+}
+
+void bench_read(State& state) {
+  const uint64_t object_size = (uint64_t)state.arg(0);
+  auto keys = make_keys();
+
+  LRUCache cache(object_size * key_num);
+  for (const auto& key : keys) {
+    void* object = std::calloc(1, object_size);
+    if (!cache.insert(key, object, object_size).ok()) {
+      state.skip_with_error("insert failed");
+      return;
+    }
+  }
+
+  Buffer buffer;
+  uint64_t i = 0;
+  while (state.keep_running()) {
+    bool success = false;
+    buffer.reset_offset();
+    buffer.reset_size();
+    if (!cache.read(keys[(i++ * 31) % key_num], &buffer, &success).ok() ||
+        !success) {
+      state.skip_with_error("read failed");
+      break;
+    }
+  }
+
+  state.set_bytes_per_iteration(object_size);
+}
+
+bool registered TILEDB_MICRO_UNUSED =
+    register_benchmark("LRUCache/insert", bench_insert)
+        ->range(1 << 10, 1 << 20) != nullptr &&
+    register_benchmark("LRUCache/read", bench_read)->range(1 << 10, 1 << 20) !=
+        nullptr;
+
+}  // namespace
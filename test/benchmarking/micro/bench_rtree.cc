@@ -0,0 +1,112 @@
+/**
+ * @file   bench_rtree.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `RTree::get_tile_overlap` on 2D trees. The first
+ * argument is the number of leaf MBRs, the second one the percentage of the
+ * domain (per dimension) covered by the query range.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/rtree/rtree.h"
+
+#include <cmath>
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+template <class T>
+void bench_get_tile_overlap(State& state, Datatype type) {
+  const uint64_t leaf_num = (uint64_t)state.arg(0);
+  const uint64_t pct = (uint64_t)state.arg(1);
+
+  // Lay out the leaves on a square grid of unit-sized MBRs.
+  const uint64_t side = (uint64_t)std::ceil(std::sqrt((double)leaf_num));
+  Domain domain;
+  create_domain<T>(type, 2, (T)(side * 10), (T)10, &domain);
+
+  std::vector<NDRange> mbrs(leaf_num);
+  for (uint64_t i = 0; i < leaf_num; ++i) {
+    T r[] = {(T)((i / side) * 10), (T)((i / side) * 10 + 9)};
+    T c[] = {(T)((i % side) * 10), (T)((i % side) * 10 + 9)};
+    mbrs[i].resize(2);
+    mbrs[i][0].set_range(r, sizeof(r));
+    mbrs[i][1].set_range(c, sizeof(c));
+  }
+
+  RTree rtree(&domain, 10);
+  if (!rtree.set_leaves(mbrs).ok() || !rtree.build_tree().ok()) {
+    state.skip_with_error("cannot build R-tree");
+    return;
+  }
+
+  // Query a square range in the middle of the domain.
+  T width = (T)std::max<uint64_t>(1, side * 10 * pct / 100);
+  T lo = (T)(side * 5 - (uint64_t)width / 2);
+  T range[] = {lo, (T)(lo + width - 1)};
+  NDRange query(2);
+  query[0].set_range(range, sizeof(range));
+  query[1].set_range(range, sizeof(range));
+
+  while (state.keep_running()) {
+    auto overlap = rtree.get_tile_overlap(query);
+    do_not_optimize(overlap);
+  }
+
+  state.set_items_per_iteration(leaf_num);
+}
+
+bool register_all() {
+  register_benchmark("RTree/get_tile_overlap/int32", [](State& state) {
+    bench_get_tile_overlap<int32_t>(state, Datatype::INT32);
+  })
+      ->args({1 << 10, 1})
+      ->args({1 << 10, 50})
+      ->args({1 << 16, 1})
+      ->args({1 << 16, 50})
+      ->args({1 << 20, 1})
+      ->args({1 << 20, 50});
+  register_benchmark("RTree/get_tile_overlap/float64", [](State& state) {
+    bench_get_tile_overlap<double>(state, Datatype::FLOAT64);
+  })
+      ->args({1 << 10, 1})
+      ->args({1 << 10, 50})
+      ->args({1 << 16, 1})
+      ->args({1 << 16, 50})
+      ->args({1 << 20, 1})
+      ->args({1 << 20, 50});
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
@@ -0,0 +1,124 @@
+/**
+ * @file   bench_sort.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `parallel_sort` of `ResultCoords` with the `GlobalCmp`,
+ * `RowCmp` and `ColCmp` comparators, as done by the Reader for sparse reads.
+ * The argument is the number of coordinates to sort.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/comparators.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/query/result_tile.h"
+#include "tiledb/sm/tile/tile.h"
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+template <class T, class CmpT>
+void bench_sort_coords(State& state, Datatype type) {
+  const uint64_t cell_num = (uint64_t)state.arg(0);
+  const unsigned dim_num = 2;
+  const T dim_extent = (T)10000;
+
+  Domain domain;
+  create_domain<T>(type, dim_num, dim_extent, (T)100, &domain);
+
+  // Build a single result tile holding random coordinates, one tile per
+  // dimension.
+  ResultTile result_tile(0, 0, &domain);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto name = domain.dimension(d)->name();
+    result_tile.init_coord_tile(name, d);
+    auto values = random_values<T>(cell_num, (T)0, (T)(dim_extent - 1));
+    auto buff = new Buffer();
+    buff->write(values.data(), cell_num * sizeof(T));
+    result_tile.tile_pair(name)->first =
+        Tile(type, sizeof(T), 0, buff, true);
+  }
+
+  std::vector<ResultCoords> unsorted;
+  unsorted.reserve(cell_num);
+  for (uint64_t i = 0; i < cell_num; ++i)
+    unsorted.emplace_back(&result_tile, i);
+
+  std::vector<ResultCoords> coords;
+  while (state.keep_running()) {
+    state.pause_timing();
+    coords = unsorted;
+    state.resume_timing();
+
+    parallel_sort(coords.begin(), coords.end(), CmpT(&domain));
+  }
+
+  state.set_items_per_iteration(cell_num);
+}
+
+bool register_all() {
+  register_benchmark(
+      "parallel_sort/GlobalCmp/int32",
+      [](State& state) {
+        bench_sort_coords<int32_t, GlobalCmp>(state, Datatype::INT32);
+      })
+      ->range(1 << 12, 1 << 21);
+  register_benchmark(
+      "parallel_sort/GlobalCmp/int64",
+      [](State& state) {
+        bench_sort_coords<int64_t, GlobalCmp>(state, Datatype::INT64);
+      })
+      ->range(1 << 12, 1 << 21);
+  register_benchmark(
+      "parallel_sort/GlobalCmp/float64",
+      [](State& state) {
+        bench_sort_coords<double, GlobalCmp>(state, Datatype::FLOAT64);
+      })
+      ->range(1 << 12, 1 << 21);
+  register_benchmark(
+      "parallel_sort/RowCmp/int64",
+      [](State& state) {
+        bench_sort_coords<int64_t, RowCmp>(state, Datatype::INT64);
+      })
+      ->range(1 << 12, 1 << 21);
+  register_benchmark(
+      "parallel_sort/ColCmp/int64",
+      [](State& state) {
+        bench_sort_coords<int64_t, ColCmp>(state, Datatype::INT64);
+      })
+      ->range(1 << 12, 1 << 21);
+  return true;
+}
+
+bool registered TILEDB_MICRO_UNUSED = register_all();
+
+}  // namespace
@@ -0,0 +1,134 @@
+/**
+ * @file   bench_subarray.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `Subarray::compute_tile_overlap` on a local sparse
+ * array. The first argument is the number of fragments, the second one the
+ * number of ranges per dimension in the subarray.
+ */
+
+#include "micro_benchmark.h"
+#include "micro_benchmark_helpers.h"
+
+#include "tiledb/sm/c_api/tiledb_struct_def.h"
+#include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/subarray/subarray.h"
+
+using namespace tiledb::bench;
+
+namespace {
+
+/** Creates a sparse 2D array with `fragment_num` fragments. */
+void create_array(
+    tiledb::Context& ctx, const std::string& uri, uint64_t fragment_num) {
+  tiledb::VFS vfs(ctx);
+  if (vfs.is_dir(uri))
+    vfs.remove_dir(uri);
+
+  tiledb::Domain domain(ctx);
+  domain.add_dimension(
+      tiledb::Dimension::create<int64_t>(ctx, "d1", {{1, 10000}}, 100))
+      .add_dimension(
+          tiledb::Dimension::create<int64_t>(ctx, "d2", {{1, 10000}}, 100));
+  tiledb::ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(100);
+  schema.add_attribute(tiledb::Attribute::create<int32_t>(ctx, "a"));
+  tiledb::Array::create(uri, schema);
+
+  const uint64_t cell_num = 10000;
+  std::vector<int32_t> a(cell_num, 1);
+  for (uint64_t f = 0; f < fragment_num; ++f) {
+    auto d1 = random_values<int64_t>(cell_num, 1, 10000);
+    auto d2 = random_values<int64_t>(cell_num, 1, 10000);
+    // Vary the coordinates across fragments.
+    for (auto& v : d2)
+      v = (v + (int64_t)f * 997) % 10000 + 1;
+    tiledb::Array array(ctx, uri, TILEDB_WRITE);
+    tiledb::Query query(ctx, array, TILEDB_WRITE);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", a)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2);
+    query.submit();
+    array.close();
+  }
+}
+
+void bench_compute_tile_overlap(State& state) {
+  const uint64_t fragment_num = (uint64_t)state.arg(0);
+  const uint64_t range_num = (uint64_t)state.arg(1);
+  const std::string uri = "tiledb_micro_bench_subarray";
+
+  tiledb::Context ctx;
+  try {
+    create_array(ctx, uri, fragment_num);
+  } catch (const std::exception& e) {
+    state.skip_with_error(e.what());
+    return;
+  }
+
+  tiledb::Array array(ctx, uri, TILEDB_READ);
+  const tiledb::sm::Array* internal = array.ptr()->array_;
+
+  // Evenly spaced ranges of width 50 along both dimensions.
+  std::vector<tiledb::sm::Range> ranges;
+  for (uint64_t r = 0; r < range_num; ++r) {
+    int64_t lo = 1 + (int64_t)(r * (10000 / range_num));
+    int64_t range[] = {lo, lo + 49};
+    ranges.emplace_back(range, sizeof(range));
+  }
+
+  while (state.keep_running()) {
+    state.pause_timing();
+    tiledb::sm::Subarray subarray(internal, tiledb::sm::Layout::ROW_MAJOR);
+    for (unsigned d = 0; d < 2; ++d) {
+      for (const auto& range : ranges)
+        subarray.add_range(d, range);
+    }
+    state.resume_timing();
+
+    if (!subarray.compute_tile_overlap().ok()) {
+      state.skip_with_error("compute_tile_overlap failed");
+      break;
+    }
+  }
+
+  array.close();
+  tiledb::VFS(ctx).remove_dir(uri);
+  state.set_items_per_iteration(fragment_num * range_num * range_num);
+}
+
+bool registered TILEDB_MICRO_UNUSED =
+    register_benchmark("Subarray/compute_tile_overlap", bench_compute_tile_overlap)
+        ->args({1, 1})
+        ->args({1, 16})
+        ->args({16, 1})
+        ->args({16, 16})
+        ->args({64, 16}) != nullptr;
+
+}  // namespace
@@ -0,0 +1,112 @@
+/**
+ * @file   bench_vfs.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmarks for `VFS::read_all` on a local file, which groups the
+ * requested regions with `VFS::compute_read_batches` before reading them.
+ * The first argument is the number of regions, the second one the gap in
+ * bytes between consecutive regions.
+ */
+
+#include "micro_benchmark.h"
+
+#include "tiledb/sm/config/config.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/misc/thread_pool.h"
+#include "tiledb/sm/misc/uri.h"
+
+#ifdef _WIN32
+#include "tiledb/sm/filesystem/win.h"
+#else
+#include "tiledb/sm/filesystem/posix.h"
+#endif
+
+using namespace tiledb::sm;
+using namespace tiledb::bench;
+
+namespace {
+
+void bench_read_all(State& state) {
+  const uint64_t region_num = (uint64_t)state.arg(0);
+  const uint64_t gap = (uint64_t)state.arg(1);
+  const uint64_t region_size = 4096;
+
+#ifdef _WIN32
+  URI uri(Win::current_dir() + "\\tiledb_micro_bench_vfs_read_all");
+#else
+  URI uri(Posix::current_dir() + "/tiledb_micro_bench_vfs_read_all");
+#endif
+
+  Config config;
+  VFS vfs;
+  ThreadPool thread_pool;
+  if (!vfs.init(nullptr, &config).ok() || !thread_pool.init(4).ok()) {
+    state.skip_with_error("cannot initialize VFS");
+    return;
+  }
+
+  // Write the file the regions are read from.
+  const uint64_t file_size = region_num * (region_size + gap);
+  std::vector<char> contents(file_size, 'x');
+  if (!vfs.write(uri, contents.data(), file_size).ok() ||
+      !vfs.close_file(uri).ok()) {
+    state.skip_with_error("cannot write file");
+    return;
+  }
+
+  // Regions are given out of order, as the Reader does.
+  std::vector<char> dest(region_num * region_size);
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> regions;
+  for (uint64_t i = 0; i < region_num; ++i) {
+    uint64_t r = (i * 7919) % region_num;
+    regions.emplace_back(
+        r * (region_size + gap), &dest[r * region_size], region_size);
+  }
+
+  while (state.keep_running()) {
+    std::vector<std::future<Status>> tasks;
+    if (!vfs.read_all(uri, regions, &thread_pool, &tasks).ok() ||
+        !thread_pool.wait_all(tasks).ok()) {
+      state.skip_with_error("read_all failed");
+      break;
+    }
+  }
+
+  vfs.remove_file(uri);
+  state.set_bytes_per_iteration(region_num * region_size);
+  state.set_items_per_iteration(region_num);
+}
+
+bool registered TILEDB_MICRO_UNUSED =
+    register_benchmark("VFS/read_all", bench_read_all)
+        ->args({64, 0})
+        ->args({64, 1 << 20})
+        ->args({4096, 0})
+        ->args({4096, 16 << 10}) != nullptr;
+
+}  // namespace
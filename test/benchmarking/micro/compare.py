@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+
+"""
+Compares two JSON result files produced by the TileDB micro-benchmarks
+(`tiledb_micro_benchmarks --format=json --out=<file>`) and reports the
+relative change of each benchmark. Exits with a non-zero status if any
+benchmark regressed by more than the given threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    """
+    Loads a micro-benchmark JSON result file.
+
+    :param path: path to the JSON file
+    :return: dict mapping benchmark name to its result entry
+    """
+    with open(path) as f:
+        doc = json.load(f)
+    results = {}
+    for b in doc.get('benchmarks', []):
+        results[b['name']] = b
+    return results
+
+
+def compare(baseline, contender, threshold_pct, metric):
+    """
+    Compares the contender results to the baseline.
+
+    :param baseline: dict of baseline results
+    :param contender: dict of contender results
+    :param threshold_pct: regression threshold in percent
+    :param metric: time field to compare ('real_time' or 'min_time')
+    :return: list of (name, base_ns, new_ns, change_pct, status) tuples
+    """
+    rows = []
+    for name in sorted(set(baseline.keys()) | set(contender.keys())):
+        base = baseline.get(name)
+        new = contender.get(name)
+        if base is None:
+            rows.append((name, None, new.get(metric), None, 'NEW'))
+            continue
+        if new is None:
+            rows.append((name, base.get(metric), None, None, 'REMOVED'))
+            continue
+        if base.get('error_occurred') or new.get('error_occurred'):
+            rows.append((name, base.get(metric), new.get(metric), None,
+                         'ERROR'))
+            continue
+
+        base_ns = float(base[metric])
+        new_ns = float(new[metric])
+        change = 0.0 if base_ns == 0 else 100.0 * (new_ns - base_ns) / base_ns
+        if change > threshold_pct:
+            status = 'REGRESSION'
+        elif change < -threshold_pct:
+            status = 'IMPROVEMENT'
+        else:
+            status = ''
+        rows.append((name, base_ns, new_ns, change, status))
+    return rows
+
+
+def format_ns(value):
+    """Formats a time in nanoseconds, or '-' if missing."""
+    return '-' if value is None else '{:.0f}'.format(value)
+
+
+def print_rows(rows):
+    """Prints the comparison table."""
+    print('{:<60s}{:>16s}{:>16s}{:>10s}  {}'.format(
+        'Benchmark', 'Base (ns)', 'New (ns)', 'Change', 'Status'))
+    print('-' * 118)
+    for name, base_ns, new_ns, change, status in rows:
+        change_str = '-' if change is None else '{:+.1f}%'.format(change)
+        print('{:<60s}{:>16s}{:>16s}{:>10s}  {}'.format(
+            name, format_ns(base_ns), format_ns(new_ns), change_str, status))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares TileDB micro-benchmark results.')
+    parser.add_argument('baseline', help='Baseline JSON result file.')
+    parser.add_argument('contender', help='Contender JSON result file.')
+    parser.add_argument('-t', '--threshold', type=float, default=5.0,
+                        help='Regression threshold in percent (default 5).')
+    parser.add_argument('-m', '--metric', default='real_time',
+                        choices=['real_time', 'min_time'],
+                        help='Time field to compare (default real_time, the '
+                             'median over repetitions).')
+    args = parser.parse_args()
+
+    rows = compare(load_results(args.baseline), load_results(args.contender),
+                   args.threshold, args.metric)
+    print_rows(rows)
+
+    regressions = [r for r in rows if r[4] in ('REGRESSION', 'ERROR')]
+    if regressions:
+        print('\n{} benchmark(s) regressed by more than {}%.'.format(
+            len(regressions), args.threshold))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,505 @@
+/**
+ * @file   micro_benchmark.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Implements the micro-benchmark harness.
+ */
+
+#include "micro_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace tiledb {
+namespace bench {
+
+/* ********************************* */
+/*               STATE               */
+/* ********************************* */
+
+State::State(const std::vector<int64_t>& args, uint64_t max_iterations)
+    : args_(args)
+    , max_iterations_(max_iterations)
+    , iterations_(0)
+    , elapsed_ns_(0)
+    , running_(false)
+    , bytes_per_iteration_(0)
+    , items_per_iteration_(0) {
+}
+
+int64_t State::arg(unsigned idx) const {
+  return idx < args_.size() ? args_[idx] : 0;
+}
+
+bool State::keep_running() {
+  if (!error_.empty()) {
+    pause_timing();
+    return false;
+  }
+
+  if (iterations_ == 0 && !running_)
+    resume_timing();
+
+  if (iterations_ < max_iterations_) {
+    ++iterations_;
+    return true;
+  }
+
+  pause_timing();
+  return false;
+}
+
+void State::pause_timing() {
+  if (!running_)
+    return;
+  auto end = std::chrono::steady_clock::now();
+  elapsed_ns_ +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+          .count();
+  running_ = false;
+}
+
+void State::resume_timing() {
+  if (running_)
+    return;
+  start_ = std::chrono::steady_clock::now();
+  running_ = true;
+}
+
+void State::set_bytes_per_iteration(uint64_t bytes) {
+  bytes_per_iteration_ = bytes;
+}
+
+void State::set_items_per_iteration(uint64_t items) {
+  items_per_iteration_ = items;
+}
+
+void State::skip_with_error(const std::string& msg) {
+  error_ = msg;
+}
+
+uint64_t State::iterations() const {
+  return iterations_;
+}
+
+uint64_t State::elapsed_ns() const {
+  return elapsed_ns_;
+}
+
+uint64_t State::bytes_per_iteration() const {
+  return bytes_per_iteration_;
+}
+
+uint64_t State::items_per_iteration() const {
+  return items_per_iteration_;
+}
+
+const std::string& State::error() const {
+  return error_;
+}
+
+/* ********************************* */
+/*             BENCHMARK             */
+/* ********************************* */
+
+Benchmark::Benchmark(const std::string& name, const Function& func)
+    : name_(name)
+    , func_(func) {
+}
+
+Benchmark* Benchmark::args(const std::vector<int64_t>& args) {
+  arg_sets_.push_back(args);
+  return this;
+}
+
+Benchmark* Benchmark::range(int64_t lo, int64_t hi, int64_t mult) {
+  for (int64_t v = lo; v <= hi; v *= std::max<int64_t>(mult, 2))
+    arg_sets_.push_back({v});
+  return this;
+}
+
+const std::string& Benchmark::name() const {
+  return name_;
+}
+
+const Benchmark::Function& Benchmark::func() const {
+  return func_;
+}
+
+const std::vector<std::vector<int64_t>>& Benchmark::arg_sets() const {
+  return arg_sets_;
+}
+
+/* ********************************* */
+/*              RUNNER               */
+/* ********************************* */
+
+namespace {
+
+/** The global benchmark registry. */
+std::vector<std::unique_ptr<Benchmark>>& registry() {
+  static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+  return benchmarks;
+}
+
+/** Command line options of the runner. */
+struct Options {
+  std::string filter = ".*";
+  double min_time_s = 0.5;
+  unsigned repetitions = 3;
+  std::string format = "console";
+  std::string out;
+  bool list = false;
+};
+
+/** The result of one benchmark instance. */
+struct Result {
+  std::string name;
+  uint64_t iterations = 0;
+  std::vector<double> ns_per_iter;
+  uint64_t bytes_per_iteration = 0;
+  uint64_t items_per_iteration = 0;
+  std::string error;
+
+  double median() const {
+    if (ns_per_iter.empty())
+      return 0.0;
+    std::vector<double> v(ns_per_iter);
+    std::sort(v.begin(), v.end());
+    auto n = v.size();
+    return (n % 2) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+  }
+
+  double min() const {
+    return ns_per_iter.empty() ?
+               0.0 :
+               *std::min_element(ns_per_iter.begin(), ns_per_iter.end());
+  }
+
+  double mean() const {
+    if (ns_per_iter.empty())
+      return 0.0;
+    double sum = 0.0;
+    for (auto v : ns_per_iter)
+      sum += v;
+    return sum / ns_per_iter.size();
+  }
+
+  double stddev() const {
+    if (ns_per_iter.size() < 2)
+      return 0.0;
+    double m = mean(), sum = 0.0;
+    for (auto v : ns_per_iter)
+      sum += (v - m) * (v - m);
+    return std::sqrt(sum / (ns_per_iter.size() - 1));
+  }
+};
+
+void usage(const char* argv0) {
+  std::cerr
+      << "USAGE: " << argv0 << " [options]" << std::endl
+      << std::endl
+      << "Runs the TileDB core micro-benchmarks. Options:" << std::endl
+      << "    --filter=<regex>     Only run benchmarks matching the regex."
+      << std::endl
+      << "    --min_time=<sec>     Minimum timed duration per repetition "
+         "(default 0.5)."
+      << std::endl
+      << "    --repetitions=<n>    Number of repetitions (default 3)."
+      << std::endl
+      << "    --format=<fmt>       'console' (default) or 'json'." << std::endl
+      << "    --out=<file>         Write the results to <file>." << std::endl
+      << "    --list               List the benchmarks and exit."
+      << std::endl;
+}
+
+bool parse_options(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    auto eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+    if (key == "--filter") {
+      options->filter = value;
+    } else if (key == "--min_time") {
+      options->min_time_s = std::atof(value.c_str());
+    } else if (key == "--repetitions") {
+      options->repetitions = std::max(1, std::atoi(value.c_str()));
+    } else if (key == "--format" && (value == "console" || value == "json")) {
+      options->format = value;
+    } else if (key == "--out") {
+      options->out = value;
+    } else if (key == "--list") {
+      options->list = true;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string instance_name(
+    const Benchmark& benchmark, const std::vector<int64_t>& args) {
+  std::stringstream ss;
+  ss << benchmark.name();
+  for (auto a : args)
+    ss << "/" << a;
+  return ss.str();
+}
+
+/**
+ * Runs a single benchmark instance, first calibrating the number of
+ * iterations so that each repetition lasts at least `min_time_s`.
+ */
+Result run_instance(
+    const Benchmark& benchmark,
+    const std::vector<int64_t>& args,
+    const Options& options) {
+  Result result;
+  result.name = instance_name(benchmark, args);
+
+  const double min_time_ns = options.min_time_s * 1e9;
+  uint64_t iters = 1;
+  for (;;) {
+    State state(args, iters);
+    benchmark.func()(state);
+    if (!state.error().empty()) {
+      result.error = state.error();
+      return result;
+    }
+
+    double elapsed = (double)state.elapsed_ns();
+    if (elapsed >= min_time_ns || iters >= (uint64_t(1) << 40))
+      break;
+
+    // Predict the number of iterations needed, with some headroom, and
+    // never grow more than 10x at a time.
+    double multiplier =
+        elapsed <= 0.0 ? 10.0 : std::min(10.0, 1.4 * min_time_ns / elapsed);
+    iters = std::max(iters + 1, (uint64_t)(iters * multiplier));
+  }
+
+  result.iterations = iters;
+  for (unsigned r = 0; r < options.repetitions; ++r) {
+    State state(args, iters);
+    benchmark.func()(state);
+    if (!state.error().empty()) {
+      result.error = state.error();
+      return result;
+    }
+    result.ns_per_iter.push_back(
+        (double)state.elapsed_ns() / (double)state.iterations());
+    result.bytes_per_iteration = state.bytes_per_iteration();
+    result.items_per_iteration = state.items_per_iteration();
+  }
+
+  return result;
+}
+
+std::string json_escape(const std::string& s) {
+  std::string out;
+  for (auto c : s) {
+    if (c == '"' || c == '\\')
+      out.push_back('\\');
+    out.push_back(c);
+  }
+  return out;
+}
+
+void report_json(std::ostream& os, const std::vector<Result>& results) {
+  char date[64];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  os << "{\n";
+  os << "  \"context\": {\n";
+  os << "    \"date\": \"" << date << "\",\n";
+  os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+  os << "    \"library_build_type\": \"release\"\n";
+#else
+  os << "    \"library_build_type\": \"debug\"\n";
+#endif
+  os << "  },\n";
+  os << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& r = results[i];
+    os << (i == 0 ? "\n" : ",\n");
+    os << "    {\n";
+    os << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+    if (!r.error.empty()) {
+      os << "      \"error_occurred\": true,\n";
+      os << "      \"error_message\": \"" << json_escape(r.error) << "\"\n";
+      os << "    }";
+      continue;
+    }
+    double median = r.median();
+    os << "      \"iterations\": " << r.iterations << ",\n";
+    os << "      \"repetitions\": " << r.ns_per_iter.size() << ",\n";
+    os << "      \"real_time\": " << median << ",\n";
+    os << "      \"cpu_time\": " << median << ",\n";
+    os << "      \"min_time\": " << r.min() << ",\n";
+    os << "      \"mean_time\": " << r.mean() << ",\n";
+    os << "      \"stddev_time\": " << r.stddev() << ",\n";
+    if (r.bytes_per_iteration > 0 && median > 0)
+      os << "      \"bytes_per_second\": "
+         << (double)r.bytes_per_iteration * 1e9 / median << ",\n";
+    if (r.items_per_iteration > 0 && median > 0)
+      os << "      \"items_per_second\": "
+         << (double)r.items_per_iteration * 1e9 / median << ",\n";
+    os << "      \"time_unit\": \"ns\"\n";
+    os << "    }";
+  }
+  os << "\n  ]\n";
+  os << "}\n";
+}
+
+void report_console_header(std::ostream& os) {
+  char line[160];
+  std::snprintf(
+      line,
+      sizeof(line),
+      "%-60s%16s%16s%12s%14s",
+      "Benchmark",
+      "Time (ns)",
+      "Min (ns)",
+      "Iters",
+      "MB/s");
+  os << line << std::endl << std::string(118, '-') << std::endl;
+}
+
+void report_console(std::ostream& os, const Result& r) {
+  char line[256];
+  if (!r.error.empty()) {
+    std::snprintf(
+        line, sizeof(line), "%-60s ERROR: %s", r.name.c_str(), r.error.c_str());
+  } else {
+    double median = r.median();
+    double mbs = (r.bytes_per_iteration > 0 && median > 0) ?
+                     (double)r.bytes_per_iteration * 1e3 / median :
+                     0.0;
+    std::snprintf(
+        line,
+        sizeof(line),
+        "%-60s%16.0f%16.0f%12llu%14.1f",
+        r.name.c_str(),
+        median,
+        r.min(),
+        (unsigned long long)r.iterations,
+        mbs);
+  }
+  os << line << std::endl;
+}
+
+}  // namespace
+
+Benchmark* register_benchmark(
+    const std::string& name, const Benchmark::Function& func) {
+  registry().emplace_back(new Benchmark(name, func));
+  return registry().back().get();
+}
+
+int run_benchmarks(int argc, char** argv) {
+  Options options;
+  if (!parse_options(argc, argv, &options)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::regex filter;
+  try {
+    filter = std::regex(options.filter);
+  } catch (const std::regex_error& e) {
+    std::cerr << "Invalid filter regex '" << options.filter << "': " << e.what()
+              << std::endl;
+    return 1;
+  }
+
+  // Collect the matching benchmark instances.
+  std::vector<std::pair<const Benchmark*, std::vector<int64_t>>> instances;
+  for (const auto& b : registry()) {
+    auto arg_sets = b->arg_sets();
+    if (arg_sets.empty())
+      arg_sets.emplace_back();
+    for (const auto& args : arg_sets) {
+      if (std::regex_search(instance_name(*b, args), filter))
+        instances.emplace_back(b.get(), args);
+    }
+  }
+
+  if (options.list) {
+    for (const auto& inst : instances)
+      std::cout << instance_name(*inst.first, inst.second) << std::endl;
+    return 0;
+  }
+
+  bool console = options.format == "console";
+  if (console)
+    report_console_header(std::cout);
+
+  bool failed = false;
+  std::vector<Result> results;
+  for (const auto& inst : instances) {
+    results.push_back(run_instance(*inst.first, inst.second, options));
+    failed |= !results.back().error.empty();
+    if (console)
+      report_console(std::cout, results.back());
+  }
+
+  if (!console || !options.out.empty()) {
+    if (options.out.empty()) {
+      report_json(std::cout, results);
+    } else {
+      std::ofstream ofs(options.out);
+      if (!ofs) {
+        std::cerr << "Cannot open output file '" << options.out << "'"
+                  << std::endl;
+        return 1;
+      }
+      report_json(ofs, results);
+    }
+  }
+
+  return failed ? 1 : 0;
+}
+
+}  // namespace bench
+}  // namespace tiledb
+
+int main(int argc, char** argv) {
+  return tiledb::bench::run_benchmarks(argc, argv);
+}
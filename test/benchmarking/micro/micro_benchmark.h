@@ -0,0 +1,214 @@
+/**
+ * @file   micro_benchmark.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a small harness for micro-benchmarks of TileDB core internals.
+ *
+ * A micro-benchmark is a function taking a `State&` that loops while
+ * `state.keep_running()` returns true. The harness calibrates the number of
+ * iterations, repeats the measurement and reports the results either as a
+ * console table or as JSON (in a format compatible with Google Benchmark, so
+ * that the output can be consumed by `compare_micro.py`).
+ */
+
+#ifndef TILEDB_MICRO_BENCHMARK_H
+#define TILEDB_MICRO_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace bench {
+
+/** Per-run state handed to each micro-benchmark function. */
+class State {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param args The arguments (e.g. sizes) of this benchmark instance.
+   * @param max_iterations The number of timed iterations to run.
+   */
+  State(const std::vector<int64_t>& args, uint64_t max_iterations);
+
+  /** Returns the argument with the given index. */
+  int64_t arg(unsigned idx) const;
+
+  /**
+   * Returns true while more iterations must be run. The first call starts
+   * the timer and the last call stops it.
+   */
+  bool keep_running();
+
+  /** Pauses the timer, e.g. to exclude per-iteration setup. */
+  void pause_timing();
+
+  /** Resumes the timer paused with `pause_timing`. */
+  void resume_timing();
+
+  /** Sets the number of bytes processed by a single iteration. */
+  void set_bytes_per_iteration(uint64_t bytes);
+
+  /** Sets the number of items processed by a single iteration. */
+  void set_items_per_iteration(uint64_t items);
+
+  /** Records an error; the benchmark is reported as failed. */
+  void skip_with_error(const std::string& msg);
+
+  /** Returns the number of timed iterations. */
+  uint64_t iterations() const;
+
+  /** Returns the total time spent in timed regions, in nanoseconds. */
+  uint64_t elapsed_ns() const;
+
+  /** Returns the bytes processed by a single iteration. */
+  uint64_t bytes_per_iteration() const;
+
+  /** Returns the items processed by a single iteration. */
+  uint64_t items_per_iteration() const;
+
+  /** Returns the error message, empty if no error occurred. */
+  const std::string& error() const;
+
+ private:
+  /** The benchmark arguments. */
+  std::vector<int64_t> args_;
+
+  /** The number of iterations to run. */
+  uint64_t max_iterations_;
+
+  /** The number of iterations run so far. */
+  uint64_t iterations_;
+
+  /** Total time spent in timed regions. */
+  uint64_t elapsed_ns_;
+
+  /** Start of the current timed region. */
+  std::chrono::steady_clock::time_point start_;
+
+  /** True if the timer is currently running. */
+  bool running_;
+
+  /** Bytes processed per iteration. */
+  uint64_t bytes_per_iteration_;
+
+  /** Items processed per iteration. */
+  uint64_t items_per_iteration_;
+
+  /** Error message. */
+  std::string error_;
+};
+
+/** A registered micro-benchmark with its argument sets. */
+class Benchmark {
+ public:
+  /** Benchmark function type. */
+  typedef std::function<void(State&)> Function;
+
+  /** Constructor. */
+  Benchmark(const std::string& name, const Function& func);
+
+  /** Adds a single argument set. */
+  Benchmark* args(const std::vector<int64_t>& args);
+
+  /**
+   * Adds one argument set per value in the range `[lo, hi]`, multiplying by
+   * `mult` each step.
+   */
+  Benchmark* range(int64_t lo, int64_t hi, int64_t mult = 8);
+
+  /** Returns the benchmark name. */
+  const std::string& name() const;
+
+  /** Returns the benchmark function. */
+  const Function& func() const;
+
+  /** Returns the argument sets. */
+  const std::vector<std::vector<int64_t>>& arg_sets() const;
+
+ private:
+  /** The benchmark name. */
+  std::string name_;
+
+  /** The benchmark function. */
+  Function func_;
+
+  /** The argument sets, one benchmark instance is run for each. */
+  std::vector<std::vector<int64_t>> arg_sets_;
+};
+
+/**
+ * Registers a benchmark. The returned pointer is owned by the global registry
+ * and can be used to add argument sets.
+ */
+Benchmark* register_benchmark(
+    const std::string& name, const Benchmark::Function& func);
+
+/** Runs the registered benchmarks given the command line. */
+int run_benchmarks(int argc, char** argv);
+
+/**
+ * Prevents the compiler from optimizing away the computation of `value`.
+ */
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+}  // namespace bench
+}  // namespace tiledb
+
+#define TILEDB_MICRO_CONCAT_IMPL(a, b) a##b
+#define TILEDB_MICRO_CONCAT(a, b) TILEDB_MICRO_CONCAT_IMPL(a, b)
+
+/**
+ * Registers a micro-benchmark in a static initializer, e.g.:
+ *
+ *   TILEDB_MICRO_BENCHMARK("Sort/uint64", bench_sort<uint64_t>)
+ *       ->range(1 << 10, 1 << 20);
+ */
+#define TILEDB_MICRO_BENCHMARK(name, func)                        \
+  static ::tiledb::bench::Benchmark* TILEDB_MICRO_CONCAT(         \
+      tiledb_micro_benchmark_, __LINE__) TILEDB_MICRO_UNUSED =    \
+      ::tiledb::bench::register_benchmark(name, func)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TILEDB_MICRO_UNUSED __attribute__((unused))
+#else
+#define TILEDB_MICRO_UNUSED
+#endif
+
+#endif  // TILEDB_MICRO_BENCHMARK_H
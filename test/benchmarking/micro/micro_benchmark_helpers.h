@@ -0,0 +1,104 @@
+/**
+ * @file   micro_benchmark_helpers.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Input data generators and helpers shared by the micro-benchmarks.
+ */
+
+#ifndef TILEDB_MICRO_BENCHMARK_HELPERS_H
+#define TILEDB_MICRO_BENCHMARK_HELPERS_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/layout.h"
+
+namespace tiledb {
+namespace bench {
+
+/** Fixed seed so that every run benchmarks the same data. */
+static const unsigned micro_benchmark_seed = 0x7113DB;
+
+/**
+ * Returns `num` slowly increasing values with small random noise, which
+ * resemble sensor readings or timestamps and compress reasonably well.
+ */
+template <class T>
+std::vector<T> sensor_values(uint64_t num) {
+  std::mt19937_64 gen(micro_benchmark_seed);
+  std::uniform_int_distribution<int> noise(0, 15);
+  std::vector<T> values(num);
+  uint64_t base = 1000;
+  for (uint64_t i = 0; i < num; ++i) {
+    base += (uint64_t)noise(gen) % 4;
+    values[i] = static_cast<T>(base + (uint64_t)noise(gen));
+  }
+  return values;
+}
+
+/** Returns `num` uniformly random values. */
+template <class T>
+std::vector<T> random_values(uint64_t num, T lo, T hi) {
+  std::mt19937_64 gen(micro_benchmark_seed);
+  std::vector<T> values(num);
+  std::uniform_real_distribution<double> dist((double)lo, (double)hi);
+  for (uint64_t i = 0; i < num; ++i)
+    values[i] = static_cast<T>(dist(gen));
+  return values;
+}
+
+/**
+ * Populates `domain` with `dim_num` dimensions of type `T`, every dimension
+ * spanning `[0, dim_extent - 1]` with the given tile extent.
+ */
+template <class T>
+void create_domain(
+    sm::Datatype type,
+    unsigned dim_num,
+    T dim_extent,
+    T tile_extent,
+    sm::Domain* domain) {
+  T dim_dom[] = {0, static_cast<T>(dim_extent - 1)};
+  for (unsigned d = 0; d < dim_num; ++d) {
+    sm::Dimension dim("d" + std::to_string(d), type);
+    dim.set_domain(dim_dom);
+    dim.set_tile_extent(&tile_extent);
+    domain->add_dimension(&dim);
+  }
+  domain->init(sm::Layout::ROW_MAJOR, sm::Layout::ROW_MAJOR);
+}
+
+}  // namespace bench
+}  // namespace tiledb
+
+#endif  // TILEDB_MICRO_BENCHMARK_HELPERS_H
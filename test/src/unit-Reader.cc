@@ -34,6 +34,7 @@
 #include "tiledb/sm/c_api/tiledb_struct_def.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/query/reader.h"
+#include "tiledb/sm/query/result_coords.h"
 
 #ifdef _WIN32
 #include "tiledb/sm/filesystem/win.h"
@@ -243,3 +244,18 @@ TEST_CASE_METHOD(
   // Check correctness
   CHECK(result_space_tiles == c_result_space_tiles);
 }
+
+TEST_CASE(
+    "Reader: Result coords validity and position",
+    "[Reader][result_coords]") {
+  ResultTile tile;
+  uint64_t pos = (uint64_t(1) << 40) + 3;
+  ResultCoords rc(&tile, pos);
+  CHECK(rc.valid());
+  CHECK(rc.pos_ == pos);
+  CHECK(rc.tile_ == &tile);
+
+  rc.invalidate();
+  CHECK(!rc.valid());
+  CHECK(rc.pos_ == pos);
+}
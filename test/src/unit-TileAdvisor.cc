@@ -0,0 +1,162 @@
+/**
+ * @file unit-TileAdvisor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `TileAdvisor` class.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/array_schema/tile_advisor.h"
+#include "tiledb/sm/enums/array_type.h"
+#include "tiledb/sm/enums/datatype.h"
+
+#include <cstring>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Creates a 2D array schema with int32 dimensions and attribute. */
+void create_schema(
+    const int32_t* domain_vec,
+    const int32_t* tile_extents_vec,
+    ArraySchema* schema) {
+  Dimension d1("d1", Datatype::INT32);
+  REQUIRE(d1.set_domain(&domain_vec[0]).ok());
+  REQUIRE(d1.set_tile_extent(&tile_extents_vec[0]).ok());
+  Dimension d2("d2", Datatype::INT32);
+  REQUIRE(d2.set_domain(&domain_vec[2]).ok());
+  REQUIRE(d2.set_tile_extent(&tile_extents_vec[1]).ok());
+  Domain domain;
+  REQUIRE(domain.add_dimension(&d1).ok());
+  REQUIRE(domain.add_dimension(&d2).ok());
+  REQUIRE(schema->set_domain(&domain).ok());
+  Attribute a("a", Datatype::INT32);
+  REQUIRE(schema->add_attribute(&a).ok());
+  REQUIRE(schema->init().ok());
+}
+
+/** Returns the int32 tile extent stored in `v`. */
+int32_t extent(const ByteVecValue& v) {
+  int32_t e;
+  REQUIRE(v.size() == sizeof(int32_t));
+  std::memcpy(&e, &v[0], sizeof(int32_t));
+  return e;
+}
+
+}  // namespace
+
+TEST_CASE("TileAdvisor: Dense, row queries", "[TileAdvisor][dense]") {
+  int32_t domain_vec[] = {1, 10000, 1, 10000};
+  int32_t tile_extents_vec[] = {100, 100};
+  ArraySchema schema(ArrayType::DENSE);
+  create_schema(domain_vec, tile_extents_vec, &schema);
+
+  // Queries reading a few full rows favor tiles elongated along the rows
+  TileAdvisor advisor(&schema);
+  auto size = 2 * sizeof(int32_t);
+  for (int32_t r = 1; r <= 9001; r += 1000) {
+    int32_t rows[] = {r, r + 1};
+    int32_t cols[] = {1, 10000};
+    NDRange subarray = {Range(rows, size), Range(cols, size)};
+    REQUIRE(advisor.add_query(subarray).ok());
+  }
+  advisor.set_tile_size_limits(64 * 1024, 16 * 1024 * 1024);
+
+  TileAdvisor::Recommendation rec;
+  REQUIRE(advisor.recommend(&rec).ok());
+  REQUIRE(rec.tile_extents_.size() == 2);
+  CHECK(extent(rec.tile_extents_[0]) < extent(rec.tile_extents_[1]));
+  CHECK(rec.max_tile_size_ >= 64 * 1024);
+  CHECK(rec.max_tile_size_ <= 16 * 1024 * 1024);
+  CHECK(rec.query_tile_num_.size() == 10);
+  CHECK(rec.query_bytes_.size() == 10);
+  CHECK(rec.filter_notes_.size() == 1);
+
+  // Apply on a copy of the schema
+  ArraySchema applied(&schema);
+  REQUIRE(TileAdvisor::apply(rec, &applied).ok());
+  REQUIRE(applied.init().ok());
+  CHECK(
+      extent(applied.domain()->tile_extent(0)) ==
+      extent(rec.tile_extents_[0]));
+  CHECK(
+      extent(applied.domain()->tile_extent(1)) ==
+      extent(rec.tile_extents_[1]));
+}
+
+TEST_CASE(
+    "TileAdvisor: Sparse, sampled coordinates", "[TileAdvisor][sparse]") {
+  int32_t domain_vec[] = {1, 1000, 1, 1000};
+  int32_t tile_extents_vec[] = {10, 10};
+  ArraySchema schema(ArrayType::SPARSE);
+  create_schema(domain_vec, tile_extents_vec, &schema);
+
+  TileAdvisor advisor(&schema);
+  TileAdvisor::Recommendation rec;
+  CHECK(!advisor.recommend(&rec).ok());
+
+  // Sample one cell per 10x10 block
+  std::vector<int32_t> d1, d2;
+  for (int32_t i = 1; i <= 1000; i += 10) {
+    for (int32_t j = 1; j <= 1000; j += 10) {
+      d1.push_back(i);
+      d2.push_back(j);
+    }
+  }
+  std::vector<const void*> coords = {&d1[0], &d2[0]};
+  REQUIRE(advisor.add_coords(coords, d1.size()).ok());
+
+  auto size = 2 * sizeof(int32_t);
+  int32_t rows[] = {100, 150};
+  int32_t cols[] = {200, 250};
+  NDRange subarray = {Range(rows, size), Range(cols, size)};
+  REQUIRE(advisor.add_query(subarray).ok());
+  advisor.set_tile_size_limits(1024, 1024 * 1024);
+
+  REQUIRE(advisor.recommend(&rec).ok());
+  CHECK(rec.capacity_ > 0);
+  CHECK((rec.capacity_ & (rec.capacity_ - 1)) == 0);
+  CHECK(rec.tile_cell_num_ * sizeof(int32_t) >= 1024);
+  CHECK(rec.tile_num_ * rec.capacity_ >= d1.size());
+  REQUIRE(rec.query_tile_num_.size() == 1);
+  CHECK(rec.query_tile_num_[0] <= rec.tile_num_);
+
+  // A larger tile overhead favors larger tiles
+  advisor.set_tile_overhead(64 * 1024 * 1024);
+  TileAdvisor::Recommendation rec_large;
+  REQUIRE(advisor.recommend(&rec_large).ok());
+  CHECK(rec_large.capacity_ >= rec.capacity_);
+
+  REQUIRE(TileAdvisor::apply(rec, &schema).ok());
+  CHECK(schema.capacity() == rec.capacity_);
+}
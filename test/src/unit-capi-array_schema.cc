@@ -997,8 +997,9 @@ void ArraySchemaFx::load_and_check_array_schema(const std::string& path) {
       "- Allows duplicates: " +
       "false\n"
       "- Coordinates filters: 1\n" +
-      "  > ZSTD: COMPRESSION_LEVEL=-1\n" + "- Offsets filters: 1\n" +
-      "  > ZSTD: COMPRESSION_LEVEL=-1\n\n" + "### Dimension ###\n" +
+      "  > ZSTD: COMPRESSION_LEVEL=-1\n" + "- Offsets filters: 2\n" +
+      "  > OffsetsDelta\n" + "  > ZSTD: COMPRESSION_LEVEL=-1\n\n" +
+      "### Dimension ###\n" +
       "- Name: " + DIM1_NAME + "\n" + "- Domain: " + DIM1_DOMAIN_STR + "\n" +
       "- Tile extent: " + DIM1_TILE_EXTENT_STR + "\n" + "- Filters: 0\n\n" +
       "### Dimension ###\n" + "- Name: " + DIM2_NAME + "\n" +
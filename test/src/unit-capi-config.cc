@@ -215,6 +215,9 @@ void check_save_to_file() {
   ss << "sm.check_coord_dups true\n";
   ss << "sm.check_coord_oob true\n";
   ss << "sm.check_global_order true\n";
+  ss << "sm.checksum.skip_on_cache_hit false\n";
+  ss << "sm.checksum.verify_sample_rate 1.0\n";
+  ss << "sm.concurrent_partitions 1\n";
   ss << "sm.consolidation.amplification 1.0\n";
   ss << "sm.consolidation.buffer_size 50000000\n";
   ss << "sm.consolidation.step_max_frags 4294967295\n";
@@ -223,13 +226,20 @@ void check_save_to_file() {
   ss << "sm.consolidation.steps 4294967295\n";
   ss << "sm.dedup_coords false\n";
   ss << "sm.enable_signal_handlers true\n";
+  ss << "sm.est_result_size_mode fast\n";
+  ss << "sm.fragment_metadata_cache_size 10000000\n";
   ss << "sm.memory_budget 5368709120\n";
   ss << "sm.memory_budget_var 10737418240\n";
+  ss << "sm.memory_limit 0\n";
+  ss << "sm.memory_limit_policy block\n";
   ss << "sm.num_async_threads 1\n";
   ss << "sm.num_reader_threads 1\n";
   ss << "sm.num_tbb_threads -1\n";
   ss << "sm.num_writer_threads 1\n";
+  ss << "sm.query_result_cache_size 0\n";
+  ss << "sm.read_ahead false\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.var_offsets.bitsize 64\n";
   ss << "vfs.azure.block_list_block_size 5242880\n";
   ss << "vfs.azure.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
@@ -417,8 +427,18 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.check_coord_oob"] = "true";
   all_param_values["sm.check_global_order"] = "true";
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.fragment_metadata_cache_size"] = "10000000";
+  all_param_values["sm.query_result_cache_size"] = "0";
   all_param_values["sm.memory_budget"] = "5368709120";
   all_param_values["sm.memory_budget_var"] = "10737418240";
+  all_param_values["sm.memory_limit"] = "0";
+  all_param_values["sm.memory_limit_policy"] = "block";
+  all_param_values["sm.read_ahead"] = "false";
+  all_param_values["sm.concurrent_partitions"] = "1";
+  all_param_values["sm.est_result_size_mode"] = "fast";
+  all_param_values["sm.var_offsets.bitsize"] = "64";
+  all_param_values["sm.checksum.verify_sample_rate"] = "1.0";
+  all_param_values["sm.checksum.skip_on_cache_hit"] = "false";
   all_param_values["sm.enable_signal_handlers"] = "true";
   all_param_values["sm.num_async_threads"] = "1";
   all_param_values["sm.num_reader_threads"] = "1";
@@ -35,9 +35,11 @@
 #include "tiledb/sm/c_api/tiledb.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <chrono>
 #include <climits>
 #include <cstring>
 #include <iostream>
+#include <thread>
 
 using namespace tiledb::test;
 
@@ -414,6 +416,9 @@ void ConsolidationFx::write_dense_vector_4_fragments() {
   rc = tiledb_query_submit(ctx_, query_1);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   subarray[0] = 201;
@@ -429,6 +434,9 @@ void ConsolidationFx::write_dense_vector_4_fragments() {
   rc = tiledb_query_submit(ctx_, query_2);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   subarray[0] = 251;
@@ -444,6 +452,9 @@ void ConsolidationFx::write_dense_vector_4_fragments() {
   rc = tiledb_query_submit(ctx_, query_3);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 311;
@@ -511,6 +522,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_not_coinciding() {
   rc = tiledb_query_submit(ctx_, query_1);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   subarray[0] = 199;
@@ -526,6 +540,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_not_coinciding() {
   rc = tiledb_query_submit(ctx_, query_2);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   subarray[0] = 249;
@@ -541,6 +558,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_not_coinciding() {
   rc = tiledb_query_submit(ctx_, query_3);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 309;
@@ -609,6 +629,9 @@ void ConsolidationFx::
   rc = tiledb_query_submit(ctx_, query_1);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   subarray[0] = 203;
@@ -624,6 +647,9 @@ void ConsolidationFx::
   rc = tiledb_query_submit(ctx_, query_2);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   subarray[0] = 251;
@@ -639,6 +665,9 @@ void ConsolidationFx::
   rc = tiledb_query_submit(ctx_, query_3);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 311;
@@ -717,6 +746,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_mixed() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_2);
@@ -732,6 +764,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_mixed() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_3);
@@ -747,6 +782,9 @@ void ConsolidationFx::write_dense_vector_4_fragments_mixed() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_3);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 301;
@@ -814,6 +852,9 @@ void ConsolidationFx::write_dense_vector_consolidatable_1() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_2);
@@ -829,6 +870,9 @@ void ConsolidationFx::write_dense_vector_consolidatable_1() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   subarray[0] = 101;
@@ -894,6 +938,9 @@ void ConsolidationFx::write_dense_vector_consolidatable_2() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   subarray[0] = 201;
@@ -967,6 +1014,9 @@ void ConsolidationFx::write_dense_vector_del_1() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_2);
@@ -982,6 +1032,9 @@ void ConsolidationFx::write_dense_vector_del_1() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_3);
@@ -997,6 +1050,9 @@ void ConsolidationFx::write_dense_vector_del_1() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_3);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 201;
@@ -1070,6 +1126,9 @@ void ConsolidationFx::write_dense_vector_del_2() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_2);
@@ -1085,6 +1144,9 @@ void ConsolidationFx::write_dense_vector_del_2() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_3);
@@ -1100,6 +1162,9 @@ void ConsolidationFx::write_dense_vector_del_2() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_3);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   subarray[0] = 1;
@@ -1173,6 +1238,9 @@ void ConsolidationFx::write_dense_vector_del_3() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #2
   tiledb_query_t* query_2;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_2);
@@ -1188,6 +1256,9 @@ void ConsolidationFx::write_dense_vector_del_3() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #3
   tiledb_query_t* query_3;
   subarray[0] = 201;
@@ -1204,6 +1275,9 @@ void ConsolidationFx::write_dense_vector_del_3() {
   CHECK(rc == TILEDB_OK);
   tiledb_query_free(&query_3);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Submit query #4
   tiledb_query_t* query_4;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query_4);
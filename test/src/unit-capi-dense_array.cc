@@ -46,6 +46,7 @@
 
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <climits>
 #include <cstring>
 #include <ctime>
@@ -4319,6 +4320,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&query);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Write slice [2,3], [2,3]
   int write_a2[] = {101, 102, 103, 104};
   uint64_t write_a2_size = sizeof(write_a2);
@@ -4590,6 +4594,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&wq1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Open array for write query 2
   rc = tiledb_array_alloc(ctx_, array_name.c_str(), &array);
   CHECK(rc == TILEDB_OK);
@@ -4619,6 +4626,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&wq2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Open array for write query 3
   rc = tiledb_array_alloc(ctx_, array_name.c_str(), &array);
   CHECK(rc == TILEDB_OK);
@@ -41,7 +41,9 @@
 #endif
 
 #include <catch.hpp>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 using namespace tiledb::sm;
 using namespace tiledb::test;
@@ -976,3 +978,58 @@ TEST_CASE_METHOD(
   // Clean up
   close_array(ctx_, array_);
 }
+
+TEST_CASE_METHOD(
+    CDenseArrayFx,
+    "Dense array: 2D, sparse fragments overwritten by a later dense fragment",
+    "[capi][dense2][2D][overwritten]") {
+  // Create and write array
+  create_default_array_2d();
+  write_sparse_fragment_2d();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  write_default_array_2d();
+
+  std::vector<int> c_a = {};
+  SECTION("- sparse, dense") {
+    // The later dense fragment covers all the tiles of the sparse fragment
+    c_a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  }
+
+  SECTION("- sparse, dense, sparse") {
+    // The tiles of the last sparse fragment are not overwritten
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    write_sparse_fragment_2d();
+    c_a = {1, 102, 103, 4, 105, 6, 7, 8, 109, 10, 11, 12, 13, 14, 15, 16};
+  }
+
+  // Prepare buffers that will store the results
+  std::vector<int> a(16);
+  uint64_t a_size = a.size() * sizeof(int);
+  std::vector<uint64_t> coords(32);
+  uint64_t coords_size = coords.size() * sizeof(uint64_t);
+  tiledb::test::QueryBuffers buffers;
+  buffers["a"] = tiledb::test::QueryBuffer({&a[0], a_size, nullptr, 0});
+  buffers[TILEDB_COORDS] =
+      tiledb::test::QueryBuffer({&coords[0], coords_size, nullptr, 0});
+
+  // Read from the array, reusing the fragment index of the open array.
+  // The sparse tiles fully overlap the range, so they are checked against
+  // the later dense fragments.
+  open_array(ctx_, array_, TILEDB_READ);
+  SubarrayRanges<uint64_t> ranges = {{1, 4}, {1, 4}};
+  for (int i = 0; i < 2; ++i) {
+    std::fill(a.begin(), a.end(), 0);
+    std::fill(coords.begin(), coords.end(), 0);
+    read_array(ctx_, array_, ranges, TILEDB_ROW_MAJOR, buffers);
+
+    // Check results
+    std::vector<uint64_t> c_coords = {1, 1, 1, 2, 1, 3, 1, 4, 2, 1, 2,
+                                      2, 2, 3, 2, 4, 3, 1, 3, 2, 3, 3,
+                                      3, 4, 4, 1, 4, 2, 4, 3, 4, 4};
+    CHECK(a == c_a);
+    CHECK(coords == c_coords);
+  }
+
+  // Clean up
+  close_array(ctx_, array_);
+}
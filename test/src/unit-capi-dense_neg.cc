@@ -40,6 +40,7 @@
 #include "tiledb/sm/c_api/tiledb.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -649,7 +650,9 @@ TEST_CASE_METHOD(
 
   create_dense_array(vector_name);
   write_dense_array_global(vector_name);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
   write_dense_array_row(vector_name);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
   write_dense_array_col(vector_name);
   read_dense_array_global(vector_name);
   read_dense_array_row(vector_name);
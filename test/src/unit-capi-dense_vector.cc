@@ -40,6 +40,7 @@
 #include "tiledb/sm/c_api/tiledb.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -373,6 +374,9 @@ void DenseVectorFx::check_update(const std::string& path) {
   rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
   CHECK(rc == TILEDB_OK);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Update
   tiledb_query_t* update_query;
   rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &update_query);
@@ -451,6 +455,9 @@ void DenseVectorFx::check_duplicate_coords(const std::string& path) {
     uint64_t update_buffer_sizes[] = {sizeof(update_buffer),
                                       sizeof(coords_buffer)};
 
+    // Prevent fragment timestamp conflicts
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
     // Update
     tiledb_query_t* update_query;
     rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &update_query);
@@ -700,6 +707,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&write_query_0);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // --- First write ----
 
   // Open array
@@ -741,6 +751,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&write_query_1);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // --- Second write ----
 
   // Open array
@@ -779,6 +792,9 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   tiledb_query_free(&write_query_2);
 
+  // Prevent fragment timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // --- Third write ----
 
   // Open array
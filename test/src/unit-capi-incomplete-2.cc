@@ -57,6 +57,7 @@ struct IncompleteFx2 {
   ~IncompleteFx2();
 
   // Functions
+  void enable_read_ahead();
   void create_dense_array();
   void create_sparse_array();
   void write_dense_full();
@@ -86,6 +87,20 @@ IncompleteFx2::~IncompleteFx2() {
   tiledb_ctx_free(&ctx_);
 }
 
+void IncompleteFx2::enable_read_ahead() {
+  tiledb_config_t* config;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  REQUIRE(
+      tiledb_config_set(config, "sm.read_ahead", "true", &error) ==
+      TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_ctx_free(&ctx_);
+  REQUIRE(tiledb_ctx_alloc(config, &ctx_) == TILEDB_OK);
+  tiledb_config_free(&config);
+}
+
 void IncompleteFx2::create_dense_array() {
   // Create dimensions
   uint64_t dim_domain[] = {1, 4, 1, 4};
@@ -1135,3 +1150,35 @@ TEST_CASE_METHOD(
   check_sparse_unsplittable_complete();
   remove_sparse_array();
 }
+
+TEST_CASE_METHOD(
+    IncompleteFx2,
+    "C API: Test incomplete read queries 2, dense, read-ahead",
+    "[capi], [incomplete-2], [dense-incomplete-2], [read-ahead]") {
+  enable_read_ahead();
+  remove_dense_array();
+  create_dense_array();
+  write_dense_full();
+  check_dense_incomplete();
+  check_dense_until_complete();
+  check_dense_shrink_buffer_size();
+  check_dense_unsplittable_overflow();
+  check_dense_unsplittable_complete();
+  check_dense_reset_buffers();
+  remove_dense_array();
+}
+
+TEST_CASE_METHOD(
+    IncompleteFx2,
+    "C API: Test incomplete read queries 2, sparse, read-ahead",
+    "[capi], [incomplete-2], [sparse-incomplete-2], [read-ahead]") {
+  enable_read_ahead();
+  remove_sparse_array();
+  create_sparse_array();
+  write_sparse_full();
+  check_sparse_incomplete();
+  check_sparse_until_complete();
+  check_sparse_unsplittable_overflow();
+  check_sparse_unsplittable_complete();
+  remove_sparse_array();
+}
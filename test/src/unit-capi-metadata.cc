@@ -570,6 +570,9 @@ TEST_CASE_METHOD(
   REQUIRE(rc == TILEDB_OK);
   tiledb_array_free(&array);
 
+  // Prevent array metadata filename/timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Write once more
   rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
   REQUIRE(rc == TILEDB_OK);
@@ -619,6 +622,212 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
 }
 
+TEST_CASE_METHOD(
+    CMetadataFx,
+    "C API: Metadata, consolidate into indexed metadata",
+    "[capi][metadata][consolidation][indexed]") {
+  // Create default array
+  create_default_array_1d();
+
+  // Write enough items to span several metadata blocks
+  const int64_t key_num = 20000;
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  char key_buff[16];
+  for (int64_t i = 0; i < key_num; ++i) {
+    snprintf(key_buff, sizeof(key_buff), "key_%05d", (int)i);
+    rc = tiledb_array_put_metadata(ctx_, array, key_buff, TILEDB_INT64, 1, &i);
+    REQUIRE(rc == TILEDB_OK);
+  }
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+
+  // Consolidate
+  rc = tiledb_array_consolidate_metadata(ctx_, array_name_.c_str(), nullptr);
+  CHECK(rc == TILEDB_OK);
+
+  // Prevent array metadata filename/timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // Update on top of the indexed metadata
+  rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  int64_t v = -1;
+  rc = tiledb_array_put_metadata(ctx_, array, "key_00010", TILEDB_INT64, 1, &v);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_delete_metadata(ctx_, array, "key_00020");
+  CHECK(rc == TILEDB_OK);
+  v = 7;
+  rc = tiledb_array_put_metadata(ctx_, array, "new_key", TILEDB_INT64, 1, &v);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+
+  // Open the array in read mode
+  rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Read
+  const void* v_r;
+  tiledb_datatype_t v_type;
+  uint32_t v_num;
+  rc = tiledb_array_get_metadata(
+      ctx_, array, "key_15000", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(v_type == TILEDB_INT64);
+  CHECK(v_num == 1);
+  CHECK(*((const int64_t*)v_r) == 15000);
+  rc = tiledb_array_get_metadata(
+      ctx_, array, "key_00010", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(*((const int64_t*)v_r) == -1);
+  rc = tiledb_array_get_metadata(
+      ctx_, array, "key_00020", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(v_r == nullptr);
+  rc = tiledb_array_get_metadata(ctx_, array, "new_key", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(*((const int64_t*)v_r) == 7);
+  rc = tiledb_array_get_metadata(ctx_, array, "a", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(v_r == nullptr);
+  int32_t has_key = 0;
+  rc = tiledb_array_has_metadata_key(
+      ctx_, array, "key_19999", &v_type, &has_key);
+  CHECK(rc == TILEDB_OK);
+  CHECK(has_key == 1);
+
+  // Prefix iteration
+  std::vector<std::string> keys;
+  CHECK(array->array_->get_metadata_keys("key_0001", &keys).ok());
+  CHECK(keys.size() == 10);
+  CHECK(keys.front() == "key_00010");
+  CHECK(keys.back() == "key_00019");
+  CHECK(array->array_->get_metadata_keys("key_0002", &keys).ok());
+  CHECK(keys.size() == 9);
+  CHECK(keys.front() == "key_00021");
+  CHECK(array->array_->get_metadata_keys("n", &keys).ok());
+  CHECK(keys == std::vector<std::string>{"new_key"});
+  CHECK(array->array_->get_metadata_keys("z", &keys).ok());
+  CHECK(keys.empty());
+
+  uint64_t num = 0;
+  rc = tiledb_array_get_metadata_num(ctx_, array, &num);
+  CHECK(rc == TILEDB_OK);
+  CHECK(num == (uint64_t)key_num);
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+
+  // Consolidate again and read only from the indexed metadata
+  rc = tiledb_array_consolidate_metadata(ctx_, array_name_.c_str(), nullptr);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+
+  num = 0;
+  rc = tiledb_array_get_metadata_num(ctx_, array, &num);
+  CHECK(rc == TILEDB_OK);
+  CHECK(num == (uint64_t)key_num);
+
+  // "key_00020" was deleted, so the index is shifted by one after it
+  const char* key;
+  uint32_t key_len;
+  rc = tiledb_array_get_metadata_from_index(
+      ctx_, array, 12345, &key, &key_len, &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(std::string(key, key_len) == "key_12346");
+  CHECK(*((const int64_t*)v_r) == 12346);
+  rc = tiledb_array_get_metadata_from_index(
+      ctx_, array, key_num - 1, &key, &key_len, &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(std::string(key, key_len) == "new_key");
+  rc = tiledb_array_get_metadata_from_index(
+      ctx_, array, key_num, &key, &key_len, &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_array_get_metadata(
+      ctx_, array, "key_00010", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(*((const int64_t*)v_r) == -1);
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+}
+
+TEST_CASE_METHOD(
+    CMetadataFx,
+    "C API: Metadata, consolidate with an older format version",
+    "[capi][metadata][consolidation][indexed]") {
+  // Recreate the default array with the format version that precedes the
+  // indexed metadata files
+  create_default_array_1d();
+  tiledb_array_schema_t* array_schema;
+  int rc = tiledb_array_schema_load(ctx_, array_name_.c_str(), &array_schema);
+  REQUIRE(rc == TILEDB_OK);
+  array_schema->array_schema_->set_version(5);
+  rc = tiledb_object_remove(ctx_, array_name_.c_str());
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_create(ctx_, array_name_.c_str(), array_schema);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_schema_free(&array_schema);
+
+  // Write and consolidate
+  tiledb_array_t* array;
+  rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  int32_t v = 5;
+  rc = tiledb_array_put_metadata(ctx_, array, "aaa", TILEDB_INT32, 1, &v);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  rc = tiledb_array_consolidate_metadata(ctx_, array_name_.c_str(), nullptr);
+  CHECK(rc == TILEDB_OK);
+
+  // The consolidated metadata are stored in a legacy metadata file
+  rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb::sm::Metadata* metadata;
+  REQUIRE(array->array_->metadata(&metadata).ok());
+  const auto& uris = metadata->loaded_metadata_uris();
+  REQUIRE(uris.size() == 1);
+  const auto& name = uris[0].last_path_part();
+  CHECK(name.substr(name.size() - 4) != "_idx");
+
+  const void* v_r;
+  tiledb_datatype_t v_type;
+  uint32_t v_num;
+  rc = tiledb_array_get_metadata(ctx_, array, "aaa", &v_type, &v_num, &v_r);
+  CHECK(rc == TILEDB_OK);
+  CHECK(v_type == TILEDB_INT32);
+  CHECK(*((const int32_t*)v_r) == 5);
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+}
+
 TEST_CASE_METHOD(
     CMetadataFx, "C API: Metadata, open at", "[capi][metadata][open-at]") {
   // Create default array
@@ -889,6 +1098,9 @@ TEST_CASE_METHOD(
   REQUIRE(rc == TILEDB_OK);
   tiledb_array_free(&array);
 
+  // Prevent array metadata filename/timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Write once more
   rc = tiledb_array_alloc(ctx_, array_name_.c_str(), &array);
   REQUIRE(rc == TILEDB_OK);
@@ -35,6 +35,9 @@
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace tiledb;
 
 struct Point {
@@ -1058,3 +1061,241 @@ TEST_CASE("C++ API: Write cell with large cell val num", "[cppapi][sparse]") {
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Test reopening arrays with the fragment metadata cache",
+    "[cppapi][fragment-metadata-cache]") {
+  const std::string array_name = "cpp_unit_array";
+  std::string cache_size;
+  SECTION("- Default cache size") {
+    cache_size = "10000000";
+  }
+  SECTION("- Cache smaller than a fragment footer") {
+    cache_size = "100";
+  }
+  Config config;
+  config["sm.fragment_metadata_cache_size"] = cache_size;
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(5);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write one fragment at a time, reading the whole array after each write
+  // with a new array instance, so that the metadata of the older fragments
+  // come from the cache
+  std::vector<int> all_d, all_a;
+  std::string all_b;
+  for (int f = 0; f < 3; ++f) {
+    std::vector<int> d, a;
+    std::vector<uint64_t> b_off;
+    std::string b;
+    for (int i = 0; i < 20; ++i) {
+      d.push_back(f * 20 + i + 1);
+      a.push_back(f * 100 + i);
+      b_off.push_back(b.size());
+      b.append(i % 3 + 1, 'a' + f);
+    }
+    all_d.insert(all_d.end(), d.begin(), d.end());
+    all_a.insert(all_a.end(), a.begin(), a.end());
+    all_b += b;
+
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_coordinates(d)
+        .set_buffer("a", a)
+        .set_buffer("b", b_off, b);
+    query_w.submit();
+    array_w.close();
+
+    for (int r = 0; r < 2; ++r) {
+      Array array(ctx, array_name, TILEDB_READ);
+      Query query(ctx, array);
+      std::vector<int> r_d(100), r_a(100);
+      std::vector<uint64_t> r_b_off(100);
+      std::string r_b(1000, '\0');
+      query.set_layout(TILEDB_ROW_MAJOR)
+          .set_subarray<int>({1, 100})
+          .set_coordinates(r_d)
+          .set_buffer("a", r_a)
+          .set_buffer("b", r_b_off, r_b);
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+      auto result_el = query.result_buffer_elements();
+      REQUIRE(result_el[TILEDB_COORDS].second == all_d.size());
+      r_d.resize(all_d.size());
+      r_a.resize(all_a.size());
+      r_b.resize(result_el["b"].second);
+      CHECK(r_d == all_d);
+      CHECK(r_a == all_a);
+      CHECK(r_b == all_b);
+      array.close();
+    }
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test reopening an array while fragments are added",
+    "[cppapi][reopen]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(5);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Keep the array open for reads while writing fragments, as a tailing
+  // reader would do. The fragments are written with another context, as
+  // a context waits for its arrays to be closed for reads before storing
+  // fragment metadata.
+  Context ctx_w;
+  Array array(ctx, array_name, TILEDB_READ);
+  for (int f = 0; f < 4; ++f) {
+    std::vector<int> d = {2 * f + 1, 2 * f + 2}, a = {f, f};
+    Array array_w(ctx_w, array_name, TILEDB_WRITE);
+    Query query_w(ctx_w, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_coordinates(d)
+        .set_buffer("a", a);
+    query_w.submit();
+    array_w.close();
+
+    // A fragment directory without metadata (e.g., one that is being
+    // written) must be ignored, and checked again upon the next reopen
+    auto incomplete =
+        array_name + "/__1_1_0123456789abcdef0123456789abcdef_5";
+    if (f == 1)
+      vfs.create_dir(incomplete);
+    if (f == 3)
+      vfs.remove_dir(incomplete);
+
+    array.reopen();
+    Query query(ctx, array);
+    std::vector<int> r_d(10), r_a(10);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, 100})
+        .set_coordinates(r_d)
+        .set_buffer("a", r_a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_num = 2 * (f + 1);
+    REQUIRE(
+        query.result_buffer_elements()[TILEDB_COORDS].second ==
+        (uint64_t)result_num);
+    for (int i = 0; i < result_num; ++i) {
+      CHECK(r_d[i] == i + 1);
+      CHECK(r_a[i] == i / 2);
+    }
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test reading an array from many threads while it is reopened",
+    "[cppapi][concurrent-reads]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(5);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Fragment `f` has cells 2f+1 and 2f+2, with value `f`. The fragments
+  // are written with another context, which does not wait for the array
+  // to be closed for reads.
+  const int fragment_num = 4;
+  Context ctx_w;
+  auto write_fragment = [&](int f) {
+    std::vector<int> d = {2 * f + 1, 2 * f + 2}, a = {f, f};
+    Array array_w(ctx_w, array_name, TILEDB_WRITE);
+    Query query_w(ctx_w, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_coordinates(d)
+        .set_buffer("a", a);
+    query_w.submit();
+    array_w.close();
+  };
+  write_fragment(0);
+
+  // Many threads read from the same open array, while it is reopened as
+  // fragments are added. Every read must see all the cells of a prefix of
+  // the fragments.
+  Array array(ctx, array_name, TILEDB_READ);
+  std::atomic<int> errors(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 8; ++t) {
+    readers.emplace_back([&]() {
+      for (int i = 0; i < 20; ++i) {
+        Query query(ctx, array);
+        std::vector<int> r_d(2 * fragment_num), r_a(2 * fragment_num);
+        query.set_layout(TILEDB_ROW_MAJOR)
+            .set_subarray<int>({1, 100})
+            .set_coordinates(r_d)
+            .set_buffer("a", r_a);
+        if (query.submit() != Query::Status::COMPLETE) {
+          ++errors;
+          continue;
+        }
+        auto result_num = query.result_buffer_elements()[TILEDB_COORDS].second;
+        if (result_num < 2 || result_num % 2 != 0)
+          ++errors;
+        for (uint64_t c = 0; c < result_num; ++c) {
+          if (r_d[c] != (int)c + 1 || r_a[c] != (int)c / 2)
+            ++errors;
+        }
+      }
+    });
+  }
+
+  for (int f = 1; f < fragment_num; ++f) {
+    write_fragment(f);
+    array.reopen();
+  }
+
+  for (auto& reader : readers)
+    reader.join();
+  CHECK(errors == 0);
+
+  // All the fragments are visible after the last reopen
+  Query query(ctx, array);
+  std::vector<int> r_d(2 * fragment_num), r_a(2 * fragment_num);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int>({1, 100})
+      .set_coordinates(r_d)
+      .set_buffer("a", r_a);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(
+      query.result_buffer_elements()[TILEDB_COORDS].second ==
+      (uint64_t)(2 * fragment_num));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
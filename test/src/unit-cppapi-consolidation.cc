@@ -116,3 +116,34 @@ TEST_CASE(
 
   remove_array(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Test consolidation exceeding the memory limit",
+    "[cppapi][consolidation][memory-broker]") {
+  std::string array_name = "cppapi_consolidation";
+  remove_array(array_name);
+
+  create_array(array_name);
+  write_array(array_name, {1, 2}, {1, 2});
+  write_array(array_name, {3, 3}, {3});
+  CHECK(num_fragments(array_name) == 2);
+
+  // The buffers of the consolidator fit in the limit, but not along with
+  // the memory of the read query, which must fail instead of waiting for
+  // the consolidator to release its buffers
+  for (auto policy : {"block", "shrink"}) {
+    Config ctx_config;
+    ctx_config["sm.memory_limit"] = "5";
+    ctx_config["sm.memory_limit_policy"] = policy;
+    Context ctx(ctx_config);
+    Config config;
+    config["sm.consolidation.buffer_size"] = "4";
+    REQUIRE_THROWS_AS(
+        Array::consolidate(ctx, array_name, &config), TileDBError);
+    CHECK(num_fragments(array_name) == 2);
+  }
+
+  read_array(array_name, {1, 3}, {1, 2, 3});
+
+  remove_array(array_name);
+}
@@ -93,6 +93,283 @@ TEST_CASE("C++ API: Filter options", "[cppapi], [filter]") {
       std::invalid_argument);
 }
 
+TEST_CASE("C++ API: Filter dictionary", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_dict";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Only ZStd filters support dictionaries
+  Filter f_lz4(ctx, TILEDB_FILTER_LZ4);
+  REQUIRE_THROWS_AS(f_lz4.set_dictionary("abc", 3), TileDBError);
+
+  std::vector<std::string> samples;
+  for (int i = 0; i < 1000; i++)
+    samples.push_back(
+        "sample-" + std::to_string(i) + "-" + std::to_string(i * i % 97) +
+        "-common-suffix");
+  Filter f(ctx, TILEDB_FILTER_ZSTD);
+  REQUIRE(f.dictionary().empty());
+  f.train_dictionary(samples, 2048);
+  auto dict = f.dictionary();
+  REQUIRE(!dict.empty());
+  REQUIRE(dict.size() <= 2048);
+
+  // The dictionary is stored with the array schema
+  FilterList filters(ctx);
+  filters.add_filter(f);
+  auto a = Attribute::create<std::string>(ctx, "a");
+  a.set_filter_list(filters);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 99}}, 100));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attribute(a);
+  Array::create(array_name, schema);
+
+  std::vector<std::string> a_data(samples.begin(), samples.begin() + 100);
+  auto a_buf = ungroup_var_buffer(a_data);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_buffer("a", a_buf).set_layout(TILEDB_ROW_MAJOR);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  array.open(TILEDB_READ);
+  auto schema_r = array.schema();
+  auto f_r = schema_r.attribute("a").filter_list().filter(0);
+  REQUIRE(f_r.dictionary() == dict);
+
+  std::vector<uint64_t> a_off(100);
+  std::string a_val;
+  a_val.resize(a_buf.second.size());
+  Query query_r(ctx, array);
+  query_r.set_subarray(std::vector<int>{0, 99})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_off, a_val);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a_val == std::string(a_buf.second.begin(), a_buf.second.end()));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Dictionary filter on array", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_dict_filter";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Categorical string and integer attributes
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_DICTIONARY})
+      .add_filter({ctx, TILEDB_FILTER_ZSTD});
+  auto a1 = Attribute::create<std::string>(ctx, "a1");
+  auto a2 = Attribute::create<int64_t>(ctx, "a2");
+  a1.set_filter_list(filters);
+  a2.set_filter_list(filters);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 9999}}, 5000));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attributes(a1, a2);
+  Array::create(array_name, schema);
+
+  const std::vector<std::string> categories = {"active", "inactive", "new"};
+  std::vector<std::string> a1_data;
+  std::vector<int64_t> a2_data;
+  for (int i = 0; i < 10000; i++) {
+    a1_data.push_back(categories[(i / 3) % categories.size()]);
+    a2_data.push_back((i % 5) * 1000000007LL);
+  }
+  auto a1_buf = ungroup_var_buffer(a1_data);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_buffer("a1", a1_buf)
+      .set_buffer("a2", a2_data)
+      .set_layout(TILEDB_ROW_MAJOR);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  array.open(TILEDB_READ);
+  std::vector<uint64_t> a1_off(10000);
+  std::string a1_val;
+  a1_val.resize(a1_buf.second.size());
+  std::vector<int64_t> a2_read(10000);
+  Query query_r(ctx, array);
+  query_r.set_subarray(std::vector<int>{0, 9999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_off, a1_val)
+      .set_buffer("a2", a2_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a1_off == a1_buf.first);
+  REQUIRE(a1_val == std::string(a1_buf.second.begin(), a1_buf.second.end()));
+  REQUIRE(a2_read == a2_data);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Offsets delta filter and 32-bit offsets", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_offsets_delta_filter";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // The offsets filter is part of the default offsets filter list
+  auto a1 = Attribute::create<std::string>(ctx, "a1");
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 9999}}, 5000));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).add_attribute(a1);
+  REQUIRE(schema.offsets_filter_list().nfilters() == 2);
+  REQUIRE(
+      schema.offsets_filter_list().filter(0).filter_type() ==
+      TILEDB_FILTER_OFFSETS_DELTA);
+  Array::create(array_name, schema);
+
+  std::vector<std::string> a1_data;
+  for (int i = 0; i < 10000; i++)
+    a1_data.push_back(std::string(i % 13 + 1, 'a' + (i % 26)));
+  auto a1_buf = ungroup_var_buffer(a1_data);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_buffer("a1", a1_buf).set_layout(TILEDB_ROW_MAJOR);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Read with 64-bit offsets
+  std::string a1_val;
+  a1_val.resize(a1_buf.second.size());
+  array.open(TILEDB_READ);
+  std::vector<uint64_t> a1_off(10000);
+  Query query_r(ctx, array);
+  query_r.set_subarray(std::vector<int>{0, 9999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_off, a1_val);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a1_off == a1_buf.first);
+  REQUIRE(a1_val == std::string(a1_buf.second.begin(), a1_buf.second.end()));
+  array.close();
+
+  // Read with 32-bit offsets
+  Config config;
+  REQUIRE_THROWS_AS(config["sm.var_offsets.bitsize"] = "16", TileDBError);
+  config["sm.var_offsets.bitsize"] = "32";
+  Context ctx_32(config);
+  Array array_32(ctx_32, array_name, TILEDB_READ);
+  std::vector<uint32_t> a1_off_32(10000);
+  std::string a1_val_32;
+  a1_val_32.resize(a1_buf.second.size());
+  Query query_32(ctx_32, array_32);
+  query_32.set_subarray(std::vector<int>{0, 9999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer(
+          "a1",
+          reinterpret_cast<uint64_t*>(a1_off_32.data()),
+          a1_off_32.size() / 2,
+          &a1_val_32[0],
+          a1_val_32.size());
+  // The estimate is returned in 64-bit offset units
+  auto est_size = query_32.est_result_size_var("a1");
+  CHECK(est_size.first * sizeof(uint64_t) == a1_off_32.size() * 4);
+  REQUIRE(query_32.submit() == Query::Status::COMPLETE);
+  for (uint64_t i = 0; i < a1_off_32.size(); i++)
+    REQUIRE(a1_off_32[i] == a1_buf.first[i]);
+  REQUIRE(a1_val_32 == a1_val);
+  array_32.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Frame of reference and XOR filters on array",
+    "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_for_xor_filters";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Timestamps dimension with the frame of reference filter, and a float
+  // attribute with the XOR filter
+  FilterList t_filters(ctx);
+  t_filters.add_filter({ctx, TILEDB_FILTER_FRAME_OF_REFERENCE})
+      .add_filter({ctx, TILEDB_FILTER_ZSTD});
+  FilterList a_filters(ctx);
+  a_filters.add_filter({ctx, TILEDB_FILTER_XOR});
+  REQUIRE(
+      Filter::to_str(TILEDB_FILTER_FRAME_OF_REFERENCE) ==
+      "FRAME_OF_REFERENCE");
+  REQUIRE(Filter::to_str(TILEDB_FILTER_XOR) == "XOR");
+
+  auto t = Dimension::create<int64_t>(ctx, "t", {{0, 1000000000000}}, 1000000);
+  t.set_filter_list(t_filters);
+  Domain domain(ctx);
+  domain.add_dimension(t);
+  auto a = Attribute::create<double>(ctx, "a");
+  a.set_filter_list(a_filters);
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).add_attribute(a).set_capacity(10000);
+  Array::create(array_name, schema);
+
+  const int64_t nelts = 20000;
+  std::vector<int64_t> t_data(nelts);
+  std::vector<double> a_data(nelts);
+  for (int64_t i = 0; i < nelts; i++) {
+    t_data[i] = 1000000 + i * 1000 + (i * 7) % 13;
+    a_data[i] = 15.0 + (double)(i / 50) * 0.5;
+  }
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_buffer("t", t_data)
+      .set_buffer("a", a_data)
+      .set_layout(TILEDB_GLOBAL_ORDER);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  query.finalize();
+  array.close();
+
+  array.open(TILEDB_READ);
+  std::vector<int64_t> t_read(nelts);
+  std::vector<double> a_read(nelts);
+  Query query_r(ctx, array);
+  query_r.set_subarray(std::vector<int64_t>{0, 1000000000000})
+      .set_layout(TILEDB_GLOBAL_ORDER)
+      .set_buffer("t", t_read)
+      .set_buffer("a", a_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(t_read == t_data);
+  REQUIRE(a_read == a_data);
+
+  // Check the filter lists of the schema
+  auto schema_r = array.schema();
+  auto t_filters_r = schema_r.domain().dimension("t").filter_list();
+  REQUIRE(t_filters_r.nfilters() == 2);
+  CHECK(
+      t_filters_r.filter(0).filter_type() ==
+      TILEDB_FILTER_FRAME_OF_REFERENCE);
+  auto a_filters_r = schema_r.attribute("a").filter_list();
+  REQUIRE(a_filters_r.nfilters() == 1);
+  CHECK(a_filters_r.filter(0).filter_type() == TILEDB_FILTER_XOR);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
 TEST_CASE("C++ API: Filter lists", "[cppapi], [filter]") {
   using namespace tiledb;
   Context ctx;
@@ -228,3 +505,109 @@ TEST_CASE("C++ API: Filter lists on array", "[cppapi], [filter]") {
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Read a subset of the cells of multi-chunk tiles",
+    "[cppapi], [filter], [partial-unfilter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array_partial_unfilter";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // A single tile per attribute, split in many small chunks
+  FilterList filters(ctx);
+  filters.set_max_chunk_size(256).add_filter({ctx, TILEDB_FILTER_ZSTD});
+  auto a1 = Attribute::create<int>(ctx, "a1");
+  auto a2 = Attribute::create<std::string>(ctx, "a2");
+  a1.set_filter_list(filters);
+  a2.set_filter_list(filters);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 1000));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(1000).add_attributes(a1, a2);
+  schema.set_offsets_filter_list(filters);
+  Array::create(array_name, schema);
+
+  std::vector<int> coords, a1_data;
+  std::vector<std::string> a2_data;
+  for (int i = 1; i <= 1000; i++) {
+    coords.push_back(i);
+    a1_data.push_back(3 * i);
+    a2_data.push_back(std::string(i % 7 + 1, 'a' + (i % 26)));
+  }
+  auto a2_buf = ungroup_var_buffer(a2_data);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_coordinates(coords)
+      .set_buffer("a1", a1_data)
+      .set_buffer("a2", a2_buf)
+      .set_layout(TILEDB_UNORDERED);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Reads the cells of the input ranges of `d`
+  array.open(TILEDB_READ);
+  auto read = [&](const std::vector<std::pair<int, int>>& ranges,
+                  std::vector<int>* r_coords,
+                  std::vector<int>* r_a1,
+                  std::vector<std::string>* r_a2) {
+    std::vector<int> coords_buf(1000), a1_buf(1000);
+    std::vector<uint64_t> a2_off(1000);
+    std::string a2_val(a2_buf.second.size(), '\0');
+    Query query_r(ctx, array);
+    for (const auto& r : ranges)
+      query_r.add_range(0, r.first, r.second);
+    query_r.set_layout(TILEDB_ROW_MAJOR)
+        .set_coordinates(coords_buf)
+        .set_buffer("a1", a1_buf)
+        .set_buffer("a2", a2_off, a2_val);
+    REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+    auto result_num = query_r.result_buffer_elements();
+    auto cell_num = result_num[TILEDB_COORDS].second;
+    REQUIRE(result_num["a1"].second == cell_num);
+    REQUIRE(result_num["a2"].first == cell_num);
+    r_coords->assign(coords_buf.begin(), coords_buf.begin() + cell_num);
+    r_a1->assign(a1_buf.begin(), a1_buf.begin() + cell_num);
+    r_a2->clear();
+    for (uint64_t c = 0; c < cell_num; c++) {
+      auto end = (c + 1 < cell_num) ? a2_off[c + 1] : result_num["a2"].second;
+      r_a2->push_back(a2_val.substr(a2_off[c], end - a2_off[c]));
+    }
+  };
+
+  // Read a sparse subset of the cells, which unfilters only some chunks,
+  // then all the cells from the same (cached) tiles
+  std::vector<std::pair<int, int>> ranges = {
+      {100, 110}, {500, 505}, {990, 1000}};
+  std::vector<int> sub_coords, sub_a1;
+  std::vector<std::string> sub_a2;
+  read(ranges, &sub_coords, &sub_a1, &sub_a2);
+  std::vector<int> all_coords, all_a1;
+  std::vector<std::string> all_a2;
+  read({{1, 1000}}, &all_coords, &all_a1, &all_a2);
+  array.close();
+
+  CHECK(all_coords == coords);
+  CHECK(all_a1 == a1_data);
+  CHECK(all_a2 == a2_data);
+
+  // The subset matches the full read
+  std::vector<int> exp_coords, exp_a1;
+  std::vector<std::string> exp_a2;
+  for (const auto& r : ranges) {
+    for (int i = r.first; i <= r.second; i++) {
+      exp_coords.push_back(all_coords[i - 1]);
+      exp_a1.push_back(all_a1[i - 1]);
+      exp_a2.push_back(all_a2[i - 1]);
+    }
+  }
+  CHECK(sub_coords == exp_coords);
+  CHECK(sub_a1 == exp_a1);
+  CHECK(sub_a2 == exp_a2);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
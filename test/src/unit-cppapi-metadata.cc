@@ -455,6 +455,9 @@ TEST_CASE_METHOD(
   // Close array
   array.close();
 
+  // Prevent array metadata filename/timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Write once more
   array.open(TILEDB_WRITE);
 
@@ -672,6 +675,9 @@ TEST_CASE_METHOD(
   // Close array
   array.close();
 
+  // Prevent array metadata filename/timestamp conflicts
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
   // Write once more
   array.open(TILEDB_WRITE, enc_type_, key_, key_len_);
 
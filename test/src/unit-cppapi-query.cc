@@ -31,8 +31,14 @@
  */
 
 #include "catch.hpp"
+#include "tiledb/sm/c_api/tiledb_struct_def.h"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/query/query.h"
+#include "tiledb/sm/query/reader.h"
+
+#include <map>
 
 using namespace tiledb;
 
@@ -130,3 +136,437 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Test reading partitions concurrently",
+    "[cppapi][query][concurrent-partitions]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 100));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write
+  std::vector<int> d(1000), a(1000);
+  std::vector<uint64_t> b_off(1000);
+  std::string b;
+  for (int i = 0; i < 1000; ++i) {
+    d[i] = i + 1;
+    a[i] = i;
+    b_off[i] = b.size();
+    b.append(i % 5 + 1, 'a' + i % 26);
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_coordinates(d)
+      .set_buffer("a", a)
+      .set_buffer("b", b_off, b);
+  query_w.submit();
+  array_w.close();
+
+  // Read with a small memory budget, which leads to many partitions, with
+  // and without processing them concurrently
+  Stats::enable();
+  auto& stats = tiledb::sm::stats::all_stats;
+  for (auto layout : {TILEDB_ROW_MAJOR, TILEDB_GLOBAL_ORDER}) {
+    for (std::string concurrent_partitions : {"1", "4"}) {
+      Stats::reset();
+      Config config;
+      config["sm.memory_budget"] = "1000";
+      config["sm.memory_budget_var"] = "1000";
+      config["sm.concurrent_partitions"] = concurrent_partitions;
+      Context ctx_r(config);
+      Array array(ctx_r, array_name, TILEDB_READ);
+      Query query(ctx_r, array);
+      std::vector<int> buff_d(1000), buff_a(1000);
+      std::vector<uint64_t> buff_b_off(1000);
+      std::string buff_b(b.size(), '\0');
+      query.set_layout(layout)
+          .set_subarray<int>({1, 1000})
+          .set_coordinates(buff_d)
+          .set_buffer("a", buff_a)
+          .set_buffer("b", buff_b_off, buff_b);
+
+      // Collect the results of all the submissions
+      std::vector<int> r_d, r_a;
+      std::vector<uint64_t> r_b_off;
+      std::string r_b;
+      Query::Status status;
+      do {
+        status = query.submit();
+        auto result_num = query.result_buffer_elements();
+        auto cell_num = result_num[TILEDB_COORDS].second;
+        REQUIRE(result_num["a"].second == cell_num);
+        REQUIRE(result_num["b"].first == cell_num);
+        for (uint64_t c = 0; c < cell_num; ++c) {
+          r_d.push_back(buff_d[c]);
+          r_a.push_back(buff_a[c]);
+          r_b_off.push_back(r_b.size() + buff_b_off[c]);
+        }
+        r_b.append(buff_b, 0, result_num["b"].second);
+      } while (status == Query::Status::INCOMPLETE);
+      REQUIRE(status == Query::Status::COMPLETE);
+
+      CHECK(r_d == d);
+      CHECK(r_a == a);
+      CHECK(r_b_off == b_off);
+      CHECK(r_b == b);
+      if (concurrent_partitions == "1")
+        CHECK(stats.counter_reader_num_concurrent_partitions == 0);
+      else
+        CHECK(stats.counter_reader_num_concurrent_partitions > 0);
+      array.close();
+    }
+  }
+  Stats::disable();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test the query result cache",
+    "[cppapi][query][query-result-cache]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(10);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Writes cells `first..last` in a new fragment
+  std::vector<int> d, a;
+  std::vector<uint64_t> b_off;
+  std::string b;
+  auto write = [&](int first, int last) {
+    std::vector<int> w_d, w_a;
+    std::vector<uint64_t> w_b_off;
+    std::string w_b;
+    for (int i = first; i <= last; ++i) {
+      w_d.push_back(i);
+      w_a.push_back(10 * i);
+      w_b_off.push_back(w_b.size());
+      w_b.append(i % 3 + 1, 'a' + i % 26);
+      d.push_back(i);
+      a.push_back(10 * i);
+      b_off.push_back(b.size());
+      b.append(i % 3 + 1, 'a' + i % 26);
+    }
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_coordinates(w_d)
+        .set_buffer("a", w_a)
+        .set_buffer("b", w_b_off, w_b);
+    query_w.submit();
+    array_w.close();
+  };
+
+  // Reads cells `1..50` with buffers of `cell_num` cells
+  Config config;
+  config["sm.query_result_cache_size"] = "1000000";
+  Context ctx_r(config);
+  auto read = [&](Array& array,
+                  size_t cell_num,
+                  std::vector<int>* r_d,
+                  std::vector<int>* r_a,
+                  std::vector<uint64_t>* r_b_off,
+                  std::string* r_b) {
+    Query query(ctx_r, array);
+    r_d->resize(cell_num);
+    r_a->resize(cell_num);
+    r_b_off->resize(cell_num);
+    r_b->resize(3 * cell_num);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, 50})
+        .set_coordinates(*r_d)
+        .set_buffer("a", *r_a)
+        .set_buffer("b", *r_b_off, *r_b);
+    auto status = query.submit();
+    auto result_num = query.result_buffer_elements();
+    r_d->resize(result_num[TILEDB_COORDS].second);
+    r_a->resize(result_num["a"].second);
+    r_b_off->resize(result_num["b"].first);
+    r_b->resize(result_num["b"].second);
+    return status;
+  };
+
+  write(1, 10);
+  Array array(ctx_r, array_name, TILEDB_READ);
+  std::vector<int> r_d, r_a;
+  std::vector<uint64_t> r_b_off;
+  std::string r_b;
+  Stats::enable();
+  Stats::reset();
+  auto& stats = tiledb::sm::stats::all_stats;
+
+  // The first read computes the results and caches them
+  CHECK(read(array, 50, &r_d, &r_a, &r_b_off, &r_b) == Query::Status::COMPLETE);
+  CHECK(r_d == d);
+  CHECK(r_a == a);
+  CHECK(r_b_off == b_off);
+  CHECK(r_b == b);
+  CHECK(stats.counter_sm_query_result_cache_misses == 1);
+  CHECK(stats.counter_sm_query_result_cache_inserts == 1);
+
+  // An identical read is served from the cache
+  CHECK(read(array, 50, &r_d, &r_a, &r_b_off, &r_b) == Query::Status::COMPLETE);
+  CHECK(r_d == d);
+  CHECK(r_a == a);
+  CHECK(r_b_off == b_off);
+  CHECK(r_b == b);
+  CHECK(stats.counter_sm_query_result_cache_hits == 1);
+
+  // A read served from the cache completes its read state like a computed
+  // one, so that a resubmission does not read the results again
+  for (Context* ctx_resubmit : {&ctx, &ctx_r}) {
+    Array array_resubmit(*ctx_resubmit, array_name, TILEDB_READ);
+    Query query(*ctx_resubmit, array_resubmit);
+    std::vector<int> s_d(50), s_a(50);
+    std::vector<uint64_t> s_b_off(50);
+    std::string s_b(150, '\0');
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int>({1, 50})
+        .set_coordinates(s_d)
+        .set_buffer("a", s_a)
+        .set_buffer("b", s_b_off, s_b);
+    CHECK(query.submit() == Query::Status::COMPLETE);
+    CHECK(query.result_buffer_elements()["a"].second == d.size());
+    auto reader = query.ptr()->query_->reader();
+    CHECK(!reader->incomplete());
+    CHECK(reader->read_state()->done());
+    CHECK(query.submit() == Query::Status::COMPLETE);
+    CHECK(query.result_buffer_elements()["a"].second == d.size());
+  }
+  CHECK(stats.counter_sm_query_result_cache_hits == 2);
+
+  // The cached results do not fit in smaller buffers, so they are computed
+  auto status = read(array, 4, &r_d, &r_a, &r_b_off, &r_b);
+  CHECK(status == Query::Status::INCOMPLETE);
+  CHECK(!r_d.empty());
+  CHECK(r_d == std::vector<int>(d.begin(), d.begin() + r_d.size()));
+  CHECK(stats.counter_sm_query_result_cache_hits == 2);
+  CHECK(stats.counter_sm_query_result_cache_misses == 2);
+  CHECK(stats.counter_sm_query_result_cache_inserts == 1);
+
+  // A new fragment changes the key, so the results are recomputed
+  write(11, 20);
+  array.reopen();
+  CHECK(read(array, 50, &r_d, &r_a, &r_b_off, &r_b) == Query::Status::COMPLETE);
+  CHECK(r_d == d);
+  CHECK(r_a == a);
+  CHECK(r_b_off == b_off);
+  CHECK(r_b == b);
+  CHECK(stats.counter_sm_query_result_cache_misses == 3);
+  CHECK(stats.counter_sm_query_result_cache_inserts == 2);
+
+  Stats::disable();
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test reading tile-aligned subarrays of dense arrays",
+    "[cppapi][query][dense-aligned-read]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  tiledb_layout_t cell_order = TILEDB_ROW_MAJOR;
+  SECTION("- Row-major cell order") {
+    cell_order = TILEDB_ROW_MAJOR;
+  }
+  SECTION("- Col-major cell order") {
+    cell_order = TILEDB_COL_MAJOR;
+  }
+
+  // Create an 8x8 array with 4x4 tiles
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{1, 8}}, 4))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{1, 8}}, 4));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_cell_order(cell_order);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<double>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Writes `a = 100 * row + col + base` on the input subarray. The writes
+  // use another context, as the array stays open for reads below.
+  Context ctx_w;
+  auto write = [&](std::vector<int> sub, int base) {
+    std::vector<int> a;
+    std::vector<double> b;
+    for (int i = sub[0]; i <= sub[1]; ++i) {
+      for (int j = sub[2]; j <= sub[3]; ++j) {
+        a.push_back(100 * i + j + base);
+        b.push_back(a.back() + 0.5);
+      }
+    }
+    Array array_w(ctx_w, array_name, TILEDB_WRITE);
+    Query query_w(ctx_w, array_w);
+    query_w.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray(sub)
+        .set_buffer("a", a)
+        .set_buffer("b", b);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+    array_w.close();
+  };
+
+  // Returns the cells of the subarray in the input layout, where the tile
+  // order is row-major
+  auto cells = [&](std::vector<int> sub, tiledb_layout_t layout) {
+    std::vector<std::pair<int, int>> ret;
+    auto add_cells = [&](int r0, int r1, int c0, int c1, bool row) {
+      for (int x = (row ? r0 : c0); x <= (row ? r1 : c1); ++x) {
+        for (int y = (row ? c0 : r0); y <= (row ? c1 : r1); ++y)
+          ret.emplace_back(row ? x : y, row ? y : x);
+      }
+    };
+    if (layout == TILEDB_GLOBAL_ORDER) {
+      for (int r = sub[0]; r <= sub[1]; r += 4) {
+        for (int c = sub[2]; c <= sub[3]; c += 4)
+          add_cells(r, r + 3, c, c + 3, cell_order == TILEDB_ROW_MAJOR);
+      }
+    } else {
+      add_cells(
+          sub[0], sub[1], sub[2], sub[3], layout == TILEDB_ROW_MAJOR);
+    }
+    return ret;
+  };
+
+  // Reads the subarray and checks the results against the input values
+  Array array(ctx, array_name, TILEDB_READ);
+  std::map<std::pair<int, int>, int> values;
+  auto check_read = [&](std::vector<int> sub, tiledb_layout_t layout) {
+    auto expected = cells(sub, layout);
+    std::vector<int> a(expected.size());
+    std::vector<double> b(expected.size());
+    Query query(ctx, array);
+    query.set_layout(layout)
+        .set_subarray(sub)
+        .set_buffer("a", a)
+        .set_buffer("b", b);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_num = query.result_buffer_elements();
+    REQUIRE(result_num["a"].second == expected.size());
+    REQUIRE(result_num["b"].second == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CHECK(a[i] == values[expected[i]]);
+      CHECK(b[i] == values[expected[i]] + 0.5);
+    }
+  };
+
+  write({1, 8, 1, 8}, 0);
+  for (int i = 1; i <= 8; ++i) {
+    for (int j = 1; j <= 8; ++j)
+      values[std::make_pair(i, j)] = 100 * i + j;
+  }
+  array.reopen();
+
+  Stats::enable();
+  Stats::reset();
+  auto& stats = tiledb::sm::stats::all_stats;
+
+  // Tiles are unfiltered into the user buffers for the global order, and
+  // copied when a tile spans several slabs of the user buffers
+  check_read({1, 8, 1, 8}, TILEDB_GLOBAL_ORDER);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 8);
+  CHECK(stats.counter_reader_num_aligned_tiles_copied == 0);
+  check_read({1, 8, 1, 8}, TILEDB_ROW_MAJOR);
+  check_read({1, 8, 1, 8}, TILEDB_COL_MAJOR);
+  check_read({5, 8, 1, 8}, TILEDB_ROW_MAJOR);
+  check_read({1, 8, 5, 8}, TILEDB_COL_MAJOR);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 8);
+  CHECK(stats.counter_reader_num_aligned_tiles_copied == 24);
+
+  // A single column (row) of tiles in row-major (col-major) cell order is
+  // contiguous in the user buffers
+  if (cell_order == TILEDB_ROW_MAJOR)
+    check_read({1, 8, 5, 8}, TILEDB_ROW_MAJOR);
+  else
+    check_read({5, 8, 1, 8}, TILEDB_COL_MAJOR);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 12);
+  CHECK(stats.counter_reader_num_aligned_tiles_copied == 24);
+
+  // Subarrays that are not tile-aligned take the regular path
+  check_read({1, 6, 1, 8}, TILEDB_ROW_MAJOR);
+  check_read({2, 8, 1, 8}, TILEDB_COL_MAJOR);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 12);
+  CHECK(stats.counter_reader_num_aligned_tiles_copied == 24);
+
+  // A newer fragment covering only part of the subarray forces the regular
+  // path, but is read with the fast path where it covers the subarray
+  write({1, 4, 1, 4}, 1000);
+  for (int i = 1; i <= 4; ++i) {
+    for (int j = 1; j <= 4; ++j)
+      values[std::make_pair(i, j)] = 100 * i + j + 1000;
+  }
+  array.reopen();
+  check_read({1, 8, 1, 8}, TILEDB_GLOBAL_ORDER);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 12);
+  check_read({1, 4, 1, 4}, TILEDB_GLOBAL_ORDER);
+  CHECK(stats.counter_reader_num_aligned_tiles_direct == 14);
+  check_read({5, 8, 5, 8}, TILEDB_ROW_MAJOR);
+  CHECK(
+      stats.counter_reader_num_aligned_tiles_direct +
+          stats.counter_reader_num_aligned_tiles_copied ==
+      40);
+
+  // A newer sparse fragment forces the regular path
+  {
+    std::vector<int> coords = {6, 7}, a = {-1};
+    std::vector<double> b = {-0.5};
+    Array array_w(ctx_w, array_name, TILEDB_WRITE);
+    Query query_w(ctx_w, array_w);
+    query_w.set_layout(TILEDB_UNORDERED)
+        .set_coordinates(coords)
+        .set_buffer("a", a)
+        .set_buffer("b", b);
+    REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+    array_w.close();
+    values[std::make_pair(6, 7)] = -1;
+  }
+  array.reopen();
+  check_read({5, 8, 5, 8}, TILEDB_ROW_MAJOR);
+  check_read({1, 8, 1, 8}, TILEDB_COL_MAJOR);
+  CHECK(
+      stats.counter_reader_num_aligned_tiles_direct +
+          stats.counter_reader_num_aligned_tiles_copied ==
+      40);
+  check_read({1, 4, 1, 4}, TILEDB_ROW_MAJOR);
+  CHECK(
+      stats.counter_reader_num_aligned_tiles_direct +
+          stats.counter_reader_num_aligned_tiles_copied ==
+      42);
+
+  Stats::disable();
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -384,3 +384,125 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Test tight estimated result sizes",
+    "[cppapi][sparse][subarray][est-result-size]") {
+  const std::string array_name = "cpp_unit_array";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{1, 1000}}, 1000));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(100);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write a single tile with skewed data: 99 cells in [1, 99] and one cell
+  // at 1000, so that the MBR of the tile covers the whole domain
+  std::vector<int> d, a;
+  std::vector<uint64_t> b_off;
+  std::string b;
+  for (int i = 1; i <= 100; ++i) {
+    d.push_back(i < 100 ? i : 1000);
+    a.push_back(i);
+    b_off.push_back(b.size());
+    b.append(i % 4 + 1, 'x');
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", d)
+      .set_buffer("a", a)
+      .set_buffer("b", b_off, b);
+  query_w.submit();
+  array_w.close();
+
+  Config config;
+  config["sm.est_result_size_mode"] = "tight";
+  Context ctx_tight(config);
+
+  SECTION("- Dense part of the tile") {
+    Array array(ctx_tight, array_name, TILEDB_READ);
+    Query query(ctx_tight, array);
+    query.add_range(0, 2, 500);
+    CHECK(query.est_result_size("a") == 98 * sizeof(int));
+    auto est_size_var = query.est_result_size_var("b");
+    CHECK(est_size_var.first == 98);
+    CHECK(est_size_var.second == b.size());
+
+    // The estimates fit the results
+    std::vector<int> r_a(98);
+    std::vector<uint64_t> r_b_off(98);
+    std::string r_b(b.size(), '\0');
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", r_a)
+        .set_buffer("b", r_b_off, r_b);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    CHECK(query.result_buffer_elements()["a"].second == 98);
+  }
+
+  SECTION("- Empty part of the tile") {
+    Array array(ctx_tight, array_name, TILEDB_READ);
+    Query query(ctx_tight, array);
+    query.add_range(0, 200, 900);
+    CHECK(query.est_result_size("a") == 0);
+    auto est_size_var = query.est_result_size_var("b");
+    CHECK(est_size_var.first == 0);
+    CHECK(est_size_var.second == 0);
+
+    // The fast estimate assumes that the cells are uniform in the tile
+    Array array_fast(ctx, array_name, TILEDB_READ);
+    Query query_fast(ctx, array_fast);
+    query_fast.add_range(0, 200, 900);
+    CHECK(query_fast.est_result_size("a") > 0);
+  }
+
+  SECTION("- Incomplete read with read-ahead") {
+    Config config_ra;
+    config_ra["sm.est_result_size_mode"] = "tight";
+    config_ra["sm.read_ahead"] = "true";
+    Context ctx_ra(config_ra);
+    Array array(ctx_ra, array_name, TILEDB_READ);
+    Query query(ctx_ra, array);
+    query.add_range(0, 1, 1000);
+
+    // Small buffers split the read in several partitions, so that the
+    // tiles of the next one are read ahead
+    std::vector<int> r_a(10);
+    std::vector<uint64_t> r_b_off(10);
+    std::string r_b(50, '\0');
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", r_a)
+        .set_buffer("b", r_b_off, r_b);
+    std::vector<int> all_a;
+    auto status = query.submit();
+    CHECK(status == Query::Status::INCOMPLETE);
+    auto num = query.result_buffer_elements()["a"].second;
+    all_a.insert(all_a.end(), r_a.begin(), r_a.begin() + num);
+
+    // The tight estimate is computed while the read-ahead is pending
+    CHECK(query.est_result_size("a") == 100 * sizeof(int));
+    auto est_size_var = query.est_result_size_var("b");
+    CHECK(est_size_var.first == 100);
+    CHECK(est_size_var.second == b.size());
+
+    // Resubmitting returns the rest of the results
+    while (status == Query::Status::INCOMPLETE) {
+      status = query.submit();
+      num = query.result_buffer_elements()["a"].second;
+      all_a.insert(all_a.end(), r_a.begin(), r_a.begin() + num);
+    }
+    CHECK(status == Query::Status::COMPLETE);
+    CHECK(all_a == a);
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
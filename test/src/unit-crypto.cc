@@ -37,7 +37,10 @@
 #include "tiledb/sm/crypto/crypto.h"
 
 #include <catch.hpp>
+#include <cstring>
+#include <future>
 #include <iostream>
+#include <vector>
 
 using namespace tiledb::sm;
 
@@ -209,6 +212,55 @@ TEST_CASE("Crypto: Test AES-256-GCM", "[crypto], [aes]") {
     }
   }
 
+  SECTION("- Interleaved keys and threads") {
+    // The cipher contexts are cached per thread; check that switching keys
+    // and failed decryptions do not leak state into the next operations.
+    char key_bytes[2][33] = {"0123456789abcdeF0123456789abcdeF",
+                             "fEdcba9876543210fEdcba9876543210"};
+    auto run = [&key_bytes](unsigned seed) {
+      bool ok = true;
+      for (unsigned iter = 0; iter < 50; iter++) {
+        unsigned k = (seed + iter) % 2;
+        ConstBuffer key(key_bytes[k], 32), other_key(key_bytes[1 - k], 32);
+        std::vector<unsigned> values(iter * 10 + seed);
+        for (unsigned i = 0; i < values.size(); i++)
+          values[i] = i * seed;
+        ConstBuffer input_cb(values.data(), values.size() * sizeof(unsigned));
+
+        Buffer encrypted;
+        char tag_array[16], iv_array[12];
+        PreallocatedBuffer output_iv(&iv_array[0], sizeof(iv_array));
+        PreallocatedBuffer output_tag(&tag_array[0], sizeof(tag_array));
+        ok &= Crypto::encrypt_aes256gcm(
+                  &key, nullptr, &input_cb, &encrypted, &output_iv, &output_tag)
+                  .ok();
+
+        ConstBuffer iv(iv_array, sizeof(iv_array));
+        ConstBuffer tag(tag_array, sizeof(tag_array));
+        ConstBuffer encrypted_cb(&encrypted);
+        Buffer wrong;
+        ok &= !Crypto::decrypt_aes256gcm(
+                   &other_key, &iv, &tag, &encrypted_cb, &wrong)
+                   .ok();
+        Buffer decrypted;
+        ok &= Crypto::decrypt_aes256gcm(
+                  &key, &iv, &tag, &encrypted_cb, &decrypted)
+                  .ok();
+        ok &= decrypted.size() == input_cb.size() &&
+              (input_cb.size() == 0 ||
+               std::memcmp(decrypted.data(), values.data(), input_cb.size()) ==
+                   0);
+      }
+      return ok;
+    };
+
+    std::vector<std::future<bool>> results;
+    for (unsigned t = 0; t < 4; t++)
+      results.push_back(std::async(std::launch::async, run, t + 1));
+    for (auto& r : results)
+      CHECK(r.get());
+  }
+
   SECTION("- NIST test vectors") {
     // From:
     // https://csrc.nist.gov/Projects/Cryptographic-Algorithm-Validation-Program/CAVP-TESTING-BLOCK-CIPHER-MODES#GCMVS
@@ -396,6 +396,34 @@ TEST_CASE("FilterBuffer: Test view reclaim", "[filter], [filter-buffer]") {
   CHECK(storage.num_in_use() == 0);
 }
 
+TEST_CASE("FilterBuffer: Test storage reuse", "[filter], [filter-buffer]") {
+  FilterStorage storage;
+
+  {
+    FilterBuffer fbuf(&storage), fbuf2(&storage);
+    CHECK(fbuf.prepend_buffer(sizeof(uint64_t)).ok());
+    CHECK(fbuf2.prepend_buffer(sizeof(uint64_t)).ok());
+    CHECK(fbuf2.prepend_buffer(sizeof(uint64_t)).ok());
+    CHECK(storage.num_in_use() == 3);
+
+    // Nothing is reclaimed while the filter buffers hold the buffers
+    storage.reclaim_unused(16);
+    CHECK(storage.num_available() == 0);
+    CHECK(storage.num_in_use() == 3);
+  }
+
+  // The filter buffers went out of scope without being cleared
+  storage.reclaim_unused(2);
+  CHECK(storage.num_available() == 2);
+  CHECK(storage.num_in_use() == 0);
+
+  // A new filter buffer reuses a reclaimed buffer
+  FilterBuffer fbuf(&storage);
+  CHECK(fbuf.prepend_buffer(sizeof(uint64_t)).ok());
+  CHECK(storage.num_available() == 1);
+  CHECK(storage.num_in_use() == 1);
+}
+
 TEST_CASE("FilterBuffer: Test fixed allocation", "[filter], [filter-buffer]") {
   FilterStorage storage;
   FilterBuffer fbuf(&storage);
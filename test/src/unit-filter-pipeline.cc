@@ -35,6 +35,7 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/crypto/encryption_key.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/datatype.h"
@@ -43,15 +44,22 @@
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
 #include "tiledb/sm/filter/checksum_md5_filter.h"
 #include "tiledb/sm/filter/checksum_sha256_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
+#include "tiledb/sm/filter/offsets_delta_filter.h"
 #include "tiledb/sm/filter/positive_delta_filter.h"
+#include "tiledb/sm/filter/simd_kernels.h"
+#include "tiledb/sm/filter/xor_filter.h"
 #include "tiledb/sm/tile/tile.h"
 
 #include <catch.hpp>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <random>
@@ -855,6 +863,386 @@ TEST_CASE("Filter: Test compression", "[filter], [compression]") {
   }
 }
 
+TEST_CASE("Filter: Test compression dictionary", "[filter], [compression]") {
+  // Small JSON-like records, which share most of their bytes
+  auto record = [](uint64_t i) {
+    return "{\"id\": " + std::to_string(i) + ", \"name\": \"user_" +
+           std::to_string(i * 7919 % 1000) + "\", \"status\": \"" +
+           (i % 3 == 0 ? "active" : "inactive") + "\"}";
+  };
+
+  // Train a dictionary on a separate set of records
+  std::string samples;
+  std::vector<uint64_t> sample_sizes;
+  for (uint64_t i = 0; i < 2000; i++) {
+    auto r = record(100000 + i);
+    samples += r;
+    sample_sizes.push_back(r.size());
+  }
+  CompressionFilter zstd(Compressor::ZSTD, -1);
+  CHECK(zstd.dictionary() == nullptr);
+  REQUIRE(zstd.train_dictionary(samples.data(), sample_sizes, 4096).ok());
+  REQUIRE(zstd.dictionary() != nullptr);
+  CHECK(zstd.dictionary()->data().size() <= 4096);
+  CHECK(
+      !CompressionFilter(Compressor::LZ4, -1)
+           .train_dictionary(samples.data(), sample_sizes, 4096)
+           .ok());
+
+  // Set up a small tile
+  std::string data;
+  for (uint64_t i = 0; i < 20; i++)
+    data += record(i);
+  auto compressed_size = [&](const CompressionFilter& filter) {
+    Buffer buff;
+    CHECK(buff.write(data.data(), data.size()).ok());
+    Tile tile(Datatype::CHAR, sizeof(char), 0, &buff, false);
+    FilterPipeline pipeline;
+    CHECK(pipeline.add_filter(filter).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    auto size = tile.buffer()->size();
+    CHECK(pipeline.run_reverse(&tile).ok());
+    CHECK(tile.buffer()->size() == data.size());
+    CHECK(std::memcmp(buff.data(), data.data(), data.size()) == 0);
+    return size;
+  };
+
+  // The dictionary improves the compression of small tiles
+  auto dict_size = compressed_size(zstd);
+  auto plain_size = compressed_size(CompressionFilter(Compressor::ZSTD, -1));
+  CHECK(dict_size < plain_size);
+
+  // The dictionary is serialized with the filter
+  Buffer serialized;
+  REQUIRE(zstd.serialize(&serialized).ok());
+  ConstBuffer cbuff(&serialized);
+  Filter* deserialized = nullptr;
+  REQUIRE(Filter::deserialize(&cbuff, &deserialized).ok());
+  CHECK(cbuff.end());
+  auto compression = dynamic_cast<CompressionFilter*>(deserialized);
+  REQUIRE(compression != nullptr);
+  REQUIRE(compression->dictionary() != nullptr);
+  CHECK(compression->dictionary()->data() == zstd.dictionary()->data());
+  CHECK(compressed_size(*compression) == dict_size);
+  delete deserialized;
+
+  // Filters without a dictionary serialize as before
+  Buffer serialized_plain;
+  REQUIRE(CompressionFilter(Compressor::ZSTD, -1)
+              .serialize(&serialized_plain)
+              .ok());
+  CHECK(
+      serialized_plain.size() ==
+      sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(int32_t));
+
+  // Removing the dictionary
+  REQUIRE(zstd.set_dictionary(nullptr, 0).ok());
+  CHECK(zstd.dictionary() == nullptr);
+}
+
+TEST_CASE("Filter: Test dictionary encoding", "[filter]") {
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(DictionaryFilter()).ok());
+
+  SECTION("- Fixed-sized values") {
+    const uint64_t nelts = 10000;
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      auto value = int32_t(1000 * (i % 7));
+      CHECK(buff.write(&value, sizeof(int32_t)).ok());
+    }
+    Tile tile(Datatype::INT32, sizeof(int32_t), 0, &buff, false);
+
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() < nelts * sizeof(int32_t) / 2);
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    CHECK(tile.buffer()->size() == nelts * sizeof(int32_t));
+    buff.reset_offset();
+    for (uint64_t i = 0; i < nelts; i++) {
+      CHECK(buff.value<int32_t>() == int32_t(1000 * (i % 7)));
+      buff.advance_offset(sizeof(int32_t));
+    }
+  }
+
+  SECTION("- High cardinality") {
+    const uint64_t nelts = 100000;
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(buff.write(&i, sizeof(uint64_t)).ok());
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+    // The values are forwarded unmodified
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() > nelts * sizeof(uint64_t));
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    buff.reset_offset();
+    for (uint64_t i = 0; i < nelts; i++) {
+      CHECK(buff.value<uint64_t>() == i);
+      buff.advance_offset(sizeof(uint64_t));
+    }
+  }
+
+  SECTION("- Var-sized values") {
+    const std::vector<std::string> categories = {
+        "Argentina", "Brazil", "Chile", "", "Denmark", "Ecuador"};
+    const uint64_t nelts = 20000;
+    std::mt19937 gen(0);
+    std::string data;
+    Buffer offsets_buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      uint64_t offset = data.size();
+      CHECK(offsets_buff.write(&offset, sizeof(uint64_t)).ok());
+      data += categories[gen() % categories.size()];
+    }
+    Buffer buff;
+    CHECK(buff.write(data.data(), data.size()).ok());
+    Tile offsets_tile(
+        Datatype::UINT64, sizeof(uint64_t), 0, &offsets_buff, false);
+    Tile tile(Datatype::CHAR, sizeof(char), 0, &buff, false);
+
+    // Chunks are aligned on cells, whose sizes are exposed to the filters
+    CHECK(pipeline.add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok());
+    CHECK(pipeline.run_forward(&tile, &offsets_tile).ok());
+    CHECK(pipeline.current_chunk_cell_sizes() == nullptr);
+    auto encoded_size = tile.buffer()->size();
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == data.size());
+    CHECK(std::memcmp(buff.data(), data.data(), data.size()) == 0);
+
+    // Without the offsets, the values are treated as single characters
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(encoded_size < tile.buffer()->size());
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == data.size());
+    CHECK(std::memcmp(buff.data(), data.data(), data.size()) == 0);
+  }
+}
+
+TEST_CASE("Filter: Test offsets delta encoding", "[filter]") {
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(OffsetsDeltaFilter()).ok());
+
+  SECTION("- Short cells") {
+    const uint64_t nelts = 100000;
+    std::mt19937 gen(0);
+    std::vector<uint64_t> offsets(nelts);
+    Buffer buff;
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < nelts; i++) {
+      offsets[i] = offset;
+      CHECK(buff.write(&offset, sizeof(uint64_t)).ok());
+      // Mostly short cells, with a few long ones and some empty ones
+      offset += (i % 1000 == 0) ? 100000 : gen() % 16;
+    }
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() < nelts * sizeof(uint64_t) / 8);
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(uint64_t));
+    CHECK(
+        std::memcmp(buff.data(), offsets.data(), nelts * sizeof(uint64_t)) ==
+        0);
+  }
+
+  SECTION("- Decreasing values") {
+    const uint64_t nelts = 1000;
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      uint64_t value = nelts - i;
+      CHECK(buff.write(&value, sizeof(uint64_t)).ok());
+    }
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+    // The values are forwarded unmodified
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() > nelts * sizeof(uint64_t));
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    buff.reset_offset();
+    for (uint64_t i = 0; i < nelts; i++) {
+      CHECK(buff.value<uint64_t>() == nelts - i);
+      buff.advance_offset(sizeof(uint64_t));
+    }
+  }
+
+  SECTION("- Followed by compression") {
+    const uint64_t nelts = 10000;
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      uint64_t offset = i * 7;
+      CHECK(buff.write(&offset, sizeof(uint64_t)).ok());
+    }
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+    CHECK(pipeline.add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(uint64_t));
+    buff.reset_offset();
+    for (uint64_t i = 0; i < nelts; i++) {
+      CHECK(buff.value<uint64_t>() == i * 7);
+      buff.advance_offset(sizeof(uint64_t));
+    }
+  }
+}
+
+TEST_CASE("Filter: Test frame of reference encoding", "[filter]") {
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(FrameOfReferenceFilter()).ok());
+
+  SECTION("- Timestamps") {
+    const uint64_t nelts = 100000;
+    std::mt19937 gen(0);
+    std::vector<int64_t> values(nelts);
+    Buffer buff;
+    int64_t timestamp = 1600000000000000000;
+    for (uint64_t i = 0; i < nelts; i++) {
+      // Regular intervals with jitter and a few outliers
+      timestamp += 1000000 + gen() % 100;
+      values[i] = (i % 10000 == 5) ? -timestamp : timestamp;
+      CHECK(buff.write(&values[i], sizeof(int64_t)).ok());
+    }
+    Tile tile(Datatype::DATETIME_NS, sizeof(int64_t), 0, &buff, false);
+
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() < nelts * sizeof(int64_t) / 4);
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(int64_t));
+    CHECK(
+        std::memcmp(buff.data(), values.data(), nelts * sizeof(int64_t)) ==
+        0);
+  }
+
+  SECTION("- All integer types") {
+    const uint64_t nelts = 1001;
+    std::mt19937 gen(0);
+    std::vector<Datatype> types = {Datatype::INT8,
+                                   Datatype::UINT8,
+                                   Datatype::INT16,
+                                   Datatype::UINT16,
+                                   Datatype::INT32,
+                                   Datatype::UINT32,
+                                   Datatype::INT64,
+                                   Datatype::UINT64};
+    for (auto type : types) {
+      auto size = datatype_size(type);
+      std::vector<uint8_t> bytes(nelts * size);
+      for (auto& byte : bytes)
+        byte = (uint8_t)(gen() % 4);
+      Buffer buff;
+      CHECK(buff.write(bytes.data(), bytes.size()).ok());
+      Tile tile(type, size, 0, &buff, false);
+
+      CHECK(pipeline.run_forward(&tile).ok());
+      CHECK(pipeline.run_reverse(&tile).ok());
+      REQUIRE(tile.buffer()->size() == bytes.size());
+      CHECK(std::memcmp(buff.data(), bytes.data(), bytes.size()) == 0);
+    }
+  }
+
+  SECTION("- Unsupported type") {
+    const uint64_t nelts = 1000;
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      float value = 1.0f;
+      CHECK(buff.write(&value, sizeof(float)).ok());
+    }
+    Tile tile(Datatype::FLOAT32, sizeof(float), 0, &buff, false);
+
+    // The values are forwarded unmodified
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() > nelts * sizeof(float));
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(float));
+    buff.reset_offset();
+    for (uint64_t i = 0; i < nelts; i++) {
+      CHECK(buff.value<float>() == 1.0f);
+      buff.advance_offset(sizeof(float));
+    }
+  }
+}
+
+TEST_CASE("Filter: Test XOR encoding", "[filter]") {
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(XorFilter()).ok());
+
+  SECTION("- Slowly changing values") {
+    const uint64_t nelts = 100000;
+    std::vector<double> values(nelts);
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      values[i] = 20.0 + (double)(i / 100) * 0.25;
+      CHECK(buff.write(&values[i], sizeof(double)).ok());
+    }
+    Tile tile(Datatype::FLOAT64, sizeof(double), 0, &buff, false);
+
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(tile.buffer()->size() < nelts * sizeof(double) / 8);
+
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(double));
+    CHECK(
+        std::memcmp(buff.data(), values.data(), nelts * sizeof(double)) == 0);
+  }
+
+  SECTION("- Random values") {
+    const uint64_t nelts = 1000;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    std::vector<float> values(nelts);
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++) {
+      values[i] = (i % 7 == 0) ? values[i - (i > 0 ? 1 : 0)] : dist(gen);
+      CHECK(buff.write(&values[i], sizeof(float)).ok());
+    }
+    Tile tile(Datatype::FLOAT32, sizeof(float), 0, &buff, false);
+
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(float));
+    CHECK(std::memcmp(buff.data(), values.data(), nelts * sizeof(float)) == 0);
+  }
+}
+
+TEST_CASE("Filter: Test partial reverse", "[filter]") {
+  // Set up test data
+  const uint64_t nelts = 100;
+  Buffer buff;
+  for (uint64_t i = 0; i < nelts; i++)
+    CHECK(buff.write(&i, sizeof(uint64_t)).ok());
+
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+  // Ten chunks of ten cells each
+  FilterPipeline pipeline;
+  pipeline.set_max_chunk_size(10 * sizeof(uint64_t));
+  CHECK(pipeline.add_filter(Add1InPlace()).ok());
+  CHECK(pipeline.add_filter(Add1OutOfPlace()).ok());
+  CHECK(pipeline.run_forward(&tile).ok());
+
+  // Decode cells 25-29 (chunk 2), the first cell (chunk 0) and the last
+  // cell (chunk 9)
+  std::vector<std::pair<uint64_t, uint64_t>> ranges = {
+      {0, 8}, {25 * 8, 30 * 8}, {99 * 8, 100 * 8}};
+  CHECK(pipeline.run_reverse(&tile, ranges).ok());
+  CHECK(tile.buffer()->size() == nelts * sizeof(uint64_t));
+
+  // Check the elements of the decoded chunks, and that the skipped chunks
+  // are zeroed.
+  for (uint64_t i = 0; i < nelts; i++) {
+    buff.set_offset(i * sizeof(uint64_t));
+    if (i / 10 == 0 || i / 10 == 2 || i / 10 == 9)
+      CHECK(buff.value<uint64_t>() == i);
+    else
+      CHECK(buff.value<uint64_t>() == 0);
+  }
+}
+
 TEST_CASE("Filter: Test pseudo-checksum", "[filter]") {
   // Set up test data
   const uint64_t nelts = 100;
@@ -1114,6 +1502,7 @@ TEST_CASE("Filter: Test random pipeline", "[filter]") {
       []() { return new PseudoChecksumFilter(); },
       []() { return new ChecksumMD5Filter(); },
       []() { return new ChecksumSHA256Filter(); },
+      []() { return new ChecksumCRC32CFilter(); },
       [&encryption_key]() {
         return new EncryptionAES256GCMFilter(encryption_key);
       },
@@ -1367,6 +1756,127 @@ TEST_CASE("Filter: Test positive-delta encoding", "[filter]") {
   }
 }
 
+/** Checks the dispatched integer kernels against the portable ones. */
+template <class T>
+void check_simd_kernels() {
+  std::mt19937_64 gen(0);
+  std::uniform_int_distribution<uint64_t> dist(0, 7);
+  for (uint64_t num : {0, 1, 3, 7, 8, 9, 31, 33, 1000}) {
+    // Non-decreasing values, wrapping around for the small types
+    std::vector<T> values(num);
+    T val = (T)100;
+    for (uint64_t i = 0; i < num; i++) {
+      val = (T)(val + (T)dist(gen));
+      values[i] = val;
+    }
+
+    std::vector<T> deltas(num), expected(num);
+    bool ok = simd::delta_encode(values.data(), num, (T)0, deltas.data());
+    bool expected_ok =
+        simd::generic::delta_encode(values.data(), num, (T)0, expected.data());
+    REQUIRE(ok == expected_ok);
+    if (ok)
+      CHECK(deltas == expected);
+
+    std::vector<T> sums(num);
+    simd::prefix_sum(deltas.data(), num, (T)0, sums.data());
+    simd::generic::prefix_sum(deltas.data(), num, (T)0, expected.data());
+    CHECK(sums == expected);
+
+    // In place
+    simd::prefix_sum(deltas.data(), num, (T)0, deltas.data());
+    CHECK(deltas == expected);
+
+    // A single decreasing value anywhere is rejected
+    if (num > 1 && ok) {
+      values[num / 2 + 1] = (T)(values[num / 2] - 1);
+      CHECK(!simd::delta_encode(values.data(), num, (T)0, deltas.data()));
+    }
+  }
+}
+
+TEST_CASE("Filter: Test SIMD kernels", "[filter]") {
+  check_simd_kernels<int8_t>();
+  check_simd_kernels<uint8_t>();
+  check_simd_kernels<int16_t>();
+  check_simd_kernels<uint16_t>();
+  check_simd_kernels<int32_t>();
+  check_simd_kernels<uint32_t>();
+  check_simd_kernels<int64_t>();
+  check_simd_kernels<uint64_t>();
+
+  std::vector<int64_t> values = {-5, 1000, 7, -5, 12};
+  int64_t min, max;
+  simd::min_max(values.data(), values.size(), &min, &max);
+  CHECK(min == -5);
+  CHECK(max == 1000);
+
+  std::vector<uint16_t> narrowed(values.size());
+  std::vector<int64_t> widened(values.size());
+  simd::narrow(values.data(), values.size(), min, narrowed.data());
+  simd::widen(narrowed.data(), values.size(), min, widened.data());
+  CHECK(widened == values);
+
+  // CRC32C check value, also computed in two steps and unaligned
+  const char* check = "0123456789";
+  CHECK(simd::crc32c(0, check + 1, 9) == 0xE3069283);
+  CHECK(simd::generic::crc32c(0, check + 1, 9) == 0xE3069283);
+  auto crc = simd::crc32c(0, check + 1, 4);
+  CHECK(simd::crc32c(crc, check + 5, 5) == 0xE3069283);
+  std::vector<uint8_t> bytes(1001);
+  for (uint64_t i = 0; i < bytes.size(); i++)
+    bytes[i] = (uint8_t)(i * 37);
+  CHECK(
+      simd::crc32c(0, &bytes[1], 1000) ==
+      simd::generic::crc32c(0, &bytes[1], 1000));
+}
+
+TEST_CASE("Filter: Test CRC32C checksum", "[filter]") {
+  const uint64_t nelts = 1000;
+  Buffer buff;
+  for (uint64_t i = 0; i < nelts; i++)
+    CHECK(buff.write(&i, sizeof(uint64_t)).ok());
+  Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(ChecksumCRC32CFilter()).ok());
+  CHECK(pipeline.verify_checksums());
+
+  SECTION("- Round trip") {
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(uint64_t));
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(tile.buffer()->value<uint64_t>(i * sizeof(uint64_t)) == i);
+  }
+
+  SECTION("- Corruption") {
+    CHECK(pipeline.add_filter(ChecksumMD5Filter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+
+    // Flip a bit of the last value, which is at the end of the last chunk
+    auto size = tile.buffer()->size();
+    static_cast<char*>(tile.buffer()->data())[size - 1] ^= 1;
+    Buffer corrupted;
+    CHECK(corrupted.write(tile.buffer()->data(), size).ok());
+    CHECK(!pipeline.run_reverse(&tile).ok());
+
+    // The corruption goes unnoticed if the checksums are not verified, also
+    // in a copy of the pipeline
+    pipeline.set_verify_checksums(false);
+    FilterPipeline copy(pipeline);
+    CHECK(!copy.verify_checksums());
+    Tile corrupted_tile(
+        Datatype::UINT64, sizeof(uint64_t), 0, &corrupted, false);
+    CHECK(copy.run_reverse(&corrupted_tile).ok());
+    REQUIRE(corrupted_tile.buffer()->size() == nelts * sizeof(uint64_t));
+    auto last = (nelts - 1) * sizeof(uint64_t);
+    CHECK(
+        corrupted_tile.buffer()->value<uint64_t>(last) ==
+        ((nelts - 1) ^ (1ull << 56)));
+  }
+}
+
 TEST_CASE("Filter: Test bitshuffle", "[filter]") {
   // Set up test data
   const uint64_t nelts = 1000;
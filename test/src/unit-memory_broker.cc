@@ -0,0 +1,155 @@
+/**
+ * @file unit-memory_broker.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests classes MemoryBroker and MemoryReservation.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/misc/memory_broker.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace tiledb::sm;
+
+TEST_CASE("MemoryBroker: Test unlimited", "[memory-broker]") {
+  MemoryBroker broker;
+  CHECK(broker.limit() == 0);
+  CHECK(broker.reserve(100).ok());
+  CHECK(broker.try_reserve(1000));
+  CHECK(broker.usage() == 1100);
+  broker.release(1000);
+  CHECK(broker.usage() == 100);
+  CHECK(broker.peak() == 1100);
+  broker.release(100);
+  CHECK(broker.usage() == 0);
+}
+
+TEST_CASE("MemoryBroker: Test invalid policy", "[memory-broker]") {
+  MemoryBroker broker;
+  CHECK(!broker.init(100, "foo").ok());
+  CHECK(broker.init(100, "shrink").ok());
+  CHECK(broker.policy() == MemoryBroker::Policy::SHRINK);
+}
+
+TEST_CASE("MemoryBroker: Test fail policy", "[memory-broker]") {
+  MemoryBroker broker;
+  REQUIRE(broker.init(100, "fail").ok());
+  CHECK(!broker.reserve(101).ok());
+  CHECK(broker.reserve(60).ok());
+  CHECK(!broker.reserve(50).ok());
+  CHECK(!broker.try_reserve(50));
+  CHECK(broker.try_reserve(40));
+  CHECK(broker.usage() == 100);
+  broker.release(100);
+  CHECK(broker.reserve(50).ok());
+  CHECK(broker.peak() == 100);
+}
+
+TEST_CASE("MemoryBroker: Test block policy", "[memory-broker]") {
+  MemoryBroker broker;
+  REQUIRE(broker.init(100, "block").ok());
+  CHECK(!broker.reserve(101).ok());
+  REQUIRE(broker.reserve(80).ok());
+
+  // The second reservation waits until the first one is released
+  std::atomic<bool> reserved(false);
+  std::thread t([&]() {
+    CHECK(broker.reserve(50).ok());
+    reserved = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  CHECK(!reserved);
+  broker.release(80);
+  t.join();
+  CHECK(reserved);
+  CHECK(broker.usage() == 50);
+}
+
+TEST_CASE("MemoryBroker: Test held memory", "[memory-broker]") {
+  MemoryBroker broker;
+  REQUIRE(broker.init(100, "block").ok());
+  MemoryReservation parent;
+  REQUIRE(parent.reserve(&broker, 80).ok());
+
+  // A request that cannot fit along with the memory its caller holds fails
+  // instead of waiting forever
+  MemoryReservation child;
+  CHECK(!child.reserve(&broker, 30, parent.size()).ok());
+  CHECK(child.size() == 0);
+  CHECK(child.reserve(&broker, 20, parent.size()).ok());
+  CHECK(broker.usage() == 100);
+}
+
+TEST_CASE("MemoryBroker: Test reservation", "[memory-broker]") {
+  MemoryBroker broker;
+  REQUIRE(broker.init(100, "fail").ok());
+  {
+    MemoryReservation reservation;
+    CHECK(reservation.reserve(&broker, 70).ok());
+    CHECK(reservation.size() == 70);
+    CHECK(!reservation.try_reserve(&broker, 101));
+    CHECK(reservation.size() == 0);
+    CHECK(reservation.try_reserve(&broker, 90));
+    CHECK(broker.usage() == 90);
+  }
+  CHECK(broker.usage() == 0);
+}
+
+TEST_CASE("MemoryBroker: Test reclaiming the cache", "[memory-broker]") {
+  MemoryBroker broker;
+  REQUIRE(broker.init(100, "fail").ok());
+  LRUCache cache(1000);
+  cache.set_memory_broker(&broker);
+  broker.set_reclaimer([&cache](uint64_t nbytes) { cache.reclaim(nbytes); });
+
+  // The cache evicts its own objects to fit in the limit
+  for (int i = 0; i < 3; ++i) {
+    auto object = std::malloc(40);
+    REQUIRE(cache.insert(std::to_string(i), object, 40).ok());
+  }
+  CHECK(cache.size() == 80);
+  CHECK(broker.usage() == 80);
+
+  // Reservations evict objects from the cache
+  CHECK(broker.reserve(50).ok());
+  CHECK(cache.size() == 40);
+  CHECK(broker.usage() == 90);
+
+  // Objects that do not fit even after emptying the cache are not cached
+  auto object = std::malloc(60);
+  REQUIRE(cache.insert("3", object, 60).ok());
+  CHECK(cache.size() == 0);
+  CHECK(broker.usage() == 50);
+  broker.release(50);
+  CHECK(broker.usage() == 0);
+}
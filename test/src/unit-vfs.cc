@@ -327,6 +327,59 @@ TEST_CASE("VFS: Test long posix paths", "[vfs]") {
   REQUIRE(vfs->terminate().ok());
 }
 
+TEST_CASE("VFS: Test bulk listing and removal", "[vfs]") {
+  std::unique_ptr<VFS> vfs(new VFS);
+  REQUIRE(vfs->init(nullptr, nullptr).ok());
+
+  std::string tmpdir = Posix::current_dir() + "/tiledb_test_bulk/";
+  bool exists = false;
+  REQUIRE(vfs->is_dir(URI(tmpdir), &exists).ok());
+  if (exists)
+    REQUIRE(vfs->remove_dir(URI(tmpdir)).ok());
+  REQUIRE(vfs->create_dir(URI(tmpdir)).ok());
+
+  // Create a few directories with a few files each
+  std::vector<URI> dirs, files;
+  for (int d = 0; d < 4; d++) {
+    URI dir(tmpdir + "dir" + std::to_string(d));
+    REQUIRE(vfs->create_dir(dir).ok());
+    dirs.push_back(dir);
+    for (int f = 0; f < 3; f++) {
+      URI file(dir.join_path("file" + std::to_string(f)));
+      REQUIRE(vfs->touch(file).ok());
+      files.push_back(file);
+    }
+  }
+
+  std::vector<std::vector<URI>> children;
+  REQUIRE(vfs->ls_all(dirs, &children).ok());
+  REQUIRE(children.size() == dirs.size());
+  for (const auto& c : children)
+    CHECK(c.size() == 3);
+
+  // Remove the first file of each directory
+  std::vector<URI> to_remove;
+  for (size_t i = 0; i < files.size(); i += 3)
+    to_remove.push_back(files[i]);
+  REQUIRE(vfs->remove_files(to_remove).ok());
+  REQUIRE(vfs->ls_all(dirs, &children).ok());
+  for (const auto& c : children)
+    CHECK(c.size() == 2);
+
+  // Remove all but the last directory
+  std::vector<URI> dirs_to_remove(dirs.begin(), dirs.end() - 1);
+  REQUIRE(vfs->remove_dirs(dirs_to_remove).ok());
+  for (const auto& dir : dirs_to_remove) {
+    REQUIRE(vfs->is_dir(dir, &exists).ok());
+    CHECK(!exists);
+  }
+  REQUIRE(vfs->is_dir(dirs.back(), &exists).ok());
+  CHECK(exists);
+
+  REQUIRE(vfs->remove_dir(URI(tmpdir)).ok());
+  REQUIRE(vfs->terminate().ok());
+}
+
 #endif
 
 TEST_CASE("VFS: URI semantics", "[vfs][uri]") {
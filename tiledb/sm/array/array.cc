@@ -40,6 +40,7 @@
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/enums/serialization_type.h"
+#include "tiledb/sm/fragment/fragment_index.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
@@ -72,12 +73,11 @@ Array::Array(const URI& array_uri, StorageManager* storage_manager)
 /* ********************************* */
 
 ArraySchema* Array::array_schema() const {
-  std::unique_lock<std::mutex> lck(mtx_);
-  return array_schema_;
+  auto snapshot = this->snapshot();
+  return (snapshot == nullptr) ? nullptr : snapshot->array_schema_;
 }
 
 const URI& Array::array_uri() const {
-  std::unique_lock<std::mutex> lck(mtx_);
   return array_uri_;
 }
 
@@ -130,6 +130,7 @@ Status Array::open(
     metadata_.reset(timestamp_);
   }
 
+  publish_snapshot();
   is_open_ = true;
 
   return Status::Ok();
@@ -183,6 +184,7 @@ Status Array::open(
         &fragment_metadata_));
   }
 
+  publish_snapshot();
   is_open_ = true;
 
   return Status::Ok();
@@ -233,6 +235,7 @@ Status Array::open(
   }
 
   query_type_ = query_type;
+  publish_snapshot();
   is_open_ = true;
 
   return Status::Ok();
@@ -247,11 +250,14 @@ Status Array::close() {
   is_open_ = false;
   clear_last_max_buffer_sizes();
   fragment_metadata_.clear();
+  reset_snapshot();
 
   if (remote_) {
     // Update array metadata for write queries if metadata was written by the
     // user
-    if (query_type_ == QueryType::WRITE && metadata_.num() > 0) {
+    uint64_t metadata_num;
+    RETURN_NOT_OK(metadata_.num(&metadata_num));
+    if (query_type_ == QueryType::WRITE && metadata_num > 0) {
       // Set metadata loaded to be true so when serialization fetchs the
       // metadata it won't trigger a deadlock
       metadata_loaded_ = true;
@@ -282,12 +288,11 @@ Status Array::close() {
 }
 
 bool Array::is_empty() const {
-  std::unique_lock<std::mutex> lck(mtx_);
-  return fragment_metadata_.empty();
+  auto snapshot = this->snapshot();
+  return snapshot == nullptr || snapshot->fragment_metadata_.empty();
 }
 
 bool Array::is_open() const {
-  std::unique_lock<std::mutex> lck(mtx_);
   return is_open_;
 }
 
@@ -296,32 +301,45 @@ bool Array::is_remote() const {
 }
 
 std::vector<FragmentMetadata*> Array::fragment_metadata() const {
-  std::unique_lock<std::mutex> lck(mtx_);
-  return fragment_metadata_;
+  auto snapshot = this->snapshot();
+  return (snapshot == nullptr) ? std::vector<FragmentMetadata*>() :
+                                 snapshot->fragment_metadata_;
 }
 
-Status Array::get_array_schema(ArraySchema** array_schema) const {
-  std::unique_lock<std::mutex> lck(mtx_);
+std::shared_ptr<const FragmentIndex> Array::fragment_index() const {
+  auto snapshot = this->snapshot();
+  if (snapshot == nullptr || snapshot->array_schema_ == nullptr)
+    return nullptr;
+
+  // Concurrent callers wait for the first one to build the index
+  std::call_once(snapshot->fragment_index_once_, [&snapshot]() {
+    snapshot->fragment_index_ = std::make_shared<const FragmentIndex>(
+        snapshot->array_schema_->domain(), snapshot->fragment_metadata_);
+  });
+
+  return snapshot->fragment_index_;
+}
 
+Status Array::get_array_schema(ArraySchema** array_schema) const {
   // Error if the array is not open
-  if (!is_open_)
+  auto snapshot = this->snapshot();
+  if (snapshot == nullptr)
     return LOG_STATUS(
         Status::ArrayError("Cannot get array schema; Array is not open"));
 
-  *array_schema = array_schema_;
+  *array_schema = snapshot->array_schema_;
 
   return Status::Ok();
 }
 
 Status Array::get_query_type(QueryType* query_type) const {
-  std::unique_lock<std::mutex> lck(mtx_);
-
   // Error if the array is not open
-  if (!is_open_)
+  auto snapshot = this->snapshot();
+  if (snapshot == nullptr)
     return LOG_STATUS(
         Status::ArrayError("Cannot get query_type; Array is not open"));
 
-  *query_type = query_type_;
+  *query_type = snapshot->query_type_;
 
   return Status::Ok();
 }
@@ -429,7 +447,6 @@ Status Array::get_max_buffer_size(
 }
 
 const EncryptionKey& Array::get_encryption_key() const {
-  std::unique_lock<std::mutex> lck(mtx_);
   return encryption_key_;
 }
 
@@ -463,21 +480,25 @@ Status Array::reopen(uint64_t timestamp) {
         encryption_key_.key().data(),
         encryption_key_.key().size());
   }
-  return storage_manager_->array_reopen(
+
+  // The queries in progress keep using the previous snapshot, until the
+  // new one is published below
+  auto st = storage_manager_->array_reopen(
       array_uri_,
       timestamp_,
       encryption_key_,
       &array_schema_,
       &fragment_metadata_);
+  publish_snapshot();
+
+  return st;
 }
 
 uint64_t Array::timestamp() const {
-  std::unique_lock<std::mutex> lck(mtx_);
   return timestamp_;
 }
 
 Status Array::set_timestamp(uint64_t timestamp) {
-  std::unique_lock<std::mutex> lck(mtx_);
   timestamp_ = timestamp;
   return Status::Ok();
 }
@@ -615,7 +636,7 @@ Status Array::get_metadata_num(uint64_t* num) {
   if (!metadata_loaded_)
     RETURN_NOT_OK(load_metadata());
 
-  *num = metadata_.num();
+  RETURN_NOT_OK(metadata_.num(num));
 
   return Status::Ok();
 }
@@ -647,6 +668,33 @@ Status Array::has_metadata_key(
   return Status::Ok();
 }
 
+Status Array::get_metadata_keys(
+    const char* prefix, std::vector<std::string>* keys) {
+  // Check if array is open
+  if (!is_open_)
+    return LOG_STATUS(
+        Status::ArrayError("Cannot get metadata keys; Array is not open"));
+
+  // Check mode
+  if (query_type_ != QueryType::READ)
+    return LOG_STATUS(
+        Status::ArrayError("Cannot get metadata keys; Array was "
+                           "not opened in read mode"));
+
+  // Check if prefix is null
+  if (prefix == nullptr)
+    return LOG_STATUS(
+        Status::ArrayError("Cannot get metadata keys; Prefix cannot be null"));
+
+  // Load array metadata, if not loaded yet
+  if (!metadata_loaded_)
+    RETURN_NOT_OK(load_metadata());
+
+  RETURN_NOT_OK(metadata_.get_keys(prefix, keys));
+
+  return Status::Ok();
+}
+
 Metadata* Array::metadata() {
   return &metadata_;
 }
@@ -656,6 +704,7 @@ Status Array::metadata(Metadata** metadata) {
   if (!metadata_loaded_)
     RETURN_NOT_OK(load_metadata());
 
+  RETURN_NOT_OK(metadata_.load_all());
   *metadata = &metadata_;
 
   return Status::Ok();
@@ -671,6 +720,23 @@ void Array::clear_last_max_buffer_sizes() {
   last_max_buffer_sizes_subarray_.shrink_to_fit();
 }
 
+void Array::publish_snapshot() {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->array_schema_ = array_schema_;
+  snapshot->query_type_ = query_type_;
+  snapshot->fragment_metadata_ = fragment_metadata_;
+  std::atomic_store(
+      &snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+void Array::reset_snapshot() {
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>());
+}
+
+std::shared_ptr<const Array::Snapshot> Array::snapshot() const {
+  return std::atomic_load(&snapshot_);
+}
+
 Status Array::compute_max_buffer_sizes(const void* subarray) {
   // Applicable only to domains where all dimensions have the same type
   if (!array_schema_->domain()->all_dims_same_type())
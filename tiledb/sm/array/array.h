@@ -34,6 +34,8 @@
 #define TILEDB_ARRAY_H
 
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -46,6 +48,7 @@ namespace tiledb {
 namespace sm {
 
 class ArraySchema;
+class FragmentIndex;
 class FragmentMetadata;
 class StorageManager;
 enum class QueryType : uint8_t;
@@ -53,6 +56,13 @@ enum class QueryType : uint8_t;
 /**
  * An array object to be opened for reads/writes. An ``Array`` instance
  * is associated with the timestamp it is opened at.
+ *
+ * The state that the queries on the array use (the array schema, query
+ * type, fragment metadata and fragment index) is published as an immutable
+ * snapshot upon every open and reopen. Its accessors do not lock, so that
+ * many threads can read from the same array without blocking on each
+ * other or on a concurrent reopen, which publishes a new snapshot instead
+ * of modifying the one in use.
  */
 class Array {
  public:
@@ -144,10 +154,19 @@ class Array {
 
   /**
    * Returns the fragment metadata of the array. If the array is not open,
-   * an empty vector is returned.
+   * an empty vector is returned. The metadata remain valid until the array
+   * is closed, even if it is reopened meanwhile.
    */
   std::vector<FragmentMetadata*> fragment_metadata() const;
 
+  /**
+   * Returns the index over the fragments of the array (see
+   * `fragment_metadata`), building it upon the first call after the array
+   * is opened or reopened. The index is shared by all the queries on the
+   * array. If the array is not open, `nullptr` is returned.
+   */
+  std::shared_ptr<const FragmentIndex> fragment_index() const;
+
   /**
    * Returns `true` if the array is empty at the time it is opened.
    * The funciton returns `false` if the array is not open.
@@ -287,7 +306,20 @@ class Array {
   /** Sets has_key == 1 and corresponding value_type if the array has key. */
   Status has_metadata_key(const char* key, Datatype* value_type, bool* has_key);
 
-  /** Retrieves the array metadata object. */
+  /**
+   * Retrieves the sorted keys of the array metadata items that start with
+   * the input prefix.
+   *
+   * @param prefix The key prefix.
+   * @param keys The keys to be retrieved.
+   * @return Status
+   */
+  Status get_metadata_keys(const char* prefix, std::vector<std::string>* keys);
+
+  /**
+   * Retrieves the array metadata object, with all its items loaded (see
+   * `Metadata::load_all`).
+   */
   Status metadata(Metadata** metadata);
 
   /**
@@ -325,6 +357,31 @@ class Array {
   /** The metadata of the fragments the array was opened with. */
   std::vector<FragmentMetadata*> fragment_metadata_;
 
+  /** The state of an open array used by the queries on it. */
+  struct Snapshot {
+    /** The array schema. */
+    ArraySchema* array_schema_;
+
+    /** The query type the array was opened for. */
+    QueryType query_type_;
+
+    /** The metadata of the fragments the array was opened with. */
+    std::vector<FragmentMetadata*> fragment_metadata_;
+
+    /** Ensures that `fragment_index_` is built only once. */
+    mutable std::once_flag fragment_index_once_;
+
+    /** The index over `fragment_metadata_`, built lazily. */
+    mutable std::shared_ptr<const FragmentIndex> fragment_index_;
+  };
+
+  /**
+   * The snapshot of the open array, or `nullptr` if the array is not open.
+   * It is replaced (never modified) while holding `mtx_`, and accessed
+   * with `std::atomic_load` without locking.
+   */
+  std::shared_ptr<const Snapshot> snapshot_;
+
   /** `True` if the array has been opened. */
   std::atomic<bool> is_open_;
 
@@ -335,7 +392,7 @@ class Array {
    * The timestamp at which the `open_array_` got opened. In TileDB,
    * timestamps are in ms elapsed since 1970-01-01 00:00:00 +0000 (UTC).
    */
-  uint64_t timestamp_;
+  std::atomic<uint64_t> timestamp_;
 
   /** TileDB storage manager. */
   StorageManager* storage_manager_;
@@ -350,7 +407,10 @@ class Array {
    */
   std::vector<uint8_t> last_max_buffer_sizes_subarray_;
 
-  /** Mutex for thread-safety. */
+  /**
+   * Mutex for thread-safety. It serializes opening, reopening and closing
+   * the array, but it is not taken by the accessors of the snapshot.
+   */
   mutable std::mutex mtx_;
 
   /** True if the array is remote (has `tiledb://` URI scheme). */
@@ -369,6 +429,18 @@ class Array {
   /** Clears the cached max buffer sizes and subarray. */
   void clear_last_max_buffer_sizes();
 
+  /**
+   * Publishes a new snapshot with the current array schema, query type and
+   * fragment metadata. It must be called while holding `mtx_`.
+   */
+  void publish_snapshot();
+
+  /** Unpublishes the snapshot. It must be called while holding `mtx_`. */
+  void reset_snapshot();
+
+  /** Returns the current snapshot, or `nullptr` if the array is not open. */
+  std::shared_ptr<const Snapshot> snapshot() const;
+
   /**
    * Computes the maximum buffer sizes for all attributes given a subarray,
    * which are cached locally in the instance.
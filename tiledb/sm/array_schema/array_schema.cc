@@ -42,6 +42,7 @@
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/offsets_delta_filter.h"
 #include "tiledb/sm/misc/logger.h"
 
 #include <cassert>
@@ -73,6 +74,7 @@ ArraySchema::ArraySchema(ArrayType array_type)
   // Set up default filter pipelines for coords and offsets
   coords_filters_.add_filter(CompressionFilter(
       constants::coords_compression, constants::coords_compression_level));
+  cell_var_offsets_filters_.add_filter(OffsetsDeltaFilter());
   cell_var_offsets_filters_.add_filter(CompressionFilter(
       constants::cell_var_offsets_compression,
       constants::cell_var_offsets_compression_level));
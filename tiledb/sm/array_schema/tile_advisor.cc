@@ -0,0 +1,678 @@
+/**
+ * @file   tile_advisor.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileAdvisor.
+ */
+
+#include "tiledb/sm/array_schema/tile_advisor.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/array_type.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Default minimum uncompressed tile size (64KB). */
+const uint64_t default_min_tile_size = 64 * 1024;
+
+/** Default maximum uncompressed tile size (64MB). */
+const uint64_t default_max_tile_size = 64 * 1024 * 1024;
+
+/** Default fixed cost of reading a tile (256KB). */
+const uint64_t default_tile_overhead = 256 * 1024;
+
+/** The largest sparse capacity considered (as a power of 2). */
+const unsigned max_capacity_log2 = 30;
+
+/** Returns the `i`-th value of type `type` in `buff` as a double. */
+double value_to_double(Datatype type, const void* buff, uint64_t i) {
+  switch (type) {
+    case Datatype::INT8:
+      return ((const int8_t*)buff)[i];
+    case Datatype::UINT8:
+      return ((const uint8_t*)buff)[i];
+    case Datatype::INT16:
+      return ((const int16_t*)buff)[i];
+    case Datatype::UINT16:
+      return ((const uint16_t*)buff)[i];
+    case Datatype::INT32:
+      return ((const int32_t*)buff)[i];
+    case Datatype::UINT32:
+      return ((const uint32_t*)buff)[i];
+    case Datatype::UINT64:
+      return (double)((const uint64_t*)buff)[i];
+    case Datatype::FLOAT32:
+      return ((const float*)buff)[i];
+    case Datatype::FLOAT64:
+      return ((const double*)buff)[i];
+    default:
+      // INT64 and the datetime types
+      return (double)((const int64_t*)buff)[i];
+  }
+}
+
+/** Stores `value` as a value of type `type` in `v`. */
+template <class T>
+void double_to_value(double value, ByteVecValue* v) {
+  auto t = static_cast<T>(value);
+  v->resize(sizeof(T));
+  std::memcpy(&(*v)[0], &t, sizeof(T));
+}
+
+/** Stores `value` as a value of type `type` in `v`. */
+void double_to_value(Datatype type, double value, ByteVecValue* v) {
+  switch (type) {
+    case Datatype::INT8:
+      return double_to_value<int8_t>(value, v);
+    case Datatype::UINT8:
+      return double_to_value<uint8_t>(value, v);
+    case Datatype::INT16:
+      return double_to_value<int16_t>(value, v);
+    case Datatype::UINT16:
+      return double_to_value<uint16_t>(value, v);
+    case Datatype::INT32:
+      return double_to_value<int32_t>(value, v);
+    case Datatype::UINT32:
+      return double_to_value<uint32_t>(value, v);
+    case Datatype::UINT64:
+      return double_to_value<uint64_t>(value, v);
+    default:
+      // INT64 and the datetime types
+      return double_to_value<int64_t>(value, v);
+  }
+}
+
+/**
+ * Returns the length of `[low, high]`, counting cells for integer
+ * dimensions.
+ */
+double range_length(double low, double high, bool integer) {
+  return integer ? high - low + 1 : high - low;
+}
+
+/**
+ * Compares how much two tilings violate the tile size limits (1 means no
+ * violation). Returns a positive value if the first violates the limits
+ * more, negative if less, and zero if equally.
+ */
+int compare_violation(double violation_a, double violation_b) {
+  if (violation_a > violation_b)
+    return 1;
+  if (violation_a < violation_b)
+    return -1;
+  return 0;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TileAdvisor::TileAdvisor(const ArraySchema* array_schema)
+    : array_schema_(array_schema)
+    , cell_num_(0)
+    , min_tile_size_(default_min_tile_size)
+    , max_tile_size_(default_max_tile_size)
+    , tile_overhead_(default_tile_overhead) {
+  assert(array_schema_ != nullptr);
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status TileAdvisor::add_coords(
+    const std::vector<const void*>& coords, uint64_t coords_num) {
+  auto dim_num = array_schema_->dim_num();
+  if (coords.size() != dim_num)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot add coordinates to tile advisor; One buffer per dimension is "
+        "required"));
+  if (coords_num == 0)
+    return Status::Ok();
+
+  if (non_empty_domain_.empty()) {
+    non_empty_domain_.resize(
+        dim_num,
+        std::pair<double, double>(
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::lowest()));
+  }
+
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = array_schema_->dimension(d);
+    if (dim->var_size() || coords[d] == nullptr)
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot add coordinates to tile advisor; Only fixed-sized "
+          "dimensions are supported"));
+    auto type = dim->type();
+    auto& range = non_empty_domain_[d];
+    for (uint64_t i = 0; i < coords_num; ++i) {
+      auto v = value_to_double(type, coords[d], i);
+      range.first = std::min(range.first, v);
+      range.second = std::max(range.second, v);
+    }
+  }
+  cell_num_ += coords_num;
+
+  return Status::Ok();
+}
+
+Status TileAdvisor::add_cells(
+    uint64_t cell_num, const NDRange& non_empty_domain) {
+  auto dim_num = array_schema_->dim_num();
+  if (non_empty_domain.size() != dim_num)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot add cells to tile advisor; Invalid number of dimensions"));
+
+  if (non_empty_domain_.empty()) {
+    non_empty_domain_.resize(
+        dim_num,
+        std::pair<double, double>(
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::lowest()));
+  }
+
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto type = array_schema_->dimension(d)->type();
+    auto low = value_to_double(type, non_empty_domain[d].start(), 0);
+    auto high = value_to_double(type, non_empty_domain[d].end(), 0);
+    non_empty_domain_[d].first = std::min(non_empty_domain_[d].first, low);
+    non_empty_domain_[d].second = std::max(non_empty_domain_[d].second, high);
+  }
+  cell_num_ += cell_num;
+
+  return Status::Ok();
+}
+
+Status TileAdvisor::add_query(const NDRange& subarray) {
+  auto dim_num = array_schema_->dim_num();
+  if (subarray.size() != dim_num)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot add query to tile advisor; Invalid number of dimensions"));
+
+  std::vector<std::pair<double, double>> query(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto type = array_schema_->dimension(d)->type();
+    query[d].first = value_to_double(type, subarray[d].start(), 0);
+    query[d].second = value_to_double(type, subarray[d].end(), 0);
+    if (query[d].first > query[d].second)
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot add query to tile advisor; Range start exceeds range end"));
+  }
+  queries_.emplace_back(std::move(query));
+
+  return Status::Ok();
+}
+
+void TileAdvisor::set_cell_size(const std::string& name, double cell_size) {
+  cell_sizes_[name] = cell_size;
+}
+
+void TileAdvisor::set_compression_ratio(const std::string& name, double ratio) {
+  compression_ratios_[name] = ratio;
+}
+
+void TileAdvisor::set_tile_size_limits(
+    uint64_t min_tile_size, uint64_t max_tile_size) {
+  min_tile_size_ = min_tile_size;
+  max_tile_size_ = std::max(min_tile_size, max_tile_size);
+}
+
+void TileAdvisor::set_tile_overhead(uint64_t tile_overhead) {
+  tile_overhead_ = tile_overhead;
+}
+
+Status TileAdvisor::recommend(Recommendation* rec) const {
+  assert(rec != nullptr);
+  *rec = Recommendation();
+
+  if (array_schema_->dense())
+    RETURN_NOT_OK(recommend_dense(rec));
+  else
+    RETURN_NOT_OK(recommend_sparse(rec));
+
+  filter_notes(rec);
+
+  return Status::Ok();
+}
+
+Status TileAdvisor::evaluate(Recommendation* rec) const {
+  assert(rec != nullptr);
+  *rec = Recommendation();
+  auto domain = array_schema_->domain();
+  auto dim_num = domain->dim_num();
+
+  if (array_schema_->dense()) {
+    if (!domain->all_dims_int())
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot evaluate tiling; Dense arrays must have integer "
+          "dimensions"));
+    std::vector<double> extents(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto type = domain->dimension(d)->type();
+      const auto& extent = domain->tile_extent(d);
+      const auto& r = domain->domain(d);
+      extents[d] =
+          extent.empty() ?
+              range_length(
+                  value_to_double(type, r.start(), 0),
+                  value_to_double(type, r.end(), 0),
+                  true) :
+              value_to_double(type, &extent[0], 0);
+    }
+    dense_cost(extents, rec);
+    rec->capacity_ = array_schema_->capacity();
+  } else {
+    if (cell_num_ == 0 || non_empty_domain_.empty())
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot evaluate tiling; No cells were added to the tile advisor"));
+    sparse_cost(array_schema_->capacity(), rec);
+  }
+  rec->tile_extents_ = domain->tile_extents();
+
+  return Status::Ok();
+}
+
+Status TileAdvisor::apply(const Recommendation& rec, ArraySchema* array_schema) {
+  assert(array_schema != nullptr);
+  auto old_domain = array_schema->domain();
+  auto dim_num = old_domain->dim_num();
+  if (rec.tile_extents_.size() != dim_num)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot apply tile advice; Invalid number of dimensions"));
+
+  if (!array_schema->dense()) {
+    array_schema->set_capacity(rec.capacity_);
+    return Status::Ok();
+  }
+
+  Domain domain;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    Dimension dim(old_domain->dimension(d));
+    RETURN_NOT_OK(dim.set_tile_extent(rec.tile_extents_[d]));
+    RETURN_NOT_OK(domain.add_dimension(&dim));
+  }
+
+  return array_schema->set_domain(&domain);
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+double TileAdvisor::cell_size(const std::string& name) const {
+  auto it = cell_sizes_.find(name);
+  if (it != cell_sizes_.end())
+    return it->second;
+
+  if (array_schema_->var_size(name))
+    return constants::cell_var_offset_size + 8;
+  return array_schema_->cell_size(name);
+}
+
+double TileAdvisor::compression_ratio(const std::string& name) const {
+  auto it = compression_ratios_.find(name);
+  return (it != compression_ratios_.end()) ? it->second : 1.0;
+}
+
+void TileAdvisor::cell_stats(
+    double* raw_cell_size,
+    double* filtered_cell_size,
+    double* max_cell_size,
+    double* tile_metadata_size) const {
+  *raw_cell_size = 0;
+  *filtered_cell_size = 0;
+  *max_cell_size = 0;
+  *tile_metadata_size = 0;
+
+  // Every attribute tile stores an offset and a size in the fragment
+  // metadata, twice for var-sized attributes
+  for (const auto& attr : array_schema_->attributes()) {
+    auto size = cell_size(attr->name());
+    *raw_cell_size += size;
+    *filtered_cell_size += size * compression_ratio(attr->name());
+    *max_cell_size = std::max(*max_cell_size, size);
+    *tile_metadata_size += (attr->var_size() ? 4 : 2) * sizeof(uint64_t);
+  }
+
+  // Sparse arrays also read the coordinates and store an MBR per tile
+  if (!array_schema_->dense()) {
+    auto dim_num = array_schema_->dim_num();
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto dim = array_schema_->dimension(d);
+      double size = dim->coord_size();
+      *raw_cell_size += size;
+      *filtered_cell_size += size * compression_ratio(dim->name());
+      *max_cell_size = std::max(*max_cell_size, size);
+      *tile_metadata_size += 2 * sizeof(uint64_t) + 2 * size;
+    }
+  }
+}
+
+void TileAdvisor::filter_notes(Recommendation* rec) const {
+  for (const auto& attr : array_schema_->attributes()) {
+    const auto& name = attr->name();
+    auto it = compression_ratios_.find(name);
+    if (attr->filters().empty()) {
+      rec->filter_notes_.emplace_back(
+          name,
+          "no filters; a compression filter (e.g., zstd) would reduce the "
+          "bytes read");
+    } else if (it != compression_ratios_.end() && it->second > 0.9) {
+      rec->filter_notes_.emplace_back(
+          name,
+          "filters reduce the tile size by less than 10%; consider a "
+          "byte/bit shuffle before compression, or removing them to save "
+          "the unfiltering time");
+    }
+  }
+}
+
+std::vector<std::vector<std::pair<double, double>>> TileAdvisor::cost_queries()
+    const {
+  if (!queries_.empty())
+    return queries_;
+  return {non_empty_domain_};
+}
+
+Status TileAdvisor::recommend_dense(Recommendation* rec) const {
+  auto domain = array_schema_->domain();
+  auto dim_num = domain->dim_num();
+  if (!domain->all_dims_int())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot recommend tiling; Dense arrays must have integer dimensions"));
+
+  // Compute the full length of each dimension domain
+  std::vector<double> full(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto type = domain->dimension(d)->type();
+    const auto& r = domain->domain(d);
+    full[d] = range_length(
+        value_to_double(type, r.start(), 0),
+        value_to_double(type, r.end(), 0),
+        true);
+  }
+
+  // Start from square-ish tiles of the minimum size
+  double raw_cell_size, filtered_cell_size, max_cell_size, tile_metadata_size;
+  cell_stats(
+      &raw_cell_size, &filtered_cell_size, &max_cell_size, &tile_metadata_size);
+  double start_cells =
+      std::max(1.0, (double)min_tile_size_ / std::max(1.0, max_cell_size));
+  double start_extent =
+      std::exp2(std::ceil(std::log2(std::pow(start_cells, 1.0 / dim_num))));
+  std::vector<double> extents(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d)
+    extents[d] = std::min(full[d], start_extent);
+
+  // Local search over the extents: double, halve or extend to the whole
+  // domain, one dimension at a time, preferring tilings that respect the
+  // tile size limits and then the lowest cost
+  auto violation = [&](const std::vector<double>& e) {
+    double cells = 1;
+    bool all_full = true;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      cells *= e[d];
+      all_full = all_full && e[d] >= full[d];
+    }
+    double size = cells * max_cell_size;
+    if (size > max_tile_size_)
+      return size / max_tile_size_;
+    if (size < min_tile_size_ && !all_full)
+      return min_tile_size_ / std::max(1.0, size);
+    return 1.0;
+  };
+
+  Recommendation cur;
+  double cur_cost = dense_cost(extents, &cur);
+  double cur_violation = violation(extents);
+  for (bool improved = true; improved;) {
+    improved = false;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      double candidates[] = {
+          std::min(full[d], extents[d] * 2),
+          std::max(1.0, std::floor(extents[d] / 2)),
+          full[d]};
+      for (auto c : candidates) {
+        if (c == extents[d])
+          continue;
+        auto e = extents;
+        e[d] = c;
+        Recommendation cand;
+        double cand_cost = dense_cost(e, &cand);
+        double cand_violation = violation(e);
+        int cmp = compare_violation(cand_violation, cur_violation);
+        if (cmp < 0 || (cmp == 0 && cand_cost < cur_cost)) {
+          extents = e;
+          cur = cand;
+          cur_cost = cand_cost;
+          cur_violation = cand_violation;
+          improved = true;
+        }
+      }
+    }
+  }
+
+  *rec = cur;
+  rec->tile_extents_.resize(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d)
+    double_to_value(
+        domain->dimension(d)->type(), extents[d], &rec->tile_extents_[d]);
+  rec->capacity_ = array_schema_->capacity();
+
+  return Status::Ok();
+}
+
+double TileAdvisor::dense_cost(
+    const std::vector<double>& tile_extents, Recommendation* rec) const {
+  auto domain = array_schema_->domain();
+  auto dim_num = domain->dim_num();
+  double raw_cell_size, filtered_cell_size, max_cell_size, tile_metadata_size;
+  cell_stats(
+      &raw_cell_size, &filtered_cell_size, &max_cell_size, &tile_metadata_size);
+
+  // The tiles along a dimension are aligned to the domain start
+  std::vector<double> domain_low(dim_num);
+  std::vector<double> domain_high(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto type = domain->dimension(d)->type();
+    domain_low[d] = value_to_double(type, domain->domain(d).start(), 0);
+    domain_high[d] = value_to_double(type, domain->domain(d).end(), 0);
+  }
+  auto tile_num = [&](const std::vector<std::pair<double, double>>& r) {
+    double num = 1;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto e = tile_extents[d];
+      num *= std::floor((r[d].second - domain_low[d]) / e) -
+             std::floor((r[d].first - domain_low[d]) / e) + 1;
+    }
+    return num;
+  };
+
+  double tile_cell_num = 1;
+  for (auto e : tile_extents)
+    tile_cell_num *= e;
+
+  // Dense fragments cover the non-empty domain, or the whole domain
+  std::vector<std::pair<double, double>> data = non_empty_domain_;
+  if (data.empty()) {
+    for (unsigned d = 0; d < dim_num; ++d)
+      data.emplace_back(domain_low[d], domain_high[d]);
+  }
+  double total_tile_num = tile_num(data);
+
+  rec->tile_cell_num_ = (uint64_t)tile_cell_num;
+  rec->max_tile_size_ = (uint64_t)(tile_cell_num * max_cell_size);
+  rec->tile_num_ = (uint64_t)total_tile_num;
+  rec->metadata_size_ = (uint64_t)(total_tile_num * tile_metadata_size);
+  rec->query_tile_num_.clear();
+  rec->query_bytes_.clear();
+
+  auto queries = queries_;
+  if (queries.empty())
+    queries.push_back(data);
+
+  double cost = rec->metadata_size_;
+  for (const auto& query : queries) {
+    // Crop the query to the data
+    auto q = query;
+    bool empty = false;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      q[d].first = std::max(q[d].first, data[d].first);
+      q[d].second = std::min(q[d].second, data[d].second);
+      empty = empty || q[d].first > q[d].second;
+    }
+    double tiles = empty ? 0 : tile_num(q);
+    double bytes = tiles * tile_cell_num * filtered_cell_size;
+    rec->query_tile_num_.push_back((uint64_t)tiles);
+    rec->query_bytes_.push_back((uint64_t)bytes);
+    cost += bytes + tiles * tile_overhead_;
+  }
+  rec->cost_ = cost;
+
+  return cost;
+}
+
+Status TileAdvisor::recommend_sparse(Recommendation* rec) const {
+  if (cell_num_ == 0 || non_empty_domain_.empty())
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Cannot recommend tiling; No cells were added to the tile advisor"));
+  auto dim_num = array_schema_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (array_schema_->dimension(d)->var_size())
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Cannot recommend tiling; Variable-sized dimensions are not "
+          "supported"));
+  }
+
+  double raw_cell_size, filtered_cell_size, max_cell_size, tile_metadata_size;
+  cell_stats(
+      &raw_cell_size, &filtered_cell_size, &max_cell_size, &tile_metadata_size);
+
+  // Try all powers of 2, preferring capacities that respect the tile
+  // size limits and then the lowest cost
+  bool found = false;
+  double best_cost = 0, best_violation = 0;
+  for (unsigned i = 0; i <= max_capacity_log2; ++i) {
+    uint64_t capacity = uint64_t(1) << i;
+    double size = (double)std::min(capacity, cell_num_) * max_cell_size;
+    double violation = 1.0;
+    if (size > max_tile_size_)
+      violation = size / max_tile_size_;
+    else if (size < min_tile_size_ && capacity < cell_num_)
+      violation = min_tile_size_ / std::max(1.0, size);
+
+    Recommendation cand;
+    double cost = sparse_cost(capacity, &cand);
+    int cmp = compare_violation(violation, best_violation);
+    if (!found || cmp < 0 || (cmp == 0 && cost < best_cost)) {
+      *rec = cand;
+      best_cost = cost;
+      best_violation = violation;
+      found = true;
+    }
+
+    // Larger capacities only add empty space to the single tile
+    if (capacity >= cell_num_)
+      break;
+  }
+
+  rec->tile_extents_ = array_schema_->domain()->tile_extents();
+
+  return Status::Ok();
+}
+
+double TileAdvisor::sparse_cost(uint64_t capacity, Recommendation* rec) const {
+  auto dim_num = array_schema_->dim_num();
+  double raw_cell_size, filtered_cell_size, max_cell_size, tile_metadata_size;
+  cell_stats(
+      &raw_cell_size, &filtered_cell_size, &max_cell_size, &tile_metadata_size);
+
+  // Model the MBRs as hypercubes that evenly partition the data, so that a
+  // query overlaps the MBRs whose centers lie in the query expanded by
+  // one MBR side along each dimension
+  double tile_cell_num = (double)std::min(capacity, cell_num_);
+  double tile_num = std::ceil((double)cell_num_ / capacity);
+  double mbr_side = std::pow(1.0 / tile_num, 1.0 / dim_num);
+
+  rec->capacity_ = capacity;
+  rec->tile_cell_num_ = (uint64_t)tile_cell_num;
+  rec->max_tile_size_ = (uint64_t)(tile_cell_num * max_cell_size);
+  rec->tile_num_ = (uint64_t)tile_num;
+  rec->metadata_size_ = (uint64_t)(tile_num * tile_metadata_size);
+  rec->query_tile_num_.clear();
+  rec->query_bytes_.clear();
+
+  double cost = rec->metadata_size_;
+  for (const auto& query : cost_queries()) {
+    double fraction = 1;
+    for (unsigned d = 0; d < dim_num; ++d) {
+      bool integer =
+          !datatype_is_real(array_schema_->dimension(d)->type());
+      const auto& data = non_empty_domain_[d];
+      double low = std::max(query[d].first, data.first);
+      double high = std::min(query[d].second, data.second);
+      if (low > high) {
+        fraction = 0;
+        break;
+      }
+      double data_len = range_length(data.first, data.second, integer);
+      double q = (data_len > 0) ?
+                     range_length(low, high, integer) / data_len :
+                     1.0;
+      fraction *= std::min(1.0, q + mbr_side);
+    }
+    double tiles = std::min(tile_num, std::ceil(fraction * tile_num));
+    double bytes = tiles * tile_cell_num * filtered_cell_size;
+    rec->query_tile_num_.push_back((uint64_t)tiles);
+    rec->query_bytes_.push_back((uint64_t)bytes);
+    cost += bytes + tiles * tile_overhead_;
+  }
+  rec->cost_ = cost;
+
+  return cost;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,249 @@
+/**
+ * @file   tile_advisor.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileAdvisor.
+ */
+
+#ifndef TILEDB_TILE_ADVISOR_H
+#define TILEDB_TILE_ADVISOR_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/types.h"
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+
+/**
+ * Recommends the dimension tile extents (dense arrays) or the data tile
+ * capacity (sparse arrays) of an array schema, given a sample of the data
+ * and a set of representative query subarrays.
+ *
+ * The data is modeled as uniformly distributed over its non-empty domain.
+ * The cost of a tiling is the number of bytes the queries read from
+ * storage, plus a fixed overhead per tile read (which models the request
+ * latency and the per-tile unfiltering work), plus the size of the fragment
+ * metadata (tile offsets/sizes and MBRs) that is loaded upon opening the
+ * array.
+ */
+class TileAdvisor {
+ public:
+  /* ********************************* */
+  /*         TYPE DEFINITIONS          */
+  /* ********************************* */
+
+  /** A recommended tiling along with its projected costs. */
+  struct Recommendation {
+    /**
+     * The tile extent per dimension. For sparse arrays, these are the
+     * current tile extents of the schema.
+     */
+    std::vector<ByteVecValue> tile_extents_;
+    /** The data tile capacity (sparse arrays only). */
+    uint64_t capacity_ = 0;
+    /** The number of cells per data tile. */
+    uint64_t tile_cell_num_ = 0;
+    /** The uncompressed size of the largest attribute/dimension tile. */
+    uint64_t max_tile_size_ = 0;
+    /** The projected number of data tiles of the array. */
+    uint64_t tile_num_ = 0;
+    /** The projected size of the fragment metadata in bytes. */
+    uint64_t metadata_size_ = 0;
+    /** The projected number of data tiles read by each query. */
+    std::vector<uint64_t> query_tile_num_;
+    /** The projected number of bytes read by each query. */
+    std::vector<uint64_t> query_bytes_;
+    /** The projected total cost (see the class description), in bytes. */
+    double cost_ = 0;
+    /** Filter suggestions as (attribute, suggestion) pairs. */
+    std::vector<std::pair<std::string, std::string>> filter_notes_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param array_schema The schema to advise on. It must outlive the advisor.
+   */
+  explicit TileAdvisor(const ArraySchema* array_schema);
+
+  /** Destructor. */
+  ~TileAdvisor() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Adds a sample of coordinates, e.g., from a representative write buffer.
+   *
+   * @param coords One buffer per dimension, each holding `coords_num`
+   *     fixed-sized coordinates.
+   * @param coords_num The number of coordinates in each buffer.
+   * @return Status
+   */
+  Status add_coords(
+      const std::vector<const void*>& coords, uint64_t coords_num);
+
+  /**
+   * Adds `cell_num` cells spread over `non_empty_domain`, e.g., from the
+   * metadata of an existing fragment.
+   */
+  Status add_cells(uint64_t cell_num, const NDRange& non_empty_domain);
+
+  /** Adds a representative query subarray (one range per dimension). */
+  Status add_query(const NDRange& subarray);
+
+  /**
+   * Sets the average size in bytes of a cell of the input attribute or
+   * dimension, as measured on the data. By default, this is the cell size
+   * of the schema, or the offset size plus 8 bytes for var-sized attributes.
+   */
+  void set_cell_size(const std::string& name, double cell_size);
+
+  /**
+   * Sets the ratio of the persisted (filtered) to the in-memory size of
+   * the tiles of the input attribute or dimension. The default is 1.
+   */
+  void set_compression_ratio(const std::string& name, double ratio);
+
+  /**
+   * Sets the range of acceptable uncompressed tile sizes, applied to the
+   * largest attribute/dimension tile.
+   */
+  void set_tile_size_limits(uint64_t min_tile_size, uint64_t max_tile_size);
+
+  /** Sets the fixed cost in bytes charged for every tile read. */
+  void set_tile_overhead(uint64_t tile_overhead);
+
+  /** Computes the recommended tiling. */
+  Status recommend(Recommendation* rec) const;
+
+  /**
+   * Computes the projected costs of the current tiling of the schema, for
+   * comparison with the recommended one.
+   */
+  Status evaluate(Recommendation* rec) const;
+
+  /**
+   * Applies a recommendation on the input schema, which must have the same
+   * dimensions as the schema of the advisor.
+   */
+  static Status apply(const Recommendation& rec, ArraySchema* array_schema);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The array schema. */
+  const ArraySchema* array_schema_;
+
+  /** The number of sampled cells. */
+  uint64_t cell_num_;
+
+  /** The non-empty domain of the sampled cells, as `[low, high]` pairs. */
+  std::vector<std::pair<double, double>> non_empty_domain_;
+
+  /** The query subarrays, as `[low, high]` pairs per dimension. */
+  std::vector<std::vector<std::pair<double, double>>> queries_;
+
+  /** Measured cell sizes per attribute/dimension. */
+  std::map<std::string, double> cell_sizes_;
+
+  /** Measured compression ratios per attribute/dimension. */
+  std::map<std::string, double> compression_ratios_;
+
+  /** The minimum acceptable tile size. */
+  uint64_t min_tile_size_;
+
+  /** The maximum acceptable tile size. */
+  uint64_t max_tile_size_;
+
+  /** The fixed cost in bytes of reading a tile. */
+  uint64_t tile_overhead_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the cell size of the input attribute/dimension. */
+  double cell_size(const std::string& name) const;
+
+  /** Returns the compression ratio of the input attribute/dimension. */
+  double compression_ratio(const std::string& name) const;
+
+  /**
+   * Computes the size in bytes of a cell over all attributes (and the
+   * dimensions for sparse arrays), before and after filtering, as well as
+   * the size of the largest attribute/dimension cell and the fragment
+   * metadata size per tile.
+   */
+  void cell_stats(
+      double* raw_cell_size,
+      double* filtered_cell_size,
+      double* max_cell_size,
+      double* tile_metadata_size) const;
+
+  /** Adds the filter suggestions to the recommendation. */
+  void filter_notes(Recommendation* rec) const;
+
+  /** Computes the recommendation for dense arrays. */
+  Status recommend_dense(Recommendation* rec) const;
+
+  /** Computes the recommendation for sparse arrays. */
+  Status recommend_sparse(Recommendation* rec) const;
+
+  /**
+   * Computes the cost of the input dense tile extents, filling in the
+   * costs of `rec` (but not its extents).
+   */
+  double dense_cost(
+      const std::vector<double>& tile_extents, Recommendation* rec) const;
+
+  /** Computes the cost of the input sparse capacity, filling in `rec`. */
+  double sparse_cost(uint64_t capacity, Recommendation* rec) const;
+
+  /** Returns the subarrays to cost, i.e., the queries or the whole data. */
+  std::vector<std::vector<std::pair<double, double>>> cost_queries() const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_ADVISOR_H
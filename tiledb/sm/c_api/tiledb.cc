@@ -40,6 +40,7 @@
 #include "tiledb/sm/config/config_iter.h"
 #include "tiledb/sm/cpp_api/core_interface.h"
 #include "tiledb/sm/enums/array_type.h"
+#include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/enums/filesystem.h"
 #include "tiledb/sm/enums/filter_option.h"
@@ -1283,6 +1284,94 @@ int32_t tiledb_filter_get_option(
   return TILEDB_OK;
 }
 
+/**
+ * Returns the compression filter wrapped by `filter`, or `nullptr` (saving
+ * an error on the context) if it is not a ZStd filter.
+ */
+static tiledb::sm::CompressionFilter* zstd_filter(
+    tiledb_ctx_t* ctx, tiledb_filter_t* filter) {
+  auto compression =
+      dynamic_cast<tiledb::sm::CompressionFilter*>(filter->filter_);
+  if (compression == nullptr ||
+      compression->compressor() != tiledb::sm::Compressor::ZSTD) {
+    auto st = tiledb::sm::Status::FilterError(
+        "Dictionaries are only supported by the ZStd filter");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return nullptr;
+  }
+  return compression;
+}
+
+int32_t tiledb_filter_set_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* dictionary,
+    uint64_t dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = zstd_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, compression->set_dictionary(dictionary, dictionary_size)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_get_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** dictionary,
+    uint64_t* dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = zstd_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  auto dict = compression->dictionary();
+  *dictionary = (dict == nullptr) ? nullptr : dict->data().data();
+  *dictionary_size = (dict == nullptr) ? 0 : dict->data().size();
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_train_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* samples,
+    const uint64_t* sample_sizes,
+    uint64_t sample_num,
+    uint64_t dictionary_capacity) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = zstd_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  std::vector<uint64_t> sizes;
+  if (sample_sizes != nullptr)
+    sizes.assign(sample_sizes, sample_sizes + sample_num);
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          compression->train_dictionary(samples, sizes, dictionary_capacity)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
 /* ********************************* */
 /*            FILTER LIST            */
 /* ********************************* */
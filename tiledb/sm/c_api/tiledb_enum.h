@@ -163,6 +163,16 @@
     TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_MD5) = 12,
     /** SHA256 checksum filter. */
     TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_SHA256) = 13,
+    /** Dictionary encoding filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_DICTIONARY) = 14,
+    /** Delta and bit-packing filter for var-sized offsets. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_OFFSETS_DELTA) = 15,
+    /** Patched frame-of-reference bit-packing filter for integers. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_FRAME_OF_REFERENCE) = 16,
+    /** Gorilla-style XOR encoding filter for floating point values. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_XOR) = 17,
+    /** CRC32C checksum filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_CHECKSUM_CRC32C) = 18,
 #endif
 
 #ifdef TILEDB_FILTER_OPTION_ENUM
@@ -33,6 +33,7 @@
 #include "tiledb/sm/cache/lru_cache.h"
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/memory_broker.h"
 #include "tiledb/sm/misc/stats.h"
 
 #include <cassert>
@@ -53,6 +54,7 @@ LRUCache::LRUCache(
   evict_callback_ = evict_callback;
   evict_callback_data_ = evict_callback_data;
   max_size_ = max_size;
+  memory_broker_ = nullptr;
   size_ = 0;
 }
 
@@ -72,6 +74,10 @@ void LRUCache::clear() {
       (*evict_callback_)(&item, evict_callback_data_);
   }
   item_ll_.clear();
+  item_map_.clear();
+  if (memory_broker_ != nullptr)
+    memory_broker_->release(size_);
+  size_ = 0;
 }
 
 Status LRUCache::insert(
@@ -101,6 +107,21 @@ Status LRUCache::insert(
   while (size_ + size > max_size_)
     evict();
 
+  // Reserve the object memory, evicting older objects to make room
+  if (memory_broker_ != nullptr) {
+    while (!memory_broker_->try_reserve(size, false)) {
+      if (item_ll_.empty()) {
+        std::free(object);
+        return Status::Ok();
+      }
+      evict();
+    }
+  }
+
+  // The existing item may have been evicted
+  item_it = item_map_.find(key);
+  exists = item_it != item_map_.end();
+
   // Key exists
   if (exists) {
     // Replace cache item
@@ -110,6 +131,9 @@ Status LRUCache::insert(
       std::free(item.object_);
     else
       (*evict_callback_)(&item, evict_callback_data_);
+    if (memory_broker_ != nullptr)
+      memory_broker_->release(item.size_);
+    size_ -= item.size_;
     item.object_ = object;
     item.size_ = size;
 
@@ -240,6 +264,20 @@ Status LRUCache::read(
   STATS_FUNC_OUT(cache_lru_read_partial);
 }
 
+void LRUCache::reclaim(uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock{mtx_};
+  uint64_t freed = 0;
+  while (freed < nbytes && !item_ll_.empty()) {
+    freed += item_ll_.front().size_;
+    evict();
+  }
+}
+
+void LRUCache::set_memory_broker(MemoryBroker* memory_broker) {
+  std::lock_guard<std::mutex> lock{mtx_};
+  memory_broker_ = memory_broker;
+}
+
 std::list<LRUCache::LRUCacheItem>::const_iterator LRUCache::item_iter_begin()
     const {
   return item_ll_.begin();
@@ -266,6 +304,8 @@ void LRUCache::evict() {
     (*evict_callback_)(&item, evict_callback_data_);
   item_map_.erase(item.key_);
   size_ -= item.size_;
+  if (memory_broker_ != nullptr)
+    memory_broker_->release(item.size_);
   item_ll_.pop_front();
 
   STATS_FUNC_VOID_OUT(cache_lru_evict);
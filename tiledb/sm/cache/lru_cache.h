@@ -43,6 +43,7 @@ namespace tiledb {
 namespace sm {
 
 class Buffer;
+class MemoryBroker;
 
 /**
  * Implements an LRU cache of opaque (`void*`) objects that can be located via
@@ -170,6 +171,19 @@ class LRUCache {
       uint64_t nbytes,
       bool* success);
 
+  /**
+   * Evicts objects until at least `nbytes` bytes are freed, or the cache
+   * is empty.
+   */
+  void reclaim(uint64_t nbytes);
+
+  /**
+   * Sets the broker on which the memory of the cached objects is reserved.
+   * When the broker has no memory available, inserted objects evict older
+   * ones, or are not cached at all.
+   */
+  void set_memory_broker(MemoryBroker* memory_broker);
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
@@ -196,6 +210,9 @@ class LRUCache {
   /** The maximum cache size. */
   uint64_t max_size_;
 
+  /** The broker the cached objects are reserved on (may be null). */
+  MemoryBroker* memory_broker_;
+
   /** The mutex for thread-safety. */
   std::mutex mtx_;
 
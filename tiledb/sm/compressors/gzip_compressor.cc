@@ -43,6 +43,63 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * A zlib stream reused across the calls of a thread, which avoids
+ * reallocating the stream state (about 256KB for deflate) for every chunk.
+ */
+struct ThreadStream {
+  /** The zlib stream. */
+  z_stream strm_;
+  /** `true` if `strm_` has been initialized. */
+  bool init_ = false;
+  /** `true` if `strm_` is a deflate stream, `false` for inflate. */
+  bool deflate_;
+  /** The compression level of a deflate stream. */
+  int level_ = 0;
+
+  explicit ThreadStream(bool deflate)
+      : deflate_(deflate) {
+  }
+
+  ~ThreadStream() {
+    end();
+  }
+
+  /** Frees the stream state. */
+  void end() {
+    if (init_)
+      (void)(deflate_ ? deflateEnd(&strm_) : inflateEnd(&strm_));
+    init_ = false;
+  }
+
+  /** Prepares the stream for a new compression/decompression. */
+  int reset(int level) {
+    // A deflate stream is reinitialized when the level changes
+    if (init_ && deflate_ && level != level_)
+      end();
+
+    if (init_) {
+      STATS_COUNTER_ADD(compressor_contexts_reused, 1);
+      return deflate_ ? deflateReset(&strm_) : inflateReset(&strm_);
+    }
+
+    STATS_COUNTER_ADD(compressor_contexts_created, 1);
+    strm_.zalloc = Z_NULL;
+    strm_.zfree = Z_NULL;
+    strm_.opaque = Z_NULL;
+    strm_.avail_in = 0;
+    strm_.next_in = Z_NULL;
+    int ret = deflate_ ? deflateInit(&strm_, level) : inflateInit(&strm_);
+    init_ = (ret == Z_OK);
+    level_ = level;
+    return ret;
+  }
+};
+
+}  // namespace
+
 Status GZip::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   STATS_FUNC_IN(compressor_gzip_compress);
@@ -52,33 +109,27 @@ Status GZip::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with GZip; invalid buffer format"));
 
-  int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, level < 0 ? GZip::default_level() : level);
-
+  // Get the deflate state of this thread
+  static thread_local ThreadStream stream(true);
+  int ret = stream.reset(level < 0 ? GZip::default_level() : level);
   if (ret != Z_OK) {
-    (void)deflateEnd(&strm);
+    stream.end();
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
   }
 
   // Compress
+  z_stream& strm = stream.strm_;
   strm.next_in = (unsigned char*)input_buffer->data();
   strm.next_out = (unsigned char*)output_buffer->cur_data();
   strm.avail_in = (uInt)input_buffer->size();
   strm.avail_out = (uInt)output_buffer->free_space();
   ret = deflate(&strm, Z_FINISH);
 
-  // Clean up
-  (void)deflateEnd(&strm);
-
   // Return
-  if (ret == Z_STREAM_ERROR || strm.avail_in != 0)
+  if (ret == Z_STREAM_ERROR || strm.avail_in != 0) {
+    stream.end();
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
+  }
 
   // Set size of compressed data
   uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
@@ -99,22 +150,16 @@ Status GZip::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with GZip; invalid buffer format"));
 
-  int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = inflateInit(&strm);
-
+  // Get the inflate state of this thread
+  static thread_local ThreadStream stream(false);
+  int ret = stream.reset(0);
   if (ret != Z_OK) {
+    stream.end();
     return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
   }
 
   // Decompress
+  z_stream& strm = stream.strm_;
   strm.next_in = (unsigned char*)input_buffer->data();
   strm.next_out = (unsigned char*)output_buffer->cur_data();
   strm.avail_in = (uInt)input_buffer->size();
@@ -122,6 +167,7 @@ Status GZip::decompress(
   ret = inflate(&strm, Z_FINISH);
 
   if (ret != Z_STREAM_END) {
+    stream.end();
     return LOG_STATUS(
         Status::GZipError("Cannot decompress with GZIP, Stream Error"));
   }
@@ -130,9 +176,6 @@ Status GZip::decompress(
   uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
   output_buffer->advance_offset(compressed_size);
 
-  // Clean up
-  (void)inflateEnd(&strm);
-
   // Success
   return Status::Ok();
 
@@ -37,14 +37,95 @@
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
 
+#include <zdict.h>
 #include <zstd.h>
 #include <iostream>
+#include <memory>
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * Returns the compression context of the calling thread, creating it upon
+ * the first call. Reusing the context avoids reallocating its (large)
+ * internal state for every chunk.
+ */
+ZSTD_CCtx* thread_cctx() {
+  static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(
+      nullptr, ZSTD_freeCCtx);
+  if (ctx == nullptr) {
+    ctx.reset(ZSTD_createCCtx());
+    STATS_COUNTER_ADD(compressor_contexts_created, 1);
+  } else {
+    STATS_COUNTER_ADD(compressor_contexts_reused, 1);
+  }
+  return ctx.get();
+}
+
+/** Returns the decompression context of the calling thread. */
+ZSTD_DCtx* thread_dctx() {
+  static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(
+      nullptr, ZSTD_freeDCtx);
+  if (ctx == nullptr) {
+    ctx.reset(ZSTD_createDCtx());
+    STATS_COUNTER_ADD(compressor_contexts_created, 1);
+  } else {
+    STATS_COUNTER_ADD(compressor_contexts_reused, 1);
+  }
+  return ctx.get();
+}
+
+}  // namespace
+
+/* ****************************** */
+/*           DICTIONARY           */
+/* ****************************** */
+
+ZStd::Dictionary::Dictionary(const void* data, uint64_t size)
+    : data_((const uint8_t*)data, (const uint8_t*)data + size)
+    , ddict_(nullptr) {
+}
+
+ZStd::Dictionary::~Dictionary() {
+  for (auto& it : cdicts_)
+    ZSTD_freeCDict(it.second);
+  ZSTD_freeDDict(ddict_);
+}
+
+const std::vector<uint8_t>& ZStd::Dictionary::data() const {
+  return data_;
+}
+
+const ZSTD_CDict* ZStd::Dictionary::cdict(int level) const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = cdicts_.find(level);
+  if (it != cdicts_.end())
+    return it->second;
+
+  auto cdict = ZSTD_createCDict(data_.data(), data_.size(), level);
+  if (cdict != nullptr)
+    cdicts_[level] = cdict;
+  return cdict;
+}
+
+const ZSTD_DDict* ZStd::Dictionary::ddict() const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (ddict_ == nullptr)
+    ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+  return ddict_;
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
 Status ZStd::compress(
-    int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
+    int level,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer,
+    const Dictionary* dictionary) {
   STATS_FUNC_IN(compressor_zstd_compress);
 
   // Sanity check
@@ -52,21 +133,36 @@ Status ZStd::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
-  // Create context
-  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(
-      ZSTD_createCCtx(), ZSTD_freeCCtx);
-  if (ctx.get() == nullptr)
+  // Get the context of this thread
+  ZSTD_CCtx* ctx = thread_cctx();
+  if (ctx == nullptr)
     return LOG_STATUS(Status::CompressionError(
         std::string("ZStd compression failed; could not allocate context.")));
 
   // Compress
-  uint64_t zstd_ret = ZSTD_compressCCtx(
-      ctx.get(),
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size(),
-      level < 0 ? ZStd::default_level() : level);
+  level = level < 0 ? ZStd::default_level() : level;
+  uint64_t zstd_ret;
+  if (dictionary != nullptr) {
+    auto cdict = dictionary->cdict(level);
+    if (cdict == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd compression failed; could not digest dictionary."));
+    zstd_ret = ZSTD_compress_usingCDict(
+        ctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        cdict);
+  } else {
+    zstd_ret = ZSTD_compressCCtx(
+        ctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        level);
+  }
 
   // Handle error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -85,7 +181,9 @@ Status ZStd::compress(
 }
 
 Status ZStd::decompress(
-    ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer) {
+    ConstBuffer* input_buffer,
+    PreallocatedBuffer* output_buffer,
+    const Dictionary* dictionary) {
   STATS_FUNC_IN(compressor_zstd_decompress);
 
   // Sanity check
@@ -93,20 +191,34 @@ Status ZStd::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
-  // Create context
-  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(
-      ZSTD_createDCtx(), ZSTD_freeDCtx);
-  if (ctx.get() == nullptr)
+  // Get the context of this thread
+  ZSTD_DCtx* ctx = thread_dctx();
+  if (ctx == nullptr)
     return LOG_STATUS(Status::CompressionError(
         std::string("ZStd decompression failed; could not allocate context.")));
 
   // Decompress
-  uint64_t zstd_ret = ZSTD_decompressDCtx(
-      ctx.get(),
-      output_buffer->cur_data(),
-      output_buffer->free_space(),
-      input_buffer->data(),
-      input_buffer->size());
+  uint64_t zstd_ret;
+  if (dictionary != nullptr) {
+    auto ddict = dictionary->ddict();
+    if (ddict == nullptr)
+      return LOG_STATUS(Status::CompressionError(
+          "ZStd decompression failed; could not digest dictionary."));
+    zstd_ret = ZSTD_decompress_usingDDict(
+        ctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size(),
+        ddict);
+  } else {
+    zstd_ret = ZSTD_decompressDCtx(
+        ctx,
+        output_buffer->cur_data(),
+        output_buffer->free_space(),
+        input_buffer->data(),
+        input_buffer->size());
+  }
 
   // Check error
   if (ZSTD_isError(zstd_ret) != 0) {
@@ -123,6 +235,36 @@ Status ZStd::decompress(
   STATS_FUNC_OUT(compressor_zstd_decompress);
 }
 
+Status ZStd::train_dictionary(
+    const void* samples,
+    const std::vector<uint64_t>& sample_sizes,
+    uint64_t capacity,
+    std::vector<uint8_t>* dictionary) {
+  if (samples == nullptr || sample_sizes.empty() || capacity == 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot train ZStd dictionary; no samples or zero capacity"));
+
+  std::vector<size_t> sizes(sample_sizes.begin(), sample_sizes.end());
+  dictionary->resize(capacity);
+  uint64_t zstd_ret = ZDICT_trainFromBuffer(
+      dictionary->data(),
+      dictionary->size(),
+      samples,
+      sizes.data(),
+      (unsigned)sizes.size());
+
+  if (ZDICT_isError(zstd_ret) != 0) {
+    dictionary->clear();
+    const char* msg = ZDICT_getErrorName(zstd_ret);
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd dictionary training failed: ") + msg));
+  }
+
+  dictionary->resize(zstd_ret);
+
+  return Status::Ok();
+}
+
 uint64_t ZStd::overhead(uint64_t nbytes) {
   return ZSTD_compressBound(nbytes) - nbytes;
 }
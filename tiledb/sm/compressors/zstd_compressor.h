@@ -33,8 +33,16 @@
 #ifndef TILEDB_ZSTD_H
 #define TILEDB_ZSTD_H
 
+#include "tiledb/sm/misc/macros.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace tiledb {
 namespace sm {
 
@@ -45,26 +53,98 @@ class PreallocatedBuffer;
 /** Handles compression/decompression with the zstd library. */
 class ZStd {
  public:
+  /**
+   * A compression dictionary. Its digested forms, which are expensive to
+   * build, are created upon first use and then shared by all threads.
+   */
+  class Dictionary {
+   public:
+    /**
+     * Constructor.
+     *
+     * @param data The dictionary bytes (copied).
+     * @param size The dictionary size.
+     */
+    Dictionary(const void* data, uint64_t size);
+
+    /** Destructor. */
+    ~Dictionary();
+
+    DISABLE_COPY_AND_COPY_ASSIGN(Dictionary);
+    DISABLE_MOVE_AND_MOVE_ASSIGN(Dictionary);
+
+    /** Returns the dictionary bytes. */
+    const std::vector<uint8_t>& data() const;
+
+    /**
+     * Returns the digested compression dictionary for the input level,
+     * or `nullptr` if it could not be created.
+     */
+    const ZSTD_CDict_s* cdict(int level) const;
+
+    /**
+     * Returns the digested decompression dictionary, or `nullptr` if it
+     * could not be created.
+     */
+    const ZSTD_DDict_s* ddict() const;
+
+   private:
+    /** The dictionary bytes. */
+    std::vector<uint8_t> data_;
+
+    /** Protects the lazily created digested dictionaries. */
+    mutable std::mutex mtx_;
+
+    /** The digested compression dictionaries, per compression level. */
+    mutable std::map<int, ZSTD_CDict_s*> cdicts_;
+
+    /** The digested decompression dictionary. */
+    mutable ZSTD_DDict_s* ddict_;
+  };
+
   /**
    * Compression function.
    *
    * @param level Compression level.
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write to the compressed data.
+   * @param dictionary The dictionary to compress with (optional).
    * @return Status
    */
   static Status compress(
-      int level, ConstBuffer* input_buffer, Buffer* output_buffer);
+      int level,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer,
+      const Dictionary* dictionary = nullptr);
 
   /**
    * Decompression function.
    *
    * @param input_buffer Input buffer to read from.
    * @param output_buffer Output buffer to write the decompressed data to.
+   * @param dictionary The dictionary the input was compressed with, if any.
    * @return Status
    */
   static Status decompress(
-      ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer);
+      ConstBuffer* input_buffer,
+      PreallocatedBuffer* output_buffer,
+      const Dictionary* dictionary = nullptr);
+
+  /**
+   * Trains a dictionary on a set of samples, which should be representative
+   * of the parts the dictionary will compress (e.g., tile chunks).
+   *
+   * @param samples The concatenated samples.
+   * @param sample_sizes The size of each sample.
+   * @param capacity The maximum size of the dictionary.
+   * @param dictionary The trained dictionary.
+   * @return Status
+   */
+  static Status train_dictionary(
+      const void* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t capacity,
+      std::vector<uint8_t>* dictionary);
 
   /** Returns the default compression level. */
   static int default_level() {
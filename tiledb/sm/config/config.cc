@@ -56,8 +56,18 @@ const std::string Config::SM_CHECK_COORD_DUPS = "true";
 const std::string Config::SM_CHECK_COORD_OOB = "true";
 const std::string Config::SM_CHECK_GLOBAL_ORDER = "true";
 const std::string Config::SM_TILE_CACHE_SIZE = "10000000";
+const std::string Config::SM_FRAGMENT_METADATA_CACHE_SIZE = "10000000";
+const std::string Config::SM_QUERY_RESULT_CACHE_SIZE = "0";
 const std::string Config::SM_MEMORY_BUDGET = "5368709120";       // 5GB
 const std::string Config::SM_MEMORY_BUDGET_VAR = "10737418240";  // 10GB;
+const std::string Config::SM_MEMORY_LIMIT = "0";
+const std::string Config::SM_MEMORY_LIMIT_POLICY = "block";
+const std::string Config::SM_READ_AHEAD = "false";
+const std::string Config::SM_CONCURRENT_PARTITIONS = "1";
+const std::string Config::SM_EST_RESULT_SIZE_MODE = "fast";
+const std::string Config::SM_VAR_OFFSETS_BITSIZE = "64";
+const std::string Config::SM_CHECKSUM_VERIFY_SAMPLE_RATE = "1.0";
+const std::string Config::SM_CHECKSUM_SKIP_ON_CACHE_HIT = "false";
 const std::string Config::SM_ENABLE_SIGNAL_HANDLERS = "true";
 const std::string Config::SM_NUM_ASYNC_THREADS = "1";
 const std::string Config::SM_NUM_READER_THREADS = "1";
@@ -149,8 +159,21 @@ Config::Config() {
   param_values_["sm.check_coord_oob"] = SM_CHECK_COORD_OOB;
   param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  param_values_["sm.fragment_metadata_cache_size"] =
+      SM_FRAGMENT_METADATA_CACHE_SIZE;
+  param_values_["sm.query_result_cache_size"] = SM_QUERY_RESULT_CACHE_SIZE;
   param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
   param_values_["sm.memory_budget_var"] = SM_MEMORY_BUDGET_VAR;
+  param_values_["sm.memory_limit"] = SM_MEMORY_LIMIT;
+  param_values_["sm.memory_limit_policy"] = SM_MEMORY_LIMIT_POLICY;
+  param_values_["sm.read_ahead"] = SM_READ_AHEAD;
+  param_values_["sm.concurrent_partitions"] = SM_CONCURRENT_PARTITIONS;
+  param_values_["sm.est_result_size_mode"] = SM_EST_RESULT_SIZE_MODE;
+  param_values_["sm.var_offsets.bitsize"] = SM_VAR_OFFSETS_BITSIZE;
+  param_values_["sm.checksum.verify_sample_rate"] =
+      SM_CHECKSUM_VERIFY_SAMPLE_RATE;
+  param_values_["sm.checksum.skip_on_cache_hit"] =
+      SM_CHECKSUM_SKIP_ON_CACHE_HIT;
   param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   param_values_["sm.num_async_threads"] = SM_NUM_ASYNC_THREADS;
   param_values_["sm.num_reader_threads"] = SM_NUM_READER_THREADS;
@@ -350,10 +373,33 @@ Status Config::unset(const std::string& param) {
     param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   } else if (param == "sm.tile_cache_size") {
     param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    param_values_["sm.fragment_metadata_cache_size"] =
+        SM_FRAGMENT_METADATA_CACHE_SIZE;
+  } else if (param == "sm.query_result_cache_size") {
+    param_values_["sm.query_result_cache_size"] = SM_QUERY_RESULT_CACHE_SIZE;
   } else if (param == "sm.memory_budget") {
     param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
   } else if (param == "sm.memory_budget_var") {
     param_values_["sm.memory_budget_var"] = SM_MEMORY_BUDGET_VAR;
+  } else if (param == "sm.memory_limit") {
+    param_values_["sm.memory_limit"] = SM_MEMORY_LIMIT;
+  } else if (param == "sm.memory_limit_policy") {
+    param_values_["sm.memory_limit_policy"] = SM_MEMORY_LIMIT_POLICY;
+  } else if (param == "sm.read_ahead") {
+    param_values_["sm.read_ahead"] = SM_READ_AHEAD;
+  } else if (param == "sm.concurrent_partitions") {
+    param_values_["sm.concurrent_partitions"] = SM_CONCURRENT_PARTITIONS;
+  } else if (param == "sm.est_result_size_mode") {
+    param_values_["sm.est_result_size_mode"] = SM_EST_RESULT_SIZE_MODE;
+  } else if (param == "sm.var_offsets.bitsize") {
+    param_values_["sm.var_offsets.bitsize"] = SM_VAR_OFFSETS_BITSIZE;
+  } else if (param == "sm.checksum.verify_sample_rate") {
+    param_values_["sm.checksum.verify_sample_rate"] =
+        SM_CHECKSUM_VERIFY_SAMPLE_RATE;
+  } else if (param == "sm.checksum.skip_on_cache_hit") {
+    param_values_["sm.checksum.skip_on_cache_hit"] =
+        SM_CHECKSUM_SKIP_ON_CACHE_HIT;
   } else if (param == "sm.enable_signal_handlers") {
     param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   } else if (param == "sm.num_async_threads") {
@@ -510,10 +556,46 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.query_result_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget_var") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.memory_limit") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.memory_limit_policy") {
+    if (value != "block" && value != "shrink" && value != "fail")
+      return LOG_STATUS(Status::ConfigError(
+          "Invalid memory limit policy parameter value; must be 'block', "
+          "'shrink' or 'fail'"));
+  } else if (param == "sm.read_ahead") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
+  } else if (param == "sm.concurrent_partitions") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
+    if (v32 == 0)
+      return LOG_STATUS(Status::ConfigError(
+          "Invalid concurrent partitions parameter value; must be positive"));
+  } else if (param == "sm.est_result_size_mode") {
+    if (value != "fast" && value != "tight")
+      return LOG_STATUS(Status::ConfigError(
+          "Invalid estimated result size mode parameter value; must be "
+          "'fast' or 'tight'"));
+  } else if (param == "sm.var_offsets.bitsize") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
+    if (v32 != 32 && v32 != 64)
+      return LOG_STATUS(Status::ConfigError(
+          "Invalid offsets bitsize parameter value; must be 32 or 64"));
+  } else if (param == "sm.checksum.verify_sample_rate") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vf));
+    if (!(vf >= 0.0f && vf <= 1.0f))
+      return LOG_STATUS(Status::ConfigError(
+          "Invalid checksum verify sample rate parameter value; must be in "
+          "[0, 1]"));
+  } else if (param == "sm.checksum.skip_on_cache_hit") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.enable_signal_handlers") {
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.num_async_threads") {
@@ -90,6 +90,18 @@ class Config {
   /** The tile cache size. */
   static const std::string SM_TILE_CACHE_SIZE;
 
+  /**
+   * The size of the cache of fragment metadata sections, which outlives the
+   * open arrays.
+   */
+  static const std::string SM_FRAGMENT_METADATA_CACHE_SIZE;
+
+  /**
+   * The size of the cache of the results of complete read queries. Zero
+   * disables the cache.
+   */
+  static const std::string SM_QUERY_RESULT_CACHE_SIZE;
+
   /**
    * The maximum memory budget for producing the result (in bytes)
    * for a fixed-sized attribute or the offsets of a var-sized attribute.
@@ -102,6 +114,55 @@ class Config {
    */
   static const std::string SM_MEMORY_BUDGET_VAR;
 
+  /**
+   * The maximum memory in bytes reserved at any time by the queries, the
+   * consolidator and the tile cache of a context. Zero means unlimited.
+   */
+  static const std::string SM_MEMORY_LIMIT;
+
+  /**
+   * What a reservation does when it exceeds `sm.memory_limit`: `block`,
+   * `shrink` or `fail`.
+   */
+  static const std::string SM_MEMORY_LIMIT_POLICY;
+
+  /**
+   * If `true`, incomplete reads fetch the tiles of the next subarray
+   * partition in the background, while the results are consumed.
+   */
+  static const std::string SM_READ_AHEAD;
+
+  /**
+   * The maximum number of subarray partitions a read processes in
+   * parallel, when their estimated results fit in the user buffers.
+   */
+  static const std::string SM_CONCURRENT_PARTITIONS;
+
+  /**
+   * The mode of the result size estimation of reads: `fast` (from the
+   * fragment metadata) or `tight` (upper bounds computed from the
+   * coordinates of the partially overlapping sparse tiles).
+   */
+  static const std::string SM_EST_RESULT_SIZE_MODE;
+
+  /**
+   * The size in bits of the var-sized attribute offsets returned to the user
+   * upon reads. It can be 32 or 64.
+   */
+  static const std::string SM_VAR_OFFSETS_BITSIZE;
+
+  /**
+   * The fraction of the tiles read whose checksums are verified by the
+   * checksum filters, in [0, 1].
+   */
+  static const std::string SM_CHECKSUM_VERIFY_SAMPLE_RATE;
+
+  /**
+   * If `true`, the checksums of tiles served by the tile cache are not
+   * verified.
+   */
+  static const std::string SM_CHECKSUM_SKIP_ON_CACHE_HIT;
+
   /** Whether or not the signal handlers are installed. */
   static const std::string SM_ENABLE_SIGNAL_HANDLERS;
 
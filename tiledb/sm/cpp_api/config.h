@@ -245,9 +245,19 @@ class Config {
    * <br>
    *    **Default**: 10,000,000
    * - `sm.fragment_metadata_cache_size` <br>
-   *    The fragment metadata cache size in bytes. Any `uint64_t` value is
-   *    acceptable. <br>
+   *    The fragment metadata cache size in bytes. The cache holds the
+   *    footers, R-trees and tile offsets of the fragments (except for
+   *    encrypted arrays) even after the arrays are closed, evicting the least
+   *    recently used. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.query_result_cache_size` <br>
+   *    The query result cache size in bytes. The cache holds the results of
+   *    read queries that completed in a single submission, keyed by the
+   *    array, its open fragments, the subarray ranges, the
+   *    attributes/dimensions and the layout. Identical later reads copy the
+   *    cached results into the user buffers, if they fit. `0` disables the
+   *    cache. <br>
+   *    **Default**: 0
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
@@ -303,6 +313,61 @@ class Config {
    *    The memory budget for tiles of var-sized attributes
    *    to be fetched during reads.<br>
    *    **Default**: 10GB
+   * - `sm.memory_limit` <br>
+   *    The maximum memory in bytes that the readers, writers, consolidator
+   *    and tile cache of the context may reserve in total, on top of the
+   *    per-query `sm.memory_budget` and `sm.memory_budget_var`. Zero means
+   *    unlimited.<br>
+   *    **Default**: 0
+   * - `sm.memory_limit_policy` <br>
+   *    What happens when a reservation exceeds `sm.memory_limit`, after
+   *    evicting tiles from the tile cache. With `block` the query waits until
+   *    enough memory is released. With `shrink`, reads split their current
+   *    partition and consolidation uses smaller buffers, falling back to
+   *    waiting when they cannot shrink further. With `fail` the query fails.
+   *    Requests larger than `sm.memory_limit` always fail, as do the
+   *    requests of the consolidation queries that do not fit in it along
+   *    with the consolidation buffers.<br>
+   *    **Default**: block
+   * - `sm.read_ahead` <br>
+   *    If `true`, a read that is incomplete fetches in the background the
+   *    tiles of the next subarray partition, so that the next submission of
+   *    the query mostly unfilters and copies them. The tiles read ahead take
+   *    at most `sm.memory_budget` and `sm.memory_budget_var` bytes.<br>
+   *    **Default**: false
+   * - `sm.concurrent_partitions` <br>
+   *    The maximum number of subarray partitions that a read processes in
+   *    parallel, writing into disjoint regions of the user buffers that are
+   *    then compacted in order. Partitions are processed together only if
+   *    their estimated results fit in the user buffers, and with a value
+   *    `K > 1` each partition gets `1/K` of `sm.memory_budget` and
+   *    `sm.memory_budget_var`.<br>
+   *    **Default**: 1
+   * - `sm.est_result_size_mode` <br>
+   *    The mode of the estimated result sizes of reads. With `fast`, they
+   *    are computed from the fragment metadata, assuming that the cells are
+   *    uniformly distributed in the tiles that partially overlap the
+   *    subarray. With `tight`, the coordinates of those tiles are read once
+   *    to count the result cells exactly, and the estimates are upper bounds
+   *    (the var-sized estimates include the whole var-sized tiles with
+   *    results).<br>
+   *    **Default**: fast
+   * - `sm.var_offsets.bitsize` <br>
+   *    The size in bits of the offsets of var-sized attributes returned by
+   *    reads. It can be `32` or `64`. With `32`, the offsets buffers hold
+   *    `uint32_t` values, and reads fail if an offset does not fit.<br>
+   *    **Default**: 64
+   * - `sm.checksum.verify_sample_rate` <br>
+   *    The fraction of the tiles read whose checksums are verified by the
+   *    checksum filters, in `[0, 1]`. The verified tiles are spread evenly over
+   *    the reads. Tiles that fail to unfilter are evicted from the tile
+   *    cache.<br>
+   *    **Default**: 1.0
+   * - `sm.checksum.skip_on_cache_hit` <br>
+   *    If `true`, the checksums of the tiles served by the tile cache are not
+   *    verified. They are verified (subject to the sample rate above) when the
+   *    tiles are first read from storage.<br>
+   *    **Default**: false
    * - `vfs.num_threads` <br>
    *    The number of threads allocated for VFS operations (any backend), per
    *    VFS instance. <br>
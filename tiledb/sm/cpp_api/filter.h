@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace tiledb {
 
@@ -227,6 +228,83 @@ class Filter {
         ctx.ptr().get(), filter_.get(), option, value));
   }
 
+  /**
+   * Sets the compression dictionary of a ZStd filter. The dictionary is
+   * stored in the array schema and used to both compress and decompress.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Filter f(ctx, TILEDB_FILTER_ZSTD);
+   * f.set_dictionary(dict.data(), dict.size());
+   * @endcode
+   *
+   * @param dictionary The dictionary bytes.
+   * @param size The dictionary size (0 removes the dictionary).
+   * @return Reference to this Filter
+   *
+   * @throws TileDBError if the filter is not a ZStd filter.
+   */
+  Filter& set_dictionary(const void* dictionary, uint64_t size) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_filter_set_dictionary(
+        ctx.ptr().get(), filter_.get(), dictionary, size));
+    return *this;
+  }
+
+  /**
+   * Returns the compression dictionary of a ZStd filter (empty if it has
+   * none).
+   *
+   * @throws TileDBError if the filter is not a ZStd filter.
+   */
+  std::vector<uint8_t> dictionary() const {
+    auto& ctx = ctx_.get();
+    const void* dictionary;
+    uint64_t size;
+    ctx.handle_error(tiledb_filter_get_dictionary(
+        ctx.ptr().get(), filter_.get(), &dictionary, &size));
+    auto data = static_cast<const uint8_t*>(dictionary);
+    return std::vector<uint8_t>(data, data + size);
+  }
+
+  /**
+   * Trains a compression dictionary for a ZStd filter on a set of samples
+   * representative of the attribute data, and sets it on the filter.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Filter f(ctx, TILEDB_FILTER_ZSTD);
+   * std::vector<std::string> samples = ...;
+   * f.train_dictionary(samples, 16 * 1024);
+   * @endcode
+   *
+   * @param samples The samples.
+   * @param capacity The maximum size of the dictionary.
+   * @return Reference to this Filter
+   *
+   * @throws TileDBError if the filter is not a ZStd filter or training fails.
+   */
+  Filter& train_dictionary(
+      const std::vector<std::string>& samples, uint64_t capacity) {
+    auto& ctx = ctx_.get();
+    std::string data;
+    std::vector<uint64_t> sizes;
+    for (const auto& sample : samples) {
+      data.append(sample);
+      sizes.push_back(sample.size());
+    }
+    ctx.handle_error(tiledb_filter_train_dictionary(
+        ctx.ptr().get(),
+        filter_.get(),
+        data.data(),
+        sizes.data(),
+        sizes.size(),
+        capacity));
+    return *this;
+  }
+
   /** Gets the filter type of this filter. */
   tiledb_filter_type_t filter_type() const {
     auto& ctx = ctx_.get();
@@ -269,6 +347,16 @@ class Filter {
         return "CHECKSUM_MD5";
       case TILEDB_FILTER_CHECKSUM_SHA256:
         return "CHECKSUM_SHA256";
+      case TILEDB_FILTER_DICTIONARY:
+        return "DICTIONARY";
+      case TILEDB_FILTER_OFFSETS_DELTA:
+        return "OFFSETS_DELTA";
+      case TILEDB_FILTER_FRAME_OF_REFERENCE:
+        return "FRAME_OF_REFERENCE";
+      case TILEDB_FILTER_XOR:
+        return "XOR";
+      case TILEDB_FILTER_CHECKSUM_CRC32C:
+        return "CHECKSUM_CRC32C";
     }
     return "";
   }
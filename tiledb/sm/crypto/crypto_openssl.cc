@@ -39,15 +39,115 @@
 #include "tiledb/sm/crypto/crypto.h"
 #include "tiledb/sm/misc/logger.h"
 
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/md5.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 
+#include <cstring>
+
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * An AES-256-GCM cipher context cached by a thread across calls. Allocating
+ * a context and expanding the key schedule costs as much as encrypting a
+ * few KB, which dominated the encryption of small tile chunks. A cached
+ * context is only given the new IV when the key did not change.
+ */
+class CachedCipherContext {
+ public:
+  /** Constructor. */
+  explicit CachedCipherContext(bool encrypt)
+      : ctx_(nullptr)
+      , encrypt_(encrypt)
+      , has_key_(false) {
+  }
+
+  /** Destructor. */
+  ~CachedCipherContext() {
+    reset();
+  }
+
+  CachedCipherContext(const CachedCipherContext&) = delete;
+  CachedCipherContext& operator=(const CachedCipherContext&) = delete;
+
+  /**
+   * Initializes the context for a new message with the input key and IV,
+   * and returns it, or returns nullptr on error.
+   */
+  EVP_CIPHER_CTX* init(const void* key, const unsigned char* iv) {
+    if (ctx_ == nullptr) {
+      ctx_ = EVP_CIPHER_CTX_new();
+      if (ctx_ == nullptr)
+        return nullptr;
+    }
+
+    // Passing a null cipher and key keeps the current key schedule.
+    bool same_key =
+        has_key_ && CRYPTO_memcmp(key_, key, Crypto::AES256GCM_KEY_BYTES) == 0;
+    const EVP_CIPHER* cipher = same_key ? nullptr : EVP_aes_256_gcm();
+    auto key_buf = same_key ? nullptr : (const unsigned char*)key;
+    int rc = encrypt_ ?
+                 EVP_EncryptInit_ex(ctx_, cipher, nullptr, key_buf, iv) :
+                 EVP_DecryptInit_ex(ctx_, cipher, nullptr, key_buf, iv);
+    if (rc == 0) {
+      reset();
+      return nullptr;
+    }
+
+    if (!same_key) {
+      std::memcpy(key_, key, Crypto::AES256GCM_KEY_BYTES);
+      has_key_ = true;
+    }
+    return ctx_;
+  }
+
+  /**
+   * Frees the context and wipes the cached key. This is called upon errors,
+   * as the state of the context is then unknown.
+   */
+  void reset() {
+    if (ctx_ != nullptr) {
+      EVP_CIPHER_CTX_free(ctx_);
+      ctx_ = nullptr;
+    }
+    OPENSSL_cleanse(key_, sizeof(key_));
+    has_key_ = false;
+  }
+
+ private:
+  /** The OpenSSL context. */
+  EVP_CIPHER_CTX* ctx_;
+
+  /** Whether the context encrypts or decrypts. */
+  bool encrypt_;
+
+  /** Whether `key_` holds the key of the context. */
+  bool has_key_;
+
+  /** A copy of the key of the context. */
+  unsigned char key_[Crypto::AES256GCM_KEY_BYTES];
+};
+
+/** Returns the encryption context of the calling thread. */
+CachedCipherContext& encrypt_context() {
+  static thread_local CachedCipherContext ctx(true);
+  return ctx;
+}
+
+/** Returns the decryption context of the calling thread. */
+CachedCipherContext& decrypt_context() {
+  static thread_local CachedCipherContext ctx(false);
+  return ctx;
+}
+
+}  // namespace
+
 Status OpenSSL::get_random_bytes(unsigned num_bytes, Buffer* output) {
   if (output->free_space() < num_bytes)
     RETURN_NOT_OK(output->realloc(output->alloced_size() + num_bytes));
@@ -97,24 +197,13 @@ Status OpenSSL::encrypt_aes256gcm(
   // Copy IV to output arg.
   std::memcpy(output_iv->cur_data(), iv_buf, iv_len);
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-  if (ctx == nullptr)
-    return LOG_STATUS(Status::EncryptionError(
-        "OpenSSL error; cannot encrypt: context allocation failed."));
-
   // Initialize the cipher. We use the default parameter lengths for the IV and
   // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_EncryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          iv_buf) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+  auto& cipher_ctx = encrypt_context();
+  EVP_CIPHER_CTX* ctx = cipher_ctx.init(key->data(), iv_buf);
+  if (ctx == nullptr)
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Encrypt the input.
   int output_len;
@@ -124,7 +213,7 @@ Status OpenSSL::encrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error encrypting data."));
   }
@@ -134,7 +223,7 @@ Status OpenSSL::encrypt_aes256gcm(
   // Finalize encryption.
   if (EVP_EncryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error finalizing encryption."));
   }
@@ -147,14 +236,11 @@ Status OpenSSL::encrypt_aes256gcm(
           EVP_CTRL_GCM_GET_TAG,
           Crypto::AES256GCM_TAG_BYTES,
           (char*)output_tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error getting tag."));
   }
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
@@ -179,24 +265,14 @@ Status OpenSSL::decrypt_aes256gcm(
         "OpenSSL error; cannot decrypt: output buffer too small."));
   }
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-  if (ctx == nullptr)
-    return LOG_STATUS(Status::EncryptionError(
-        "OpenSSL error; cannot decrypt: context allocation failed."));
-
   // Initialize the cipher. We use the default parameter lengths for the IV and
   // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_DecryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          (unsigned char*)iv->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+  auto& cipher_ctx = decrypt_context();
+  EVP_CIPHER_CTX* ctx =
+      cipher_ctx.init(key->data(), (const unsigned char*)iv->data());
+  if (ctx == nullptr)
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Decrypt the input.
   int output_len;
@@ -206,7 +282,7 @@ Status OpenSSL::decrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error decrypting data."));
   }
@@ -220,7 +296,7 @@ Status OpenSSL::decrypt_aes256gcm(
           EVP_CTRL_GCM_SET_TAG,
           Crypto::AES256GCM_TAG_BYTES,
           (char*)tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error setting tag."));
   }
@@ -228,7 +304,7 @@ Status OpenSSL::decrypt_aes256gcm(
   // Finalize decryption.
   if (EVP_DecryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
+    cipher_ctx.reset();
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error finalizing decryption."));
   }
@@ -236,9 +312,6 @@ Status OpenSSL::decrypt_aes256gcm(
     output->advance_size((uint64_t)output_len);
   output->advance_offset((uint64_t)output_len);
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
@@ -83,6 +83,16 @@ inline const std::string& filter_type_str(FilterType filter_type) {
       return constants::filter_checksum_md5_str;
     case FilterType::FILTER_CHECKSUM_SHA256:
       return constants::filter_checksum_sha256_str;
+    case FilterType::FILTER_DICTIONARY:
+      return constants::filter_dictionary_str;
+    case FilterType::FILTER_OFFSETS_DELTA:
+      return constants::filter_offsets_delta_str;
+    case FilterType::FILTER_FRAME_OF_REFERENCE:
+      return constants::filter_frame_of_reference_str;
+    case FilterType::FILTER_XOR:
+      return constants::filter_xor_str;
+    case FilterType::FILTER_CHECKSUM_CRC32C:
+      return constants::filter_checksum_crc32c_str;
     default:
       return constants::empty_str;
   }
@@ -117,6 +127,16 @@ inline Status filter_type_enum(
     *filter_type = FilterType::FILTER_CHECKSUM_MD5;
   else if (filter_type_str == constants::filter_checksum_sha256_str)
     *filter_type = FilterType::FILTER_CHECKSUM_SHA256;
+  else if (filter_type_str == constants::filter_dictionary_str)
+    *filter_type = FilterType::FILTER_DICTIONARY;
+  else if (filter_type_str == constants::filter_offsets_delta_str)
+    *filter_type = FilterType::FILTER_OFFSETS_DELTA;
+  else if (filter_type_str == constants::filter_frame_of_reference_str)
+    *filter_type = FilterType::FILTER_FRAME_OF_REFERENCE;
+  else if (filter_type_str == constants::filter_xor_str)
+    *filter_type = FilterType::FILTER_XOR;
+  else if (filter_type_str == constants::filter_checksum_crc32c_str)
+    *filter_type = FilterType::FILTER_CHECKSUM_CRC32C;
   else {
     return Status::Error("Invalid FilterType " + filter_type_str);
   }
@@ -817,16 +817,34 @@ Status Azure::remove_blob(const URI& uri) const {
   return wait_for_blob_to_be_deleted(container_name, blob_path);
 }
 
+Status Azure::remove_blobs(const std::vector<URI>& uris) const {
+  assert(client_);
+
+  if (uris.size() <= 1)
+    return uris.empty() ? Status::Ok() : remove_blob(uris[0]);
+
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(uris.size());
+  for (const auto& uri : uris) {
+    std::function<Status()> remove_blob_fn =
+        std::bind(&Azure::remove_blob, this, uri);
+    tasks.emplace_back(thread_pool_->enqueue(std::move(remove_blob_fn)));
+  }
+
+  return thread_pool_->wait_all(tasks);
+}
+
 Status Azure::remove_dir(const URI& uri) const {
   assert(client_);
 
   std::vector<std::string> paths;
   RETURN_NOT_OK(ls(uri, &paths, ""));
-  for (const auto& path : paths) {
-    RETURN_NOT_OK(remove_blob(URI(path)));
-  }
 
-  return Status::Ok();
+  std::vector<URI> uris;
+  uris.reserve(paths.size());
+  for (const auto& path : paths)
+    uris.emplace_back(path);
+  return remove_blobs(uris);
 }
 
 Status Azure::touch(const URI& uri) const {
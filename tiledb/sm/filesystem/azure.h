@@ -230,6 +230,16 @@ class Azure {
    */
   Status remove_blob(const URI& uri) const;
 
+  /**
+   * Deletes the blobs with the given URIs. The Blob service has no batch
+   * delete in the client library, so the deletes are issued in parallel on
+   * the VFS thread pool.
+   *
+   * @param uris The URIs of the blobs to be deleted.
+   * @return Status
+   */
+  Status remove_blobs(const std::vector<URI>& uris) const;
+
   /**
    * Deletes all objects with prefix `uri/` (if the ending `/` does not
    * exist in `uri`, it is added by the function.
@@ -41,6 +41,7 @@
 #include <boost/interprocess/streams/bufferstream.hpp>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include "tiledb/sm/global_state/global_state.h"
 
 #include "tiledb/sm/global_state/unit_test_config.h"
@@ -774,15 +775,61 @@ Status S3::remove_object(const URI& uri) const {
   return Status::Ok();
 }
 
+Status S3::remove_objects(const std::vector<URI>& uris) const {
+  RETURN_NOT_OK(init_client());
+
+  // Group the keys per bucket and split them in DeleteObjects batches
+  std::map<std::string, std::vector<std::string>> bucket_keys;
+  for (const auto& uri : uris) {
+    if (!uri.is_s3()) {
+      return LOG_STATUS(Status::S3Error(
+          std::string("URI is not an S3 URI: " + uri.to_string())));
+    }
+    Aws::Http::URI aws_uri = uri.to_string().c_str();
+    bucket_keys[aws_uri.GetAuthority().c_str()].emplace_back(
+        remove_front_slash(aws_uri.GetPath().c_str()));
+  }
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> batches;
+  for (auto& bk : bucket_keys) {
+    auto& keys = bk.second;
+    for (size_t i = 0; i < keys.size(); i += constants::s3_max_delete_objects) {
+      auto end = std::min(
+          keys.size(), i + (size_t)constants::s3_max_delete_objects);
+      batches.emplace_back(
+          bk.first,
+          std::vector<std::string>(keys.begin() + i, keys.begin() + end));
+    }
+  }
+
+  if (batches.empty())
+    return Status::Ok();
+  if (batches.size() == 1)
+    return delete_objects(batches[0].first, batches[0].second);
+
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(batches.size());
+  for (const auto& batch : batches) {
+    tasks.emplace_back(vfs_thread_pool_->enqueue([this, &batch]() {
+      return delete_objects(batch.first, batch.second);
+    }));
+  }
+
+  return vfs_thread_pool_->wait_all(tasks);
+}
+
 Status S3::remove_dir(const URI& uri) const {
   RETURN_NOT_OK(init_client());
 
   std::vector<std::string> paths;
   auto uri_dir = uri.add_trailing_slash();
   RETURN_NOT_OK(ls(uri_dir, &paths, ""));
+
+  std::vector<URI> uris;
+  uris.reserve(paths.size());
   for (const auto& p : paths)
-    RETURN_NOT_OK(remove_object(URI(p)));
-  return Status::Ok();
+    uris.emplace_back(p);
+  return remove_objects(uris);
 }
 
 Status S3::touch(const URI& uri) const {
@@ -1059,6 +1106,44 @@ Status S3::wait_for_object_to_propagate(
       "Failed waiting for object " + object_key + " to be created."));
 }
 
+Status S3::delete_objects(
+    const std::string& bucket, const std::vector<std::string>& keys) const {
+  assert(!keys.empty());
+  assert(keys.size() <= constants::s3_max_delete_objects);
+
+  Aws::S3::Model::Delete delete_keys;
+  for (const auto& key : keys)
+    delete_keys.AddObjects(
+        Aws::S3::Model::ObjectIdentifier().WithKey(key.c_str()));
+  delete_keys.SetQuiet(true);
+
+  Aws::S3::Model::DeleteObjectsRequest delete_objects_request;
+  delete_objects_request.SetBucket(bucket.c_str());
+  delete_objects_request.SetDelete(std::move(delete_keys));
+
+  auto delete_objects_outcome = client_->DeleteObjects(delete_objects_request);
+  if (!delete_objects_outcome.IsSuccess()) {
+    return LOG_STATUS(Status::S3Error(
+        std::string("Failed to delete S3 objects in bucket '") + bucket + "'" +
+        outcome_error_message(delete_objects_outcome)));
+  }
+
+  // In quiet mode, only the keys that failed to be deleted are returned
+  const auto& errors = delete_objects_outcome.GetResult().GetErrors();
+  if (!errors.empty()) {
+    const auto& error = errors.front();
+    return LOG_STATUS(Status::S3Error(
+        std::string("Failed to delete S3 object 's3://") + bucket + "/" +
+        error.GetKey().c_str() + "'; " + error.GetMessage().c_str() + " (" +
+        std::to_string(errors.size()) + " key(s) failed)"));
+  }
+
+  // Wait for the deletes of the batch to be visible, checking the last key
+  // instead of issuing one request per deleted key
+  return wait_for_object_to_be_deleted(
+      bucket.c_str(), ("/" + keys.back()).c_str());
+}
+
 Status S3::wait_for_object_to_be_deleted(
     const Aws::String& bucket_name, const Aws::String& object_key) const {
   init_client();
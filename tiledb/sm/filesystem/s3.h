@@ -60,6 +60,7 @@
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetBucketLocationRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadBucketRequest.h>
@@ -260,6 +261,16 @@ class S3 {
    */
   Status remove_object(const URI& uri) const;
 
+  /**
+   * Deletes the objects with the given URIs. The keys are deleted with
+   * DeleteObjects requests of up to `constants::s3_max_delete_objects` keys
+   * each, which are issued in parallel on the VFS thread pool.
+   *
+   * @param uris The URIs of the objects to be deleted.
+   * @return Status
+   */
+  Status remove_objects(const std::vector<URI>& uris) const;
+
   /**
    * Deletes all objects with prefix `prefix/` (if the ending `/` does not
    * exist in `prefix`, it is added by the function.
@@ -538,6 +549,17 @@ class S3 {
   Status wait_for_object_to_be_deleted(
       const Aws::String& bucketName, const Aws::String& objectKey) const;
 
+  /**
+   * Deletes the input keys of a bucket with a single DeleteObjects request.
+   *
+   * @param bucket The bucket name.
+   * @param keys The object keys (without a leading '/'). There must be at
+   *     most `constants::s3_max_delete_objects` keys.
+   * @return Status
+   */
+  Status delete_objects(
+      const std::string& bucket, const std::vector<std::string>& keys) const;
+
   /** Waits for the bucket to be created. */
   Status wait_for_bucket_to_be_created(const URI& bucket_uri) const;
 
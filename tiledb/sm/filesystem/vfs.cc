@@ -471,6 +471,84 @@ Status VFS::remove_file(const URI& uri) const {
   STATS_FUNC_OUT(vfs_remove_file);
 }
 
+Status VFS::remove_files(const std::vector<URI>& uris) {
+  if (!init_)
+    return LOG_STATUS(
+        Status::VFSError("Cannot remove files; VFS not initialized"));
+
+  if (uris.size() == 1)
+    return remove_file(uris[0]);
+
+  // The object store files are deleted in bulk, the rest one per task
+  std::vector<URI> s3_uris, azure_uris;
+  std::vector<std::future<Status>> tasks;
+  for (const auto& uri : uris) {
+    if (uri.is_s3()) {
+      s3_uris.emplace_back(uri);
+    } else if (uri.is_azure()) {
+      azure_uris.emplace_back(uri);
+    } else {
+      tasks.push_back(cancelable_tasks_.enqueue(
+          &thread_pool_, [this, &uri]() { return remove_file(uri); }));
+    }
+  }
+  RETURN_NOT_OK(thread_pool_.wait_all(tasks));
+
+  if (!s3_uris.empty()) {
+#ifdef HAVE_S3
+    RETURN_NOT_OK(s3_.remove_objects(s3_uris));
+#else
+    return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
+#endif
+  }
+
+  if (!azure_uris.empty()) {
+#ifdef HAVE_AZURE
+    RETURN_NOT_OK(azure_.remove_blobs(azure_uris));
+#else
+    return LOG_STATUS(
+        Status::VFSError("TileDB was built without Azure support"));
+#endif
+  }
+
+  return Status::Ok();
+}
+
+Status VFS::remove_dirs(const std::vector<URI>& uris) {
+  if (!init_)
+    return LOG_STATUS(
+        Status::VFSError("Cannot remove directories; VFS not initialized"));
+
+  if (uris.size() == 1)
+    return remove_dir(uris[0]);
+
+  // On object stores, list all the objects under the prefixes and delete
+  // them in bulk afterwards. The other directories are removed one per task.
+  std::vector<std::vector<std::string>> paths(uris.size());
+  std::vector<std::future<Status>> tasks;
+  for (size_t i = 0; i < uris.size(); ++i) {
+    const auto& uri = uris[i];
+    if (uri.is_s3() || uri.is_azure()) {
+      tasks.push_back(
+          cancelable_tasks_.enqueue(&thread_pool_, [this, &uri, &paths, i]() {
+            return ls_recursive(uri, &paths[i]);
+          }));
+    } else {
+      tasks.push_back(cancelable_tasks_.enqueue(
+          &thread_pool_, [this, &uri]() { return remove_dir(uri); }));
+    }
+  }
+  RETURN_NOT_OK(thread_pool_.wait_all(tasks));
+
+  std::vector<URI> objects;
+  for (const auto& dir_paths : paths) {
+    for (const auto& path : dir_paths)
+      objects.emplace_back(path);
+  }
+
+  return objects.empty() ? Status::Ok() : remove_files(objects);
+}
+
 Status VFS::filelock_lock(const URI& uri, filelock_t* lock, bool shared) const {
   STATS_FUNC_IN(vfs_filelock_lock);
 
@@ -932,6 +1010,51 @@ Status VFS::ls(const URI& parent, std::vector<URI>* uris) const {
   STATS_FUNC_OUT(vfs_ls);
 }
 
+Status VFS::ls_all(
+    const std::vector<URI>& parents, std::vector<std::vector<URI>>* uris) {
+  if (!init_)
+    return LOG_STATUS(Status::VFSError("Cannot list; VFS not initialized"));
+
+  uris->clear();
+  uris->resize(parents.size());
+  if (parents.size() == 1)
+    return ls(parents[0], &(*uris)[0]);
+
+  std::vector<std::future<Status>> tasks;
+  tasks.reserve(parents.size());
+  for (size_t i = 0; i < parents.size(); ++i) {
+    tasks.push_back(
+        cancelable_tasks_.enqueue(&thread_pool_, [this, &parents, uris, i]() {
+          return ls(parents[i], &(*uris)[i]);
+        }));
+  }
+
+  return thread_pool_.wait_all(tasks);
+}
+
+Status VFS::ls_recursive(
+    const URI& prefix, std::vector<std::string>* paths) const {
+  if (prefix.is_s3()) {
+#ifdef HAVE_S3
+    return s3_.ls(prefix.add_trailing_slash(), paths, "");
+#else
+    return LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
+#endif
+  }
+  if (prefix.is_azure()) {
+#ifdef HAVE_AZURE
+    return azure_.ls(prefix, paths, "");
+#else
+    return LOG_STATUS(
+        Status::VFSError("TileDB was built without Azure support"));
+#endif
+  }
+  (void)paths;
+  return LOG_STATUS(Status::VFSError(
+      "Cannot list recursively; Not an object store URI: " +
+      prefix.to_string()));
+}
+
 Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
   STATS_FUNC_IN(vfs_move_file);
 
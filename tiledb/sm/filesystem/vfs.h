@@ -182,6 +182,26 @@ class VFS {
    */
   Status remove_file(const URI& uri) const;
 
+  /**
+   * Deletes multiple files in parallel. The S3 objects are deleted in
+   * batches and the remaining files with one task per file on the VFS thread
+   * pool.
+   *
+   * @param uris The URIs of the files.
+   * @return Status
+   */
+  Status remove_files(const std::vector<URI>& uris);
+
+  /**
+   * Removes multiple directories (recursive) in parallel. On object stores,
+   * the directory prefixes are listed concurrently and all the listed objects
+   * are then deleted with `remove_files`.
+   *
+   * @param uris The URIs of the directories.
+   * @return Status
+   */
+  Status remove_dirs(const std::vector<URI>& uris);
+
   /**
    * Locks a filelock.
    *
@@ -277,6 +297,17 @@ class VFS {
    */
   Status ls(const URI& parent, std::vector<URI>* uris) const;
 
+  /**
+   * Lists multiple parents in parallel on the VFS thread pool.
+   *
+   * @param parents The target directories to list.
+   * @param uris The URIs that are contained in each parent, in the order
+   *     of `parents`.
+   * @return Status
+   */
+  Status ls_all(
+      const std::vector<URI>& parents, std::vector<std::vector<URI>>* uris);
+
   /**
    * Renames a file.
    *
@@ -441,6 +472,16 @@ class VFS {
   /** Wrapper for tracking and canceling certain tasks on 'thread_pool' */
   CancelableTasks cancelable_tasks_;
 
+  /**
+   * Lists all the objects under the input object store prefix, i.e., without
+   * a delimiter.
+   *
+   * @param prefix The S3 or Azure prefix.
+   * @param paths The listed object paths.
+   * @return Status
+   */
+  Status ls_recursive(const URI& prefix, std::vector<std::string>* paths) const;
+
   /**
    * Groups the given vector of regions to be read into a possibly smaller
    * vector of batched reads.
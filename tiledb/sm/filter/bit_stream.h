@@ -0,0 +1,199 @@
+/**
+ * @file   bit_stream.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines classes BitWriter and BitReader.
+ */
+
+#ifndef TILEDB_BIT_STREAM_H
+#define TILEDB_BIT_STREAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/** Returns the number of bits needed to represent `v`. */
+inline unsigned value_bit_width(uint64_t v) {
+  unsigned width = 0;
+  if (v >> 32) {
+    width += 32;
+    v >>= 32;
+  }
+  if (v >> 16) {
+    width += 16;
+    v >>= 16;
+  }
+  if (v >> 8) {
+    width += 8;
+    v >>= 8;
+  }
+  if (v >> 4) {
+    width += 4;
+    v >>= 4;
+  }
+  if (v >> 2) {
+    width += 2;
+    v >>= 2;
+  }
+  if (v >> 1) {
+    width += 1;
+    v >>= 1;
+  }
+  return width + (unsigned)v;
+}
+
+/**
+ * Appends values of up to 64 bits to a byte vector, least significant bit
+ * first. Used by the integer and floating point encoding filters.
+ */
+class BitWriter {
+ public:
+  /** Constructor. Bytes are appended to `out`. */
+  explicit BitWriter(std::vector<uint8_t>* out)
+      : out_(out)
+      , acc_(0)
+      , acc_bits_(0) {
+  }
+
+  /** Appends the `width <= 64` low bits of `value`. */
+  void write(uint64_t value, unsigned width) {
+    if (width > 32) {
+      put(value, 32);
+      value >>= 32;
+      width -= 32;
+    }
+    put(value, width);
+  }
+
+  /** Pads the pending bits with zeros up to the next byte. */
+  void flush() {
+    if (acc_bits_ > 0) {
+      out_->push_back((uint8_t)acc_);
+      acc_ = 0;
+      acc_bits_ = 0;
+    }
+  }
+
+ private:
+  /** The output bytes. */
+  std::vector<uint8_t>* out_;
+
+  /** The pending bits, fewer than 8 between calls. */
+  uint64_t acc_;
+
+  /** The number of pending bits. */
+  unsigned acc_bits_;
+
+  /** Appends the `width <= 32` low bits of `value`. */
+  void put(uint64_t value, unsigned width) {
+    if (width == 0)
+      return;
+    acc_ |= (value & ((uint64_t(1) << width) - 1)) << acc_bits_;
+    acc_bits_ += width;
+    while (acc_bits_ >= 8) {
+      out_->push_back((uint8_t)acc_);
+      acc_ >>= 8;
+      acc_bits_ -= 8;
+    }
+  }
+};
+
+/**
+ * Reads the values written by a `BitWriter`. Reading past the end of the
+ * input yields zero bits and sets the overflow flag, which callers check
+ * once they are done.
+ */
+class BitReader {
+ public:
+  /** Constructor. */
+  BitReader(const uint8_t* data, uint64_t size)
+      : pos_(data)
+      , end_(data + size)
+      , acc_(0)
+      , acc_bits_(0)
+      , overflow_(false) {
+  }
+
+  /** Reads a value of `width <= 64` bits. */
+  uint64_t read(unsigned width) {
+    if (width > 32) {
+      uint64_t low = get(32);
+      return low | (get(width - 32) << 32);
+    }
+    return get(width);
+  }
+
+  /** Skips the pending bits up to the next byte. */
+  void align() {
+    acc_ = 0;
+    acc_bits_ = 0;
+  }
+
+  /** Returns true if a read went past the end of the input. */
+  bool overflow() const {
+    return overflow_;
+  }
+
+ private:
+  /** The next input byte. */
+  const uint8_t* pos_;
+
+  /** The end of the input. */
+  const uint8_t* end_;
+
+  /** The pending bits. */
+  uint64_t acc_;
+
+  /** The number of pending bits. */
+  unsigned acc_bits_;
+
+  /** Whether a read went past the end of the input. */
+  bool overflow_;
+
+  /** Reads a value of `width <= 32` bits. */
+  uint64_t get(unsigned width) {
+    while (acc_bits_ < width) {
+      if (pos_ < end_)
+        acc_ |= (uint64_t)(*pos_++) << acc_bits_;
+      else
+        overflow_ = true;
+      acc_bits_ += 8;
+    }
+    uint64_t value = acc_ & ((uint64_t(1) << width) - 1);
+    acc_ >>= width;
+    acc_bits_ -= width;
+    return value;
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BIT_STREAM_H
@@ -35,7 +35,9 @@
 #include "tiledb/sm/enums/filter_option.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/simd_kernels.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/tile/tile.h"
 
@@ -95,6 +97,8 @@ Status BitWidthReductionFilter::run_forward(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_bit_width_reduction_forward);
+
   auto tile_type = pipeline_->current_tile()->type();
   auto tile_type_size = static_cast<uint8_t>(datatype_size(tile_type));
 
@@ -148,6 +152,8 @@ Status BitWidthReductionFilter::run_forward(
       return LOG_STATUS(
           Status::FilterError("Cannot filter; Unsupported input type"));
   }
+
+  STATS_FUNC_OUT(filter_bit_width_reduction_forward);
 }
 
 template <typename T>
@@ -214,6 +220,9 @@ Status BitWidthReductionFilter::compress_part(
   uint32_t num_windows =
       input_bytes / window_size + uint32_t(bool(input_bytes % window_size));
 
+  // Windows are narrowed into this buffer and written to the output at once.
+  std::vector<uint8_t> compressed(window_size);
+
   // Write each window.
   for (uint32_t i = 0; i < num_windows; i++) {
     // Compute the actual size in bytes of the window (may be smaller at the end
@@ -238,14 +247,15 @@ Status BitWidthReductionFilter::compress_part(
       input->advance_offset(window_nbytes);
     } else {
       // Compress and write the relative values to output.
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T relative_value = input->value<T>() - window_value_offset;
-
-        RETURN_NOT_OK(
-            write_compressed_value(output, relative_value, compressed_bits));
-
-        input->advance_offset(sizeof(T));
-      }
+      auto values = (const T*)((const char*)input->data() + input->offset());
+      RETURN_NOT_OK(write_compressed_window(
+          output,
+          values,
+          window_nelts,
+          window_value_offset,
+          compressed_bits,
+          compressed.data()));
+      input->advance_offset(window_nbytes);
     }
   }
 
@@ -257,6 +267,8 @@ Status BitWidthReductionFilter::run_reverse(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_bit_width_reduction_reverse);
+
   auto tile_type = pipeline_->current_tile()->type();
   auto tile_type_size = static_cast<uint8_t>(datatype_size(tile_type));
 
@@ -310,6 +322,8 @@ Status BitWidthReductionFilter::run_reverse(
       return LOG_STATUS(
           Status::FilterError("Cannot filter; Unsupported input type"));
   }
+
+  STATS_FUNC_OUT(filter_bit_width_reduction_reverse);
 }
 
 template <typename T>
@@ -328,6 +342,10 @@ Status BitWidthReductionFilter::run_reverse(
   RETURN_NOT_OK(output->prepend_buffer(orig_length));
   output->reset_offset();
 
+  // Windows are widened through these buffers.
+  std::vector<uint8_t> compressed;
+  std::vector<T> values;
+
   // Read each window
   for (uint32_t i = 0; i < num_windows; i++) {
     uint32_t window_nbytes;
@@ -343,15 +361,18 @@ Status BitWidthReductionFilter::run_reverse(
       RETURN_NOT_OK(output->write(input, window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Read and uncompress each window value.
+      // Read and uncompress the window values.
       uint32_t window_nelts = window_nbytes / sizeof(T);
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T input_value = 0;
-        RETURN_NOT_OK(
-            read_compressed_value(input, compressed_bits, &input_value));
-        input_value += window_value_offset;
-        RETURN_NOT_OK(output->write(&input_value, tile_type_size));
-      }
+      compressed.resize(window_nelts * (compressed_bits / 8));
+      values.resize(window_nelts);
+      RETURN_NOT_OK(input->read(compressed.data(), compressed.size()));
+      read_compressed_window(
+          compressed.data(),
+          window_nelts,
+          window_value_offset,
+          compressed_bits,
+          values.data());
+      RETURN_NOT_OK(output->write(values.data(), window_nbytes));
     }
   }
 
@@ -370,14 +391,12 @@ uint8_t BitWidthReductionFilter::compute_bits_required(
   // Compute the min and max element values within the window.
   T window_min = std::numeric_limits<T>::max(),
     window_max = std::numeric_limits<T>::lowest();
-  auto orig_offset = buffer->offset();
-  for (uint32_t j = 0; j < num_elements; j++) {
-    T input_value = buffer->value<T>();
-    window_min = std::min(window_min, input_value);
-    window_max = std::max(window_max, input_value);
-    buffer->advance_offset(sizeof(T));
-  }
-  buffer->set_offset(orig_offset);
+  if (num_elements > 0)
+    simd::min_max(
+        (const T*)((const char*)buffer->data() + buffer->offset()),
+        num_elements,
+        &window_min,
+        &window_max);
 
   // Check for overflow
   T range = window_max - window_min;
@@ -402,84 +421,78 @@ uint8_t BitWidthReductionFilter::compute_bits_required(
 }
 
 template <typename T>
-Status BitWidthReductionFilter::write_compressed_value(
-    FilterBuffer* buffer, T value, uint8_t num_bits) const {
+Status BitWidthReductionFilter::write_compressed_window(
+    FilterBuffer* buffer,
+    const T* values,
+    uint32_t num_values,
+    T offset,
+    uint8_t num_bits,
+    void* scratch) const {
+  const bool is_signed = std::is_signed<T>::value;
   switch (num_bits) {
     case 8: {
-      auto val = static_cast<
-          typename std::conditional<std::is_signed<T>::value, int8_t, uint8_t>::
-              type>(value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+      typedef typename std::conditional<is_signed, int8_t, uint8_t>::type U;
+      simd::narrow(values, num_values, offset, static_cast<U*>(scratch));
       break;
     }
     case 16: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int16_t, uint16_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+      typedef typename std::conditional<is_signed, int16_t, uint16_t>::type U;
+      simd::narrow(values, num_values, offset, static_cast<U*>(scratch));
       break;
     }
     case 32: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int32_t, uint32_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+      typedef typename std::conditional<is_signed, int32_t, uint32_t>::type U;
+      simd::narrow(values, num_values, offset, static_cast<U*>(scratch));
       break;
     }
     case 64: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+      typedef typename std::conditional<is_signed, int64_t, uint64_t>::type U;
+      simd::narrow(values, num_values, offset, static_cast<U*>(scratch));
       break;
     }
     default:
       assert(false);
   }
 
-  return Status::Ok();
+  return buffer->write(scratch, (uint64_t)num_values * (num_bits / 8));
 }
 
 template <typename T>
-Status BitWidthReductionFilter::read_compressed_value(
-    FilterBuffer* buffer, uint8_t compressed_bits, T* value) const {
+void BitWidthReductionFilter::read_compressed_window(
+    const void* compressed,
+    uint32_t num_values,
+    T offset,
+    uint8_t compressed_bits,
+    T* values) const {
+  const bool is_signed = std::is_signed<T>::value;
   switch (compressed_bits) {
     case 8: {
-      typename std::conditional<std::is_signed<T>::value, int8_t, uint8_t>::type
-          val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+      typedef typename std::conditional<is_signed, int8_t, uint8_t>::type U;
+      simd::widen(
+          static_cast<const U*>(compressed), num_values, offset, values);
       break;
     }
     case 16: {
-      typename std::conditional<std::is_signed<T>::value, int16_t, uint16_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+      typedef typename std::conditional<is_signed, int16_t, uint16_t>::type U;
+      simd::widen(
+          static_cast<const U*>(compressed), num_values, offset, values);
       break;
     }
     case 32: {
-      typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+      typedef typename std::conditional<is_signed, int32_t, uint32_t>::type U;
+      simd::widen(
+          static_cast<const U*>(compressed), num_values, offset, values);
       break;
     }
     case 64: {
-      typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+      typedef typename std::conditional<is_signed, int64_t, uint64_t>::type U;
+      simd::widen(
+          static_cast<const U*>(compressed), num_values, offset, values);
       break;
     }
     default:
       assert(false);
   }
-
-  return Status::Ok();
 }
 
 Status BitWidthReductionFilter::set_option_impl(
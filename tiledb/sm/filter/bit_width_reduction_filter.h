@@ -154,18 +154,23 @@ class BitWidthReductionFilter : public Filter {
   Status get_option_impl(FilterOption option, void* value) const override;
 
   /**
-   * Reads a compressed value of type T from the given buffer after
-   * decompressing from a value of the given bit width.
+   * Decompresses a window of values of type T from values of the given bit
+   * width.
    *
    * @tparam T Tile cell datatype
-   * @param buffer Buffer to read from
-   * @param compressed_bits Bit width of compressed value to read
-   * @param value Will be set to the decompressed value
-   * @return Status
+   * @param compressed The compressed values
+   * @param num_values Number of values in the window
+   * @param offset Window value offset, added to the compressed values
+   * @param compressed_bits Bit width of the compressed values
+   * @param values Will be set to the decompressed values
    */
   template <typename T>
-  Status read_compressed_value(
-      FilterBuffer* buffer, uint8_t compressed_bits, T* value) const;
+  void read_compressed_window(
+      const void* compressed,
+      uint32_t num_values,
+      T offset,
+      uint8_t compressed_bits,
+      T* values) const;
 
   /** Run_forward method templated on the tile cell datatype. */
   template <typename T>
@@ -190,17 +195,26 @@ class BitWidthReductionFilter : public Filter {
   Status serialize_impl(Buffer* buff) const override;
 
   /**
-   * Writes the given value of type T to the given buffer after compressing
-   * (casting) to a value of the given bit width.
+   * Writes a window of values of type T to the given buffer after
+   * compressing (casting) them to values of the given bit width.
    *
    * @param buffer Buffer to write to
-   * @param value Uncompressed value to write
-   * @param num_bits Bit width of compressed value to write
+   * @param values Uncompressed values to write
+   * @param num_values Number of values in the window
+   * @param offset Window value offset, subtracted from the values
+   * @param num_bits Bit width of compressed values to write
+   * @param scratch Buffer of at least `num_values * sizeof(T)` bytes to
+   *     compress the values into
    * @return Status
    */
   template <typename T>
-  Status write_compressed_value(
-      FilterBuffer* buffer, T value, uint8_t num_bits) const;
+  Status write_compressed_window(
+      FilterBuffer* buffer,
+      const T* values,
+      uint32_t num_values,
+      T offset,
+      uint8_t num_bits,
+      void* scratch) const;
 };
 
 }  // namespace sm
@@ -34,6 +34,7 @@
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/tile/tile.h"
 
 #include "bitshuffle_core.h"
@@ -61,6 +62,8 @@ Status BitshuffleFilter::run_forward(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_bitshuffle_forward);
+
   auto tile_type = pipeline_->current_tile()->type();
   auto tile_type_size = static_cast<uint8_t>(datatype_size(tile_type));
 
@@ -98,6 +101,8 @@ Status BitshuffleFilter::run_forward(
   }
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(filter_bitshuffle_forward);
 }
 
 Status BitshuffleFilter::compute_parts(
@@ -163,6 +168,8 @@ Status BitshuffleFilter::run_reverse(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_bitshuffle_reverse);
+
   auto tile_type = pipeline_->current_tile()->type();
   auto tile_type_size = static_cast<uint8_t>(datatype_size(tile_type));
 
@@ -200,6 +207,8 @@ Status BitshuffleFilter::run_reverse(
       input_metadata, md_offset, input_metadata->size() - md_offset));
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(filter_bitshuffle_reverse);
 }
 
 Status BitshuffleFilter::unshuffle_part(
@@ -34,6 +34,7 @@
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/tile/tile.h"
 
 #include "blosc/shuffle.h"
@@ -61,6 +62,8 @@ Status ByteshuffleFilter::run_forward(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_byteshuffle_forward);
+
   // Output size does not change with this filter.
   RETURN_NOT_OK(output->prepend_buffer(input->size()));
   Buffer* output_buf = output->buffer_ptr(0);
@@ -87,6 +90,8 @@ Status ByteshuffleFilter::run_forward(
   }
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(filter_byteshuffle_forward);
 }
 
 Status ByteshuffleFilter::shuffle_part(
@@ -108,6 +113,8 @@ Status ByteshuffleFilter::run_reverse(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_byteshuffle_reverse);
+
   // Get number of parts
   uint32_t num_parts;
   RETURN_NOT_OK(input_metadata->read(&num_parts, sizeof(uint32_t)));
@@ -137,6 +144,8 @@ Status ByteshuffleFilter::run_reverse(
       input_metadata, md_offset, input_metadata->size() - md_offset));
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(filter_byteshuffle_reverse);
 }
 
 Status ByteshuffleFilter::unshuffle_part(
@@ -0,0 +1,205 @@
+/**
+ * @file   checksum_crc32c_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ChecksumCRC32CFilter.
+ */
+
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/simd_kernels.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <sstream>
+
+namespace tiledb {
+namespace sm {
+
+ChecksumCRC32CFilter::ChecksumCRC32CFilter()
+    : Filter(FilterType::FILTER_CHECKSUM_CRC32C) {
+}
+
+ChecksumCRC32CFilter* ChecksumCRC32CFilter::clone_impl() const {
+  return new ChecksumCRC32CFilter;
+}
+
+void ChecksumCRC32CFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+
+  fprintf(out, "ChecksumCRC32C");
+}
+
+Status ChecksumCRC32CFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_checksum_crc32c_forward);
+
+  // Set output buffer to input buffer
+  RETURN_NOT_OK(output->append_view(input));
+  // Add original input metadata as a view to the output metadata
+  output_metadata->append_view(input_metadata);
+
+  // Compute and write the metadata
+  std::vector<ConstBuffer> data_parts = input->buffers(),
+                           metadata_parts = input_metadata->buffers();
+  auto num_data_parts = (uint32_t)data_parts.size();
+  auto num_metadata_parts = (uint32_t)metadata_parts.size();
+  auto total_num_parts = num_data_parts + num_metadata_parts;
+
+  uint32_t part_md_size = CRC32C_DIGEST_BYTES + sizeof(uint64_t);
+  uint32_t metadata_size =
+      (total_num_parts * part_md_size) + (2 * sizeof(uint32_t));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(metadata_size));
+  RETURN_NOT_OK(output_metadata->write(&num_metadata_parts, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&num_data_parts, sizeof(uint32_t)));
+
+  // Checksum all parts
+  for (auto& part : metadata_parts)
+    RETURN_NOT_OK(checksum_part(&part, output_metadata));
+  for (auto& part : data_parts)
+    RETURN_NOT_OK(checksum_part(&part, output_metadata));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_checksum_crc32c_forward);
+}
+
+Status ChecksumCRC32CFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_checksum_crc32c_reverse);
+
+  // Set output buffer to input buffer
+  RETURN_NOT_OK(output->append_view(input));
+
+  // Read the number of parts from input metadata.
+  uint32_t num_metadata_parts, num_data_parts;
+  RETURN_NOT_OK(input_metadata->read(&num_metadata_parts, sizeof(uint32_t)));
+  RETURN_NOT_OK(input_metadata->read(&num_data_parts, sizeof(uint32_t)));
+
+  // Skip the checksums if the pipeline does not verify them
+  if (pipeline_ != nullptr && !pipeline_->verify_checksums()) {
+    uint64_t part_md_size = CRC32C_DIGEST_BYTES + sizeof(uint64_t);
+    uint64_t skip_size =
+        ((uint64_t)num_metadata_parts + num_data_parts) * part_md_size;
+    if (skip_size > input_metadata->size() - input_metadata->offset())
+      return LOG_STATUS(Status::ChecksumError(
+          "Cannot skip checksums; crc32c filter metadata is truncated"));
+    input_metadata->advance_offset(skip_size);
+    auto md_offset = input_metadata->offset();
+    return output_metadata->append_view(
+        input_metadata, md_offset, input_metadata->size() - md_offset);
+  }
+
+  // Pull out the (size, checksum) pairs of the metadata and data parts
+  std::vector<std::pair<uint64_t, uint32_t>> checksums(
+      (uint64_t)num_metadata_parts + num_data_parts);
+  for (auto& checksum : checksums) {
+    RETURN_NOT_OK(input_metadata->read(&checksum.first, sizeof(uint64_t)));
+    RETURN_NOT_OK(
+        input_metadata->read(&checksum.second, CRC32C_DIGEST_BYTES));
+  }
+
+  // Compare the checksums of the metadata, then reset the metadata offset
+  // if there was metadata that we read.
+  uint64_t offset_before_checksum = input_metadata->offset();
+  for (uint32_t i = 0; i < num_metadata_parts; i++) {
+    RETURN_NOT_OK(compare_checksum_part(
+        input_metadata, checksums[i].first, checksums[i].second));
+  }
+  if (input_metadata->offset() != offset_before_checksum)
+    input_metadata->set_offset(offset_before_checksum);
+
+  for (uint32_t i = 0; i < num_data_parts; i++) {
+    auto& checksum = checksums[num_metadata_parts + i];
+    RETURN_NOT_OK(compare_checksum_part(input, checksum.first, checksum.second));
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_checksum_crc32c_reverse);
+}
+
+Status ChecksumCRC32CFilter::checksum_part(
+    ConstBuffer* part, FilterBuffer* output_metadata) const {
+  uint64_t part_size = part->size();
+  uint32_t checksum = simd::crc32c(0, part->data(), part_size);
+
+  // Write metadata.
+  RETURN_NOT_OK(output_metadata->write(&part_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(output_metadata->write(&checksum, CRC32C_DIGEST_BYTES));
+
+  return Status::Ok();
+}
+
+Status ChecksumCRC32CFilter::compare_checksum_part(
+    FilterBuffer* part, uint64_t bytes_to_compare, uint32_t checksum) const {
+  uint32_t computed;
+
+  // First we try to get a view on the bytes we need without copying. This
+  // fails if the bytes span multiple underlying buffers, in which case we
+  // copy them out.
+  ConstBuffer view(nullptr, 0);
+  if (part->get_const_buffer(bytes_to_compare, &view).ok()) {
+    computed = simd::crc32c(0, view.data(), bytes_to_compare);
+    part->advance_offset(bytes_to_compare);
+  } else {
+    Buffer copy;
+    RETURN_NOT_OK(copy.realloc(bytes_to_compare));
+    RETURN_NOT_OK(part->read(copy.data(), bytes_to_compare));
+    computed = simd::crc32c(0, copy.data(), bytes_to_compare);
+  }
+
+  if (computed != checksum) {
+    std::stringstream message;
+    message << "Checksum mismatch for crc32c filter, expect " << std::hex
+            << checksum << " got " << computed;
+    return LOG_STATUS(Status::ChecksumError(message.str()));
+  }
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -34,6 +34,7 @@
 #include "tiledb/sm/buffer/preallocated_buffer.h"
 #include "tiledb/sm/crypto/crypto.h"
 #include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/tile/tile.h"
 
@@ -103,6 +104,20 @@ Status ChecksumSHA256Filter::run_reverse(
   RETURN_NOT_OK(input_metadata->read(&num_metadata_parts, sizeof(uint32_t)));
   RETURN_NOT_OK(input_metadata->read(&num_data_parts, sizeof(uint32_t)));
 
+  // Skip the checksums if the pipeline does not verify them
+  if (pipeline_ != nullptr && !pipeline_->verify_checksums()) {
+    uint64_t part_md_size = Crypto::SHA256_DIGEST_BYTES + sizeof(uint64_t);
+    uint64_t skip_size =
+        ((uint64_t)num_metadata_parts + num_data_parts) * part_md_size;
+    if (skip_size > input_metadata->size() - input_metadata->offset())
+      return LOG_STATUS(Status::ChecksumError(
+          "Cannot skip checksums; sha256 filter metadata is truncated"));
+    input_metadata->advance_offset(skip_size);
+    auto md_offset = input_metadata->offset();
+    return output_metadata->append_view(
+        input_metadata, md_offset, input_metadata->size() - md_offset);
+  }
+
   // Build pairs of checksum to sizes
   std::vector<std::pair<uint64_t, Buffer>> metadata_checksums(
       num_metadata_parts);
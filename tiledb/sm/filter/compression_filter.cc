@@ -102,15 +102,56 @@ void CompressionFilter::dump(FILE* out) const {
   }
 
   fprintf(out, "%s: COMPRESSION_LEVEL=%i", compressor_str.c_str(), level_);
+  if (dictionary_ != nullptr)
+    fprintf(out, ", DICTIONARY=%zu bytes", dictionary_->data().size());
 }
 
 CompressionFilter* CompressionFilter::clone_impl() const {
-  return new CompressionFilter(compressor_, level_);
+  auto clone = new CompressionFilter(compressor_, level_);
+  clone->dictionary_ = dictionary_;
+  return clone;
 }
 
 void CompressionFilter::set_compressor(Compressor compressor) {
   compressor_ = compressor;
   type_ = compressor_to_filter(compressor);
+  if (compressor_ != Compressor::ZSTD)
+    dictionary_.reset();
+}
+
+const ZStd::Dictionary* CompressionFilter::dictionary() const {
+  return dictionary_.get();
+}
+
+Status CompressionFilter::set_dictionary(const void* data, uint64_t size) {
+  if (compressor_ != Compressor::ZSTD)
+    return LOG_STATUS(Status::FilterError(
+        "Compression filter error; dictionaries are only supported by ZStd"));
+  if (size > std::numeric_limits<uint32_t>::max())
+    return LOG_STATUS(Status::FilterError(
+        "Compression filter error; dictionary exceeds uint32 max"));
+
+  if (size == 0)
+    dictionary_.reset();
+  else
+    dictionary_ = std::make_shared<const ZStd::Dictionary>(data, size);
+
+  return Status::Ok();
+}
+
+Status CompressionFilter::train_dictionary(
+    const void* samples,
+    const std::vector<uint64_t>& sample_sizes,
+    uint64_t capacity) {
+  if (compressor_ != Compressor::ZSTD)
+    return LOG_STATUS(Status::FilterError(
+        "Compression filter error; dictionaries are only supported by ZStd"));
+
+  std::vector<uint8_t> dict;
+  RETURN_NOT_OK(
+      ZStd::train_dictionary(samples, sample_sizes, capacity, &dict));
+
+  return set_dictionary(dict.data(), dict.size());
 }
 
 void CompressionFilter::set_compression_level(int compressor_level) {
@@ -288,7 +329,8 @@ Status CompressionFilter::compress_part(
       RETURN_NOT_OK(GZip::compress(level_, &input_buffer, output));
       break;
     case Compressor::ZSTD:
-      RETURN_NOT_OK(ZStd::compress(level_, &input_buffer, output));
+      RETURN_NOT_OK(ZStd::compress(
+          level_, &input_buffer, output, dictionary_.get()));
       break;
     case Compressor::LZ4:
       RETURN_NOT_OK(LZ4::compress(level_, &input_buffer, output));
@@ -353,7 +395,7 @@ Status CompressionFilter::decompress_part(
       st = GZip::decompress(&input_buffer, &output_buffer);
       break;
     case Compressor::ZSTD:
-      st = ZStd::decompress(&input_buffer, &output_buffer);
+      st = ZStd::decompress(&input_buffer, &output_buffer, dictionary_.get());
       break;
     case Compressor::LZ4:
       st = LZ4::decompress(&input_buffer, &output_buffer);
@@ -405,6 +447,15 @@ Status CompressionFilter::serialize_impl(Buffer* buff) const {
   RETURN_NOT_OK(buff->write(&compressor_char, sizeof(uint8_t)));
   RETURN_NOT_OK(buff->write(&level_, sizeof(int32_t)));
 
+  // The dictionary is optional and only written if set, so that filters
+  // without one serialize exactly as before.
+  if (dictionary_ != nullptr) {
+    const auto& dict = dictionary_->data();
+    auto dict_size = static_cast<uint32_t>(dict.size());
+    RETURN_NOT_OK(buff->write(&dict_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff->write(dict.data(), dict.size()));
+  }
+
   return Status::Ok();
 }
 
@@ -414,6 +465,17 @@ Status CompressionFilter::deserialize_impl(ConstBuffer* buff) {
   compressor_ = static_cast<Compressor>(compressor_char);
   RETURN_NOT_OK(buff->read(&level_, sizeof(int32_t)));
 
+  dictionary_.reset();
+  if (buff->nbytes_left_to_read() > 0) {
+    uint32_t dict_size;
+    RETURN_NOT_OK(buff->read(&dict_size, sizeof(uint32_t)));
+    if (buff->nbytes_left_to_read() < dict_size)
+      return LOG_STATUS(Status::FilterError(
+          "Compression filter error; invalid dictionary size"));
+    RETURN_NOT_OK(set_dictionary(buff->cur_data(), dict_size));
+    buff->advance_offset(dict_size);
+  }
+
   return Status::Ok();
 }
 
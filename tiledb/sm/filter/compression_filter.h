@@ -33,9 +33,13 @@
 #ifndef TILEDB_COMPRESSION_FILTER_H
 #define TILEDB_COMPRESSION_FILTER_H
 
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <memory>
+#include <vector>
+
 namespace tiledb {
 namespace sm {
 
@@ -70,6 +74,11 @@ enum class Compressor : uint8_t;
  *
  * The reverse (decompress) output format is simply:
  *   uint8_t[] - Array of uncompressed bytes
+ *
+ * ZStd compression filters may carry a dictionary, trained on sample data
+ * of the attribute. The dictionary is serialized with the filter (and thus
+ * stored in the array schema) and is used for both compression and
+ * decompression, which benefits the small parts produced by chunking.
  */
 class CompressionFilter : public Filter {
  public:
@@ -122,6 +131,32 @@ class CompressionFilter : public Filter {
   /** Set the compression level used by this filter instance. */
   void set_compression_level(int compressor_level);
 
+  /** Returns the dictionary of this filter, or `nullptr` if it has none. */
+  const ZStd::Dictionary* dictionary() const;
+
+  /**
+   * Sets the dictionary to compress with. Only ZStd supports dictionaries.
+   *
+   * @param data The dictionary bytes (copied).
+   * @param size The dictionary size. If 0, the dictionary is removed.
+   * @return Status
+   */
+  Status set_dictionary(const void* data, uint64_t size);
+
+  /**
+   * Trains a dictionary on the input samples and sets it on this filter
+   * (see `ZStd::train_dictionary`).
+   *
+   * @param samples The concatenated samples.
+   * @param sample_sizes The size of each sample.
+   * @param capacity The maximum size of the dictionary.
+   * @return Status
+   */
+  Status train_dictionary(
+      const void* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t capacity);
+
  private:
   /** The compressor. */
   Compressor compressor_;
@@ -129,6 +164,12 @@ class CompressionFilter : public Filter {
   /** The compression level. */
   int level_;
 
+  /**
+   * The compression dictionary (ZStd only). It is immutable, hence shared
+   * among the clones of this filter.
+   */
+  std::shared_ptr<const ZStd::Dictionary> dictionary_;
+
   /** Returns a new clone of this filter. */
   CompressionFilter* clone_impl() const override;
 
@@ -0,0 +1,326 @@
+/**
+ * @file   dictionary_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DictionaryFilter.
+ */
+
+#include "tiledb/sm/filter/dictionary_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The maximum number of dictionary values (the codes are 16-bit). */
+const uint64_t max_dictionary_size = 65536;
+
+/** A cell value, referencing the input bytes. */
+struct Value {
+  const char* data_;
+  uint64_t size_;
+
+  bool operator==(const Value& other) const {
+    return size_ == other.size_ && std::memcmp(data_, other.data_, size_) == 0;
+  }
+};
+
+/** FNV-1a hash of a cell value. */
+struct ValueHash {
+  size_t operator()(const Value& value) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < value.size_; i++) {
+      hash ^= (uint8_t)value.data_[i];
+      hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
+  }
+};
+
+}  // namespace
+
+DictionaryFilter::DictionaryFilter()
+    : Filter(FilterType::FILTER_DICTIONARY) {
+}
+
+DictionaryFilter* DictionaryFilter::clone_impl() const {
+  return new DictionaryFilter;
+}
+
+void DictionaryFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "Dictionary");
+}
+
+bool DictionaryFilter::compute_cell_sizes(
+    const ConstBuffer& input,
+    uint32_t* value_size,
+    std::vector<uint64_t>* cell_sizes) const {
+  // Var-sized cells, whose boundaries are known to the pipeline. The sizes
+  // do not match the input if a preceding filter transformed it.
+  auto var_cell_sizes = pipeline_->current_chunk_cell_sizes();
+  if (var_cell_sizes != nullptr) {
+    uint64_t total_size = 0;
+    for (auto size : *var_cell_sizes)
+      total_size += size;
+    if (total_size == input.size()) {
+      *value_size = 0;
+      *cell_sizes = *var_cell_sizes;
+      return true;
+    }
+  }
+
+  // Fixed-sized cells. Coordinate tiles store one value per dimension.
+  auto tile = pipeline_->current_tile();
+  auto cell_size = tile->cell_size();
+  if (tile->stores_coords() && tile->dim_num() > 0)
+    cell_size /= tile->dim_num();
+  if (cell_size == 0 || cell_size > std::numeric_limits<uint32_t>::max() ||
+      input.size() % cell_size != 0)
+    return false;
+
+  *value_size = (uint32_t)cell_size;
+  cell_sizes->assign(input.size() / cell_size, cell_size);
+  return true;
+}
+
+Status DictionaryFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+
+  return Status::Ok();
+}
+
+Status DictionaryFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_dictionary_forward);
+
+  // The values must be contiguous.
+  if (input->num_buffers() != 1)
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+  ConstBuffer data = input->buffers()[0];
+  uint32_t value_size;
+  std::vector<uint64_t> cell_sizes;
+  if (!compute_cell_sizes(data, &value_size, &cell_sizes) ||
+      cell_sizes.size() > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Build the dictionary, assigning codes in order of first appearance.
+  auto cell_num = cell_sizes.size();
+  std::unordered_map<Value, uint16_t, ValueHash> codes;
+  std::vector<Value> dictionary;
+  std::vector<uint16_t> cell_codes(cell_num);
+  uint64_t dictionary_bytes = 0;
+  auto cell_data = static_cast<const char*>(data.data());
+  for (uint64_t c = 0; c < cell_num; c++) {
+    Value value = {cell_data, cell_sizes[c]};
+    cell_data += cell_sizes[c];
+    auto it = codes.find(value);
+    if (it != codes.end()) {
+      cell_codes[c] = it->second;
+      continue;
+    }
+    if (dictionary.size() == max_dictionary_size)
+      return forward_unencoded(input_metadata, input, output_metadata, output);
+    auto code = (uint16_t)dictionary.size();
+    codes.emplace(value, code);
+    dictionary.push_back(value);
+    dictionary_bytes += value.size_ + (value_size == 0 ? sizeof(uint32_t) : 0);
+    cell_codes[c] = code;
+  }
+
+  // Forward the input if the encoding does not pay off.
+  uint8_t code_size = dictionary.size() <= 256 ? 1 : 2;
+  uint64_t encoded_size = dictionary_bytes + cell_num * code_size;
+  if (encoded_size >= data.size())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Write the header.
+  uint8_t encoded = 1;
+  auto header_cell_num = (uint32_t)cell_num;
+  auto dictionary_num = (uint32_t)dictionary.size();
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(
+      2 * sizeof(uint8_t) + 3 * sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&code_size, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&value_size, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&header_cell_num, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&dictionary_num, sizeof(uint32_t)));
+
+  // Write the dictionary and the codes.
+  RETURN_NOT_OK(output->prepend_buffer(encoded_size));
+  output->reset_offset();
+  if (value_size == 0) {
+    for (const auto& value : dictionary) {
+      auto size = (uint32_t)value.size_;
+      RETURN_NOT_OK(output->write(&size, sizeof(uint32_t)));
+    }
+  }
+  for (const auto& value : dictionary)
+    RETURN_NOT_OK(output->write(value.data_, value.size_));
+  if (code_size == 1) {
+    std::vector<uint8_t> narrow_codes(cell_codes.begin(), cell_codes.end());
+    RETURN_NOT_OK(output->write(narrow_codes.data(), cell_num));
+  } else {
+    RETURN_NOT_OK(
+        output->write(cell_codes.data(), cell_num * sizeof(uint16_t)));
+  }
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_dictionary_forward);
+}
+
+Status DictionaryFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_dictionary_reverse);
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint8_t code_size;
+    uint32_t value_size, cell_num, dictionary_num;
+    RETURN_NOT_OK(input_metadata->read(&code_size, sizeof(uint8_t)));
+    RETURN_NOT_OK(input_metadata->read(&value_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&cell_num, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&dictionary_num, sizeof(uint32_t)));
+    if (code_size != 1 && code_size != 2)
+      return LOG_STATUS(Status::FilterError(
+          "Dictionary filter error; invalid code size"));
+
+    // Get the input as a contiguous buffer.
+    Buffer contiguous;
+    if (input->num_buffers() != 1) {
+      RETURN_NOT_OK(input->copy_to(&contiguous));
+      input->reset_offset();
+    }
+    ConstBuffer data = (input->num_buffers() == 1) ?
+                           input->buffers()[0] :
+                           ConstBuffer(contiguous.data(), contiguous.size());
+    auto bytes = static_cast<const char*>(data.data());
+    uint64_t bytes_left = data.size();
+
+    // Locate the dictionary values.
+    std::vector<Value> dictionary(dictionary_num);
+    if (value_size == 0) {
+      if (bytes_left < dictionary_num * sizeof(uint32_t))
+        return LOG_STATUS(Status::FilterError(
+            "Dictionary filter error; input is truncated"));
+      uint64_t values_offset = dictionary_num * sizeof(uint32_t);
+      for (uint32_t i = 0; i < dictionary_num; i++) {
+        uint32_t size;
+        std::memcpy(&size, bytes + i * sizeof(uint32_t), sizeof(uint32_t));
+        dictionary[i] = {bytes + values_offset, size};
+        values_offset += size;
+      }
+      if (bytes_left < values_offset)
+        return LOG_STATUS(Status::FilterError(
+            "Dictionary filter error; input is truncated"));
+      bytes += values_offset;
+      bytes_left -= values_offset;
+    } else {
+      uint64_t values_size = (uint64_t)dictionary_num * value_size;
+      if (bytes_left < values_size)
+        return LOG_STATUS(Status::FilterError(
+            "Dictionary filter error; input is truncated"));
+      for (uint32_t i = 0; i < dictionary_num; i++)
+        dictionary[i] = {bytes + (uint64_t)i * value_size, value_size};
+      bytes += values_size;
+      bytes_left -= values_size;
+    }
+
+    // Decode the codes.
+    if (bytes_left < (uint64_t)cell_num * code_size)
+      return LOG_STATUS(Status::FilterError(
+          "Dictionary filter error; input is truncated"));
+    std::vector<uint16_t> cell_codes(cell_num);
+    uint64_t output_size = 0;
+    for (uint32_t c = 0; c < cell_num; c++) {
+      uint16_t code;
+      if (code_size == 1) {
+        code = (uint8_t)bytes[c];
+      } else {
+        std::memcpy(&code, bytes + c * sizeof(uint16_t), sizeof(uint16_t));
+      }
+      if (code >= dictionary_num)
+        return LOG_STATUS(Status::FilterError(
+            "Dictionary filter error; invalid code"));
+      cell_codes[c] = code;
+      output_size += dictionary[code].size_;
+    }
+
+    RETURN_NOT_OK(output->prepend_buffer(output_size));
+    output->reset_offset();
+    for (auto code : cell_codes) {
+      const auto& value = dictionary[code];
+      RETURN_NOT_OK(output->write(value.data_, value.size_));
+    }
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used by
+  // this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_dictionary_reverse);
+}
+
+}  // namespace sm
+}  // namespace tiledb
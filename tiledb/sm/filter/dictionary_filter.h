@@ -0,0 +1,129 @@
+/**
+ * @file   dictionary_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class DictionaryFilter.
+ */
+
+#ifndef TILEDB_DICTIONARY_FILTER_H
+#define TILEDB_DICTIONARY_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that replaces the cell values of its input with integer codes
+ * into a dictionary of the distinct values. It targets low-cardinality
+ * attributes, and is meant to precede bit width reduction or compression.
+ *
+ * The values are the fixed-sized cells of the tile, or the var-sized cells
+ * if the pipeline knows the cell boundaries of the chunk (see
+ * `FilterPipeline::current_chunk_cell_sizes()`). The dictionary is built
+ * per chunk. If the input has more than 65536 distinct values, or if the
+ * encoding would not be smaller than the input, the input is forwarded
+ * unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded (1) or forwarded (0)
+ * and, if the input was encoded:
+ *   uint8_t - Size of a code in bytes (1 or 2)
+ *   uint32_t - Size of a value in bytes (0 for var-sized values)
+ *   uint32_t - Number of cells
+ *   uint32_t - Number of dictionary values
+ *
+ * The forward output data format of an encoded input is:
+ *   uint32_t[] - Size of each dictionary value (var-sized values only)
+ *   uint8_t[] - Concatenated dictionary values
+ *   uint8_t[]/uint16_t[] - Code of each cell
+ *
+ * The reverse output format is simply:
+ *   uint8_t[] - Array of original cell values
+ */
+class DictionaryFilter : public Filter {
+ public:
+  /** Constructor. */
+  DictionaryFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  DictionaryFilter* clone_impl() const override;
+
+  /**
+   * Computes the sizes of the values of the input chunk. Returns false if
+   * the input cannot be split into values.
+   *
+   * @param input The input chunk.
+   * @param value_size Set to the size of the values, or 0 if they are
+   *     var-sized.
+   * @param cell_sizes Set to the size of each value.
+   */
+  bool compute_cell_sizes(
+      const ConstBuffer& input,
+      uint32_t* value_size,
+      std::vector<uint64_t>* cell_sizes) const;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DICTIONARY_FILTER_H
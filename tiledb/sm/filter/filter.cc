@@ -32,16 +32,22 @@
 
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
+#include "tiledb/sm/filter/checksum_crc32c_filter.h"
 #include "tiledb/sm/filter/checksum_md5_filter.h"
 #include "tiledb/sm/filter/checksum_sha256_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
 #include "tiledb/sm/filter/noop_filter.h"
+#include "tiledb/sm/filter/offsets_delta_filter.h"
 #include "tiledb/sm/filter/positive_delta_filter.h"
+#include "tiledb/sm/filter/xor_filter.h"
 #include "tiledb/sm/misc/logger.h"
 
 namespace tiledb {
@@ -85,6 +91,16 @@ Filter* Filter::create(FilterType type) {
       return new (std::nothrow) ChecksumMD5Filter();
     case FilterType::FILTER_CHECKSUM_SHA256:
       return new (std::nothrow) ChecksumSHA256Filter();
+    case FilterType::FILTER_DICTIONARY:
+      return new (std::nothrow) DictionaryFilter();
+    case FilterType::FILTER_OFFSETS_DELTA:
+      return new (std::nothrow) OffsetsDeltaFilter();
+    case FilterType::FILTER_FRAME_OF_REFERENCE:
+      return new (std::nothrow) FrameOfReferenceFilter();
+    case FilterType::FILTER_XOR:
+      return new (std::nothrow) XorFilter();
+    case FilterType::FILTER_CHECKSUM_CRC32C:
+      return new (std::nothrow) ChecksumCRC32CFilter();
     default:
       assert(false);
       return nullptr;
@@ -113,14 +129,23 @@ Status Filter::deserialize(ConstBuffer* buff, Filter** filter) {
   if (f == nullptr)
     return LOG_STATUS(Status::FilterError("Deserialization error."));
 
-  auto offset = buff->offset();
-  RETURN_NOT_OK_ELSE(f->deserialize_impl(buff), delete f);
+  if (buff->nbytes_left_to_read() < filter_metadata_len) {
+    delete f;
+    return LOG_STATUS(Status::FilterError(
+        "Deserialization error; unexpected metadata length"));
+  }
+
+  // The filter reads its metadata from a buffer of the stored length, so
+  // that it can detect optional trailing fields.
+  ConstBuffer metadata(buff->cur_data(), filter_metadata_len);
+  RETURN_NOT_OK_ELSE(f->deserialize_impl(&metadata), delete f);
 
-  if (buff->offset() - offset != filter_metadata_len) {
+  if (metadata.offset() != filter_metadata_len) {
     delete f;
     return LOG_STATUS(Status::FilterError(
         "Deserialization error; unexpected metadata length"));
   }
+  buff->advance_offset(filter_metadata_len);
 
   *filter = f;
 
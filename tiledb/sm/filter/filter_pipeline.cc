@@ -44,12 +44,39 @@
 #include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <cstring>
+
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** The maximum number of idle buffers kept by each thread filter storage. */
+const uint64_t max_thread_storage_buffers = 16;
+
+/**
+ * Returns the filter storage of the calling thread, after making the
+ * buffers released by the chunks it previously processed available for
+ * reuse.
+ */
+FilterStorage* thread_filter_storage() {
+  static thread_local FilterStorage storage;
+  storage.reclaim_unused(max_thread_storage_buffers);
+  return &storage;
+}
+
+/**
+ * The cell sizes of the chunk that the calling thread is running forward
+ * through a pipeline (see `FilterPipeline::current_chunk_cell_sizes()`).
+ */
+thread_local const std::vector<uint64_t>* thread_chunk_cell_sizes = nullptr;
+
+}  // namespace
+
 FilterPipeline::FilterPipeline() {
   current_tile_ = nullptr;
   max_chunk_size_ = constants::max_tile_chunk_size;
+  verify_checksums_ = true;
 }
 
 FilterPipeline::FilterPipeline(const FilterPipeline& other) {
@@ -58,9 +85,11 @@ FilterPipeline::FilterPipeline(const FilterPipeline& other) {
   }
   current_tile_ = other.current_tile_;
   max_chunk_size_ = other.max_chunk_size_;
+  verify_checksums_ = other.verify_checksums_;
 }
 
-FilterPipeline::FilterPipeline(FilterPipeline&& other) {
+FilterPipeline::FilterPipeline(FilterPipeline&& other)
+    : FilterPipeline() {
   swap(other);
 }
 
@@ -127,12 +156,60 @@ Status FilterPipeline::compute_tile_chunks(
   return Status::Ok();
 }
 
+Status FilterPipeline::compute_tile_chunks_var(
+    Tile* tile,
+    const Tile* offsets_tile,
+    std::vector<std::pair<void*, uint32_t>>* chunks,
+    std::vector<std::vector<uint64_t>>* chunk_cell_sizes) const {
+  auto offsets = static_cast<const uint64_t*>(offsets_tile->internal_data());
+  auto cell_num = offsets_tile->size() / sizeof(uint64_t);
+  auto tile_size = tile->size();
+  auto data = static_cast<char*>(tile->internal_data());
+
+  // Add cells to the current chunk until the next one would exceed the max
+  // chunk size. A cell larger than the max chunk size forms its own chunk.
+  uint64_t chunk_start = 0, chunk_size = 0;
+  std::vector<uint64_t> cell_sizes;
+  for (uint64_t c = 0; c < cell_num; c++) {
+    auto cell_end = (c + 1 < cell_num) ? offsets[c + 1] : tile_size;
+    if (offsets[c] != chunk_start + chunk_size || cell_end < offsets[c] ||
+        cell_end > tile_size)
+      return LOG_STATUS(
+          Status::FilterError("Filter error; invalid var cell offsets"));
+    auto cell_size = cell_end - offsets[c];
+    if (chunk_size > 0 && chunk_size + cell_size > max_chunk_size_) {
+      chunks->emplace_back(data + chunk_start, (uint32_t)chunk_size);
+      chunk_cell_sizes->emplace_back();
+      chunk_cell_sizes->back().swap(cell_sizes);
+      chunk_start += chunk_size;
+      chunk_size = 0;
+    }
+    if (chunk_size + cell_size > std::numeric_limits<uint32_t>::max())
+      return LOG_STATUS(
+          Status::FilterError("Filter error; chunk size exceeds uint32_t"));
+    chunk_size += cell_size;
+    cell_sizes.push_back(cell_size);
+  }
+  if (chunk_size > 0 || chunks->empty()) {
+    chunks->emplace_back(data + chunk_start, (uint32_t)chunk_size);
+    chunk_cell_sizes->emplace_back();
+    chunk_cell_sizes->back().swap(cell_sizes);
+  }
+
+  return Status::Ok();
+}
+
 const Tile* FilterPipeline::current_tile() const {
   return current_tile_;
 }
 
+const std::vector<uint64_t>* FilterPipeline::current_chunk_cell_sizes() const {
+  return thread_chunk_cell_sizes;
+}
+
 Status FilterPipeline::filter_chunks_forward(
     const std::vector<std::pair<void*, uint32_t>>& chunks,
+    const std::vector<std::vector<uint64_t>>& chunk_cell_sizes,
     Buffer* output) const {
   // Vector storing the input and output of the final pipeline stage for each
   // chunk.
@@ -141,16 +218,25 @@ Status FilterPipeline::filter_chunks_forward(
 
   // Run each chunk through the entire pipeline.
   auto statuses = parallel_for(0, chunks.size(), [&](uint64_t i) {
-    // TODO(ttd): can we instead allocate one FilterStorage per thread?
-    // or make it threadsafe?
-    FilterStorage storage;
-    FilterBuffer input_data(&storage), output_data(&storage);
-    FilterBuffer input_metadata(&storage), output_metadata(&storage);
+    FilterStorage* storage = thread_filter_storage();
+    FilterBuffer input_data(storage), output_data(storage);
+    FilterBuffer input_metadata(storage), output_metadata(storage);
 
     // First filter's input is the original chunk.
     const auto& chunk_input = chunks[i];
     RETURN_NOT_OK(input_data.init(chunk_input.first, chunk_input.second));
 
+    // Expose the cell sizes of the chunk to the filters while they run.
+    struct CellSizesGuard {
+      explicit CellSizesGuard(const std::vector<uint64_t>* cell_sizes) {
+        thread_chunk_cell_sizes = cell_sizes;
+      }
+      ~CellSizesGuard() {
+        thread_chunk_cell_sizes = nullptr;
+      }
+    } cell_sizes_guard(
+        chunk_cell_sizes.empty() ? nullptr : &chunk_cell_sizes[i]);
+
     // Apply the filters sequentially.
     for (auto it = filters_.begin(), ite = filters_.end(); it != ite; ++it) {
       auto& f = *it;
@@ -175,8 +261,8 @@ Status FilterPipeline::filter_chunks_forward(
     }
 
     // Save the finished chunk (last stage's output). This is safe to do because
-    // when the local FilterStorage goes out of scope, it will not free the
-    // buffers saved here as their shared_ptr counters will not be zero.
+    // the thread's FilterStorage will not reuse or free the buffers saved here
+    // as long as their shared_ptr counters are greater than one.
     // However, as the output may have been a view on the input, we do need to
     // save both here to prevent the input buffer from being freed.
     auto& io = final_stage_io[i];
@@ -261,6 +347,7 @@ Status FilterPipeline::filter_chunks_forward(
 
 Status FilterPipeline::filter_chunks_reverse(
     const std::vector<std::tuple<void*, uint32_t, uint32_t, uint32_t>>& chunks,
+    const std::vector<bool>& decode,
     Buffer* output) const {
   // Precompute the offsets for the final chunks in the shared output buffer.
   std::vector<uint64_t> chunk_dest_offsets(chunks.size());
@@ -272,6 +359,12 @@ Status FilterPipeline::filter_chunks_reverse(
 
   // Run each chunk through the entire pipeline.
   auto statuses = parallel_for(0, chunks.size(), [&](uint64_t i) {
+    if (!decode.empty() && !decode[i]) {
+      std::memset(
+          output->data(chunk_dest_offsets[i]), 0, std::get<2>(chunks[i]));
+      return Status::Ok();
+    }
+
     const auto& chunk_input = chunks[i];
     uint32_t filtered_chunk_len = std::get<1>(chunk_input);
     uint32_t orig_chunk_len = std::get<2>(chunk_input);
@@ -279,11 +372,9 @@ Status FilterPipeline::filter_chunks_reverse(
     void* metadata = std::get<0>(chunk_input);
     void* chunk_data = (char*)metadata + metadata_len;
 
-    // TODO(ttd): can we instead allocate one FilterStorage per thread?
-    // or make it threadsafe?
-    FilterStorage storage;
-    FilterBuffer input_data(&storage), output_data(&storage);
-    FilterBuffer input_metadata(&storage), output_metadata(&storage);
+    FilterStorage* storage = thread_filter_storage();
+    FilterBuffer input_data(storage), output_data(storage);
+    FilterBuffer input_metadata(storage), output_metadata(storage);
 
     // First filter's input is the filtered chunk data.
     RETURN_NOT_OK(input_metadata.init(metadata, metadata_len));
@@ -354,14 +445,24 @@ uint32_t FilterPipeline::max_chunk_size() const {
   return max_chunk_size_;
 }
 
-Status FilterPipeline::run_forward(Tile* tile) const {
+bool FilterPipeline::verify_checksums() const {
+  return verify_checksums_;
+}
+
+Status FilterPipeline::run_forward(Tile* tile, const Tile* offsets_tile) const {
   STATS_FUNC_IN(filter_pipeline_run_forward);
 
   current_tile_ = tile;
 
   // Compute the chunks.
   std::vector<std::pair<void*, uint32_t>> chunks;
-  RETURN_NOT_OK(compute_tile_chunks(tile, &chunks));
+  std::vector<std::vector<uint64_t>> chunk_cell_sizes;
+  if (offsets_tile != nullptr && tile->size() > 0) {
+    RETURN_NOT_OK(compute_tile_chunks_var(
+        tile, offsets_tile, &chunks, &chunk_cell_sizes));
+  } else {
+    RETURN_NOT_OK(compute_tile_chunks(tile, &chunks));
+  }
   uint64_t num_chunks = chunks.size();
   if (num_chunks == 0)
     return Status::FilterError("Filter error; tile has 0 chunks.");
@@ -373,7 +474,8 @@ Status FilterPipeline::run_forward(Tile* tile) const {
   RETURN_NOT_OK(filtered_tile.write(&num_chunks, sizeof(uint64_t)));
 
   // Run the filters over all the chunks into the filtered_tile buffer.
-  RETURN_NOT_OK(filter_chunks_forward(chunks, &filtered_tile));
+  RETURN_NOT_OK(
+      filter_chunks_forward(chunks, chunk_cell_sizes, &filtered_tile));
 
   // Replace the tile's buffer with the filtered buffer.
   RETURN_NOT_OK(tile->buffer()->swap(filtered_tile));
@@ -384,6 +486,25 @@ Status FilterPipeline::run_forward(Tile* tile) const {
 }
 
 Status FilterPipeline::run_reverse(Tile* tile) const {
+  return run_reverse(tile, {});
+}
+
+Status FilterPipeline::run_reverse(
+    Tile* tile,
+    const std::vector<std::pair<uint64_t, uint64_t>>& ranges) const {
+  return run_reverse(tile, ranges, nullptr, 0);
+}
+
+Status FilterPipeline::run_reverse(
+    Tile* tile, void* dest, uint64_t dest_size) const {
+  return run_reverse(tile, {}, dest, dest_size);
+}
+
+Status FilterPipeline::run_reverse(
+    Tile* tile,
+    const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+    void* dest,
+    uint64_t dest_size) const {
   STATS_FUNC_IN(filter_pipeline_run_reverse);
 
   auto tile_buff = tile->buffer();
@@ -415,14 +536,37 @@ Status FilterPipeline::run_reverse(Tile* tile) const {
   }
   assert(tile_buff->offset() == tile_buff->size());
 
+  // Select the chunks overlapping the input ranges, if any.
+  std::vector<bool> decode;
+  if (!ranges.empty() && !tile->stores_coords()) {
+    decode.resize(num_chunks, false);
+    uint64_t chunk_start = 0;
+    size_t r = 0;
+    for (uint64_t i = 0; i < num_chunks; i++) {
+      uint64_t chunk_end = chunk_start + std::get<2>(chunks[i]);
+      while (r < ranges.size() && ranges[r].second <= chunk_start)
+        ++r;
+      decode[i] = r < ranges.size() && ranges[r].first < chunk_end;
+      chunk_start = chunk_end;
+    }
+  }
+
   // Allocate a buffer to hold the end result (the assembled, unfiltered
-  // chunks).
+  // chunks), or wrap the destination region.
   Buffer unfiltered_tile;
-  RETURN_NOT_OK(unfiltered_tile.realloc(total_orig_size));
+  if (dest == nullptr) {
+    RETURN_NOT_OK(unfiltered_tile.realloc(total_orig_size));
+  } else {
+    if (total_orig_size > dest_size)
+      return LOG_STATUS(Status::FilterError(
+          "Filter error; unfiltered tile does not fit in the destination"));
+    Buffer dest_buff(dest, total_orig_size);
+    RETURN_NOT_OK(unfiltered_tile.swap(dest_buff));
+  }
 
   // Run the filters in reverse over all the chunks into the unfiltered_tile
   // buffer.
-  RETURN_NOT_OK(filter_chunks_reverse(chunks, &unfiltered_tile));
+  RETURN_NOT_OK(filter_chunks_reverse(chunks, decode, &unfiltered_tile));
 
   // Replace the tile's buffer with the unfiltered buffer.
   RETURN_NOT_OK(tile->buffer()->swap(unfiltered_tile));
@@ -502,6 +646,10 @@ void FilterPipeline::set_max_chunk_size(uint32_t max_chunk_size) {
   max_chunk_size_ = max_chunk_size;
 }
 
+void FilterPipeline::set_verify_checksums(bool verify_checksums) {
+  verify_checksums_ = verify_checksums;
+}
+
 unsigned FilterPipeline::size() const {
   return static_cast<unsigned>(filters_.size());
 }
@@ -521,6 +669,7 @@ void FilterPipeline::swap(FilterPipeline& other) {
 
   std::swap(current_tile_, other.current_tile_);
   std::swap(max_chunk_size_, other.max_chunk_size_);
+  std::swap(verify_checksums_, other.verify_checksums_);
 }
 
 Status FilterPipeline::append_encryption_filter(
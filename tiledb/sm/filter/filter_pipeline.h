@@ -87,6 +87,14 @@ class FilterPipeline {
   /** Returns pointer to the current Tile being processed by run/run_reverse. */
   const Tile* current_tile() const;
 
+  /**
+   * Returns the sizes of the var-sized cells in the chunk that the calling
+   * thread is running forward, or `nullptr` if the cell boundaries are not
+   * known (i.e., the tile does not store var-sized values, or it was not
+   * filtered along with its offsets).
+   */
+  const std::vector<uint64_t>* current_chunk_cell_sizes() const;
+
   /**
    * Populates the filter pipeline from the data in the input binary buffer.
    *
@@ -133,6 +141,12 @@ class FilterPipeline {
   /** Returns the maximum tile chunk size. */
   uint32_t max_chunk_size() const;
 
+  /**
+   * Returns true if the checksum filters verify the checksums in the reverse
+   * direction (the default).
+   */
+  bool verify_checksums() const;
+
   /**
    * Runs the full pipeline on the given tile in the "forward" direction. The
    * forward direction is used during writes, and processes unfiltered (e.g.
@@ -169,10 +183,17 @@ class FilterPipeline {
    * The given Tile's underlying buffer is modified to contain the filtered
    * data.
    *
+   * If the tile stores var-sized values and its (unfiltered) offsets tile is
+   * given, the chunks are aligned on cell boundaries and the filters can
+   * retrieve the cell sizes of their chunk through
+   * `current_chunk_cell_sizes()`.
+   *
    * @param tile Tile to filter.
+   * @param offsets_tile The offsets of the var-sized cells of `tile`
+   *     (optional).
    * @return Status
    */
-  Status run_forward(Tile* tile) const;
+  Status run_forward(Tile* tile, const Tile* offsets_tile = nullptr) const;
 
   /**
    * Runs the pipeline in reverse on the given filtered tile. This is used
@@ -211,6 +232,37 @@ class FilterPipeline {
    */
   Status run_reverse(Tile* tile) const;
 
+  /**
+   * Same as `run_reverse(Tile*)`, but only the chunks overlapping the input
+   * byte ranges of the unfiltered tile are unfiltered. The chunk headers are
+   * used as an index to locate them. The unfiltered tile has its full size,
+   * but the bytes outside the decoded chunks are zeroed.
+   *
+   * Tiles storing zipped coordinates are always unfiltered in full.
+   *
+   * @param tile Tile to unfilter
+   * @param ranges The `[start, end)` byte ranges of the unfiltered tile that
+   *     must be decoded, sorted and non-overlapping.
+   * @return Status
+   */
+  Status run_reverse(
+      Tile* tile, const std::vector<std::pair<uint64_t, uint64_t>>& ranges)
+      const;
+
+  /**
+   * Same as `run_reverse(Tile*)`, but the tile is unfiltered directly into
+   * the input memory region (e.g., a user buffer), saving a copy. The
+   * tile buffer then wraps the region without owning it, so the region must
+   * outlive the tile.
+   *
+   * @param tile Tile to unfilter
+   * @param dest The memory region to unfilter the tile into.
+   * @param dest_size The size of `dest`. It is an error if the unfiltered
+   *     tile does not fit.
+   * @return Status
+   */
+  Status run_reverse(Tile* tile, void* dest, uint64_t dest_size) const;
+
   /**
    * Serializes the pipeline metadata into a binary buffer.
    *
@@ -222,6 +274,12 @@ class FilterPipeline {
   /** Sets the maximum tile chunk size. */
   void set_max_chunk_size(uint32_t max_chunk_size);
 
+  /**
+   * Sets whether the checksum filters verify the checksums in the reverse
+   * direction. If not, they only skip their metadata.
+   */
+  void set_verify_checksums(bool verify_checksums);
+
   /** Returns the number of filters in the pipeline. */
   unsigned size() const;
 
@@ -257,6 +315,9 @@ class FilterPipeline {
   /** The max chunk size allowed within tiles. */
   uint32_t max_chunk_size_;
 
+  /** Whether the checksum filters verify the checksums on reverse. */
+  bool verify_checksums_;
+
   /**
    * Compute chunks of the given tile, used in the forward direction.
    *
@@ -267,15 +328,36 @@ class FilterPipeline {
   Status compute_tile_chunks(
       Tile* tile, std::vector<std::pair<void*, uint32_t>>* chunks) const;
 
+  /**
+   * Compute chunks of the given var-sized tile that hold whole cells (unless
+   * a single cell exceeds the maximum chunk size), used in the forward
+   * direction.
+   *
+   * @param tile Tile to compute chunks for
+   * @param offsets_tile The offsets of the cells of `tile`
+   * @param chunks Output parameter storing the computed chunks
+   * @param chunk_cell_sizes Output parameter storing the cell sizes of each
+   *     chunk
+   * @return Status
+   */
+  Status compute_tile_chunks_var(
+      Tile* tile,
+      const Tile* offsets_tile,
+      std::vector<std::pair<void*, uint32_t>>* chunks,
+      std::vector<std::vector<uint64_t>>* chunk_cell_sizes) const;
+
   /**
    * Run the given list of chunks forward through the pipeline.
    *
    * @param chunks Chunks to process
+   * @param chunk_cell_sizes The cell sizes of each chunk, or empty if the
+   *     cell boundaries are not known.
    * @param output Buffer where output of last stage will be written.
    * @return Status
    */
   Status filter_chunks_forward(
       const std::vector<std::pair<void*, uint32_t>>& chunks,
+      const std::vector<std::vector<uint64_t>>& chunk_cell_sizes,
       Buffer* output) const;
 
   /**
@@ -283,13 +365,26 @@ class FilterPipeline {
    *
    * @param chunks Chunks to process. Format is
    *    (data ptr, filtered size, original size, metadata size).
+   * @param decode Flags marking the chunks to unfilter; empty for all. The
+   *    output of the skipped chunks is zeroed.
    * @param output Buffer where output of last stage will be written.
    * @return Status
    */
   Status filter_chunks_reverse(
       const std::vector<std::tuple<void*, uint32_t, uint32_t, uint32_t>>&
           chunks,
+      const std::vector<bool>& decode,
       Buffer* output) const;
+
+  /**
+   * Implements the `run_reverse` variants. The tile is unfiltered into
+   * `dest` if it is not `nullptr`, and into a new allocation otherwise.
+   */
+  Status run_reverse(
+      Tile* tile,
+      const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+      void* dest,
+      uint64_t dest_size) const;
 };
 
 }  // namespace sm
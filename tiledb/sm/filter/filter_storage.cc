@@ -32,13 +32,18 @@
 
 #include "tiledb/sm/filter/filter_storage.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/stats.h"
 
 namespace tiledb {
 namespace sm {
 
 std::shared_ptr<Buffer> FilterStorage::get_buffer() {
-  if (available_.empty())
+  if (available_.empty()) {
     available_.emplace_back(new Buffer());
+    STATS_COUNTER_ADD(filter_storage_buffers_allocated, 1);
+  } else {
+    STATS_COUNTER_ADD(filter_storage_buffers_reused, 1);
+  }
 
   std::shared_ptr<Buffer> buf = std::move(available_.front());
   Buffer* buf_ptr = buf.get();
@@ -80,5 +85,23 @@ Status FilterStorage::reclaim(Buffer* buffer) {
   return Status::Ok();
 }
 
+void FilterStorage::reclaim_unused(uint64_t max_available) {
+  for (auto it = in_use_.begin(); it != in_use_.end();) {
+    if (it->use_count() == 1) {
+      Buffer* buffer = it->get();
+      buffer->reset_offset();
+      buffer->reset_size();
+      in_use_list_map_.erase(buffer);
+      available_.push_front(std::move(*it));
+      it = in_use_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  while (available_.size() > max_available)
+    available_.pop_back();
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -76,6 +76,16 @@ class FilterStorage {
    */
   Status reclaim(Buffer* buffer);
 
+  /**
+   * Reclaims all the in-use buffers that are no longer referenced outside
+   * this instance, which allows reusing a storage instance across chunks
+   * and tiles. At most `max_available` buffers are kept available; the rest
+   * are freed.
+   *
+   * @param max_available The maximum number of available buffers to keep.
+   */
+  void reclaim_unused(uint64_t max_available);
+
  private:
   /** List of buffers that are available to be used (may be empty). */
   std::list<std::shared_ptr<Buffer>> available_;
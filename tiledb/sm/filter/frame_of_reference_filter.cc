@@ -0,0 +1,499 @@
+/**
+ * @file   frame_of_reference_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FrameOfReferenceFilter.
+ */
+
+#include "tiledb/sm/filter/frame_of_reference_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/bit_stream.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/simd_kernels.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** The maximum delta order. */
+const uint8_t max_order = 2;
+
+/** Maps small negative values to small positive ones. */
+template <class U>
+inline U zigzag(U v) {
+  const unsigned sign_shift = 8 * sizeof(U) - 1;
+  return (U)((U)(v << 1) ^ (U)(0 - (v >> sign_shift)));
+}
+
+/** The inverse of `zigzag`. */
+template <class U>
+inline U unzigzag(U v) {
+  return (U)((v >> 1) ^ (U)(0 - (v & 1)));
+}
+
+/** Replaces the values with their differences, wrapping around. */
+template <class U>
+void delta(U* values, uint64_t num) {
+  U prev = 0;
+  for (uint64_t i = 0; i < num; i++) {
+    U cur = values[i];
+    values[i] = (U)(cur - prev);
+    prev = cur;
+  }
+}
+
+/**
+ * Transforms the order-preserving keys of the input values according to
+ * the delta order.
+ */
+template <class U>
+void transform(U* values, uint64_t num, uint8_t order) {
+  for (uint8_t i = 0; i < order; i++)
+    delta(values, num);
+  if (order > 0) {
+    for (uint64_t i = 0; i < num; i++)
+      values[i] = zigzag(values[i]);
+  }
+}
+
+/** The packing parameters of a block. */
+template <class U>
+struct BlockLayout {
+  /** The reference, i.e., the minimum value. */
+  U ref_;
+  /** The bit width of the packed values. */
+  unsigned width_;
+  /** The bit width of the high bits of the exceptions. */
+  unsigned high_width_;
+  /** The number of exceptions. */
+  uint64_t exception_num_;
+  /** The size of the block in bits, excluding the padding. */
+  uint64_t size_;
+};
+
+/**
+ * Computes the layout of a block of `n` values, choosing the bit width that
+ * minimizes its size given that exceptions cost their position and their
+ * high bits.
+ */
+template <class U>
+BlockLayout<U> block_layout(const U* values, uint64_t n) {
+  U ref, max;
+  simd::min_max(values, n, &ref, &max);
+
+  // Histogram of the bit widths of the values minus the reference.
+  uint64_t width_count[65] = {0};
+  unsigned max_width = value_bit_width((uint64_t)(U)(max - ref));
+  for (uint64_t i = 0; i < n; i++)
+    width_count[value_bit_width((uint64_t)(U)(values[i] - ref))]++;
+
+  BlockLayout<U> layout;
+  layout.ref_ = ref;
+  layout.width_ = max_width;
+  layout.exception_num_ = 0;
+  layout.size_ = n * max_width;
+  uint64_t exception_num = 0;
+  for (unsigned w = max_width; w-- > 0;) {
+    exception_num += width_count[w + 1];
+    uint64_t size = n * w + 8 + exception_num * (8 + max_width - w);
+    if (size < layout.size_) {
+      layout.size_ = size;
+      layout.width_ = w;
+      layout.exception_num_ = exception_num;
+    }
+  }
+  layout.high_width_ = max_width - layout.width_;
+  layout.size_ += 16 + 8 * sizeof(U);
+
+  return layout;
+}
+
+/** Estimates the encoded size in bits of the input values. */
+template <class U>
+uint64_t estimate_size(const U* values, uint64_t num) {
+  const uint64_t block_size = FrameOfReferenceFilter::block_size;
+  uint64_t size = 0;
+  for (uint64_t i = 0; i < num; i += block_size)
+    size += block_layout(values + i, std::min(block_size, num - i)).size_;
+  return size;
+}
+
+/** Packs a block of `n` values. */
+template <class U>
+void encode_block(const U* values, uint64_t n, BitWriter* writer) {
+  auto layout = block_layout(values, n);
+  const U ref = layout.ref_;
+  const unsigned width = layout.width_;
+  const unsigned high_width = layout.high_width_;
+  const uint64_t exception_num = layout.exception_num_;
+
+  writer->write(width, 8);
+  writer->write(exception_num, 8);
+  writer->write(ref, 8 * sizeof(U));
+  if (exception_num > 0) {
+    writer->write(high_width, 8);
+    for (uint64_t i = 0; i < n; i++) {
+      if (((uint64_t)(U)(values[i] - ref) >> width) != 0)
+        writer->write(i, 8);
+    }
+  }
+  for (uint64_t i = 0; i < n; i++)
+    writer->write((U)(values[i] - ref), width);
+  if (exception_num > 0) {
+    for (uint64_t i = 0; i < n; i++) {
+      uint64_t value = (U)(values[i] - ref);
+      if ((value >> width) != 0)
+        writer->write(value >> width, high_width);
+    }
+  }
+  writer->flush();
+}
+
+/** Unpacks a block of `n` values. Returns false if the block is invalid. */
+template <class U>
+bool decode_block(BitReader* reader, uint64_t n, U* values) {
+  const unsigned value_bits = 8 * sizeof(U);
+  auto width = (unsigned)reader->read(8);
+  auto exception_num = reader->read(8);
+  auto ref = (U)reader->read(value_bits);
+  if (width > value_bits || exception_num > n)
+    return false;
+
+  unsigned high_width = 0;
+  uint8_t positions[FrameOfReferenceFilter::block_size];
+  if (exception_num > 0) {
+    high_width = (unsigned)reader->read(8);
+    if (width + high_width > value_bits)
+      return false;
+    for (uint64_t j = 0; j < exception_num; j++) {
+      positions[j] = (uint8_t)reader->read(8);
+      if (positions[j] >= n)
+        return false;
+    }
+  }
+
+  for (uint64_t i = 0; i < n; i++)
+    values[i] = (U)reader->read(width);
+  for (uint64_t j = 0; j < exception_num; j++)
+    values[positions[j]] |= (U)(reader->read(high_width) << width);
+  for (uint64_t i = 0; i < n; i++)
+    values[i] = (U)(values[i] + ref);
+  reader->align();
+
+  return !reader->overflow();
+}
+
+/**
+ * Encodes `num` values of type `U` (or its signed counterpart) into
+ * `encoded`, choosing the delta order that is estimated to pack best.
+ */
+template <class U>
+void encode(
+    const void* data,
+    uint64_t num,
+    bool is_signed,
+    uint8_t* order,
+    std::vector<uint8_t>* encoded) {
+  // Map the values to unsigned keys preserving their order.
+  const U sign = is_signed ? (U)((U)1 << (8 * sizeof(U) - 1)) : (U)0;
+  std::vector<U> keys(num);
+  std::memcpy(keys.data(), data, num * sizeof(U));
+  for (uint64_t i = 0; i < num; i++)
+    keys[i] ^= sign;
+
+  // Pick the delta order.
+  std::vector<U> values(keys);
+  uint64_t best_size = estimate_size(values.data(), num);
+  *order = 0;
+  for (uint8_t o = 1; o <= max_order; o++) {
+    values = keys;
+    transform(values.data(), num, o);
+    auto size = estimate_size(values.data(), num);
+    if (size < best_size) {
+      best_size = size;
+      *order = o;
+    }
+  }
+  if (*order != max_order) {
+    values = keys;
+    transform(values.data(), num, *order);
+  }
+
+  BitWriter writer(encoded);
+  const uint64_t block_size = FrameOfReferenceFilter::block_size;
+  for (uint64_t i = 0; i < num; i += block_size)
+    encode_block(values.data() + i, std::min(block_size, num - i), &writer);
+}
+
+/** Decodes `num` values into `values`. Returns false on invalid input. */
+template <class U>
+bool decode(
+    const uint8_t* encoded,
+    uint64_t encoded_size,
+    uint64_t num,
+    bool is_signed,
+    uint8_t order,
+    U* values) {
+  BitReader reader(encoded, encoded_size);
+  const uint64_t block_size = FrameOfReferenceFilter::block_size;
+  for (uint64_t i = 0; i < num; i += block_size) {
+    if (!decode_block(&reader, std::min(block_size, num - i), values + i))
+      return false;
+  }
+
+  if (order > 0) {
+    for (uint64_t i = 0; i < num; i++)
+      values[i] = unzigzag(values[i]);
+    for (uint8_t o = 0; o < order; o++)
+      simd::prefix_sum(values, num, (U)0, values);
+  }
+
+  if (is_signed) {
+    const U sign = (U)((U)1 << (8 * sizeof(U) - 1));
+    for (uint64_t i = 0; i < num; i++)
+      values[i] ^= sign;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+const uint64_t FrameOfReferenceFilter::block_size;
+
+FrameOfReferenceFilter::FrameOfReferenceFilter()
+    : Filter(FilterType::FILTER_FRAME_OF_REFERENCE) {
+}
+
+FrameOfReferenceFilter* FrameOfReferenceFilter::clone_impl() const {
+  return new FrameOfReferenceFilter;
+}
+
+void FrameOfReferenceFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "FrameOfReference");
+}
+
+Status FrameOfReferenceFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+
+  return Status::Ok();
+}
+
+Status FrameOfReferenceFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_frame_of_reference_forward);
+
+  auto tile_type = pipeline_->current_tile()->type();
+  if (!datatype_is_integer(tile_type) && !datatype_is_datetime(tile_type))
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+  auto value_size = datatype_size(tile_type);
+  bool is_signed = datatype_is_datetime(tile_type) ||
+                   tile_type == Datatype::INT8 ||
+                   tile_type == Datatype::INT16 ||
+                   tile_type == Datatype::INT32 || tile_type == Datatype::INT64;
+
+  auto num = input->size() / value_size;
+  if (num == 0 || input->size() % value_size != 0 ||
+      num > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Get the input as a contiguous buffer.
+  Buffer contiguous;
+  if (input->num_buffers() != 1) {
+    RETURN_NOT_OK(input->copy_to(&contiguous));
+    input->reset_offset();
+  }
+  ConstBuffer data = (input->num_buffers() == 1) ?
+                         input->buffers()[0] :
+                         ConstBuffer(contiguous.data(), contiguous.size());
+
+  std::vector<uint8_t> encoded;
+  encoded.reserve(data.size() / 2);
+  uint8_t order = 0;
+  switch (value_size) {
+    case sizeof(uint8_t):
+      encode<uint8_t>(data.data(), num, is_signed, &order, &encoded);
+      break;
+    case sizeof(uint16_t):
+      encode<uint16_t>(data.data(), num, is_signed, &order, &encoded);
+      break;
+    case sizeof(uint32_t):
+      encode<uint32_t>(data.data(), num, is_signed, &order, &encoded);
+      break;
+    case sizeof(uint64_t):
+      encode<uint64_t>(data.data(), num, is_signed, &order, &encoded);
+      break;
+    default:
+      return forward_unencoded(input_metadata, input, output_metadata, output);
+  }
+  auto header_size = 4 * sizeof(uint8_t) + sizeof(uint32_t);
+  if (encoded.size() + header_size >= data.size())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Write the header.
+  uint8_t header[] = {
+      1, (uint8_t)value_size, (uint8_t)(is_signed ? 1 : 0), order};
+  auto header_num = (uint32_t)num;
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(header_size));
+  RETURN_NOT_OK(output_metadata->write(header, sizeof(header)));
+  RETURN_NOT_OK(output_metadata->write(&header_num, sizeof(uint32_t)));
+
+  // Write the packed blocks.
+  RETURN_NOT_OK(output->prepend_buffer(encoded.size()));
+  output->reset_offset();
+  RETURN_NOT_OK(output->write(encoded.data(), encoded.size()));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_frame_of_reference_forward);
+}
+
+Status FrameOfReferenceFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_frame_of_reference_reverse);
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint8_t value_size, is_signed, order;
+    uint32_t num;
+    RETURN_NOT_OK(input_metadata->read(&value_size, sizeof(uint8_t)));
+    RETURN_NOT_OK(input_metadata->read(&is_signed, sizeof(uint8_t)));
+    RETURN_NOT_OK(input_metadata->read(&order, sizeof(uint8_t)));
+    RETURN_NOT_OK(input_metadata->read(&num, sizeof(uint32_t)));
+    if (order > max_order)
+      return LOG_STATUS(Status::FilterError(
+          "Frame of reference filter error; invalid delta order"));
+
+    // Get the input as a contiguous buffer.
+    Buffer contiguous;
+    if (input->num_buffers() != 1) {
+      RETURN_NOT_OK(input->copy_to(&contiguous));
+      input->reset_offset();
+    }
+    ConstBuffer data = (input->num_buffers() == 1) ?
+                           input->buffers()[0] :
+                           ConstBuffer(contiguous.data(), contiguous.size());
+    auto packed = static_cast<const uint8_t*>(data.data());
+
+    RETURN_NOT_OK(output->prepend_buffer((uint64_t)num * value_size));
+    output->reset_offset();
+    auto values = output->buffer_ptr(0)->data();
+
+    bool ok;
+    switch (value_size) {
+      case sizeof(uint8_t):
+        ok = decode(
+            packed,
+            data.size(),
+            num,
+            is_signed != 0,
+            order,
+            static_cast<uint8_t*>(values));
+        break;
+      case sizeof(uint16_t):
+        ok = decode(
+            packed,
+            data.size(),
+            num,
+            is_signed != 0,
+            order,
+            static_cast<uint16_t*>(values));
+        break;
+      case sizeof(uint32_t):
+        ok = decode(
+            packed,
+            data.size(),
+            num,
+            is_signed != 0,
+            order,
+            static_cast<uint32_t*>(values));
+        break;
+      case sizeof(uint64_t):
+        ok = decode(
+            packed,
+            data.size(),
+            num,
+            is_signed != 0,
+            order,
+            static_cast<uint64_t*>(values));
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok)
+      return LOG_STATUS(Status::FilterError(
+          "Frame of reference filter error; invalid encoded input"));
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used by
+  // this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_frame_of_reference_reverse);
+}
+
+}  // namespace sm
+}  // namespace tiledb
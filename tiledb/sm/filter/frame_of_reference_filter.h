@@ -0,0 +1,132 @@
+/**
+ * @file   frame_of_reference_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class FrameOfReferenceFilter.
+ */
+
+#ifndef TILEDB_FRAME_OF_REFERENCE_FILTER_H
+#define TILEDB_FRAME_OF_REFERENCE_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A patched frame-of-reference (PFOR) bit-packing filter for integer
+ * attributes and dimensions, e.g., sorted timestamps or clustered IDs.
+ *
+ * The values are first mapped to unsigned keys preserving their order.
+ * Depending on which is estimated to pack best, the filter then encodes
+ * either the keys (order 0), their deltas (order 1), or their deltas of
+ * deltas (order 2), the latter two zigzag-encoded so that small negative
+ * values stay small. The resulting values are split in blocks of
+ * `block_size` values. Each block stores its minimum (the reference) and
+ * the values minus the reference with a common bit width. The values that
+ * need more bits are stored as exceptions, whose high bits are packed
+ * separately, so that a few outliers do not widen the whole block.
+ *
+ * If the tile does not store integers, or if the encoding would not be
+ * smaller than the input, the input is forwarded unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded (1) or forwarded (0)
+ * and, if the input was encoded:
+ *   uint8_t - Size in bytes `s` of a value
+ *   uint8_t - Whether the values are signed
+ *   uint8_t - Delta order
+ *   uint32_t - Number of values
+ *
+ * The forward output data format of an encoded input is a sequence of
+ * blocks, each with the format:
+ *   uint8_t - Bit width `w` of the packed values
+ *   uint8_t - Number of exceptions `e`
+ *   uint8_t[s] - The reference
+ * and, if `e > 0`:
+ *   uint8_t - Bit width `h` of the high bits of the exceptions
+ *   uint8_t[e] - Positions of the exceptions in the block
+ * followed by:
+ *   uint8_t[] - The values minus the reference, `w` bits each
+ *   uint8_t[] - The exception values minus the reference, shifted right
+ *       by `w` bits, `h` bits each
+ * Bits are packed least significant bit first.
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of the original values
+ */
+class FrameOfReferenceFilter : public Filter {
+ public:
+  /** Number of values packed with the same reference and bit width. */
+  static const uint64_t block_size = 128;
+
+  /** Constructor. */
+  FrameOfReferenceFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  FrameOfReferenceFilter* clone_impl() const override;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAME_OF_REFERENCE_FILTER_H
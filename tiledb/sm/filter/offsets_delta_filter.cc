@@ -0,0 +1,289 @@
+/**
+ * @file   offsets_delta_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class OffsetsDeltaFilter.
+ */
+
+#include "tiledb/sm/filter/offsets_delta_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/**
+ * The maximum bit width of a delta, so that a delta always fits in the
+ * 64-bit accumulator next to the (at most 7) pending bits.
+ */
+const uint8_t max_bit_width = 56;
+
+/** Returns the value at the input index of an unaligned `uint64_t` array. */
+inline uint64_t load_offset(const char* data, uint64_t i) {
+  uint64_t value;
+  std::memcpy(&value, data + i * sizeof(uint64_t), sizeof(uint64_t));
+  return value;
+}
+
+/**
+ * Unpacks `num` values of `bit_width` bits from `packed` into `values`.
+ * `packed` must hold `ceil(num * bit_width / 8)` bytes.
+ */
+inline void unpack(
+    const uint8_t* packed, uint64_t num, uint8_t bit_width, uint64_t* values) {
+  if (bit_width == 0) {
+    std::fill(values, values + num, (uint64_t)0);
+    return;
+  }
+
+  const uint64_t mask = (uint64_t(1) << bit_width) - 1;
+  uint64_t acc = 0;
+  unsigned acc_bits = 0;
+  for (uint64_t i = 0; i < num; i++) {
+    while (acc_bits < bit_width) {
+      acc |= (uint64_t)(*packed++) << acc_bits;
+      acc_bits += 8;
+    }
+    values[i] = acc & mask;
+    acc >>= bit_width;
+    acc_bits -= bit_width;
+  }
+}
+
+}  // namespace
+
+const uint64_t OffsetsDeltaFilter::block_size;
+
+OffsetsDeltaFilter::OffsetsDeltaFilter()
+    : Filter(FilterType::FILTER_OFFSETS_DELTA) {
+}
+
+OffsetsDeltaFilter* OffsetsDeltaFilter::clone_impl() const {
+  return new OffsetsDeltaFilter;
+}
+
+void OffsetsDeltaFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "OffsetsDelta");
+}
+
+bool OffsetsDeltaFilter::encode(
+    const uint64_t* offsets,
+    uint64_t offset_num,
+    std::vector<uint8_t>* encoded) const {
+  auto data = reinterpret_cast<const char*>(offsets);
+  uint64_t deltas[block_size];
+  uint64_t prev = load_offset(data, 0);
+  for (uint64_t i = 1; i < offset_num; i += block_size) {
+    // Compute the deltas and the bit width of the block.
+    auto num = std::min(block_size, offset_num - i);
+    uint64_t max_delta = 0;
+    for (uint64_t j = 0; j < num; j++) {
+      auto offset = load_offset(data, i + j);
+      if (offset < prev)
+        return false;
+      deltas[j] = offset - prev;
+      max_delta |= deltas[j];
+      prev = offset;
+    }
+    uint8_t bit_width = 0;
+    while (bit_width < 64 && (max_delta >> bit_width) != 0)
+      bit_width++;
+    if (bit_width > max_bit_width)
+      return false;
+
+    // Pack the deltas.
+    encoded->push_back(bit_width);
+    if (bit_width == 0)
+      continue;
+    uint64_t acc = 0;
+    unsigned acc_bits = 0;
+    for (uint64_t j = 0; j < num; j++) {
+      acc |= deltas[j] << acc_bits;
+      acc_bits += bit_width;
+      while (acc_bits >= 8) {
+        encoded->push_back((uint8_t)acc);
+        acc >>= 8;
+        acc_bits -= 8;
+      }
+    }
+    if (acc_bits > 0)
+      encoded->push_back((uint8_t)acc);
+  }
+
+  return true;
+}
+
+Status OffsetsDeltaFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+
+  return Status::Ok();
+}
+
+Status OffsetsDeltaFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_offsets_delta_forward);
+
+  // The offsets must be contiguous.
+  if (input->num_buffers() != 1)
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+  ConstBuffer data = input->buffers()[0];
+  auto offset_num = data.size() / sizeof(uint64_t);
+  if (offset_num == 0 || data.size() % sizeof(uint64_t) != 0 ||
+      offset_num > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  std::vector<uint8_t> encoded;
+  encoded.reserve(data.size() / 2);
+  auto offsets = static_cast<const uint64_t*>(data.data());
+  if (!encode(offsets, offset_num, &encoded) ||
+      encoded.size() + sizeof(uint32_t) + sizeof(uint64_t) >= data.size())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Write the header.
+  uint8_t is_encoded = 1;
+  auto header_offset_num = (uint32_t)offset_num;
+  uint64_t first_offset;
+  std::memcpy(&first_offset, data.data(), sizeof(uint64_t));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(
+      sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint64_t)));
+  RETURN_NOT_OK(output_metadata->write(&is_encoded, sizeof(uint8_t)));
+  RETURN_NOT_OK(output_metadata->write(&header_offset_num, sizeof(uint32_t)));
+  RETURN_NOT_OK(output_metadata->write(&first_offset, sizeof(uint64_t)));
+
+  // Write the packed deltas.
+  RETURN_NOT_OK(output->prepend_buffer(encoded.size()));
+  output->reset_offset();
+  RETURN_NOT_OK(output->write(encoded.data(), encoded.size()));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_offsets_delta_forward);
+}
+
+Status OffsetsDeltaFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_offsets_delta_reverse);
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint32_t offset_num;
+    uint64_t first_offset;
+    RETURN_NOT_OK(input_metadata->read(&offset_num, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&first_offset, sizeof(uint64_t)));
+
+    // Get the input as a contiguous buffer.
+    Buffer contiguous;
+    if (input->num_buffers() != 1) {
+      RETURN_NOT_OK(input->copy_to(&contiguous));
+      input->reset_offset();
+    }
+    ConstBuffer data = (input->num_buffers() == 1) ?
+                           input->buffers()[0] :
+                           ConstBuffer(contiguous.data(), contiguous.size());
+    auto packed = static_cast<const uint8_t*>(data.data());
+    uint64_t bytes_left = data.size();
+
+    RETURN_NOT_OK(output->prepend_buffer(offset_num * sizeof(uint64_t)));
+    output->reset_offset();
+    auto offsets = static_cast<uint64_t*>(output->buffer_ptr(0)->data());
+
+    // Unpack each block of deltas and compute their prefix sums on top of
+    // the last offset of the previous block.
+    uint64_t deltas[block_size];
+    uint64_t value = first_offset;
+    if (offset_num > 0)
+      offsets[0] = value;
+    for (uint64_t i = 1; i < offset_num; i += block_size) {
+      auto num = std::min(block_size, (uint64_t)offset_num - i);
+      if (bytes_left < 1)
+        return LOG_STATUS(Status::FilterError(
+            "Offsets delta filter error; input is truncated"));
+      uint8_t bit_width = *packed++;
+      bytes_left--;
+      if (bit_width > max_bit_width)
+        return LOG_STATUS(Status::FilterError(
+            "Offsets delta filter error; invalid bit width"));
+      uint64_t packed_size = (num * bit_width + 7) / 8;
+      if (bytes_left < packed_size)
+        return LOG_STATUS(Status::FilterError(
+            "Offsets delta filter error; input is truncated"));
+
+      unpack(packed, num, bit_width, deltas);
+      packed += packed_size;
+      bytes_left -= packed_size;
+      for (uint64_t j = 0; j < num; j++) {
+        value += deltas[j];
+        offsets[i + j] = value;
+      }
+    }
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used by
+  // this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_offsets_delta_reverse);
+}
+
+}  // namespace sm
+}  // namespace tiledb
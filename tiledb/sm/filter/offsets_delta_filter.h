@@ -0,0 +1,124 @@
+/**
+ * @file   offsets_delta_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class OffsetsDeltaFilter.
+ */
+
+#ifndef TILEDB_OFFSETS_DELTA_FILTER_H
+#define TILEDB_OFFSETS_DELTA_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter for the offsets tiles of var-sized attributes. It replaces the
+ * non-decreasing `uint64_t` offsets of its input with the deltas between
+ * consecutive offsets (i.e., the cell sizes), bit-packed in blocks of
+ * `block_size` deltas with the minimum bit width of each block.
+ *
+ * If the input is not a sequence of non-decreasing `uint64_t` values, if a
+ * delta needs more than 56 bits, or if the encoding would not be smaller
+ * than the input, the input is forwarded unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded (1) or forwarded (0)
+ * and, if the input was encoded:
+ *   uint32_t - Number of offsets
+ *   uint64_t - First offset
+ *
+ * The forward output data format of an encoded input is a sequence of
+ * blocks, each with the format:
+ *   uint8_t - Bit width `w` of the deltas of the block
+ *   uint8_t[] - The deltas of the block, `w` bits each, packed least
+ *       significant bit first
+ *
+ * The reverse output format is simply:
+ *   uint64_t[] - Array of the original offsets
+ */
+class OffsetsDeltaFilter : public Filter {
+ public:
+  /** Number of deltas packed with the same bit width. */
+  static const uint64_t block_size = 128;
+
+  /** Constructor. */
+  OffsetsDeltaFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  OffsetsDeltaFilter* clone_impl() const override;
+
+  /**
+   * Encodes the input offsets into `encoded`. Returns false if the offsets
+   * cannot be encoded.
+   */
+  bool encode(
+      const uint64_t* offsets,
+      uint64_t offset_num,
+      std::vector<uint8_t>* encoded) const;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_OFFSETS_DELTA_FILTER_H
@@ -35,7 +35,9 @@
 #include "tiledb/sm/enums/filter_option.h"
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/simd_kernels.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/tile/tile.h"
 
@@ -58,6 +60,8 @@ Status PositiveDeltaFilter::run_forward(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_positive_delta_forward);
+
   auto tile_type = pipeline_->current_tile()->type();
 
   // If encoding can't work, just return the input unmodified.
@@ -110,6 +114,8 @@ Status PositiveDeltaFilter::run_forward(
       return LOG_STATUS(
           Status::FilterError("Cannot filter; Unsupported input type"));
   }
+
+  STATS_FUNC_OUT(filter_positive_delta_forward);
 }
 
 template <typename T>
@@ -172,6 +178,9 @@ Status PositiveDeltaFilter::encode_part(
   uint32_t num_windows =
       input_bytes / window_size + uint32_t(bool(input_bytes % window_size));
 
+  // Windows are encoded into this buffer and written to the output at once.
+  std::vector<T> deltas(window_size / sizeof(T));
+
   // Write each window.
   for (uint32_t i = 0; i < num_windows; i++) {
     // Compute the actual size in bytes of the window (may be smaller at the end
@@ -192,19 +201,13 @@ Status PositiveDeltaFilter::encode_part(
       input->advance_offset(window_nbytes);
     } else {
       // Encode and write the relative values to output.
-      T prev_value = input->value<T>();
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T curr_value = input->value<T>();
-        if (curr_value < prev_value)
-          return LOG_STATUS(Status::FilterError(
-              "Positive delta filter error: delta is not positive."));
-
-        T delta = curr_value - prev_value;
-        RETURN_NOT_OK(output->write(&delta, sizeof(T)));
-        input->advance_offset(sizeof(T));
-
-        prev_value = curr_value;
-      }
+      auto values = (const T*)((const char*)input->data() + input->offset());
+      if (!simd::delta_encode(
+              values, window_nelts, window_value_offset, deltas.data()))
+        return LOG_STATUS(Status::FilterError(
+            "Positive delta filter error: delta is not positive."));
+      RETURN_NOT_OK(output->write(deltas.data(), window_nbytes));
+      input->advance_offset(window_nbytes);
     }
   }
 
@@ -216,6 +219,8 @@ Status PositiveDeltaFilter::run_reverse(
     FilterBuffer* input,
     FilterBuffer* output_metadata,
     FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_positive_delta_reverse);
+
   auto tile_type = pipeline_->current_tile()->type();
 
   // If encoding wasn't applied, just return the input unmodified.
@@ -268,6 +273,8 @@ Status PositiveDeltaFilter::run_reverse(
       return LOG_STATUS(
           Status::FilterError("Cannot filter; Unsupported input type"));
   }
+
+  STATS_FUNC_OUT(filter_positive_delta_reverse);
 }
 
 template <typename T>
@@ -285,6 +292,9 @@ Status PositiveDeltaFilter::run_reverse(
   RETURN_NOT_OK(output->prepend_buffer(input->size()));
   output->reset_offset();
 
+  // Windows are decoded in place in this buffer.
+  std::vector<T> values;
+
   // Read each window
   for (uint32_t i = 0; i < num_windows; i++) {
     uint32_t window_nbytes;
@@ -298,17 +308,13 @@ Status PositiveDeltaFilter::run_reverse(
       RETURN_NOT_OK(output->write(input, window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Read and decode each window value.
+      // Read and decode the window values.
       uint32_t window_nelts = window_nbytes / sizeof(T);
-      T prev_value = window_value_offset;
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T delta;
-        RETURN_NOT_OK(input->read(&delta, sizeof(T)));
-        T decoded_value = prev_value + delta;
-        RETURN_NOT_OK(output->write(&decoded_value, tile_type_size));
-
-        prev_value = decoded_value;
-      }
+      values.resize(window_nelts);
+      RETURN_NOT_OK(input->read(values.data(), window_nbytes));
+      simd::prefix_sum(
+          values.data(), window_nelts, window_value_offset, values.data());
+      RETURN_NOT_OK(output->write(values.data(), window_nbytes));
     }
   }
 
@@ -0,0 +1,481 @@
+/**
+ * @file   simd_kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the vectorized kernels used by the filters.
+ */
+
+#include "tiledb/sm/filter/simd_kernels.h"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TILEDB_SIMD_SSE42_ENABLED
+#include <nmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define TILEDB_SIMD_AVX2_ENABLED
+#include <immintrin.h>
+#endif
+
+#if defined(TILEDB_SIMD_SSE42_ENABLED) || defined(TILEDB_SIMD_AVX2_ENABLED)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// GCC and Clang only emit the SSE4.2 instructions in functions targeting it.
+#if defined(TILEDB_SIMD_SSE42_ENABLED) && !defined(_MSC_VER)
+#define TILEDB_SIMD_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define TILEDB_SIMD_TARGET_SSE42
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace simd {
+
+namespace {
+
+/** Returns `a - b`, wrapping around on overflow. */
+template <class T>
+inline T wrap_sub(T a, T b) {
+  typedef typename std::make_unsigned<T>::type U;
+  return static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+}
+
+/** Returns `a + b`, wrapping around on overflow. */
+template <class T>
+inline T wrap_add(T a, T b) {
+  typedef typename std::make_unsigned<T>::type U;
+  return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+}
+
+/** The CRC32C (Castagnoli) polynomial, bit-reflected. */
+const uint32_t crc32c_poly = 0x82F63B78;
+
+/** Lookup tables of the slicing-by-8 CRC32C implementation. */
+struct Crc32cTables {
+  uint32_t t_[8][256];
+
+  Crc32cTables() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; j++)
+        crc = (crc >> 1) ^ ((crc & 1) ? crc32c_poly : 0);
+      t_[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (int k = 1; k < 8; k++)
+        t_[k][i] = (t_[k - 1][i] >> 8) ^ t_[0][t_[k - 1][i] & 0xFF];
+    }
+  }
+};
+
+const Crc32cTables& crc32c_tables() {
+  static const Crc32cTables tables;
+  return tables;
+}
+
+#if defined(TILEDB_SIMD_SSE42_ENABLED)
+
+/** Checks the CPU support for SSE4.2 with the CPUID instruction. */
+bool cpu_supports_sse42() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#else
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    return false;
+  return (ecx & bit_SSE4_2) != 0;
+#endif
+}
+
+/** Computes the CRC32C with the SSE4.2 CRC32 instruction. */
+TILEDB_SIMD_TARGET_SSE42 uint32_t
+sse42_crc32c(uint32_t crc, const uint8_t* data, uint64_t size) {
+  uint64_t crc64 = crc;
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    crc64 = _mm_crc32_u64(crc64, word);
+    data += sizeof(uint64_t);
+  }
+  auto crc32 = static_cast<uint32_t>(crc64);
+  for (; size > 0; size--)
+    crc32 = _mm_crc32_u8(crc32, *data++);
+  return crc32;
+}
+
+#endif  // TILEDB_SIMD_SSE42_ENABLED
+
+#if defined(TILEDB_SIMD_AVX2_ENABLED)
+
+/** Checks the CPU and OS support for AVX2 with the CPUID instruction. */
+bool cpu_supports_avx2() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+    return false;
+  if ((_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0, nullptr) < 7)
+    return false;
+  __cpuid(1, eax, ebx, ecx, edx);
+  if ((ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0)
+    return false;
+  // The OS must save the YMM registers on context switches.
+  unsigned xcr0_lo, xcr0_hi;
+  __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  if ((xcr0_lo & 6) != 6)
+    return false;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  return (ebx & bit_AVX2) != 0;
+#endif
+}
+
+inline __m256i loadu(const void* p) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+inline void storeu(void* p, __m256i x) {
+  _mm256_storeu_si256(static_cast<__m256i*>(p), x);
+}
+
+/** AVX2 operations on 32-bit lanes. */
+struct Ops32 {
+  static const unsigned width = 8;
+
+  static __m256i add(__m256i a, __m256i b) {
+    return _mm256_add_epi32(a, b);
+  }
+
+  static __m256i sub(__m256i a, __m256i b) {
+    return _mm256_sub_epi32(a, b);
+  }
+
+  static __m256i set1(uint32_t v) {
+    return _mm256_set1_epi32((int32_t)v);
+  }
+
+  /** Returns the inclusive prefix sums of the lanes. */
+  static __m256i scan(__m256i x) {
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    // Add the last sum of the low 128 bits to the high 128 bits.
+    __m256i low = _mm256_permute2x128_si256(x, x, 0x08);
+    return _mm256_add_epi32(x, _mm256_shuffle_epi32(low, 0xFF));
+  }
+
+  /** Broadcasts the last lane. */
+  static __m256i broadcast_last(__m256i x) {
+    return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7));
+  }
+
+  static uint32_t first(__m256i x) {
+    return (uint32_t)_mm256_cvtsi256_si32(x);
+  }
+};
+
+/** AVX2 operations on 64-bit lanes. */
+struct Ops64 {
+  static const unsigned width = 4;
+
+  static __m256i add(__m256i a, __m256i b) {
+    return _mm256_add_epi64(a, b);
+  }
+
+  static __m256i sub(__m256i a, __m256i b) {
+    return _mm256_sub_epi64(a, b);
+  }
+
+  static __m256i set1(uint64_t v) {
+    return _mm256_set1_epi64x((int64_t)v);
+  }
+
+  /** Returns the inclusive prefix sums of the lanes. */
+  static __m256i scan(__m256i x) {
+    x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+    // Add the last sum of the low 128 bits to the high 128 bits.
+    __m256i low = _mm256_permute2x128_si256(x, x, 0x08);
+    return _mm256_add_epi64(x, _mm256_shuffle_epi32(low, 0xEE));
+  }
+
+  /** Broadcasts the last lane. */
+  static __m256i broadcast_last(__m256i x) {
+    return _mm256_permute4x64_epi64(x, 0xFF);
+  }
+
+  static uint64_t first(__m256i x) {
+    return (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(x));
+  }
+};
+
+/** Lane operations specific to the value type. */
+template <class T>
+struct Avx2Ops;
+
+template <>
+struct Avx2Ops<int32_t> : Ops32 {
+  static __m256i lt(__m256i a, __m256i b) {
+    return _mm256_cmpgt_epi32(b, a);
+  }
+};
+
+template <>
+struct Avx2Ops<uint32_t> : Ops32 {
+  static __m256i lt(__m256i a, __m256i b) {
+    const __m256i sign = _mm256_set1_epi32(INT32_MIN);
+    return _mm256_cmpgt_epi32(
+        _mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+  }
+};
+
+template <>
+struct Avx2Ops<int64_t> : Ops64 {
+  static __m256i lt(__m256i a, __m256i b) {
+    return _mm256_cmpgt_epi64(b, a);
+  }
+};
+
+template <>
+struct Avx2Ops<uint64_t> : Ops64 {
+  static __m256i lt(__m256i a, __m256i b) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(
+        _mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+  }
+};
+
+template <class T>
+bool avx2_delta_encode(const T* in, uint64_t num, T prev, T* out) {
+  typedef Avx2Ops<T> Ops;
+  const uint64_t width = Ops::width;
+  if (num == 0)
+    return true;
+  if (in[0] < prev)
+    return false;
+  out[0] = wrap_sub(in[0], prev);
+
+  // Each vector of values is subtracted the vector shifted by one value.
+  __m256i decreasing = _mm256_setzero_si256();
+  uint64_t i = 1;
+  for (; i + width <= num; i += width) {
+    __m256i cur = loadu(in + i);
+    __m256i prv = loadu(in + i - 1);
+    decreasing = _mm256_or_si256(decreasing, Ops::lt(cur, prv));
+    storeu(out + i, Ops::sub(cur, prv));
+  }
+  if (!_mm256_testz_si256(decreasing, decreasing))
+    return false;
+
+  return generic::delta_encode(in + i, num - i, in[i - 1], out + i);
+}
+
+template <class T>
+void avx2_prefix_sum(const T* in, uint64_t num, T first, T* out) {
+  typedef Avx2Ops<T> Ops;
+  const uint64_t width = Ops::width;
+
+  // The running sum is carried over in all the lanes.
+  __m256i carry = Ops::set1(first);
+  uint64_t i = 0;
+  for (; i + width <= num; i += width) {
+    __m256i x = Ops::add(Ops::scan(loadu(in + i)), carry);
+    storeu(out + i, x);
+    carry = Ops::broadcast_last(x);
+  }
+
+  generic::prefix_sum(in + i, num - i, (T)Ops::first(carry), out + i);
+}
+
+/** Value types with an AVX2 implementation. */
+template <class T>
+struct HasAvx2
+    : std::integral_constant<bool, sizeof(T) == 4 || sizeof(T) == 8> {};
+
+template <class T>
+inline bool dispatch_delta_encode(
+    const T* in, uint64_t num, T prev, T* out, std::true_type) {
+  if (avx2_enabled())
+    return avx2_delta_encode(in, num, prev, out);
+  return generic::delta_encode(in, num, prev, out);
+}
+
+template <class T>
+inline void dispatch_prefix_sum(
+    const T* in, uint64_t num, T first, T* out, std::true_type) {
+  if (avx2_enabled())
+    avx2_prefix_sum(in, num, first, out);
+  else
+    generic::prefix_sum(in, num, first, out);
+}
+
+#else
+
+template <class T>
+struct HasAvx2 : std::false_type {};
+
+#endif  // TILEDB_SIMD_AVX2_ENABLED
+
+template <class T>
+inline bool dispatch_delta_encode(
+    const T* in, uint64_t num, T prev, T* out, std::false_type) {
+  return generic::delta_encode(in, num, prev, out);
+}
+
+template <class T>
+inline void dispatch_prefix_sum(
+    const T* in, uint64_t num, T first, T* out, std::false_type) {
+  generic::prefix_sum(in, num, first, out);
+}
+
+}  // namespace
+
+/* ********************************* */
+/*              GENERIC              */
+/* ********************************* */
+
+namespace generic {
+
+template <class T>
+bool delta_encode(const T* in, uint64_t num, T prev, T* out) {
+  for (uint64_t i = 0; i < num; i++) {
+    if (in[i] < prev)
+      return false;
+    out[i] = wrap_sub(in[i], prev);
+    prev = in[i];
+  }
+  return true;
+}
+
+template <class T>
+void prefix_sum(const T* in, uint64_t num, T first, T* out) {
+  T sum = first;
+  for (uint64_t i = 0; i < num; i++) {
+    sum = wrap_add(sum, in[i]);
+    out[i] = sum;
+  }
+}
+
+uint32_t crc32c(uint32_t crc, const void* data, uint64_t size) {
+  const auto& t = crc32c_tables().t_;
+  auto p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  // Process 8 bytes at a time, in little-endian order.
+  for (; size >= 8; size -= 8, p += 8) {
+    uint32_t lo = crc ^ (uint32_t(p[0]) | uint32_t(p[1]) << 8 |
+                         uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^
+          t[4][lo >> 24] ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+  for (; size > 0; size--, p++)
+    crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+  return ~crc;
+}
+
+}  // namespace generic
+
+/* ********************************* */
+/*             DISPATCH              */
+/* ********************************* */
+
+bool avx2_enabled() {
+#if defined(TILEDB_SIMD_AVX2_ENABLED)
+  static const bool enabled = cpu_supports_avx2();
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+bool sse42_enabled() {
+#if defined(TILEDB_SIMD_SSE42_ENABLED)
+  static const bool enabled = cpu_supports_sse42();
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+uint32_t crc32c(uint32_t crc, const void* data, uint64_t size) {
+#if defined(TILEDB_SIMD_SSE42_ENABLED)
+  if (sse42_enabled())
+    return ~sse42_crc32c(~crc, static_cast<const uint8_t*>(data), size);
+#endif
+  return generic::crc32c(crc, data, size);
+}
+
+template <class T>
+bool delta_encode(const T* in, uint64_t num, T prev, T* out) {
+  return dispatch_delta_encode(in, num, prev, out, HasAvx2<T>());
+}
+
+template <class T>
+void prefix_sum(const T* in, uint64_t num, T first, T* out) {
+  dispatch_prefix_sum(in, num, first, out, HasAvx2<T>());
+}
+
+/* ********************************* */
+/*     EXPLICIT INSTANTIATIONS       */
+/* ********************************* */
+
+#define TILEDB_SIMD_INSTANTIATE(T)                                   \
+  template bool delta_encode<T>(const T*, uint64_t, T, T*);          \
+  template void prefix_sum<T>(const T*, uint64_t, T, T*);            \
+  template bool generic::delta_encode<T>(const T*, uint64_t, T, T*); \
+  template void generic::prefix_sum<T>(const T*, uint64_t, T, T*);
+
+TILEDB_SIMD_INSTANTIATE(int8_t)
+TILEDB_SIMD_INSTANTIATE(uint8_t)
+TILEDB_SIMD_INSTANTIATE(int16_t)
+TILEDB_SIMD_INSTANTIATE(uint16_t)
+TILEDB_SIMD_INSTANTIATE(int32_t)
+TILEDB_SIMD_INSTANTIATE(uint32_t)
+TILEDB_SIMD_INSTANTIATE(int64_t)
+TILEDB_SIMD_INSTANTIATE(uint64_t)
+
+#undef TILEDB_SIMD_INSTANTIATE
+
+}  // namespace simd
+}  // namespace sm
+}  // namespace tiledb
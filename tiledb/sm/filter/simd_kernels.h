@@ -0,0 +1,134 @@
+/**
+ * @file   simd_kernels.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the vectorized kernels used by the filters.
+ */
+
+#ifndef TILEDB_SIMD_KERNELS_H
+#define TILEDB_SIMD_KERNELS_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Kernels over contiguous arrays of integers, used by the bit width
+ * reduction, positive delta and frame of reference filters, and the CRC32C
+ * checksum of the CRC32C checksum filter.
+ *
+ * The delta and prefix sum functions select an AVX2 implementation at runtime
+ * when the library was built with AVX2 support and the host processor
+ * supports it, like the vendored blosc shuffle routines do. Otherwise, and
+ * for the value types without a vectorized implementation, they use the
+ * portable implementations of `simd::generic`. Both produce bit-identical
+ * results; integer arithmetic wraps around.
+ */
+namespace simd {
+
+/** Returns true if the kernels use their AVX2 implementation. */
+bool avx2_enabled();
+
+/** Returns true if `crc32c` uses the SSE4.2 CRC32 instruction. */
+bool sse42_enabled();
+
+/**
+ * Extends the CRC32C (Castagnoli) checksum `crc` of some preceding data with
+ * `size` bytes of `data`. The checksum of a whole buffer is computed with
+ * `crc = 0`. This selects the SSE4.2 implementation at runtime on x86-64
+ * processors that support it.
+ */
+uint32_t crc32c(uint32_t crc, const void* data, uint64_t size);
+
+/**
+ * Computes `out[i] = in[i] - in[i - 1]`, with `in[-1] = prev`. Returns
+ * false if some `in[i] < in[i - 1]`, in which case `out` is undefined.
+ */
+template <class T>
+bool delta_encode(const T* in, uint64_t num, T prev, T* out);
+
+/**
+ * Computes `out[i] = out[i - 1] + in[i]`, with `out[-1] = first`. `in`
+ * and `out` may be the same array.
+ */
+template <class T>
+void prefix_sum(const T* in, uint64_t num, T first, T* out);
+
+/**
+ * Computes the minimum and maximum of `num > 0` values. This and the
+ * following loops have no loop-carried dependencies, so they are left for
+ * the compiler to vectorize.
+ */
+template <class T>
+inline void min_max(const T* values, uint64_t num, T* min, T* max) {
+  T lo = values[0], hi = values[0];
+  for (uint64_t i = 1; i < num; i++) {
+    lo = values[i] < lo ? values[i] : lo;
+    hi = values[i] > hi ? values[i] : hi;
+  }
+  *min = lo;
+  *max = hi;
+}
+
+/** Computes `out[i] = (U)(in[i] - offset)`. */
+template <class T, class U>
+inline void narrow(const T* in, uint64_t num, T offset, U* out) {
+  for (uint64_t i = 0; i < num; i++)
+    out[i] = static_cast<U>(in[i] - offset);
+}
+
+/** Computes `out[i] = (T)in[i] + offset`, the inverse of `narrow`. */
+template <class T, class U>
+inline void widen(const U* in, uint64_t num, T offset, T* out) {
+  for (uint64_t i = 0; i < num; i++)
+    out[i] = static_cast<T>(static_cast<T>(in[i]) + offset);
+}
+
+/** Portable implementations of the kernels. */
+namespace generic {
+
+/** See `simd::delta_encode`. */
+template <class T>
+bool delta_encode(const T* in, uint64_t num, T prev, T* out);
+
+/** See `simd::prefix_sum`. */
+template <class T>
+void prefix_sum(const T* in, uint64_t num, T first, T* out);
+
+/** See `simd::crc32c`. This is a slicing-by-8 table implementation. */
+uint32_t crc32c(uint32_t crc, const void* data, uint64_t size);
+
+}  // namespace generic
+
+}  // namespace simd
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SIMD_KERNELS_H
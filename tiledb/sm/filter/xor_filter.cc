@@ -0,0 +1,285 @@
+/**
+ * @file   xor_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class XorFilter.
+ */
+
+#include "tiledb/sm/filter/xor_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/filter_type.h"
+#include "tiledb/sm/filter/bit_stream.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Returns the number of trailing zero bits of `v != 0`. */
+inline unsigned trailing_zeros(uint64_t v) {
+  return value_bit_width(v & (~v + 1)) - 1;
+}
+
+/** Encodes `num > 0` values with the bit representation `U`. */
+template <class U>
+void encode(const void* data, uint64_t num, std::vector<uint8_t>* encoded) {
+  const unsigned value_bits = 8 * sizeof(U);
+  const unsigned field_bits = (sizeof(U) == 4) ? 5 : 6;
+  auto values = static_cast<const char*>(data);
+
+  BitWriter writer(encoded);
+  U prev;
+  std::memcpy(&prev, values, sizeof(U));
+  writer.write(prev, value_bits);
+
+  // The window of the previous stored XOR, none initially.
+  unsigned window_lz = value_bits, window_tz = value_bits;
+  for (uint64_t i = 1; i < num; i++) {
+    U value;
+    std::memcpy(&value, values + i * sizeof(U), sizeof(U));
+    U x = value ^ prev;
+    prev = value;
+    if (x == 0) {
+      writer.write(0, 1);
+      continue;
+    }
+
+    unsigned lz = value_bits - value_bit_width(x);
+    unsigned tz = trailing_zeros(x);
+    if (lz >= window_lz && tz >= window_tz &&
+        window_lz + window_tz < value_bits) {
+      writer.write(1, 1);
+      writer.write(0, 1);
+      writer.write(x >> window_tz, value_bits - window_lz - window_tz);
+    } else {
+      unsigned len = value_bits - lz - tz;
+      writer.write(1, 1);
+      writer.write(1, 1);
+      writer.write(lz, field_bits);
+      writer.write(len - 1, field_bits);
+      writer.write(x >> tz, len);
+      window_lz = lz;
+      window_tz = tz;
+    }
+  }
+  writer.flush();
+}
+
+/** Decodes `num > 0` values. Returns false on invalid input. */
+template <class U>
+bool decode(
+    const uint8_t* encoded, uint64_t encoded_size, uint64_t num, U* values) {
+  const unsigned value_bits = 8 * sizeof(U);
+  const unsigned field_bits = (sizeof(U) == 4) ? 5 : 6;
+
+  BitReader reader(encoded, encoded_size);
+  U prev = (U)reader.read(value_bits);
+  values[0] = prev;
+
+  unsigned window_lz = value_bits, window_tz = value_bits;
+  for (uint64_t i = 1; i < num; i++) {
+    if (reader.read(1) != 0) {
+      if (reader.read(1) == 0) {
+        if (window_lz + window_tz >= value_bits)
+          return false;
+        U x = (U)reader.read(value_bits - window_lz - window_tz);
+        prev ^= (U)(x << window_tz);
+      } else {
+        auto lz = (unsigned)reader.read(field_bits);
+        auto len = (unsigned)reader.read(field_bits) + 1;
+        if (lz + len > value_bits)
+          return false;
+        window_lz = lz;
+        window_tz = value_bits - lz - len;
+        U x = (U)reader.read(len);
+        prev ^= (U)(x << window_tz);
+      }
+    }
+    values[i] = prev;
+    if (reader.overflow())
+      return false;
+  }
+
+  return !reader.overflow();
+}
+
+}  // namespace
+
+XorFilter::XorFilter()
+    : Filter(FilterType::FILTER_XOR) {
+}
+
+XorFilter* XorFilter::clone_impl() const {
+  return new XorFilter;
+}
+
+void XorFilter::dump(FILE* out) const {
+  if (out == nullptr)
+    out = stdout;
+  fprintf(out, "Xor");
+}
+
+Status XorFilter::forward_unencoded(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(sizeof(uint8_t)));
+  uint8_t encoded = 0;
+  RETURN_NOT_OK(output_metadata->write(&encoded, sizeof(uint8_t)));
+
+  return Status::Ok();
+}
+
+Status XorFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_xor_forward);
+
+  auto tile_type = pipeline_->current_tile()->type();
+  if (!datatype_is_real(tile_type))
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+  auto value_size = datatype_size(tile_type);
+  auto num = input->size() / value_size;
+  if (num == 0 || input->size() % value_size != 0 ||
+      num > std::numeric_limits<uint32_t>::max())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Get the input as a contiguous buffer.
+  Buffer contiguous;
+  if (input->num_buffers() != 1) {
+    RETURN_NOT_OK(input->copy_to(&contiguous));
+    input->reset_offset();
+  }
+  ConstBuffer data = (input->num_buffers() == 1) ?
+                         input->buffers()[0] :
+                         ConstBuffer(contiguous.data(), contiguous.size());
+
+  std::vector<uint8_t> encoded;
+  encoded.reserve(data.size() / 2);
+  if (value_size == sizeof(uint32_t))
+    encode<uint32_t>(data.data(), num, &encoded);
+  else
+    encode<uint64_t>(data.data(), num, &encoded);
+  auto header_size = 2 * sizeof(uint8_t) + sizeof(uint32_t);
+  if (encoded.size() + header_size >= data.size())
+    return forward_unencoded(input_metadata, input, output_metadata, output);
+
+  // Write the header.
+  uint8_t header[] = {1, (uint8_t)value_size};
+  auto header_num = (uint32_t)num;
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(header_size));
+  RETURN_NOT_OK(output_metadata->write(header, sizeof(header)));
+  RETURN_NOT_OK(output_metadata->write(&header_num, sizeof(uint32_t)));
+
+  // Write the bit stream.
+  RETURN_NOT_OK(output->prepend_buffer(encoded.size()));
+  output->reset_offset();
+  RETURN_NOT_OK(output->write(encoded.data(), encoded.size()));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_xor_forward);
+}
+
+Status XorFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  STATS_FUNC_IN(filter_xor_reverse);
+
+  uint8_t encoded;
+  RETURN_NOT_OK(input_metadata->read(&encoded, sizeof(uint8_t)));
+
+  if (encoded == 0) {
+    RETURN_NOT_OK(output->append_view(input));
+  } else {
+    uint8_t value_size;
+    uint32_t num;
+    RETURN_NOT_OK(input_metadata->read(&value_size, sizeof(uint8_t)));
+    RETURN_NOT_OK(input_metadata->read(&num, sizeof(uint32_t)));
+    if ((value_size != sizeof(uint32_t) && value_size != sizeof(uint64_t)) ||
+        num == 0)
+      return LOG_STATUS(
+          Status::FilterError("Xor filter error; invalid encoded input"));
+
+    // Get the input as a contiguous buffer.
+    Buffer contiguous;
+    if (input->num_buffers() != 1) {
+      RETURN_NOT_OK(input->copy_to(&contiguous));
+      input->reset_offset();
+    }
+    ConstBuffer data = (input->num_buffers() == 1) ?
+                           input->buffers()[0] :
+                           ConstBuffer(contiguous.data(), contiguous.size());
+    auto bits = static_cast<const uint8_t*>(data.data());
+
+    RETURN_NOT_OK(output->prepend_buffer((uint64_t)num * value_size));
+    output->reset_offset();
+    auto values = output->buffer_ptr(0)->data();
+
+    bool ok;
+    if (value_size == sizeof(uint32_t))
+      ok = decode(bits, data.size(), num, static_cast<uint32_t*>(values));
+    else
+      ok = decode(bits, data.size(), num, static_cast<uint64_t*>(values));
+    if (!ok)
+      return LOG_STATUS(
+          Status::FilterError("Xor filter error; invalid encoded input"));
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used by
+  // this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(filter_xor_reverse);
+}
+
+}  // namespace sm
+}  // namespace tiledb
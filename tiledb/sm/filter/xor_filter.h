@@ -0,0 +1,116 @@
+/**
+ * @file   xor_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class XorFilter.
+ */
+
+#ifndef TILEDB_XOR_FILTER_H
+#define TILEDB_XOR_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A Gorilla-style XOR encoding filter for floating point attributes and
+ * dimensions, suited to slowly changing series of values.
+ *
+ * Each value is XOR-ed with the previous one. Since close values share
+ * their sign, exponent and leading mantissa bits, the result has many
+ * leading (and often trailing) zero bits, and only its meaningful bits are
+ * stored:
+ *   - '0' if the value equals the previous one,
+ *   - '10' and the meaningful bits, if they fit in the window of leading
+ *     and trailing zeros of the previous stored XOR,
+ *   - '11', the number of leading zeros, the number of meaningful bits
+ *     minus one (5 bits each for 32-bit values, 6 for 64-bit values) and
+ *     the meaningful bits otherwise, which also sets the new window.
+ * The first value is stored as is.
+ *
+ * If the tile does not store floating point values, or if the encoding
+ * would not be smaller than the input, the input is forwarded unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint8_t - Whether the input was encoded (1) or forwarded (0)
+ * and, if the input was encoded:
+ *   uint8_t - Size in bytes of a value (4 or 8)
+ *   uint32_t - Number of values
+ *
+ * The forward output data format of an encoded input is the bit stream
+ * described above, packed least significant bit first.
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of the original values
+ */
+class XorFilter : public Filter {
+ public:
+  /** Constructor. */
+  XorFilter();
+
+  /** Dumps the filter details in ASCII format in the selected output. */
+  void dump(FILE* out) const override;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  XorFilter* clone_impl() const override;
+
+  /** Forwards the input unmodified, marking it as not encoded. */
+  Status forward_unencoded(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_XOR_FILTER_H
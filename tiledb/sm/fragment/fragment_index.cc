@@ -0,0 +1,148 @@
+/**
+ * @file   fragment_index.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class FragmentIndex.
+ */
+
+#include "tiledb/sm/fragment/fragment_index.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/constants.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+FragmentIndex::FragmentIndex(
+    const Domain* domain,
+    const std::vector<FragmentMetadata*>& fragment_metadata)
+    : domain_(domain)
+    , fragment_metadata_(fragment_metadata)
+    , rtree_(domain, constants::rtree_fanout)
+    , dense_rtree_(domain, constants::rtree_fanout) {
+  std::vector<NDRange> domains, dense_non_empty_domains;
+  auto fragment_num = (unsigned)fragment_metadata_.size();
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    auto meta = fragment_metadata[f];
+    const auto& non_empty_domain = meta->non_empty_domain();
+    if (non_empty_domain.empty())
+      continue;
+    fragment_ids_.push_back(f);
+    if (meta->dense()) {
+      // The tile overlap of a dense fragment is computed on its domain
+      // expanded to the tile boundaries
+      domains.push_back(meta->domain());
+      dense_fragment_ids_.push_back(f);
+      dense_non_empty_domains.push_back(non_empty_domain);
+    } else {
+      domains.push_back(non_empty_domain);
+    }
+  }
+
+  // Setting the leaves and building the trees do not fail
+  if (!domains.empty()) {
+    rtree_.set_leaves(domains);
+    rtree_.build_tree();
+  }
+  if (!dense_non_empty_domains.empty()) {
+    dense_rtree_.set_leaves(dense_non_empty_domains);
+    dense_rtree_.build_tree();
+  }
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+const std::vector<FragmentMetadata*>& FragmentIndex::fragment_metadata()
+    const {
+  return fragment_metadata_;
+}
+
+std::vector<unsigned> FragmentIndex::overlapping_fragments(
+    const NDRange& range) const {
+  std::vector<unsigned> ret;
+  if (fragment_ids_.empty())
+    return ret;
+
+  auto leaves = overlapping_leaves(rtree_, range);
+  ret.reserve(leaves.size());
+  for (auto l : leaves)
+    ret.push_back(fragment_ids_[l]);
+
+  return ret;
+}
+
+bool FragmentIndex::covered_by_later_dense(
+    unsigned frag_idx, const NDRange& mbr) const {
+  // The dense fragments are sorted on their timestamps, so only the leaves
+  // starting from the first dense fragment after `frag_idx` are candidates
+  auto first = std::upper_bound(
+                   dense_fragment_ids_.begin(),
+                   dense_fragment_ids_.end(),
+                   frag_idx) -
+               dense_fragment_ids_.begin();
+  if ((size_t)first == dense_fragment_ids_.size())
+    return false;
+
+  for (auto l : overlapping_leaves(dense_rtree_, mbr)) {
+    if (l >= (uint64_t)first && domain_->covered(mbr, dense_rtree_.leaf(l)))
+      return true;
+  }
+
+  return false;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+std::vector<uint64_t> FragmentIndex::overlapping_leaves(
+    const RTree& rtree, const NDRange& range) {
+  std::vector<uint64_t> ret;
+  auto overlap = rtree.get_tile_overlap(range);
+  for (const auto& t : overlap.tiles_)
+    ret.push_back(t.first);
+  for (const auto& r : overlap.tile_ranges_) {
+    for (uint64_t l = r.first; l <= r.second; ++l)
+      ret.push_back(l);
+  }
+  std::sort(ret.begin(), ret.end());
+
+  return ret;
+}
+
+}  // namespace sm
+}  // namespace tiledb
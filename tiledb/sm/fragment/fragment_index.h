@@ -0,0 +1,136 @@
+/**
+ * @file   fragment_index.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FragmentIndex.
+ */
+
+#ifndef TILEDB_FRAGMENT_INDEX_H
+#define TILEDB_FRAGMENT_INDEX_H
+
+#include <cinttypes>
+#include <vector>
+
+#include "tiledb/sm/misc/types.h"
+#include "tiledb/sm/rtree/rtree.h"
+
+namespace tiledb {
+namespace sm {
+
+class Domain;
+class FragmentMetadata;
+
+/**
+ * An index over the domains of the fragments an array is opened with. It
+ * answers which fragments intersect a range and whether a tile is
+ * overwritten by a later dense fragment in logarithmic time in the number
+ * of fragments, instead of checking every fragment.
+ *
+ * The fragments are given in the order of their timestamps, and so are the
+ * fragment ids the index returns.
+ */
+class FragmentIndex {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param domain The array domain. It must outlive the index.
+   * @param fragment_metadata The metadata of the fragments to index, sorted
+   *     on their timestamps.
+   */
+  FragmentIndex(
+      const Domain* domain,
+      const std::vector<FragmentMetadata*>& fragment_metadata);
+
+  /** Destructor. */
+  ~FragmentIndex() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the metadata of the indexed fragments. */
+  const std::vector<FragmentMetadata*>& fragment_metadata() const;
+
+  /**
+   * Returns the ids of the fragments whose domain intersects the input
+   * range, in increasing order. This is the non-empty domain for sparse
+   * fragments, and the non-empty domain expanded to the tile boundaries for
+   * dense fragments.
+   */
+  std::vector<unsigned> overlapping_fragments(const NDRange& range) const;
+
+  /**
+   * Returns `true` if the input MBR of a tile of fragment `frag_idx` is
+   * covered by the non-empty domain of a dense fragment written after it.
+   */
+  bool covered_by_later_dense(unsigned frag_idx, const NDRange& mbr) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The array domain. */
+  const Domain* domain_;
+
+  /** The metadata of the indexed fragments. */
+  std::vector<FragmentMetadata*> fragment_metadata_;
+
+  /** The fragment id of each leaf of `rtree_`. */
+  std::vector<unsigned> fragment_ids_;
+
+  /**
+   * An R-Tree over the domains of all fragments (see
+   * `overlapping_fragments`).
+   */
+  RTree rtree_;
+
+  /** The fragment id of each leaf of `dense_rtree_`, in increasing order. */
+  std::vector<unsigned> dense_fragment_ids_;
+
+  /** An R-Tree over the non-empty domains of the dense fragments. */
+  RTree dense_rtree_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the ids of the leaves of `rtree` that intersect `range`. */
+  static std::vector<uint64_t> overlapping_leaves(
+      const RTree& rtree, const NDRange& range);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FRAGMENT_INDEX_H
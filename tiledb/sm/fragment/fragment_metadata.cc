@@ -37,6 +37,8 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
@@ -405,10 +407,6 @@ uint64_t FragmentMetadata::last_tile_cell_num() const {
 }
 
 Status FragmentMetadata::load(const EncryptionKey& encryption_key) {
-  auto meta_uri = fragment_uri_.join_path(
-      std::string(constants::fragment_metadata_filename));
-  RETURN_NOT_OK(storage_manager_->vfs()->file_size(meta_uri, &meta_file_size_));
-
   // Get fragment name version
   uint32_t f_version;
   RETURN_NOT_OK(
@@ -422,8 +420,15 @@ Status FragmentMetadata::load(const EncryptionKey& encryption_key) {
   //    * __t1_t2_uuid
   //  - Version 3 corresponds to version 5 or higher
   //    * __t1_t2_uuid_version
-  if (f_version == 1)
+  if (f_version == 1) {
+    auto meta_uri = fragment_uri_.join_path(
+        std::string(constants::fragment_metadata_filename));
+    RETURN_NOT_OK(
+        storage_manager_->vfs()->file_size(meta_uri, &meta_file_size_));
     return load_v1_v2(encryption_key);
+  }
+
+  // The metadata file size is loaded along with the footer
   return load_v3_or_higher(encryption_key);
 }
 
@@ -860,6 +865,9 @@ Status FragmentMetadata::load_rtree(const EncryptionKey& encryption_key) {
   if (version_ <= 2)
     return Status::Ok();
 
+  if (loaded_metadata_.rtree_)
+    return Status::Ok();
+
   std::lock_guard<std::mutex> lock(mtx_);
 
   if (loaded_metadata_.rtree_)
@@ -882,6 +890,9 @@ Status FragmentMetadata::load_tile_offsets(
   if (version_ <= 2)
     return Status::Ok();
 
+  if (loaded_metadata_.tile_offsets_[idx])
+    return Status::Ok();
+
   std::lock_guard<std::mutex> lock(mtx_);
 
   if (loaded_metadata_.tile_offsets_[idx])
@@ -903,6 +914,9 @@ Status FragmentMetadata::load_tile_var_offsets(
   if (version_ <= 2)
     return Status::Ok();
 
+  if (loaded_metadata_.tile_var_offsets_[idx])
+    return Status::Ok();
+
   std::lock_guard<std::mutex> lock(mtx_);
 
   if (loaded_metadata_.tile_var_offsets_[idx])
@@ -925,6 +939,9 @@ Status FragmentMetadata::load_tile_var_sizes(
   if (version_ <= 2)
     return Status::Ok();
 
+  if (loaded_metadata_.tile_var_sizes_[idx])
+    return Status::Ok();
+
   std::lock_guard<std::mutex> lock(mtx_);
 
   if (loaded_metadata_.tile_var_sizes_[idx])
@@ -1197,8 +1214,10 @@ Status FragmentMetadata::load_tile_offsets(ConstBuffer* buff) {
     }
   }
 
-  loaded_metadata_.tile_offsets_.resize(
-      array_schema_->attribute_num() + 1, true);
+  LoadedMetadata::reset(
+      &loaded_metadata_.tile_offsets_,
+      array_schema_->attribute_num() + 1,
+      true);
 
   return Status::Ok();
 }
@@ -1269,8 +1288,10 @@ Status FragmentMetadata::load_tile_var_offsets(ConstBuffer* buff) {
     }
   }
 
-  loaded_metadata_.tile_var_offsets_.resize(
-      array_schema_->attribute_num(), true);
+  LoadedMetadata::reset(
+      &loaded_metadata_.tile_var_offsets_,
+      array_schema_->attribute_num(),
+      true);
 
   return Status::Ok();
 }
@@ -1342,7 +1363,10 @@ Status FragmentMetadata::load_tile_var_sizes(ConstBuffer* buff) {
     }
   }
 
-  loaded_metadata_.tile_var_sizes_.resize(array_schema_->attribute_num(), true);
+  LoadedMetadata::reset(
+      &loaded_metadata_.tile_var_sizes_,
+      array_schema_->attribute_num(),
+      true);
 
   return Status::Ok();
 }
@@ -1500,10 +1524,31 @@ Status FragmentMetadata::load_footer(const EncryptionKey& encryption_key) {
   if (loaded_metadata_.footer_)
     return Status::Ok();
 
+  // The footer is cached along with the metadata file size it is located
+  // with, so that opening a cached fragment performs no I/O
+  auto cache_key = fragment_uri_
+                       .join_path(constants::fragment_metadata_filename)
+                       .to_string() +
+                   "+footer";
   Buffer buff;
-  RETURN_NOT_OK(read_file_footer(&buff));
+  bool in_cache = false;
+  RETURN_NOT_OK(storage_manager_->read_from_fragment_metadata_cache(
+      cache_key, &buff, &in_cache));
+  if (!in_cache) {
+    auto meta_uri = fragment_uri_.join_path(
+        std::string(constants::fragment_metadata_filename));
+    RETURN_NOT_OK(
+        storage_manager_->vfs()->file_size(meta_uri, &meta_file_size_));
+    Buffer footer;
+    RETURN_NOT_OK(read_file_footer(&footer));
+    RETURN_NOT_OK(buff.write(&meta_file_size_, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff.write(footer.data(), footer.size()));
+    RETURN_NOT_OK(
+        storage_manager_->write_to_fragment_metadata_cache(cache_key, buff));
+  }
 
   ConstBuffer cbuff(&buff);
+  RETURN_NOT_OK(cbuff.read(&meta_file_size_, sizeof(uint64_t)));
   RETURN_NOT_OK(load_version(&cbuff));
   RETURN_NOT_OK(load_dense(&cbuff));
   RETURN_NOT_OK(load_non_empty_domain(&cbuff));
@@ -1519,9 +1564,9 @@ Status FragmentMetadata::load_footer(const EncryptionKey& encryption_key) {
   tile_var_offsets_.resize(num);
   tile_var_sizes_.resize(num);
 
-  loaded_metadata_.tile_offsets_.resize(num, false);
-  loaded_metadata_.tile_var_offsets_.resize(num, false);
-  loaded_metadata_.tile_var_sizes_.resize(num, false);
+  LoadedMetadata::reset(&loaded_metadata_.tile_offsets_, num, false);
+  LoadedMetadata::reset(&loaded_metadata_.tile_var_offsets_, num, false);
+  LoadedMetadata::reset(&loaded_metadata_.tile_var_sizes_, num, false);
 
   RETURN_NOT_OK(load_generic_tile_offsets(&cbuff));
 
@@ -1672,6 +1717,19 @@ Status FragmentMetadata::read_generic_tile_from_file(
   URI fragment_metadata_uri = fragment_uri_.join_path(
       std::string(constants::fragment_metadata_filename));
 
+  // Check the fragment metadata cache. Decrypted sections are not cached.
+  auto cacheable =
+      encryption_key.encryption_type() == EncryptionType::NO_ENCRYPTION;
+  auto cache_key =
+      fragment_metadata_uri.to_string() + "+" + std::to_string(offset);
+  if (cacheable) {
+    bool in_cache = false;
+    RETURN_NOT_OK(storage_manager_->read_from_fragment_metadata_cache(
+        cache_key, buff, &in_cache));
+    if (in_cache)
+      return Status::Ok();
+  }
+
   // Read metadata
   TileIO tile_io(storage_manager_, fragment_metadata_uri);
   auto tile = (Tile*)nullptr;
@@ -1679,6 +1737,10 @@ Status FragmentMetadata::read_generic_tile_from_file(
   tile->buffer()->swap(*buff);
   delete tile;
 
+  if (cacheable)
+    RETURN_NOT_OK(
+        storage_manager_->write_to_fragment_metadata_cache(cache_key, *buff));
+
   return Status::Ok();
 }
 
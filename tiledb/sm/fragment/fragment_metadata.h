@@ -34,6 +34,7 @@
 #ifndef TILEDB_FRAGMENT_METADATA_H
 #define TILEDB_FRAGMENT_METADATA_H
 
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -440,13 +441,28 @@ class FragmentMetadata {
     std::vector<uint64_t> tile_var_sizes_;
   };
 
-  /** Keeps track of which metadata is loaded. */
+  /**
+   * Keeps track of which metadata is loaded. A flag is set only after its
+   * section has been loaded, and it never gets unset. The lazy loaders
+   * check the flags before locking, so that readers of sections that are
+   * already loaded never block on each other or on the loading of another
+   * section.
+   */
   struct LoadedMetadata {
-    bool footer_ = false;
-    bool rtree_ = false;
-    std::vector<bool> tile_offsets_;
-    std::vector<bool> tile_var_offsets_;
-    std::vector<bool> tile_var_sizes_;
+    std::atomic<bool> footer_{false};
+    std::atomic<bool> rtree_{false};
+    std::vector<std::atomic<bool>> tile_offsets_;
+    std::vector<std::atomic<bool>> tile_var_offsets_;
+    std::vector<std::atomic<bool>> tile_var_sizes_;
+
+    /** Resets `flags` to `num` flags with value `loaded`. */
+    static void reset(
+        std::vector<std::atomic<bool>>* flags, size_t num, bool loaded) {
+      std::vector<std::atomic<bool>> new_flags(num);
+      for (auto& flag : new_flags)
+        flag = loaded;
+      flags->swap(new_flags);
+    }
   };
 
   /* ********************************* */
@@ -501,7 +517,11 @@ class FragmentMetadata {
   /** The size of the fragment metadata file. */
   uint64_t meta_file_size_;
 
-  /** Local mutex for thread-safety. */
+  /**
+   * Local mutex for thread-safety. It serializes the loading of the lazy
+   * metadata sections, which are checked first without it (see
+   * `LoadedMetadata`).
+   */
   std::mutex mtx_;
 
   /** The offsets of the next tile for each attribute. */
@@ -34,9 +34,11 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace tiledb {
@@ -46,7 +48,9 @@ namespace sm {
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
 
-Metadata::Metadata() {
+Metadata::Metadata()
+    : indexed_(false)
+    , indexed_key_num_(0) {
   auto t = utils::time::timestamp_now_ms();
   timestamp_range_ = std::make_pair(t, t);
 }
@@ -60,79 +64,164 @@ Metadata::~Metadata() = default;
 void Metadata::clear() {
   metadata_map_.clear();
   metadata_index_.clear();
+  indexed_ = false;
+  blocks_.clear();
+  block_first_index_.clear();
+  indexed_key_num_ = 0;
+  loaded_blocks_.clear();
+  block_reader_ = nullptr;
   loaded_metadata_uris_.clear();
   timestamp_range_ = std::make_pair(0, 0);
 }
 
 Status Metadata::deserialize(
     const std::vector<std::shared_ptr<ConstBuffer>>& metadata_buffs) {
+  return deserialize(nullptr, nullptr, metadata_buffs);
+}
+
+Status Metadata::deserialize(
+    const std::shared_ptr<ConstBuffer>& index_buff,
+    const BlockReader& block_reader,
+    const std::vector<std::shared_ptr<ConstBuffer>>& metadata_buffs) {
   clear();
 
+  // Load the index of the indexed metadata file. The index buffer may be
+  // shared by several arrays, so it is read through a separate view.
+  if (index_buff != nullptr) {
+    ConstBuffer cbuff(index_buff->data(), index_buff->size());
+    RETURN_NOT_OK(deserialize_index(&cbuff, &blocks_));
+    block_first_index_.resize(blocks_.size());
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+      block_first_index_[b] = indexed_key_num_;
+      indexed_key_num_ += blocks_[b].key_num_;
+    }
+    loaded_blocks_.resize(blocks_.size());
+    block_reader_ = block_reader;
+    indexed_ = true;
+  }
+
   if (metadata_buffs.empty())
     return Status::Ok();
 
-  uint32_t key_len;
-  char del;
-  size_t value_len;
   for (const auto& buff : metadata_buffs) {
     // Iterate over all items
     buff->set_offset(0);
     while (buff->offset() != buff->size()) {
-      RETURN_NOT_OK(buff->read(&key_len, sizeof(uint32_t)));
-      std::string key((const char*)buff->cur_data(), key_len);
-      buff->advance_offset(key_len);
-      RETURN_NOT_OK(buff->read(&del, sizeof(char)));
+      std::string key;
+      MetadataValue value_struct;
+      RETURN_NOT_OK(deserialize_item(buff.get(), &key, &value_struct));
 
       metadata_map_.erase(key);
 
-      // Handle deletion
-      if (del)
+      // Handle deletion. It must be kept if it may delete an item of
+      // the indexed metadata file.
+      if (value_struct.del_ && !indexed_)
         continue;
 
-      MetadataValue value_struct;
-      value_struct.del_ = del;
-      RETURN_NOT_OK(buff->read(&value_struct.type_, sizeof(char)));
-      RETURN_NOT_OK(buff->read(&value_struct.num_, sizeof(uint32_t)));
-      if (value_struct.num_) {
-        value_len = value_struct.num_ *
-                    datatype_size(static_cast<Datatype>(value_struct.type_));
-        value_struct.value_.resize(value_len);
-        RETURN_NOT_OK(buff->read((void*)value_struct.value_.data(), value_len));
-      }
-
       // Insert to metadata
       metadata_map_.emplace(std::make_pair(key, std::move(value_struct)));
     }
   }
 
-  RETURN_NOT_OK(build_metadata_index());
-  // Note: `metadata_map_` and `metadata_index_` are immutable after this point
+  // Note: `metadata_map_` and `metadata_index_` change after this point
+  // only if the indexed items are merged into them (see `merge_blocks`)
+  if (!indexed_)
+    RETURN_NOT_OK(build_metadata_index());
 
   return Status::Ok();
 }
 
 Status Metadata::serialize(Buffer* buff) const {
+  if (indexed_)
+    return LOG_STATUS(Status::MetadataError(
+        "Cannot serialize metadata; The indexed metadata are not loaded"));
+
   // Do nothing if there are no metadata to serialize
   if (metadata_map_.empty())
     return Status::Ok();
 
+  for (const auto& meta : metadata_map_)
+    RETURN_NOT_OK(serialize_item(buff, meta.first, meta.second));
+
+  return Status::Ok();
+}
+
+Status Metadata::serialize_blocks(
+    uint64_t block_size,
+    std::vector<Buffer>* buffs,
+    std::vector<BlockInfo>* blocks) const {
+  if (indexed_)
+    return LOG_STATUS(Status::MetadataError(
+        "Cannot serialize metadata; The indexed metadata are not loaded"));
+
+  buffs->clear();
+  blocks->clear();
   for (const auto& meta : metadata_map_) {
-    auto key_len = (uint32_t)meta.first.size();
-    RETURN_NOT_OK(buff->write(&key_len, sizeof(uint32_t)));
-    RETURN_NOT_OK(buff->write(meta.first.data(), meta.first.size()));
-    const auto& value = meta.second;
-    RETURN_NOT_OK(buff->write(&value.del_, sizeof(char)));
-    if (!value.del_) {
-      RETURN_NOT_OK(buff->write(&value.type_, sizeof(char)));
-      RETURN_NOT_OK(buff->write(&value.num_, sizeof(uint32_t)));
-      if (value.num_)
-        RETURN_NOT_OK(buff->write(value.value_.data(), value.value_.size()));
+    // Deletions are not stored in indexed metadata files
+    if (meta.second.del_)
+      continue;
+
+    // Start a new block
+    if (buffs->empty() || buffs->back().size() >= block_size) {
+      buffs->emplace_back();
+      blocks->emplace_back();
+      blocks->back().first_key_ = meta.first;
     }
+
+    RETURN_NOT_OK(serialize_item(&buffs->back(), meta.first, meta.second));
+    ++(blocks->back().key_num_);
+  }
+
+  return Status::Ok();
+}
+
+Status Metadata::serialize_index(
+    const std::vector<BlockInfo>& blocks, Buffer* buff) {
+  auto version = constants::array_metadata_index_version;
+  RETURN_NOT_OK(buff->write(&version, sizeof(uint32_t)));
+  uint64_t block_num = blocks.size();
+  RETURN_NOT_OK(buff->write(&block_num, sizeof(uint64_t)));
+  for (const auto& block : blocks) {
+    auto key_len = (uint32_t)block.first_key_.size();
+    RETURN_NOT_OK(buff->write(&key_len, sizeof(uint32_t)));
+    RETURN_NOT_OK(buff->write(block.first_key_.data(), key_len));
+    RETURN_NOT_OK(buff->write(&block.offset_, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff->write(&block.key_num_, sizeof(uint64_t)));
+  }
+
+  return Status::Ok();
+}
+
+Status Metadata::deserialize_index(
+    ConstBuffer* buff, std::vector<BlockInfo>* blocks) {
+  uint32_t version;
+  RETURN_NOT_OK(buff->read(&version, sizeof(uint32_t)));
+  if (version > constants::array_metadata_index_version)
+    return LOG_STATUS(Status::MetadataError(
+        "Cannot deserialize metadata index; Unsupported version " +
+        std::to_string(version)));
+
+  uint64_t block_num;
+  RETURN_NOT_OK(buff->read(&block_num, sizeof(uint64_t)));
+  blocks->clear();
+  blocks->resize(block_num);
+  uint32_t key_len;
+  for (auto& block : *blocks) {
+    RETURN_NOT_OK(buff->read(&key_len, sizeof(uint32_t)));
+    block.first_key_.resize(key_len);
+    RETURN_NOT_OK(buff->read(&block.first_key_[0], key_len));
+    RETURN_NOT_OK(buff->read(&block.offset_, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff->read(&block.key_num_, sizeof(uint64_t)));
   }
 
   return Status::Ok();
 }
 
+Status Metadata::load_all() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return merge_blocks();
+}
+
 const std::pair<uint64_t, uint64_t>& Metadata::timestamp_range() const {
   return timestamp_range_;
 }
@@ -185,23 +274,25 @@ Status Metadata::get(
     const void** value) const {
   assert(key != nullptr);
 
-  auto it = metadata_map_.find(key);
-  if (it == metadata_map_.end()) {
+  std::unique_lock<std::mutex> lck(mtx_);
+
+  const MetadataValue* value_struct;
+  RETURN_NOT_OK(find(key, &value_struct));
+  if (value_struct == nullptr) {
     // Key not found
     *value = nullptr;
     return Status::Ok();
   }
 
   // Key found
-  auto& value_struct = it->second;
-  *value_type = static_cast<Datatype>(value_struct.type_);
-  if (value_struct.num_ == 0) {
+  *value_type = static_cast<Datatype>(value_struct->type_);
+  if (value_struct->num_ == 0) {
     // zero-valued keys
     *value_num = 1;
     *value = nullptr;
   } else {
-    *value_num = value_struct.num_;
-    *value = (const void*)(value_struct.value_.data());
+    *value_num = value_struct->num_;
+    *value = (const void*)(value_struct->value_.data());
   }
 
   return Status::Ok();
@@ -214,28 +305,49 @@ Status Metadata::get(
     Datatype* value_type,
     uint32_t* value_num,
     const void** value) {
-  if (metadata_index_.empty())
-    RETURN_NOT_OK(build_metadata_index());
+  std::unique_lock<std::mutex> lck(mtx_);
 
-  if (index >= metadata_index_.size())
-    return LOG_STATUS(
-        Status::MetadataError("Cannot get metadata; index out of bounds"));
+  const std::string* key_str;
+  const MetadataValue* value_struct;
+  if (indexed_ && metadata_map_.empty()) {
+    // Only the indexed metadata file was loaded, get the item from its block
+    if (index >= indexed_key_num_)
+      return LOG_STATUS(
+          Status::MetadataError("Cannot get metadata; index out of bounds"));
+    auto b = (size_t)(
+        std::upper_bound(
+            block_first_index_.begin(), block_first_index_.end(), index) -
+        block_first_index_.begin() - 1);
+    std::shared_ptr<Block> block;
+    RETURN_NOT_OK(load_block(b, &block));
+    const auto& item = (*block)[index - block_first_index_[b]];
+    key_str = &item.first;
+    value_struct = &item.second;
+  } else {
+    RETURN_NOT_OK(merge_blocks());
+    if (metadata_index_.empty())
+      RETURN_NOT_OK(build_metadata_index());
+
+    if (index >= metadata_index_.size())
+      return LOG_STATUS(
+          Status::MetadataError("Cannot get metadata; index out of bounds"));
+    key_str = metadata_index_[index].first;
+    value_struct = metadata_index_[index].second;
+  }
 
   // Get key
-  auto& key_str = *(metadata_index_[index].first);
-  *key = key_str.c_str();
-  *key_len = (uint32_t)key_str.size();
+  *key = key_str->c_str();
+  *key_len = (uint32_t)key_str->size();
 
   // Get value
-  auto& value_struct = *(metadata_index_[index].second);
-  *value_type = static_cast<Datatype>(value_struct.type_);
-  if (value_struct.num_ == 0) {
+  *value_type = static_cast<Datatype>(value_struct->type_);
+  if (value_struct->num_ == 0) {
     // zero-valued keys
     *value_num = 1;
     *value = nullptr;
   } else {
-    *value_num = value_struct.num_;
-    *value = (const void*)(value_struct.value_.data());
+    *value_num = value_struct->num_;
+    *value = (const void*)(value_struct->value_.data());
   }
   return Status::Ok();
 }
@@ -243,23 +355,86 @@ Status Metadata::get(
 Status Metadata::has_key(const char* key, Datatype* value_type, bool* has_key) {
   assert(key != nullptr);
 
-  auto it = metadata_map_.find(key);
-  if (it == metadata_map_.end()) {
+  std::unique_lock<std::mutex> lck(mtx_);
+
+  const MetadataValue* value_struct;
+  RETURN_NOT_OK(find(key, &value_struct));
+  if (value_struct == nullptr) {
     // Key not found
     *has_key = false;
     return Status::Ok();
   }
 
   // Key found
-  auto& value_struct = it->second;
-  *value_type = static_cast<Datatype>(value_struct.type_);
+  *value_type = static_cast<Datatype>(value_struct->type_);
   *has_key = true;
 
   return Status::Ok();
 }
 
-uint64_t Metadata::num() const {
-  return metadata_map_.size();
+Status Metadata::get_keys(const char* prefix, std::vector<std::string>* keys) {
+  assert(prefix != nullptr);
+
+  std::unique_lock<std::mutex> lck(mtx_);
+
+  keys->clear();
+  std::string prefix_str(prefix);
+
+  // Get the keys of the indexed metadata file. They are contiguous, starting
+  // from the block that may contain `prefix`.
+  if (indexed_) {
+    auto first_b = find_block(prefix_str);
+    for (auto b = first_b; b < blocks_.size(); ++b) {
+      if (b != first_b &&
+          !utils::parse::starts_with(blocks_[b].first_key_, prefix_str))
+        break;
+
+      std::shared_ptr<Block> block;
+      RETURN_NOT_OK(load_block(b, &block));
+      auto it = std::lower_bound(
+          block->begin(),
+          block->end(),
+          prefix_str,
+          [](const Block::value_type& item, const std::string& key) {
+            return item.first < key;
+          });
+      for (; it != block->end(); ++it) {
+        if (!utils::parse::starts_with(it->first, prefix_str))
+          break;
+        // Skip the keys that were overwritten or deleted later
+        if (metadata_map_.find(it->first) == metadata_map_.end())
+          keys->push_back(it->first);
+      }
+    }
+  }
+
+  // Get the rest of the keys
+  auto indexed_num = keys->size();
+  for (auto it = metadata_map_.lower_bound(prefix_str);
+       it != metadata_map_.end() &&
+       utils::parse::starts_with(it->first, prefix_str);
+       ++it) {
+    if (!it->second.del_)
+      keys->push_back(it->first);
+  }
+  std::inplace_merge(
+      keys->begin(), keys->begin() + indexed_num, keys->end());
+
+  return Status::Ok();
+}
+
+Status Metadata::num(uint64_t* num) {
+  std::unique_lock<std::mutex> lck(mtx_);
+
+  if (indexed_ && metadata_map_.empty()) {
+    *num = indexed_key_num_;
+    return Status::Ok();
+  }
+
+  RETURN_NOT_OK(merge_blocks());
+  *num = metadata_map_.size();
+
+  return Status::Ok();
 }
 
 Status Metadata::set_loaded_metadata_uris(
@@ -284,6 +459,12 @@ const std::vector<URI>& Metadata::loaded_metadata_uris() const {
 void Metadata::swap(Metadata* metadata) {
   std::swap(metadata_map_, metadata->metadata_map_);
   std::swap(metadata_index_, metadata->metadata_index_);
+  std::swap(indexed_, metadata->indexed_);
+  std::swap(blocks_, metadata->blocks_);
+  std::swap(block_first_index_, metadata->block_first_index_);
+  std::swap(indexed_key_num_, metadata->indexed_key_num_);
+  std::swap(loaded_blocks_, metadata->loaded_blocks_);
+  std::swap(block_reader_, metadata->block_reader_);
   std::swap(timestamp_range_, metadata->timestamp_range_);
   std::swap(loaded_metadata_uris_, metadata->loaded_metadata_uris_);
 }
@@ -316,5 +497,154 @@ Status Metadata::build_metadata_index() {
   return Status::Ok();
 }
 
+Status Metadata::find(
+    const std::string& key, const MetadataValue** value) const {
+  *value = nullptr;
+
+  // The items of the later metadata files take precedence
+  auto it = metadata_map_.find(key);
+  if (it != metadata_map_.end()) {
+    if (!it->second.del_)
+      *value = &(it->second);
+    return Status::Ok();
+  }
+
+  if (!indexed_ || blocks_.empty() || key < blocks_[0].first_key_)
+    return Status::Ok();
+
+  // Search the block that may contain the key
+  std::shared_ptr<Block> block;
+  RETURN_NOT_OK(load_block(find_block(key), &block));
+  auto item = std::lower_bound(
+      block->begin(),
+      block->end(),
+      key,
+      [](const Block::value_type& item, const std::string& key) {
+        return item.first < key;
+      });
+  if (item != block->end() && item->first == key)
+    *value = &(item->second);
+
+  return Status::Ok();
+}
+
+size_t Metadata::find_block(const std::string& key) const {
+  auto it = std::upper_bound(
+      blocks_.begin(),
+      blocks_.end(),
+      key,
+      [](const std::string& key, const BlockInfo& block) {
+        return key < block.first_key_;
+      });
+  return (it == blocks_.begin()) ? 0 : (size_t)(it - blocks_.begin() - 1);
+}
+
+Status Metadata::load_block(size_t b, std::shared_ptr<Block>* block) const {
+  assert(b < blocks_.size());
+
+  // Block already loaded
+  if (loaded_blocks_[b] != nullptr) {
+    *block = loaded_blocks_[b];
+    return Status::Ok();
+  }
+
+  if (block_reader_ == nullptr)
+    return LOG_STATUS(Status::MetadataError(
+        "Cannot load metadata block; No block reader was set"));
+
+  Buffer buff;
+  RETURN_NOT_OK(block_reader_(blocks_[b].offset_, &buff));
+
+  auto new_block = std::make_shared<Block>();
+  new_block->reserve(blocks_[b].key_num_);
+  ConstBuffer cbuff(&buff);
+  while (cbuff.offset() != cbuff.size()) {
+    std::string key;
+    MetadataValue value;
+    RETURN_NOT_OK(deserialize_item(&cbuff, &key, &value));
+    new_block->emplace_back(std::move(key), std::move(value));
+  }
+
+  if (new_block->size() != blocks_[b].key_num_)
+    return LOG_STATUS(Status::MetadataError(
+        "Cannot load metadata block; Unexpected number of items"));
+
+  loaded_blocks_[b] = new_block;
+  *block = new_block;
+
+  return Status::Ok();
+}
+
+Status Metadata::merge_blocks() {
+  if (!indexed_)
+    return Status::Ok();
+
+  // Move the values of the items that were not overwritten or deleted
+  // later. The keys stay in the blocks, and moving a value keeps the
+  // address of its data, so the items returned so far remain valid.
+  for (size_t b = 0; b < blocks_.size(); ++b) {
+    std::shared_ptr<Block> block;
+    RETURN_NOT_OK(load_block(b, &block));
+    for (auto& item : *block) {
+      if (metadata_map_.find(item.first) == metadata_map_.end())
+        metadata_map_.emplace(item.first, std::move(item.second));
+    }
+  }
+
+  // Remove the deletions
+  for (auto it = metadata_map_.begin(); it != metadata_map_.end();) {
+    if (it->second.del_)
+      it = metadata_map_.erase(it);
+    else
+      ++it;
+  }
+
+  indexed_ = false;
+  block_reader_ = nullptr;
+  metadata_index_.clear();
+
+  return Status::Ok();
+}
+
+Status Metadata::deserialize_item(
+    ConstBuffer* buff, std::string* key, MetadataValue* value) {
+  uint32_t key_len;
+  RETURN_NOT_OK(buff->read(&key_len, sizeof(uint32_t)));
+  key->assign((const char*)buff->cur_data(), key_len);
+  buff->advance_offset(key_len);
+  RETURN_NOT_OK(buff->read(&value->del_, sizeof(char)));
+
+  // Deletions have no value
+  if (value->del_)
+    return Status::Ok();
+
+  RETURN_NOT_OK(buff->read(&value->type_, sizeof(char)));
+  RETURN_NOT_OK(buff->read(&value->num_, sizeof(uint32_t)));
+  if (value->num_) {
+    auto value_len =
+        value->num_ * datatype_size(static_cast<Datatype>(value->type_));
+    value->value_.resize(value_len);
+    RETURN_NOT_OK(buff->read((void*)value->value_.data(), value_len));
+  }
+
+  return Status::Ok();
+}
+
+Status Metadata::serialize_item(
+    Buffer* buff, const std::string& key, const MetadataValue& value) {
+  auto key_len = (uint32_t)key.size();
+  RETURN_NOT_OK(buff->write(&key_len, sizeof(uint32_t)));
+  RETURN_NOT_OK(buff->write(key.data(), key.size()));
+  RETURN_NOT_OK(buff->write(&value.del_, sizeof(char)));
+  if (!value.del_) {
+    RETURN_NOT_OK(buff->write(&value.type_, sizeof(char)));
+    RETURN_NOT_OK(buff->write(&value.num_, sizeof(uint32_t)));
+    if (value.num_)
+      RETURN_NOT_OK(buff->write(value.value_.data(), value.value_.size()));
+  }
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
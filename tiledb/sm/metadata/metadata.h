@@ -33,9 +33,11 @@
 #ifndef TILEDB_METADATA_H
 #define TILEDB_METADATA_H
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "tiledb/sm/misc/status.h"
@@ -57,6 +59,17 @@ enum class Datatype : uint8_t;
  *  value_num (uint32_t) | values (void*)`
  *
  * The first char value is 1 if it is a deletion and 0 if it is an insertion.
+ *
+ * Consolidation produces *indexed* metadata files instead, which store the
+ * items sorted on key in blocks of about `constants::array_metadata_block_size`
+ * bytes, each block being a generic tile in the format above. The blocks are
+ * followed by a generic tile with the block index:
+ * `version (uint32_t) | block_num (uint64_t) |
+ *  first_key_len#1 (uint32_t) | first_key#1 (char*) | offset#1 (uint64_t) |
+ *  key_num#1 (uint64_t) | ...`
+ * and a footer with the offset of the index tile in the file (uint64_t).
+ * Only the index is loaded upon deserialization; the blocks are loaded
+ * on demand, when a key they may contain is looked up.
  */
 class Metadata {
  public:
@@ -76,6 +89,22 @@ class Metadata {
     std::vector<uint8_t> value_;
   };
 
+  /** Describes a block of an indexed metadata file. */
+  struct BlockInfo {
+    /** The smallest key in the block. */
+    std::string first_key_;
+    /** The offset of the block generic tile in the file. */
+    uint64_t offset_ = 0;
+    /** The number of items in the block. */
+    uint64_t key_num_ = 0;
+  };
+
+  /**
+   * Reads the block generic tile at the input offset of the indexed
+   * metadata file into the input buffer.
+   */
+  typedef std::function<Status(uint64_t, Buffer*)> BlockReader;
+
   /** Iterator type for iterating over metadata values. */
   typedef std::map<std::string, MetadataValue>::const_iterator iterator;
 
@@ -104,9 +133,54 @@ class Metadata {
   Status deserialize(
       const std::vector<std::shared_ptr<ConstBuffer>>& metadata_buffs);
 
+  /**
+   * Same as above, but the items of `metadata_buffs` are applied on top
+   * of those of an indexed metadata file.
+   *
+   * @param index_buff The index of the indexed metadata file. If it is
+   *     `nullptr`, this is equivalent to the function above.
+   * @param block_reader Reads the blocks of the indexed metadata file.
+   * @param metadata_buffs The buffers of the later metadata files.
+   * @return Status
+   */
+  Status deserialize(
+      const std::shared_ptr<ConstBuffer>& index_buff,
+      const BlockReader& block_reader,
+      const std::vector<std::shared_ptr<ConstBuffer>>& metadata_buffs);
+
   /** Serializes all key-value metadata items into the input buffer. */
   Status serialize(Buffer* buff) const;
 
+  /**
+   * Serializes all key-value metadata items into blocks of an indexed
+   * metadata file, in key order.
+   *
+   * @param block_size The target block size in bytes.
+   * @param buffs The block buffers to be retrieved.
+   * @param blocks The block descriptions to be retrieved. Their offsets
+   *     are to be set by the caller upon writing the blocks.
+   * @return Status
+   */
+  Status serialize_blocks(
+      uint64_t block_size,
+      std::vector<Buffer>* buffs,
+      std::vector<BlockInfo>* blocks) const;
+
+  /** Serializes the index of an indexed metadata file. */
+  static Status serialize_index(
+      const std::vector<BlockInfo>& blocks, Buffer* buff);
+
+  /** Deserializes the index of an indexed metadata file. */
+  static Status deserialize_index(
+      ConstBuffer* buff, std::vector<BlockInfo>* blocks);
+
+  /**
+   * Loads all the blocks of the indexed metadata file (if any), merging
+   * their items with the rest of the metadata. This is necessary before
+   * iterating or serializing all the metadata.
+   */
+  Status load_all();
+
   /** Returns the timestamp range. */
   const std::pair<uint64_t, uint64_t>& timestamp_range() const;
 
@@ -172,8 +246,19 @@ class Metadata {
       uint32_t* value_num,
       const void** value);
 
-  /** Returns the number of metadata items. */
-  uint64_t num() const;
+  /**
+   * Retrieves the keys of the metadata items that start with the input
+   * prefix, in sorted order. Only the blocks of the indexed metadata file
+   * that may contain such keys are loaded.
+   *
+   * @param prefix The key prefix.
+   * @param keys The keys to be retrieved.
+   * @return Status
+   */
+  Status get_keys(const char* prefix, std::vector<std::string>* keys);
+
+  /** Retrieves the number of metadata items. */
+  Status num(uint64_t* num);
 
   /**
    * Checks if metadata has specified key.
@@ -209,7 +294,10 @@ class Metadata {
    */
   void reset(uint64_t timestamp);
 
-  /** Returns an iterator to the beginning of the metadata. */
+  /**
+   * Returns an iterator to the beginning of the metadata. The blocks of the
+   * indexed metadata file must have been loaded with `load_all`.
+   */
   iterator begin() const;
 
   /** Returns an iterator to the end of the metadata. */
@@ -220,9 +308,38 @@ class Metadata {
   /*         PRIVATE ATTRIBUTES        */
   /* ********************************* */
 
-  /** A map from metadata key to metadata value. */
+  /** The items of an indexed metadata block, sorted on key. */
+  typedef std::vector<std::pair<std::string, MetadataValue>> Block;
+
+  /**
+   * A map from metadata key to metadata value. If `indexed_` is true, it
+   * holds the items of the metadata files that follow the indexed one,
+   * including the deletions, which take precedence over the blocks.
+   */
   std::map<std::string, MetadataValue> metadata_map_;
 
+  /** True if the blocks of an indexed metadata file are loaded on demand. */
+  bool indexed_;
+
+  /** The blocks of the indexed metadata file. */
+  std::vector<BlockInfo> blocks_;
+
+  /** The index of the first item of each block. */
+  std::vector<uint64_t> block_first_index_;
+
+  /** The number of items in the indexed metadata file. */
+  uint64_t indexed_key_num_;
+
+  /**
+   * The blocks loaded so far (`nullptr` if not loaded). The loaded blocks
+   * are kept until the metadata are cleared, since the keys and values
+   * returned by `get` point to them.
+   */
+  mutable std::vector<std::shared_ptr<Block>> loaded_blocks_;
+
+  /** Reads the blocks of the indexed metadata file. */
+  BlockReader block_reader_;
+
   /**
    * A vector pointing to all the values in `metadata_map_`. It facilitates
    * searching metadata from index. Used only for reading metadata (inapplicable
@@ -254,6 +371,36 @@ class Metadata {
    * @return Status
    */
   Status build_metadata_index();
+
+  /**
+   * Finds the value of the input key, which is `nullptr` if the key does
+   * not exist or is deleted. It must be called with `mtx_` locked.
+   */
+  Status find(const std::string& key, const MetadataValue** value) const;
+
+  /**
+   * Returns the block of the indexed metadata file that may contain the
+   * input key, i.e., the last block whose first key is not greater than
+   * `key` (or `0` if there is no such block).
+   */
+  size_t find_block(const std::string& key) const;
+
+  /**
+   * Retrieves the input block of the indexed metadata file, loading it
+   * if necessary. It must be called with `mtx_` locked.
+   */
+  Status load_block(size_t b, std::shared_ptr<Block>* block) const;
+
+  /** Same as `load_all`, but it must be called with `mtx_` locked. */
+  Status merge_blocks();
+
+  /** Deserializes a single metadata item from the input buffer. */
+  static Status deserialize_item(
+      ConstBuffer* buff, std::string* key, MetadataValue* value);
+
+  /** Serializes a single metadata item into the input buffer. */
+  static Status serialize_item(
+      Buffer* buff, const std::string& key, const MetadataValue& value);
 };
 
 }  // namespace sm
@@ -74,6 +74,15 @@ const std::string array_schema_filename = "__array_schema.tdb";
 /** The array metadata folder name. */
 const std::string array_metadata_folder_name = "__meta";
 
+/** The suffix of the names of the indexed array metadata files. */
+const std::string array_metadata_indexed_suffix = "_idx";
+
+/** The version of the index of the indexed array metadata files. */
+const uint32_t array_metadata_index_version = 1;
+
+/** The target size in bytes of a block of an indexed array metadata file. */
+const uint64_t array_metadata_block_size = 64 * 1024;
+
 /** The fragment metadata file name. */
 const std::string fragment_metadata_filename = "__fragment_metadata.tdb";
 
@@ -273,6 +282,21 @@ const std::string filter_checksum_md5_str = "CHECKSUM_MD5";
 /** String describing FILTER_CHECKSUM_SHA256. */
 const std::string filter_checksum_sha256_str = "CHECKSUM_SHA256";
 
+/** String describing FILTER_DICTIONARY. */
+const std::string filter_dictionary_str = "DICTIONARY";
+
+/** String describing FILTER_OFFSETS_DELTA. */
+const std::string filter_offsets_delta_str = "OFFSETS_DELTA";
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+const std::string filter_frame_of_reference_str = "FRAME_OF_REFERENCE";
+
+/** String describing FILTER_XOR. */
+const std::string filter_xor_str = "XOR";
+
+/** String describing FILTER_CHECKSUM_CRC32C. */
+const std::string filter_checksum_crc32c_str = "CHECKSUM_CRC32C";
+
 /** The string representation for FilterOption type compression_level. */
 const std::string filter_option_compression_level_str = "COMPRESSION_LEVEL";
 
@@ -437,7 +461,7 @@ const int32_t library_version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
 /** The TileDB serialization format version number. */
-const uint32_t format_version = 5;
+const uint32_t format_version = 6;
 
 /** The maximum size of a tile chunk (unit of compression) in bytes. */
 const uint64_t max_tile_chunk_size = 64 * 1024;
@@ -448,6 +472,9 @@ const unsigned int s3_max_attempts = 100;
 /** Milliseconds of wait time between S3 attempts. */
 const unsigned int s3_attempt_sleep_ms = 100;
 
+/** Maximum number of keys in a single S3 DeleteObjects request. */
+const uint64_t s3_max_delete_objects = 1000;
+
 /** Maximum number of attempts to wait for an Azure response. */
 const unsigned int azure_max_attempts = 10;
 
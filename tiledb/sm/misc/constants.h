@@ -68,6 +68,15 @@ extern const std::string array_schema_filename;
 /** The array metadata folder name. */
 extern const std::string array_metadata_folder_name;
 
+/** The suffix of the names of the indexed array metadata files. */
+extern const std::string array_metadata_indexed_suffix;
+
+/** The version of the index of the indexed array metadata files. */
+extern const uint32_t array_metadata_index_version;
+
+/** The target size in bytes of a block of an indexed array metadata file. */
+extern const uint64_t array_metadata_block_size;
+
 /** The default tile capacity. */
 extern const uint64_t capacity;
 
@@ -263,6 +272,21 @@ extern const std::string filter_checksum_md5_str;
 /** String describing FILTER_CHECKSUM_SHA256. */
 extern const std::string filter_checksum_sha256_str;
 
+/** String describing FILTER_DICTIONARY. */
+extern const std::string filter_dictionary_str;
+
+/** String describing FILTER_OFFSETS_DELTA. */
+extern const std::string filter_offsets_delta_str;
+
+/** String describing FILTER_FRAME_OF_REFERENCE. */
+extern const std::string filter_frame_of_reference_str;
+
+/** String describing FILTER_XOR. */
+extern const std::string filter_xor_str;
+
+/** String describing FILTER_CHECKSUM_CRC32C. */
+extern const std::string filter_checksum_crc32c_str;
+
 /** The string representation for FilterOption type compression_level. */
 extern const std::string filter_option_compression_level_str;
 
@@ -435,6 +459,9 @@ extern const unsigned int s3_max_attempts;
 /** Milliseconds of wait time between S3 attempts. */
 extern const unsigned int s3_attempt_sleep_ms;
 
+/** Maximum number of keys in a single S3 DeleteObjects request. */
+extern const uint64_t s3_max_delete_objects;
+
 /** Maximum number of attempts to wait for an Azure response. */
 extern const unsigned int azure_max_attempts;
 
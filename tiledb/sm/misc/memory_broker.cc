@@ -0,0 +1,234 @@
+/**
+ * @file   memory_broker.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements classes MemoryBroker and MemoryReservation.
+ */
+
+#include "tiledb/sm/misc/memory_broker.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <cassert>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+MemoryBroker::MemoryBroker()
+    : limit_(0)
+    , peak_(0)
+    , policy_(Policy::BLOCK)
+    , usage_(0) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status MemoryBroker::init(uint64_t limit, const std::string& policy) {
+  Policy p;
+  if (policy == "block")
+    p = Policy::BLOCK;
+  else if (policy == "shrink")
+    p = Policy::SHRINK;
+  else if (policy == "fail")
+    p = Policy::FAIL;
+  else
+    return LOG_STATUS(Status::MemError(
+        "Cannot initialize memory broker; Invalid policy '" + policy + "'"));
+
+  std::lock_guard<std::mutex> lck(mtx_);
+  limit_ = limit;
+  policy_ = p;
+
+  return Status::Ok();
+}
+
+uint64_t MemoryBroker::limit() const {
+  std::lock_guard<std::mutex> lck(mtx_);
+  return limit_;
+}
+
+uint64_t MemoryBroker::peak() const {
+  std::lock_guard<std::mutex> lck(mtx_);
+  return peak_;
+}
+
+MemoryBroker::Policy MemoryBroker::policy() const {
+  std::lock_guard<std::mutex> lck(mtx_);
+  return policy_;
+}
+
+Status MemoryBroker::reserve(uint64_t size, uint64_t held) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (limit_ != 0 && size > limit_) {
+    STATS_COUNTER_ADD(memory_broker_rejections, 1);
+    return LOG_STATUS(Status::MemError(
+        "Cannot reserve memory; The request of " + std::to_string(size) +
+        " bytes exceeds the memory limit (see config parameter "
+        "'sm.memory_limit')"));
+  }
+
+  // The held bytes are not released while waiting, so the request could
+  // never be granted
+  if (limit_ != 0 && held > limit_ - size) {
+    STATS_COUNTER_ADD(memory_broker_rejections, 1);
+    return LOG_STATUS(Status::MemError(
+        "Cannot reserve memory; The request of " + std::to_string(size) +
+        " bytes along with the " + std::to_string(held) +
+        " bytes held by its caller exceeds the memory limit (see config "
+        "parameter 'sm.memory_limit')"));
+  }
+
+  if (!fits(size))
+    reclaim(size, &lck);
+
+  while (!fits(size)) {
+    if (policy_ == Policy::FAIL) {
+      STATS_COUNTER_ADD(memory_broker_rejections, 1);
+      return LOG_STATUS(Status::MemError(
+          "Cannot reserve memory; The request of " + std::to_string(size) +
+          " bytes exceeds the available memory"));
+    }
+    STATS_COUNTER_ADD(memory_broker_waits, 1);
+    cv_.wait(lck);
+  }
+  grant(size);
+
+  return Status::Ok();
+}
+
+void MemoryBroker::release(uint64_t size) {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    assert(usage_ >= size);
+    usage_ -= size;
+    STATS_COUNTER_SET(memory_broker_usage_bytes, usage_);
+  }
+  cv_.notify_all();
+}
+
+void MemoryBroker::set_reclaimer(std::function<void(uint64_t)> reclaimer) {
+  std::lock_guard<std::mutex> lck(mtx_);
+  reclaimer_ = std::move(reclaimer);
+}
+
+bool MemoryBroker::try_reserve(uint64_t size, bool reclaim) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (!fits(size) && reclaim)
+    this->reclaim(size, &lck);
+  if (!fits(size))
+    return false;
+  grant(size);
+
+  return true;
+}
+
+uint64_t MemoryBroker::usage() const {
+  std::lock_guard<std::mutex> lck(mtx_);
+  return usage_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+bool MemoryBroker::fits(uint64_t size) const {
+  return limit_ == 0 || (size <= limit_ && usage_ <= limit_ - size);
+}
+
+void MemoryBroker::grant(uint64_t size) {
+  usage_ += size;
+  if (usage_ > peak_)
+    peak_ = usage_;
+  STATS_COUNTER_SET(memory_broker_usage_bytes, usage_);
+  STATS_COUNTER_SET(memory_broker_peak_bytes, peak_);
+}
+
+void MemoryBroker::reclaim(uint64_t size, std::unique_lock<std::mutex>* lck) {
+  if (reclaimer_ == nullptr || limit_ == 0 || size > limit_)
+    return;
+
+  auto missing = usage_ - (limit_ - size);
+  auto reclaimer = reclaimer_;
+  lck->unlock();
+  reclaimer(missing);
+  lck->lock();
+}
+
+/* ****************************** */
+/*        MemoryReservation       */
+/* ****************************** */
+
+MemoryReservation::MemoryReservation()
+    : broker_(nullptr)
+    , size_(0) {
+}
+
+MemoryReservation::~MemoryReservation() {
+  release();
+}
+
+void MemoryReservation::release() {
+  if (broker_ != nullptr && size_ != 0)
+    broker_->release(size_);
+  broker_ = nullptr;
+  size_ = 0;
+}
+
+Status MemoryReservation::reserve(
+    MemoryBroker* broker, uint64_t size, uint64_t held) {
+  release();
+  RETURN_NOT_OK(broker->reserve(size, held));
+  broker_ = broker;
+  size_ = size;
+
+  return Status::Ok();
+}
+
+uint64_t MemoryReservation::size() const {
+  return size_;
+}
+
+bool MemoryReservation::try_reserve(MemoryBroker* broker, uint64_t size) {
+  release();
+  if (!broker->try_reserve(size))
+    return false;
+  broker_ = broker;
+  size_ = size;
+
+  return true;
+}
+
+}  // namespace sm
+}  // namespace tiledb
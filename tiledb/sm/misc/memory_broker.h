@@ -0,0 +1,239 @@
+/**
+ * @file   memory_broker.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines classes MemoryBroker and MemoryReservation.
+ */
+
+#ifndef TILEDB_MEMORY_BROKER_H
+#define TILEDB_MEMORY_BROKER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Tracks the memory reserved by the queries, the consolidator and the tile
+ * cache of a context against a context-wide limit (see config parameters
+ * `sm.memory_limit` and `sm.memory_limit_policy`).
+ *
+ * When a reservation does not fit, the broker first asks the reclaimer
+ * (i.e., the tile cache) to free memory, and then applies the policy: it
+ * either waits until enough memory is released, or fails. Components that
+ * can do with less memory check for the shrink policy and use `try_reserve`
+ * with progressively smaller requests.
+ */
+class MemoryBroker {
+ public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** The policy applied when a reservation exceeds the available memory. */
+  enum class Policy : uint8_t {
+    /** Wait until enough memory is released. */
+    BLOCK,
+    /** Reduce the request if possible, otherwise wait. */
+    SHRINK,
+    /** Fail with an error. */
+    FAIL
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. The broker is unlimited until `init` is called. */
+  MemoryBroker();
+
+  /** Destructor. */
+  ~MemoryBroker() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the broker.
+   *
+   * @param limit The memory limit in bytes. Zero means unlimited.
+   * @param policy The policy, one of `block`, `shrink` or `fail`.
+   * @return Status
+   */
+  Status init(uint64_t limit, const std::string& policy);
+
+  /** Returns the memory limit in bytes (zero if unlimited). */
+  uint64_t limit() const;
+
+  /** Returns the peak reserved memory in bytes. */
+  uint64_t peak() const;
+
+  /** Returns the policy. */
+  Policy policy() const;
+
+  /**
+   * Reserves `size` bytes. If they are not available, the broker waits
+   * (block and shrink policies) or fails (fail policy). It always fails
+   * if `size` plus `held` exceeds the limit.
+   *
+   * @param size The number of bytes to reserve.
+   * @param held The number of bytes the caller (or the component running
+   *     it, e.g., the consolidator for its queries) holds while it waits.
+   *     Since they cannot be released meanwhile, a request that does not
+   *     fit in the limit along with them fails instead of waiting forever.
+   * @return Status
+   */
+  Status reserve(uint64_t size, uint64_t held = 0);
+
+  /** Releases `size` previously reserved bytes. */
+  void release(uint64_t size);
+
+  /**
+   * Sets the function called with the number of missing bytes when a
+   * reservation does not fit. It is called without holding the broker lock,
+   * so it may release memory to the broker.
+   */
+  void set_reclaimer(std::function<void(uint64_t)> reclaimer);
+
+  /**
+   * Reserves `size` bytes only if they are available, without waiting.
+   *
+   * @param size The number of bytes to reserve.
+   * @param reclaim If `true`, the reclaimer is called first if the bytes
+   *     are not available.
+   * @return `true` if the bytes were reserved.
+   */
+  bool try_reserve(uint64_t size, bool reclaim = true);
+
+  /** Returns the currently reserved memory in bytes. */
+  uint64_t usage() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** Notified whenever memory is released. */
+  std::condition_variable cv_;
+
+  /** The memory limit in bytes (zero if unlimited). */
+  uint64_t limit_;
+
+  /** Protects the usage counters. */
+  mutable std::mutex mtx_;
+
+  /** The peak reserved memory in bytes. */
+  uint64_t peak_;
+
+  /** The policy. */
+  Policy policy_;
+
+  /** Frees memory held by caches; may be empty. */
+  std::function<void(uint64_t)> reclaimer_;
+
+  /** The currently reserved memory in bytes. */
+  uint64_t usage_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns `true` if `size` more bytes fit. Must hold `mtx_`. */
+  bool fits(uint64_t size) const;
+
+  /** Adds `size` bytes to the usage. Must hold `mtx_`. */
+  void grant(uint64_t size);
+
+  /**
+   * Calls the reclaimer for the bytes missing to fit `size`, releasing and
+   * re-acquiring `lck` around the call.
+   */
+  void reclaim(uint64_t size, std::unique_lock<std::mutex>* lck);
+};
+
+/**
+ * Memory reserved on a broker, which is released when the reservation is
+ * destroyed (or released explicitly).
+ */
+class MemoryReservation {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  MemoryReservation();
+
+  /** Destructor. Releases the reserved memory. */
+  ~MemoryReservation();
+
+  MemoryReservation(const MemoryReservation&) = delete;
+  MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Releases the reserved memory, if any. */
+  void release();
+
+  /**
+   * Reserves `size` bytes on `broker` (see `MemoryBroker::reserve`),
+   * releasing any memory reserved before.
+   */
+  Status reserve(MemoryBroker* broker, uint64_t size, uint64_t held = 0);
+
+  /** Returns the number of reserved bytes. */
+  uint64_t size() const;
+
+  /**
+   * Reserves `size` bytes on `broker` only if they are available (see
+   * `MemoryBroker::try_reserve`), releasing any memory reserved before.
+   */
+  bool try_reserve(MemoryBroker* broker, uint64_t size);
+
+ private:
+  /** The broker the memory is reserved on. */
+  MemoryBroker* broker_;
+
+  /** The number of reserved bytes. */
+  uint64_t size_;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_MEMORY_BROKER_H
@@ -250,6 +250,12 @@ extern Statistics all_stats;
     stats::all_stats.counter_##counter_name += (value); \
   }
 
+/** Sets a counter stat to the given value. */
+#define STATS_COUNTER_SET(counter_name, value)         \
+  if (stats::all_stats.enabled()) {                    \
+    stats::all_stats.counter_##counter_name = (value); \
+  }
+
 /** Starts an ad hoc timer of the given name. */
 #define STATS_TIMER_START(name) \
   auto __timer_##name = std::chrono::steady_clock::now()
@@ -278,6 +284,8 @@ extern Statistics all_stats;
 
 #define STATS_COUNTER_ADD_IF(cond, counter_name, value)
 
+#define STATS_COUNTER_SET(counter_name, value)
+
 #define STATS_TIMER_START(name)
 
 #define STATS_TIMER_NS(name)
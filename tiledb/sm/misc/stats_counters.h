@@ -52,6 +52,24 @@ STATS_DEFINE_FUNC_STAT(crypto_sha256)
 // Filters
 STATS_DEFINE_FUNC_STAT(filter_pipeline_run_forward)
 STATS_DEFINE_FUNC_STAT(filter_pipeline_run_reverse)
+STATS_DEFINE_FUNC_STAT(filter_bit_width_reduction_forward)
+STATS_DEFINE_FUNC_STAT(filter_bit_width_reduction_reverse)
+STATS_DEFINE_FUNC_STAT(filter_bitshuffle_forward)
+STATS_DEFINE_FUNC_STAT(filter_bitshuffle_reverse)
+STATS_DEFINE_FUNC_STAT(filter_byteshuffle_forward)
+STATS_DEFINE_FUNC_STAT(filter_byteshuffle_reverse)
+STATS_DEFINE_FUNC_STAT(filter_positive_delta_forward)
+STATS_DEFINE_FUNC_STAT(filter_positive_delta_reverse)
+STATS_DEFINE_FUNC_STAT(filter_dictionary_forward)
+STATS_DEFINE_FUNC_STAT(filter_dictionary_reverse)
+STATS_DEFINE_FUNC_STAT(filter_offsets_delta_forward)
+STATS_DEFINE_FUNC_STAT(filter_offsets_delta_reverse)
+STATS_DEFINE_FUNC_STAT(filter_frame_of_reference_forward)
+STATS_DEFINE_FUNC_STAT(filter_frame_of_reference_reverse)
+STATS_DEFINE_FUNC_STAT(filter_xor_forward)
+STATS_DEFINE_FUNC_STAT(filter_xor_reverse)
+STATS_DEFINE_FUNC_STAT(filter_checksum_crc32c_forward)
+STATS_DEFINE_FUNC_STAT(filter_checksum_crc32c_reverse)
 // Tile cache
 STATS_DEFINE_FUNC_STAT(cache_lru_evict)
 STATS_DEFINE_FUNC_STAT(cache_lru_insert)
@@ -77,6 +95,8 @@ STATS_DEFINE_FUNC_STAT(reader_read_all_tiles)
 STATS_DEFINE_FUNC_STAT(reader_sort_coords)
 STATS_DEFINE_FUNC_STAT(reader_sparse_read)
 STATS_DEFINE_FUNC_STAT(reader_unfilter_tiles)
+// Subarray
+STATS_DEFINE_FUNC_STAT(subarray_compute_tile_overlap)
 // Writer
 STATS_DEFINE_FUNC_STAT(writer_check_coord_dups)
 STATS_DEFINE_FUNC_STAT(writer_check_coord_dups_global)
@@ -186,6 +206,24 @@ STATS_INIT_FUNC_STAT(crypto_sha256)
 // Filters
 STATS_INIT_FUNC_STAT(filter_pipeline_run_forward)
 STATS_INIT_FUNC_STAT(filter_pipeline_run_reverse)
+STATS_INIT_FUNC_STAT(filter_bit_width_reduction_forward)
+STATS_INIT_FUNC_STAT(filter_bit_width_reduction_reverse)
+STATS_INIT_FUNC_STAT(filter_bitshuffle_forward)
+STATS_INIT_FUNC_STAT(filter_bitshuffle_reverse)
+STATS_INIT_FUNC_STAT(filter_byteshuffle_forward)
+STATS_INIT_FUNC_STAT(filter_byteshuffle_reverse)
+STATS_INIT_FUNC_STAT(filter_positive_delta_forward)
+STATS_INIT_FUNC_STAT(filter_positive_delta_reverse)
+STATS_INIT_FUNC_STAT(filter_dictionary_forward)
+STATS_INIT_FUNC_STAT(filter_dictionary_reverse)
+STATS_INIT_FUNC_STAT(filter_offsets_delta_forward)
+STATS_INIT_FUNC_STAT(filter_offsets_delta_reverse)
+STATS_INIT_FUNC_STAT(filter_frame_of_reference_forward)
+STATS_INIT_FUNC_STAT(filter_frame_of_reference_reverse)
+STATS_INIT_FUNC_STAT(filter_xor_forward)
+STATS_INIT_FUNC_STAT(filter_xor_reverse)
+STATS_INIT_FUNC_STAT(filter_checksum_crc32c_forward)
+STATS_INIT_FUNC_STAT(filter_checksum_crc32c_reverse)
 // Tile cache
 STATS_INIT_FUNC_STAT(cache_lru_evict)
 STATS_INIT_FUNC_STAT(cache_lru_insert)
@@ -211,6 +249,8 @@ STATS_INIT_FUNC_STAT(reader_read_all_tiles)
 STATS_INIT_FUNC_STAT(reader_sort_coords)
 STATS_INIT_FUNC_STAT(reader_sparse_read)
 STATS_INIT_FUNC_STAT(reader_unfilter_tiles)
+// Subarray
+STATS_INIT_FUNC_STAT(subarray_compute_tile_overlap)
 // Writer
 STATS_INIT_FUNC_STAT(writer_check_coord_dups)
 STATS_INIT_FUNC_STAT(writer_check_coord_dups_global)
@@ -315,6 +355,24 @@ STATS_REPORT_FUNC_STAT(crypto_sha256)
 // Filters
 STATS_REPORT_FUNC_STAT(filter_pipeline_run_forward)
 STATS_REPORT_FUNC_STAT(filter_pipeline_run_reverse)
+STATS_REPORT_FUNC_STAT(filter_bit_width_reduction_forward)
+STATS_REPORT_FUNC_STAT(filter_bit_width_reduction_reverse)
+STATS_REPORT_FUNC_STAT(filter_bitshuffle_forward)
+STATS_REPORT_FUNC_STAT(filter_bitshuffle_reverse)
+STATS_REPORT_FUNC_STAT(filter_byteshuffle_forward)
+STATS_REPORT_FUNC_STAT(filter_byteshuffle_reverse)
+STATS_REPORT_FUNC_STAT(filter_positive_delta_forward)
+STATS_REPORT_FUNC_STAT(filter_positive_delta_reverse)
+STATS_REPORT_FUNC_STAT(filter_dictionary_forward)
+STATS_REPORT_FUNC_STAT(filter_dictionary_reverse)
+STATS_REPORT_FUNC_STAT(filter_offsets_delta_forward)
+STATS_REPORT_FUNC_STAT(filter_offsets_delta_reverse)
+STATS_REPORT_FUNC_STAT(filter_frame_of_reference_forward)
+STATS_REPORT_FUNC_STAT(filter_frame_of_reference_reverse)
+STATS_REPORT_FUNC_STAT(filter_xor_forward)
+STATS_REPORT_FUNC_STAT(filter_xor_reverse)
+STATS_REPORT_FUNC_STAT(filter_checksum_crc32c_forward)
+STATS_REPORT_FUNC_STAT(filter_checksum_crc32c_reverse)
 // Tile cache
 STATS_REPORT_FUNC_STAT(cache_lru_evict)
 STATS_REPORT_FUNC_STAT(cache_lru_insert)
@@ -340,6 +398,8 @@ STATS_REPORT_FUNC_STAT(reader_read_all_tiles)
 STATS_REPORT_FUNC_STAT(reader_sort_coords)
 STATS_REPORT_FUNC_STAT(reader_sparse_read)
 STATS_REPORT_FUNC_STAT(reader_unfilter_tiles)
+// Subarray
+STATS_REPORT_FUNC_STAT(subarray_compute_tile_overlap)
 // Writer
 STATS_REPORT_FUNC_STAT(writer_check_coord_dups)
 STATS_REPORT_FUNC_STAT(writer_check_coord_dups_global)
@@ -427,6 +487,12 @@ STATS_REPORT_FUNC_STAT(rest_curl_delete)
 STATS_DEFINE_COUNTER_STAT(cache_lru_inserts)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_hits)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_misses)
+// Compressors
+STATS_DEFINE_COUNTER_STAT(compressor_contexts_created)
+STATS_DEFINE_COUNTER_STAT(compressor_contexts_reused)
+// Filter pipeline
+STATS_DEFINE_COUNTER_STAT(filter_storage_buffers_allocated)
+STATS_DEFINE_COUNTER_STAT(filter_storage_buffers_reused)
 // Fragment Metadata
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_num_fragments)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_bytes)
@@ -437,19 +503,36 @@ STATS_DEFINE_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_DEFINE_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_DEFINE_COUNTER_STAT(reader_num_aligned_tiles_copied)
+STATS_DEFINE_COUNTER_STAT(reader_num_aligned_tiles_direct)
 STATS_DEFINE_COUNTER_STAT(reader_num_attr_tiles_touched)
 STATS_DEFINE_COUNTER_STAT(reader_num_bytes_after_unfiltering)
+STATS_DEFINE_COUNTER_STAT(reader_num_concurrent_partitions)
+STATS_DEFINE_COUNTER_STAT(reader_num_est_result_size_tiles)
 STATS_DEFINE_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_DEFINE_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
 STATS_DEFINE_COUNTER_STAT(reader_num_tile_bytes_read)
+STATS_DEFINE_COUNTER_STAT(reader_num_tile_bytes_read_ahead)
+STATS_DEFINE_COUNTER_STAT(reader_num_tiles_read_ahead)
 STATS_DEFINE_COUNTER_STAT(reader_num_var_cell_bytes_copied)
 STATS_DEFINE_COUNTER_STAT(reader_num_var_cell_bytes_read)
+STATS_DEFINE_COUNTER_STAT(reader_read_ahead_hits)
+// MemoryBroker
+STATS_DEFINE_COUNTER_STAT(memory_broker_peak_bytes)
+STATS_DEFINE_COUNTER_STAT(memory_broker_rejections)
+STATS_DEFINE_COUNTER_STAT(memory_broker_shrinks)
+STATS_DEFINE_COUNTER_STAT(memory_broker_usage_bytes)
+STATS_DEFINE_COUNTER_STAT(memory_broker_waits)
 // Writer
 STATS_DEFINE_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_DEFINE_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_DEFINE_COUNTER_STAT(writer_num_bytes_written)
 // StorageManager
 STATS_DEFINE_COUNTER_STAT(sm_contexts_created)
+STATS_DEFINE_COUNTER_STAT(sm_fragment_checks_skipped)
+STATS_DEFINE_COUNTER_STAT(sm_query_result_cache_hits)
+STATS_DEFINE_COUNTER_STAT(sm_query_result_cache_inserts)
+STATS_DEFINE_COUNTER_STAT(sm_query_result_cache_misses)
 STATS_DEFINE_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_DEFINE_COUNTER_STAT(sm_query_submit_layout_row_major)
 STATS_DEFINE_COUNTER_STAT(sm_query_submit_layout_global_order)
@@ -477,6 +560,12 @@ STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_INIT_COUNTER_STAT(cache_lru_inserts)
 STATS_INIT_COUNTER_STAT(cache_lru_read_hits)
 STATS_INIT_COUNTER_STAT(cache_lru_read_misses)
+// Compressors
+STATS_INIT_COUNTER_STAT(compressor_contexts_created)
+STATS_INIT_COUNTER_STAT(compressor_contexts_reused)
+// Filter pipeline
+STATS_INIT_COUNTER_STAT(filter_storage_buffers_allocated)
+STATS_INIT_COUNTER_STAT(filter_storage_buffers_reused)
 // Fragment Metadata
 STATS_INIT_COUNTER_STAT(fragment_metadata_num_fragments)
 STATS_INIT_COUNTER_STAT(fragment_metadata_bytes)
@@ -487,19 +576,36 @@ STATS_INIT_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_INIT_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_INIT_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_INIT_COUNTER_STAT(reader_num_aligned_tiles_copied)
+STATS_INIT_COUNTER_STAT(reader_num_aligned_tiles_direct)
 STATS_INIT_COUNTER_STAT(reader_num_attr_tiles_touched)
 STATS_INIT_COUNTER_STAT(reader_num_bytes_after_unfiltering)
+STATS_INIT_COUNTER_STAT(reader_num_concurrent_partitions)
+STATS_INIT_COUNTER_STAT(reader_num_est_result_size_tiles)
 STATS_INIT_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_INIT_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
 STATS_INIT_COUNTER_STAT(reader_num_tile_bytes_read)
+STATS_INIT_COUNTER_STAT(reader_num_tile_bytes_read_ahead)
+STATS_INIT_COUNTER_STAT(reader_num_tiles_read_ahead)
 STATS_INIT_COUNTER_STAT(reader_num_var_cell_bytes_copied)
 STATS_INIT_COUNTER_STAT(reader_num_var_cell_bytes_read)
+STATS_INIT_COUNTER_STAT(reader_read_ahead_hits)
+// MemoryBroker
+STATS_INIT_COUNTER_STAT(memory_broker_peak_bytes)
+STATS_INIT_COUNTER_STAT(memory_broker_rejections)
+STATS_INIT_COUNTER_STAT(memory_broker_shrinks)
+STATS_INIT_COUNTER_STAT(memory_broker_usage_bytes)
+STATS_INIT_COUNTER_STAT(memory_broker_waits)
 // Writer
 STATS_INIT_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_INIT_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_INIT_COUNTER_STAT(writer_num_bytes_written)
 // StorageManager
 STATS_INIT_COUNTER_STAT(sm_contexts_created)
+STATS_INIT_COUNTER_STAT(sm_fragment_checks_skipped)
+STATS_INIT_COUNTER_STAT(sm_query_result_cache_hits)
+STATS_INIT_COUNTER_STAT(sm_query_result_cache_inserts)
+STATS_INIT_COUNTER_STAT(sm_query_result_cache_misses)
 STATS_INIT_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_INIT_COUNTER_STAT(sm_query_submit_layout_row_major)
 STATS_INIT_COUNTER_STAT(sm_query_submit_layout_global_order)
@@ -527,6 +633,12 @@ STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_REPORT_COUNTER_STAT(cache_lru_inserts)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_hits)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_misses)
+// Compressors
+STATS_REPORT_COUNTER_STAT(compressor_contexts_created)
+STATS_REPORT_COUNTER_STAT(compressor_contexts_reused)
+// Filter pipeline
+STATS_REPORT_COUNTER_STAT(filter_storage_buffers_allocated)
+STATS_REPORT_COUNTER_STAT(filter_storage_buffers_reused)
 // Fragment Metadata
 STATS_REPORT_COUNTER_STAT(fragment_metadata_num_fragments)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_bytes)
@@ -537,19 +649,36 @@ STATS_REPORT_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_REPORT_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_REPORT_COUNTER_STAT(reader_num_aligned_tiles_copied)
+STATS_REPORT_COUNTER_STAT(reader_num_aligned_tiles_direct)
 STATS_REPORT_COUNTER_STAT(reader_num_attr_tiles_touched)
 STATS_REPORT_COUNTER_STAT(reader_num_bytes_after_unfiltering)
+STATS_REPORT_COUNTER_STAT(reader_num_concurrent_partitions)
+STATS_REPORT_COUNTER_STAT(reader_num_est_result_size_tiles)
 STATS_REPORT_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_REPORT_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
 STATS_REPORT_COUNTER_STAT(reader_num_tile_bytes_read)
+STATS_REPORT_COUNTER_STAT(reader_num_tile_bytes_read_ahead)
+STATS_REPORT_COUNTER_STAT(reader_num_tiles_read_ahead)
 STATS_REPORT_COUNTER_STAT(reader_num_var_cell_bytes_copied)
 STATS_REPORT_COUNTER_STAT(reader_num_var_cell_bytes_read)
+STATS_REPORT_COUNTER_STAT(reader_read_ahead_hits)
+// MemoryBroker
+STATS_REPORT_COUNTER_STAT(memory_broker_peak_bytes)
+STATS_REPORT_COUNTER_STAT(memory_broker_rejections)
+STATS_REPORT_COUNTER_STAT(memory_broker_shrinks)
+STATS_REPORT_COUNTER_STAT(memory_broker_usage_bytes)
+STATS_REPORT_COUNTER_STAT(memory_broker_waits)
 // Writer
 STATS_REPORT_COUNTER_STAT(writer_num_attr_tiles_written)
 STATS_REPORT_COUNTER_STAT(writer_num_bytes_before_filtering)
 STATS_REPORT_COUNTER_STAT(writer_num_bytes_written)
 // StorageManager
 STATS_REPORT_COUNTER_STAT(sm_contexts_created)
+STATS_REPORT_COUNTER_STAT(sm_fragment_checks_skipped)
+STATS_REPORT_COUNTER_STAT(sm_query_result_cache_hits)
+STATS_REPORT_COUNTER_STAT(sm_query_result_cache_inserts)
+STATS_REPORT_COUNTER_STAT(sm_query_result_cache_misses)
 STATS_REPORT_COUNTER_STAT(sm_query_submit_layout_col_major)
 STATS_REPORT_COUNTER_STAT(sm_query_submit_layout_row_major)
 STATS_REPORT_COUNTER_STAT(sm_query_submit_layout_global_order)
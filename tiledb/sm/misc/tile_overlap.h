@@ -51,6 +51,12 @@ struct TileOverlap {
    * indicates full overlap and 0.0 no overlap at all.
    */
   std::vector<std::pair<uint64_t, double>> tiles_;
+  /**
+   * The exact number of cells of each tile in ``tiles_`` that lie in the
+   * range, if they have been computed (see ``Reader::get_est_result_size``).
+   * Empty otherwise.
+   */
+  std::vector<uint64_t> result_cell_nums_;
   /** Ranges of tile ids that lie completely inside the subarray range. */
   std::vector<std::pair<uint64_t, uint64_t>> tile_ranges_;
 };
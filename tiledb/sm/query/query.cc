@@ -485,6 +485,13 @@ Status Query::set_layout(Layout layout) {
   return Status::Ok();
 }
 
+void Query::set_parent_reservation(const MemoryReservation* reservation) {
+  if (type_ == QueryType::WRITE)
+    writer_.set_parent_reservation(reservation);
+  else
+    reader_.set_parent_reservation(reservation);
+}
+
 Status Query::set_sparse_mode(bool sparse_mode) {
   if (type_ != QueryType::READ)
     return LOG_STATUS(Status::QueryError(
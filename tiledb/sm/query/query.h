@@ -345,6 +345,13 @@ class Query {
    */
   Status set_layout(Layout layout);
 
+  /**
+   * Sets the memory reservation held by the component running the query
+   * (e.g., the consolidator) while the query reserves its own memory (see
+   * `MemoryBroker::reserve`).
+   */
+  void set_parent_reservation(const MemoryReservation* reservation);
+
   /**
    * This is applicable only to dense arrays (errors out for sparse arrays),
    * and only in the case where the array is opened in a way that all its
@@ -257,7 +257,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs(
 
     // Add result
     result_cell_slabs_.emplace_back(
-        (*result_coords_)[i].tile_, (*result_coords_)[i].pos_, 1);
+        (*result_coords_)[i].tile_, uint64_t((*result_coords_)[i].pos_), 1);
 
     // Update cell slab copy
     cell_slab_copy.coords_[slab_dim] = result_coord + 1;
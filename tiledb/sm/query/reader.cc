@@ -34,7 +34,9 @@
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/fragment/fragment_index.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
@@ -48,7 +50,12 @@
 #include "tiledb/sm/subarray/cell_slab.h"
 #include "tiledb/sm/tile/tile_io.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <set>
 
 namespace tiledb {
 namespace sm {
@@ -84,6 +91,257 @@ inline IterT skip_invalid_elements(IterT it, const IterT& end) {
   }
   return it;
 }
+
+/**
+ * Copies `cell_num` fixed-sized cells of type `T` from `src` to the
+ * contiguous `dst`, picking every `stride`-th cell of `src`.
+ */
+template <typename T>
+inline void gather_cells(
+    const unsigned char* src,
+    unsigned char* dst,
+    uint64_t cell_num,
+    uint64_t stride) {
+  auto s = (const T*)src;
+  auto d = (T*)dst;
+  if (stride == 1) {
+    for (uint64_t i = 0; i < cell_num; ++i)
+      d[i] = s[i];
+  } else {
+    for (uint64_t i = 0; i < cell_num; ++i)
+      d[i] = s[i * stride];
+  }
+}
+
+/** A 16-byte cell, e.g., two 64-bit coordinates or a complex value. */
+struct Cell16 {
+  uint64_t v_[2];
+};
+
+/**
+ * Copies `cell_num` cells of size `cell_size` from `src` to the contiguous
+ * `dst`, picking every `stride`-th cell of `src`. The common cell sizes
+ * are dispatched to typed kernels, so that single-cell slabs (the norm
+ * for sparse reads) avoid a `memcpy` call per cell.
+ *
+ * Note that the tile buffers are allocated with `malloc`, hence suitably
+ * aligned for all typed kernels.
+ */
+inline void gather_cells(
+    const unsigned char* src,
+    unsigned char* dst,
+    uint64_t cell_size,
+    uint64_t cell_num,
+    uint64_t stride) {
+  switch (cell_size) {
+    case 1:
+      gather_cells<uint8_t>(src, dst, cell_num, stride);
+      return;
+    case 2:
+      gather_cells<uint16_t>(src, dst, cell_num, stride);
+      return;
+    case 4:
+      gather_cells<uint32_t>(src, dst, cell_num, stride);
+      return;
+    case 8:
+      gather_cells<uint64_t>(src, dst, cell_num, stride);
+      return;
+    case 16:
+      gather_cells<Cell16>(src, dst, cell_num, stride);
+      return;
+    default:
+      break;
+  }
+
+  if (stride == 1) {
+    std::memcpy(dst, src, cell_num * cell_size);
+    return;
+  }
+  for (uint64_t i = 0; i < cell_num; ++i)
+    std::memcpy(dst + i * cell_size, src + i * stride * cell_size, cell_size);
+}
+
+/** The side of the square blocks of cells transposed at a time. */
+const uint64_t transpose_block = 16;
+
+/**
+ * Transposes a `rows x cols` matrix of cells of type `T`, i.e., copies the
+ * cell at `(r, c)` of `src` (with `src_row_stride` cells between rows) to
+ * the cell at `(c, r)` of `dst` (with `dst_col_stride` cells between
+ * columns). The matrix is processed in square blocks, so that both the
+ * source and destination cells of a block stay in the cache.
+ */
+template <typename T>
+inline void transpose_cells(
+    const unsigned char* src,
+    unsigned char* dst,
+    uint64_t rows,
+    uint64_t cols,
+    uint64_t src_row_stride,
+    uint64_t dst_col_stride) {
+  auto s = (const T*)src;
+  auto d = (T*)dst;
+  for (uint64_t rb = 0; rb < rows; rb += transpose_block) {
+    auto r_end = std::min(rb + transpose_block, rows);
+    for (uint64_t cb = 0; cb < cols; cb += transpose_block) {
+      auto c_end = std::min(cb + transpose_block, cols);
+      for (uint64_t r = rb; r < r_end; ++r) {
+        for (uint64_t c = cb; c < c_end; ++c)
+          d[c * dst_col_stride + r] = s[r * src_row_stride + c];
+      }
+    }
+  }
+}
+
+/**
+ * Transposes a matrix of cells of size `cell_size` (see the typed
+ * `transpose_cells` above).
+ */
+inline void transpose_cells(
+    const unsigned char* src,
+    unsigned char* dst,
+    uint64_t cell_size,
+    uint64_t rows,
+    uint64_t cols,
+    uint64_t src_row_stride,
+    uint64_t dst_col_stride) {
+  switch (cell_size) {
+    case 1:
+      transpose_cells<uint8_t>(
+          src, dst, rows, cols, src_row_stride, dst_col_stride);
+      return;
+    case 2:
+      transpose_cells<uint16_t>(
+          src, dst, rows, cols, src_row_stride, dst_col_stride);
+      return;
+    case 4:
+      transpose_cells<uint32_t>(
+          src, dst, rows, cols, src_row_stride, dst_col_stride);
+      return;
+    case 8:
+      transpose_cells<uint64_t>(
+          src, dst, rows, cols, src_row_stride, dst_col_stride);
+      return;
+    case 16:
+      transpose_cells<Cell16>(
+          src, dst, rows, cols, src_row_stride, dst_col_stride);
+      return;
+    default:
+      break;
+  }
+
+  for (uint64_t rb = 0; rb < rows; rb += transpose_block) {
+    auto r_end = std::min(rb + transpose_block, rows);
+    for (uint64_t cb = 0; cb < cols; cb += transpose_block) {
+      auto c_end = std::min(cb + transpose_block, cols);
+      for (uint64_t r = rb; r < r_end; ++r) {
+        for (uint64_t c = cb; c < c_end; ++c)
+          std::memcpy(
+              dst + (c * dst_col_stride + r) * cell_size,
+              src + (r * src_row_stride + c) * cell_size,
+              cell_size);
+      }
+    }
+  }
+}
+
+/**
+ * Computes the strides (in cells) of the dimensions of a hyper-rectangle
+ * with the input extents, when its cells are laid out in `layout`.
+ */
+inline void cell_strides(
+    Layout layout,
+    const std::vector<uint64_t>& extents,
+    std::vector<uint64_t>* strides) {
+  auto dim_num = (unsigned)extents.size();
+  strides->resize(dim_num);
+  if (layout == Layout::ROW_MAJOR) {
+    (*strides)[dim_num - 1] = 1;
+    for (unsigned d = dim_num - 1; d > 0; --d)
+      (*strides)[d - 1] = (*strides)[d] * extents[d];
+  } else {
+    (*strides)[0] = 1;
+    for (unsigned d = 1; d < dim_num; ++d)
+      (*strides)[d] = (*strides)[d - 1] * extents[d - 1];
+  }
+}
+
+/**
+ * Returns the dimension with unit stride and the largest extent, i.e.,
+ * the dimension along which consecutive cells are contiguous.
+ */
+inline unsigned unit_stride_dim(
+    const std::vector<uint64_t>& extents,
+    const std::vector<uint64_t>& strides) {
+  unsigned ret = 0;
+  bool found = false;
+  for (unsigned d = 0; d < (unsigned)extents.size(); ++d) {
+    if (strides[d] == 1 && (!found || extents[d] > extents[ret])) {
+      ret = d;
+      found = true;
+    }
+  }
+  return ret;
+}
+
+/**
+ * Copies the cells of a hyper-rectangle with the input extents from `src`
+ * to `dst`, where the dimensions have strides (in cells) `src_strides` and
+ * `dst_strides`, respectively. Contiguous runs are copied with `memcpy`
+ * when the two sides agree on the fastest-varying dimension, and the
+ * cells are transposed block by block otherwise.
+ */
+inline void copy_tile_cells(
+    const unsigned char* src,
+    unsigned char* dst,
+    uint64_t cell_size,
+    const std::vector<uint64_t>& extents,
+    const std::vector<uint64_t>& src_strides,
+    const std::vector<uint64_t>& dst_strides) {
+  auto dim_num = (unsigned)extents.size();
+  auto src_dim = unit_stride_dim(extents, src_strides);
+  auto dst_dim = unit_stride_dim(extents, dst_strides);
+
+  // Iterate over the remaining dimensions
+  std::vector<unsigned> outer;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (d != src_dim && d != dst_dim)
+      outer.push_back(d);
+  }
+  std::vector<uint64_t> idx(outer.size(), 0);
+  for (;;) {
+    uint64_t src_off = 0, dst_off = 0;
+    for (size_t k = 0; k < outer.size(); ++k) {
+      src_off += idx[k] * src_strides[outer[k]];
+      dst_off += idx[k] * dst_strides[outer[k]];
+    }
+
+    if (src_dim == dst_dim) {
+      std::memcpy(
+          dst + dst_off * cell_size,
+          src + src_off * cell_size,
+          extents[src_dim] * cell_size);
+    } else {
+      transpose_cells(
+          src + src_off * cell_size,
+          dst + dst_off * cell_size,
+          cell_size,
+          extents[dst_dim],
+          extents[src_dim],
+          src_strides[dst_dim],
+          dst_strides[src_dim]);
+    }
+
+    size_t k = 0;
+    for (; k < outer.size(); ++k) {
+      if (++idx[k] < extents[outer[k]])
+        break;
+      idx[k] = 0;
+    }
+    if (k == outer.size())
+      break;
+  }
+}
 }  // namespace
 
 /* ****************************** */
@@ -96,10 +354,23 @@ Reader::Reader() {
   storage_manager_ = nullptr;
   layout_ = Layout::ROW_MAJOR;
   sparse_mode_ = false;
+  offsets_bitsize_ = 64;
+  checksum_sample_rate_ = 1.0;
+  checksum_skip_on_cache_hit_ = false;
+  checksum_tile_num_ = 0;
+  read_ahead_ = false;
+  concurrent_partitions_ = 0;
+  cache_results_ = false;
+  read_submitted_ = false;
+  served_from_result_cache_ = false;
+  parent_reservation_ = nullptr;
   read_state_.initialized_ = false;
 }
 
-Reader::~Reader() = default;
+Reader::~Reader() {
+  // The pending read-ahead tasks write into `read_ahead_tiles_`
+  wait_read_ahead();
+}
 
 /* ****************************** */
 /*               API              */
@@ -128,12 +399,28 @@ Status Reader::get_range(
 }
 
 Status Reader::get_est_result_size(const char* name, uint64_t* size) {
+  if (tight_est_result_size())
+    RETURN_NOT_OK(compute_result_cell_nums());
   return subarray_.get_est_result_size(name, size);
 }
 
 Status Reader::get_est_result_size(
     const char* name, uint64_t* size_off, uint64_t* size_val) {
-  return subarray_.get_est_result_size(name, size_off, size_val);
+  if (tight_est_result_size())
+    RETURN_NOT_OK(compute_result_cell_nums());
+  RETURN_NOT_OK(subarray_.get_est_result_size(name, size_off, size_val));
+
+  // The subarray estimates assume 64-bit offsets
+  if (storage_manager_ != nullptr) {
+    uint32_t offsets_bitsize = 64;
+    bool found = false;
+    RETURN_NOT_OK(storage_manager_->config().get<uint32_t>(
+        "sm.var_offsets.bitsize", &offsets_bitsize, &found));
+    assert(found);
+    *size_off /= 64 / offsets_bitsize;
+  }
+
+  return Status::Ok();
 }
 
 const ArraySchema* Reader::array_schema() const {
@@ -157,6 +444,8 @@ QueryBuffer Reader::buffer(const std::string& name) const {
 }
 
 bool Reader::incomplete() const {
+  if (served_from_result_cache_)
+    return false;
   return read_state_.overflowed_ || !read_state_.done();
 }
 
@@ -217,12 +506,50 @@ Status Reader::init(const Layout& layout) {
   RETURN_NOT_OK(check_subarray());
 
   // Get configuration parameters
-  const char *memory_budget, *memory_budget_var;
+  const char *memory_budget, *memory_budget_var, *offsets_bitsize;
   auto config = storage_manager_->config();
   RETURN_NOT_OK(config.get("sm.memory_budget", &memory_budget));
   RETURN_NOT_OK(config.get("sm.memory_budget_var", &memory_budget_var));
+  RETURN_NOT_OK(config.get("sm.var_offsets.bitsize", &offsets_bitsize));
   RETURN_NOT_OK(utils::parse::convert(memory_budget, &memory_budget_));
   RETURN_NOT_OK(utils::parse::convert(memory_budget_var, &memory_budget_var_));
+  RETURN_NOT_OK(utils::parse::convert(offsets_bitsize, &offsets_bitsize_));
+  const char *checksum_sample_rate, *checksum_skip_on_cache_hit;
+  RETURN_NOT_OK(
+      config.get("sm.checksum.verify_sample_rate", &checksum_sample_rate));
+  RETURN_NOT_OK(config.get(
+      "sm.checksum.skip_on_cache_hit", &checksum_skip_on_cache_hit));
+  RETURN_NOT_OK(
+      utils::parse::convert(checksum_sample_rate, &checksum_sample_rate_));
+  RETURN_NOT_OK(utils::parse::convert(
+      checksum_skip_on_cache_hit, &checksum_skip_on_cache_hit_));
+  const char* read_ahead;
+  RETURN_NOT_OK(config.get("sm.read_ahead", &read_ahead));
+  RETURN_NOT_OK(utils::parse::convert(read_ahead, &read_ahead_));
+  if (concurrent_partitions_ == 0) {
+    const char* concurrent_partitions;
+    RETURN_NOT_OK(
+        config.get("sm.concurrent_partitions", &concurrent_partitions));
+    RETURN_NOT_OK(utils::parse::convert(
+        concurrent_partitions, &concurrent_partitions_));
+  }
+
+  uint64_t query_result_cache_size = 0;
+  bool found = false;
+  RETURN_NOT_OK(config.get<uint64_t>(
+      "sm.query_result_cache_size", &query_result_cache_size, &found));
+  assert(found);
+  cache_results_ = query_result_cache_size > 0;
+
+  // Get the fragment index of the array, if the array has not been reopened
+  // since the fragment metadata were set
+  if (array_ != nullptr) {
+    fragment_index_ = array_->fragment_index();
+    if (fragment_index_ != nullptr &&
+        fragment_index_->fragment_metadata() != fragment_metadata_)
+      fragment_index_.reset();
+  }
+
   RETURN_NOT_OK(init_read_state());
 
   return Status::Ok();
@@ -263,49 +590,43 @@ Reader::ReadState* Reader::read_state() {
 Status Reader::read() {
   STATS_FUNC_IN(reader_read);
 
-  // Get next partition
-  if (!read_state_.unsplittable_)
-    RETURN_NOT_OK(read_state_.next());
-
-  // Handle empty array or empty/finished subarray
-  if (fragment_metadata_.empty()) {
-    zero_out_buffer_sizes();
+  // Serve the first submission from the results of an identical earlier
+  // read, if they are cached
+  std::string result_cache_key;
+  served_from_result_cache_ = false;
+  if (cache_results_ && !read_submitted_) {
+    result_cache_key = this->result_cache_key();
+    RETURN_NOT_OK(
+        read_from_result_cache(result_cache_key, &served_from_result_cache_));
+  }
+  read_submitted_ = true;
+  if (served_from_result_cache_) {
+    // The read is complete, so that a resubmission returns no results
+    auto state = read_state_.partitioner_.state();
+    state->single_range_.clear();
+    state->multi_range_.clear();
+    state->start_ = state->end_ + 1;
     return Status::Ok();
   }
 
-  // Loop until you find results, or unsplittable, or done
-  do {
-    read_state_.overflowed_ = false;
-    reset_buffer_sizes();
+  // The tiles fetched by a previous read-ahead must be in place before
+  // they are looked up by `read_tiles`
+  wait_read_ahead();
+  read_ahead_reservation_.release();
 
-    // Perform read
-    if (array_schema_->dense() && !sparse_mode_) {
-      RETURN_NOT_OK(dense_read());
-    } else {
-      RETURN_NOT_OK(sparse_read());
-    }
+  RETURN_NOT_OK_ELSE(read_next_partition(), read_ahead_tiles_.clear());
 
-    // In the case of overflow, we need to split the current partition
-    // without advancing to the next partition
-    if (read_state_.overflowed_) {
-      zero_out_buffer_sizes();
-      RETURN_NOT_OK(read_state_.split_current());
+  // Cache the results if the read completed in a single submission
+  if (!result_cache_key.empty() && !incomplete())
+    RETURN_NOT_OK(write_to_result_cache(result_cache_key));
 
-      if (read_state_.unsplittable_)
-        return Status::Ok();
-    } else {
-      bool no_results = this->no_results();
-
-      // Need to reset unsplittable if the results fit after all
-      if (!no_results)
-        read_state_.unsplittable_ = false;
-
-      if (!no_results || read_state_.done())
-        return Status::Ok();
-
-      RETURN_NOT_OK(read_state_.next());
-    }
-  } while (true);
+  // Fetch the tiles of the next partition while the results are consumed
+  if (read_ahead_ && !read_state_.unsplittable_ && !read_state_.done() &&
+      !fragment_metadata_.empty()) {
+    RETURN_NOT_OK_ELSE(read_ahead(), read_ahead_tiles_.clear());
+  } else {
+    read_ahead_tiles_.clear();
+  }
 
   return Status::Ok();
 
@@ -421,6 +742,7 @@ Status Reader::set_buffer(
 void Reader::set_fragment_metadata(
     const std::vector<FragmentMetadata*>& fragment_metadata) {
   fragment_metadata_ = fragment_metadata;
+  subarray_.set_fragment_metadata(fragment_metadata_);
 }
 
 Status Reader::set_layout(Layout layout) {
@@ -430,6 +752,10 @@ Status Reader::set_layout(Layout layout) {
   return Status::Ok();
 }
 
+void Reader::set_parent_reservation(const MemoryReservation* reservation) {
+  parent_reservation_ = reservation;
+}
+
 Status Reader::set_sparse_mode(bool sparse_mode) {
   if (!array_schema_->dense())
     return LOG_STATUS(Status::ReaderError(
@@ -458,6 +784,7 @@ void Reader::set_storage_manager(StorageManager* storage_manager) {
 
 Status Reader::set_subarray(const Subarray& subarray) {
   subarray_ = subarray;
+  subarray_.set_fragment_metadata(fragment_metadata_);
   layout_ = subarray.layout();
 
   return Status::Ok();
@@ -724,10 +1051,14 @@ Status Reader::compute_subarray_coords(
     std::vector<std::vector<ResultCoords>>* range_result_coords,
     std::vector<ResultCoords>* result_coords) {
   // Add all valid ``range_result_coords`` to ``result_coords``
+  uint64_t coords_num = 0;
+  for (const auto& rv : *range_result_coords)
+    coords_num += rv.size();
+  result_coords->reserve(result_coords->size() + coords_num);
   for (const auto& rv : *range_result_coords) {
     for (const auto& c : rv) {
       if (c.valid())
-        result_coords->emplace_back(c.tile_, c.pos_);
+        result_coords->emplace_back(c.tile_, uint64_t(c.pos_));
     }
   }
 
@@ -812,6 +1143,37 @@ Status Reader::compute_sparse_result_tiles(
   STATS_FUNC_OUT(reader_compute_overlapping_tiles);
 }
 
+void Reader::compute_tile_cell_ranges(
+    uint64_t stride,
+    const std::vector<ResultCellSlab>& result_cell_slabs,
+    std::unordered_map<
+        const ResultTile*,
+        std::vector<std::pair<uint64_t, uint64_t>>>* cell_ranges) const {
+  auto cs_stride = (stride == UINT64_MAX) ? 1 : stride;
+  for (const auto& cs : result_cell_slabs) {
+    if (cs.tile_ == nullptr || cs.length_ == 0)
+      continue;
+    auto last = cs.start_ + (cs.length_ - 1) * cs_stride;
+    (*cell_ranges)[cs.tile_].emplace_back(cs.start_, last);
+  }
+
+  // Sort and merge the ranges of each tile
+  for (auto& it : *cell_ranges) {
+    auto& ranges = it.second;
+    std::sort(ranges.begin(), ranges.end());
+    size_t merged = 0;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+      if (ranges[i].first <= ranges[merged].second + 1) {
+        ranges[merged].second =
+            std::max(ranges[merged].second, ranges[i].second);
+      } else {
+        ranges[++merged] = ranges[i];
+      }
+    }
+    ranges.resize(merged + 1);
+  }
+}
+
 Status Reader::copy_cells(
     const std::string& attribute,
     uint64_t stride,
@@ -874,7 +1236,7 @@ Status Reader::copy_fixed_cells(
         std::memcpy(buffer + offset, fill_value, fill_size);
         offset += fill_size;
       }
-    } else {  // Non-empty range
+    } else if (name == constants::coords) {  // Possibly zipped coordinates
       if (stride == UINT64_MAX) {
         RETURN_NOT_OK(
             cs.tile_->read(name, buffer + offset, cs.start_, cs.length_));
@@ -887,6 +1249,20 @@ Status Reader::copy_fixed_cells(
           start += stride;
         }
       }
+    } else {  // Non-empty range
+      const auto& tile = cs.tile_->tile_pair(name)->first;
+      auto cs_stride = (stride == UINT64_MAX) ? 1 : stride;
+      auto end_cell = cs.start_ + (cs.length_ - 1) * cs_stride;
+      if (tile.cell_size() != cell_size || end_cell >= tile.cell_num())
+        return LOG_STATUS(Status::ReaderError(
+            "Cannot copy cells; Trying to read beyond tile size"));
+      auto src = (const unsigned char*)tile.internal_data();
+      gather_cells(
+          src + cs.start_ * cell_size,
+          buffer + offset,
+          cell_size,
+          cs.length_,
+          cs_stride);
     }
 
     return Status::Ok();
@@ -916,7 +1292,7 @@ Status Reader::copy_var_cells(
   auto buffer_var = (unsigned char*)it->second.buffer_var_;
   auto buffer_size = it->second.buffer_size_;
   auto buffer_var_size = it->second.buffer_var_size_;
-  uint64_t offset_size = constants::cell_var_offset_size;
+  uint64_t offset_size = offsets_bitsize_ / 8;
   auto type = array_schema_->type(name);
   auto fill_size = datatype_size(type);
   auto fill_value = constants::fill_value(type);
@@ -970,7 +1346,12 @@ Status Reader::copy_var_cells(
       auto var_dest = buffer_var + var_offset;
 
       // Copy offset
-      std::memcpy(offset_dest, &var_offset, offset_size);
+      if (offset_size == sizeof(uint32_t)) {
+        auto var_offset_32 = (uint32_t)var_offset;
+        std::memcpy(offset_dest, &var_offset_32, sizeof(uint32_t));
+      } else {
+        std::memcpy(offset_dest, &var_offset, offset_size);
+      }
 
       // Copy variable-sized value
       if (cs.tile_ == nullptr) {
@@ -1014,7 +1395,7 @@ Status Reader::compute_var_cell_destinations(
     uint64_t* total_var_size) const {
   // For easy reference
   auto num_cs = result_cell_slabs.size();
-  auto offset_size = constants::cell_var_offset_size;
+  uint64_t offset_size = offsets_bitsize_ / 8;
   auto type = array_schema_->type(name);
   auto fill_size = datatype_size(type);
 
@@ -1060,6 +1441,11 @@ Status Reader::compute_var_cell_destinations(
       }
 
       // Record destination offsets.
+      if (offset_size == sizeof(uint32_t) &&
+          *total_var_size > std::numeric_limits<uint32_t>::max())
+        return LOG_STATUS(Status::ReaderError(
+            "Cannot copy var-sized cells; Offset does not fit in 32 bits "
+            "(see config parameter 'sm.var_offsets.bitsize')"));
       (*offset_offsets_per_cs)[cs_idx][dest_vec_idx] = *total_offset_size;
       (*var_offsets_per_cs)[cs_idx][dest_vec_idx] = *total_var_size;
       *total_offset_size += offset_size;
@@ -1209,6 +1595,77 @@ void Reader::compute_result_cell_slabs_global(
   }
 }
 
+Status Reader::compute_result_cell_nums() {
+  // The tiles read below may be looked up in `read_ahead_tiles_`, which the
+  // pending read-ahead tasks of an incomplete read still write into
+  wait_read_ahead();
+
+  RETURN_NOT_OK(subarray_.compute_tile_overlap());
+
+  // For easy reference
+  auto domain = array_schema_->domain();
+  auto dim_num = array_schema_->dim_num();
+  const auto& overlap = subarray_.tile_overlap();
+  auto range_num = subarray_.range_num();
+  auto fragment_num = fragment_metadata_.size();
+
+  // Process one fragment at a time, to bound the memory of the coordinates
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    if (fragment_metadata_[f]->dense())
+      continue;
+
+    // Collect the unique partially overlapping tiles without counts
+    std::map<uint64_t, size_t> result_tile_map;
+    std::vector<ResultTile> result_tiles;
+    for (uint64_t r = 0; r < range_num; ++r) {
+      if (!overlap[f][r].result_cell_nums_.empty())
+        continue;
+      for (const auto& o_tile : overlap[f][r].tiles_) {
+        auto t = o_tile.first;
+        if (result_tile_map.find(t) == result_tile_map.end()) {
+          result_tiles.emplace_back(f, t, domain);
+          result_tile_map[t] = result_tiles.size() - 1;
+        }
+      }
+    }
+    if (result_tiles.empty())
+      continue;
+
+    std::vector<ResultTile*> tmp_result_tiles;
+    for (auto& result_tile : result_tiles)
+      tmp_result_tiles.push_back(&result_tile);
+
+    // Read and unfilter the coordinate tiles (zipped for format versions <5,
+    // per dimension otherwise)
+    RETURN_NOT_OK(read_tiles(constants::coords, tmp_result_tiles));
+    RETURN_NOT_OK(unfilter_tiles(constants::coords, tmp_result_tiles));
+    for (unsigned d = 0; d < dim_num; ++d) {
+      const auto& dim_name = array_schema_->dimension(d)->name();
+      RETURN_NOT_OK(read_tiles(dim_name, tmp_result_tiles));
+      RETURN_NOT_OK(unfilter_tiles(dim_name, tmp_result_tiles));
+    }
+    STATS_COUNTER_ADD(reader_num_est_result_size_tiles, result_tiles.size());
+
+    // Count the cells of each tile in each range
+    for (uint64_t r = 0; r < range_num; ++r) {
+      const auto& o_tiles = overlap[f][r].tiles_;
+      if (o_tiles.empty() || !overlap[f][r].result_cell_nums_.empty())
+        continue;
+      auto ndrange = subarray_.ndrange(r);
+      std::vector<uint64_t> result_cell_nums(o_tiles.size(), 0);
+      for (size_t i = 0; i < o_tiles.size(); ++i) {
+        auto tile = &result_tiles[result_tile_map[o_tiles[i].first]];
+        auto cell_num = tile->cell_num();
+        for (uint64_t pos = 0; pos < cell_num; ++pos)
+          result_cell_nums[i] += tile->coord_in_rect(pos, ndrange);
+      }
+      subarray_.set_result_cell_nums(f, r, std::move(result_cell_nums));
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status Reader::compute_result_coords(
     std::vector<ResultTile>* result_tiles,
     std::vector<ResultCoords>* result_coords) {
@@ -1331,6 +1788,16 @@ Status Reader::dense_read() {
   assert(std::is_integral<T>::value);
   assert(!fragment_metadata_.empty());
 
+  // Read whole tiles straight into the user buffers, if possible
+  auto& subarray = read_state_.partitioner_.current();
+  bool done = false;
+  RETURN_CANCEL_OR_ERROR(dense_read_aligned<T>(subarray, &done));
+  if (done) {
+    if (has_coords())
+      RETURN_CANCEL_OR_ERROR(fill_dense_coords<T>(subarray));
+    return Status::Ok();
+  }
+
   // Compute result coordinates from the sparse fragments
   // `sparse_result_tiles` will hold all the relevant result tiles of
   // sparse fragments
@@ -1345,8 +1812,6 @@ Status Reader::dense_read() {
   std::map<const T*, ResultSpaceTile<T>> result_space_tiles;
   std::vector<ResultCellSlab> result_cell_slabs;
   std::vector<ResultTile*> result_tiles;
-  auto& subarray = read_state_.partitioner_.current();
-
   subarray.compute_tile_coords<T>();
   compute_result_cell_slabs<T>(
       subarray,
@@ -1370,7 +1835,8 @@ Status Reader::dense_read() {
       continue;
 
     RETURN_CANCEL_OR_ERROR(read_tiles(name, result_tiles));
-    RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, result_tiles));
+    RETURN_CANCEL_OR_ERROR(
+        unfilter_tiles(name, result_tiles, &result_cell_slabs, stride));
     RETURN_CANCEL_OR_ERROR(copy_cells(name, stride, result_cell_slabs));
     clear_tiles(name, result_tiles);
   }
@@ -1384,6 +1850,190 @@ Status Reader::dense_read() {
   STATS_FUNC_OUT(reader_dense_read);
 }
 
+template <class T>
+Status Reader::dense_read_aligned(Subarray& subarray, bool* done) {
+  *done = false;
+
+  // Check the subarray layout and ranges
+  auto layout = subarray.layout();
+  if (layout != Layout::ROW_MAJOR && layout != Layout::COL_MAJOR &&
+      layout != Layout::GLOBAL_ORDER)
+    return Status::Ok();
+  if (!subarray.coincides_with_tiles())
+    return Status::Ok();
+
+  // Only fixed-sized attributes are supported
+  std::vector<std::string> names;
+  for (const auto& it : buffers_) {
+    const auto& name = it.first;
+    if (name == constants::coords || array_schema_->is_dim(name))
+      continue;
+    if (array_schema_->var_size(name))
+      return Status::Ok();
+    names.push_back(name);
+  }
+  if (names.empty())
+    return Status::Ok();
+
+  // Find the latest fragment overlapping the subarray, which must be dense
+  // and contain the subarray, so that it shadows all older fragments
+  RETURN_NOT_OK(subarray.compute_tile_overlap());
+  const auto& tile_overlap = subarray.tile_overlap();
+  auto fragment_num = (unsigned)fragment_metadata_.size();
+  if (tile_overlap.size() != fragment_num)
+    return Status::Ok();
+  auto frag_idx = fragment_num;
+  for (auto f = fragment_num; f > 0; --f) {
+    const auto& overlap = tile_overlap[f - 1][0];
+    if (!overlap.tiles_.empty() || !overlap.tile_ranges_.empty()) {
+      frag_idx = f - 1;
+      break;
+    }
+  }
+  if (frag_idx == fragment_num)
+    return Status::Ok();
+  auto meta = fragment_metadata_[frag_idx];
+  auto domain = array_schema_->domain();
+  auto ndrange = subarray.ndrange(0);
+  if (!meta->dense() || !domain->covered(ndrange, meta->non_empty_domain()))
+    return Status::Ok();
+
+  // Leave the overflow handling to the regular path
+  auto cell_num = domain->cell_num(ndrange);
+  if (cell_num == 0)
+    return Status::Ok();
+  for (const auto& name : names) {
+    auto buffer_size = buffers_.find(name)->second.buffer_size_;
+    if (cell_num * array_schema_->cell_size(name) > *buffer_size)
+      return Status::Ok();
+  }
+
+  // Compute the cell strides of a tile in the fragment and in the user
+  // buffers. The tiles whose cells are laid out identically in both are
+  // unfiltered directly into the user buffers.
+  auto dim_num = array_schema_->dim_num();
+  std::vector<uint64_t> extents(dim_num), sub_extents(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto r = (const T*)ndrange[d].data();
+    extents[d] = (uint64_t)*(const T*)domain->tile_extent(d).data();
+    sub_extents[d] = (uint64_t(r[1]) - uint64_t(r[0])) + 1;
+  }
+  std::vector<uint64_t> src_strides, dst_strides;
+  cell_strides(array_schema_->cell_order(), extents, &src_strides);
+  bool global = (layout == Layout::GLOBAL_ORDER);
+  bool direct = true;
+  if (global) {
+    dst_strides = src_strides;
+  } else {
+    cell_strides(layout, sub_extents, &dst_strides);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      if (extents[d] > 1 && dst_strides[d] != src_strides[d])
+        direct = false;
+    }
+  }
+
+  // Create the result tiles and compute the position of their first cell
+  // in the user buffers
+  subarray.compute_tile_coords<T>();
+  const auto& tile_coords = subarray.tile_coords();
+  auto tile_num = (uint64_t)tile_coords.size();
+  auto cell_num_per_tile = domain->cell_num_per_tile();
+  assert(tile_num * cell_num_per_tile == cell_num);
+  auto dom = domain->domain();
+  auto tile_extents = domain->tile_extents();
+  auto tile_order = array_schema_->tile_order();
+  TileDomain<T> array_tile_domain(
+      UINT32_MAX, dom, dom, tile_extents, tile_order);
+  TileDomain<T> frag_tile_domain(
+      frag_idx, dom, meta->non_empty_domain(), tile_extents, tile_order);
+  std::vector<ResultTile> result_tiles;
+  std::vector<uint64_t> dst_cell_offsets(tile_num, 0);
+  result_tiles.reserve(tile_num);
+  for (uint64_t i = 0; i < tile_num; ++i) {
+    auto coords = (const T*)&tile_coords[i][0];
+    result_tiles.emplace_back(
+        frag_idx, frag_tile_domain.tile_pos(coords), domain);
+    if (global) {
+      dst_cell_offsets[i] = i * cell_num_per_tile;
+    } else {
+      auto start_coords = array_tile_domain.start_coords(coords);
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto r = (const T*)ndrange[d].data();
+        dst_cell_offsets[i] +=
+            (uint64_t(start_coords[d]) - uint64_t(r[0])) * dst_strides[d];
+      }
+    }
+  }
+  std::vector<ResultTile*> result_tile_ptrs;
+  for (auto& tile : result_tiles)
+    result_tile_ptrs.push_back(&tile);
+
+  // Read the attribute tiles
+  auto encryption_key = array_->encryption_key();
+  for (const auto& name : names) {
+    auto& query_buffer = buffers_.find(name)->second;
+    auto buffer = (unsigned char*)query_buffer.buffer_;
+    auto cell_size = array_schema_->cell_size(name);
+    auto tile_size = cell_num_per_tile * cell_size;
+
+    RETURN_CANCEL_OR_ERROR(read_tiles(name, result_tile_ptrs));
+    auto statuses = parallel_for(0, tile_num, [&, this](uint64_t i) {
+      auto& t = result_tiles[i].tile_pair(name)->first;
+      auto dest = buffer + dst_cell_offsets[i] * cell_size;
+      bool copy = true;
+      if (t.filtered()) {
+        // Store the filtered buffer in the tile cache.
+        auto tile_attr_uri = meta->uri(name);
+        uint64_t tile_attr_offset;
+        RETURN_NOT_OK(meta->file_offset(
+            *encryption_key,
+            name,
+            result_tiles[i].tile_idx(),
+            &tile_attr_offset));
+        RETURN_NOT_OK(storage_manager_->write_to_cache(
+            tile_attr_uri, tile_attr_offset, t.buffer()));
+
+        auto st = direct ? unfilter_tile(name, &t, false, {}, dest, tile_size) :
+                           unfilter_tile(name, &t, false, {});
+        if (!st.ok()) {
+          RETURN_NOT_OK(storage_manager_->evict_from_cache(
+              tile_attr_uri, tile_attr_offset));
+          return st;
+        }
+        copy = !direct;
+      }
+
+      if (t.size() != tile_size)
+        return LOG_STATUS(Status::ReaderError(
+            "Cannot read dense tile; Unexpected tile size"));
+
+      if (copy) {
+        copy_tile_cells(
+            (const unsigned char*)t.internal_data(),
+            dest,
+            cell_size,
+            extents,
+            src_strides,
+            dst_strides);
+        STATS_COUNTER_ADD(reader_num_aligned_tiles_copied, 1);
+      } else {
+        STATS_COUNTER_ADD(reader_num_aligned_tiles_direct, 1);
+      }
+
+      return Status::Ok();
+    });
+    for (const auto& st : statuses)
+      RETURN_CANCEL_OR_ERROR(st);
+
+    clear_tiles(name, result_tile_ptrs);
+    *(query_buffer.buffer_size_) = cell_num * cell_size;
+  }
+
+  *done = true;
+
+  return Status::Ok();
+}
+
 template <class T>
 Status Reader::fill_dense_coords(const Subarray& subarray) {
   // Prepare buffers
@@ -1590,13 +2240,24 @@ void Reader::fill_dense_coords_col_slab(
 
 Status Reader::unfilter_tiles(
     const std::string& name,
-    const std::vector<ResultTile*>& result_tiles) const {
+    const std::vector<ResultTile*>& result_tiles,
+    const std::vector<ResultCellSlab>* result_cell_slabs,
+    uint64_t stride) const {
   STATS_FUNC_IN(reader_unfilter_tiles);
 
   auto var_size = array_schema_->var_size(name);
   auto num_tiles = static_cast<uint64_t>(result_tiles.size());
   auto encryption_key = array_->encryption_key();
 
+  // Compute the cells needed from each tile, so that only the tile chunks
+  // holding them get unfiltered.
+  std::unordered_map<
+      const ResultTile*,
+      std::vector<std::pair<uint64_t, uint64_t>>>
+      cell_ranges;
+  if (result_cell_slabs != nullptr && name != constants::coords)
+    compute_tile_cell_ranges(stride, *result_cell_slabs, &cell_ranges);
+
   auto statuses = parallel_for(0, num_tiles, [&, this](uint64_t i) {
     auto& tile = result_tiles[i];
     auto& fragment = fragment_metadata_[tile->frag_idx()];
@@ -1623,13 +2284,43 @@ Status Reader::unfilter_tiles(
 
       auto& t = tile_pair->first;
       auto& t_var = tile_pair->second;
+      auto range_it = cell_ranges.find(tile);
+      const std::vector<std::pair<uint64_t, uint64_t>>* tile_cell_ranges =
+          (range_it != cell_ranges.end()) ? &range_it->second : nullptr;
 
       if (t.filtered()) {
         // Store the filtered buffer in the tile cache.
         RETURN_NOT_OK(storage_manager_->write_to_cache(
             tile_attr_uri, tile_attr_offset, t.buffer()));
-        // Unfilter the tile buffer within the 't' instance.
-        RETURN_NOT_OK(unfilter_tile(name, &t, var_size));
+
+        // Compute the byte ranges holding the needed cells. For var-sized
+        // attributes, the offsets of the first cell and of the cell after
+        // each range are also needed to compute the cell sizes.
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        if (tile_cell_ranges != nullptr) {
+          auto cell_size = var_size ? constants::cell_var_offset_size :
+                                      array_schema_->cell_size(name);
+          uint64_t extra_cells = var_size ? 2 : 1;
+          for (const auto& r : *tile_cell_ranges)
+            ranges.emplace_back(
+                r.first * cell_size, (r.second + extra_cells) * cell_size);
+          if (var_size && ranges[0].first > 0) {
+            if (ranges[0].first <= cell_size)
+              ranges[0].first = 0;
+            else
+              ranges.insert(ranges.begin(), std::make_pair(0, cell_size));
+          }
+        }
+
+        // Unfilter the tile buffer within the 't' instance. A tile that
+        // fails to unfilter (e.g., upon a checksum mismatch) is evicted from
+        // the tile cache, so that it is read again from storage.
+        auto st = unfilter_tile(name, &t, var_size, ranges);
+        if (!st.ok()) {
+          RETURN_NOT_OK(storage_manager_->evict_from_cache(
+              tile_attr_uri, tile_attr_offset));
+          return st;
+        }
       }
 
       if (var_size && t_var.filtered()) {
@@ -1641,8 +2332,30 @@ Status Reader::unfilter_tiles(
         // Store the filtered buffer in the tile cache.
         RETURN_NOT_OK(storage_manager_->write_to_cache(
             tile_attr_var_uri, tile_attr_var_offset, t_var.buffer()));
+
+        // Compute the byte ranges holding the needed cells from the
+        // (unfiltered) offsets.
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        auto cell_num = t.cell_num();
+        if (tile_cell_ranges != nullptr &&
+            tile_cell_ranges->back().second < cell_num) {
+          auto tile_offsets = (const uint64_t*)t.internal_data();
+          for (const auto& r : *tile_cell_ranges) {
+            auto start = tile_offsets[r.first] - tile_offsets[0];
+            auto end = (r.second + 1 < cell_num) ?
+                           tile_offsets[r.second + 1] - tile_offsets[0] :
+                           std::numeric_limits<uint64_t>::max();
+            ranges.emplace_back(start, end);
+          }
+        }
+
         // Unfilter the tile buffer within the 't_var' instance.
-        RETURN_NOT_OK(unfilter_tile(name, &t_var, false));
+        auto st = unfilter_tile(name, &t_var, false, ranges);
+        if (!st.ok()) {
+          RETURN_NOT_OK(storage_manager_->evict_from_cache(
+              tile_attr_var_uri, tile_attr_var_offset));
+          return st;
+        }
       }
     }
 
@@ -1657,8 +2370,35 @@ Status Reader::unfilter_tiles(
   STATS_FUNC_OUT(reader_unfilter_tiles);
 }
 
+bool Reader::tight_est_result_size() const {
+  if (storage_manager_ == nullptr)
+    return false;
+  const char* mode = nullptr;
+  auto st = storage_manager_->config().get("sm.est_result_size_mode", &mode);
+  return st.ok() && mode != nullptr && std::string(mode) == "tight";
+}
+
+bool Reader::verify_checksums(const Tile& tile) const {
+  if (checksum_skip_on_cache_hit_ && tile.from_cache())
+    return false;
+  if (checksum_sample_rate_ >= 1.0)
+    return true;
+
+  // Verify the n-th tile if the number of verified tiles, i.e.,
+  // `floor(n * rate)`, increases with it. This spreads the verified tiles
+  // evenly over the reads.
+  uint64_t n = checksum_tile_num_++;
+  return std::floor((n + 1) * checksum_sample_rate_) >
+         std::floor(n * checksum_sample_rate_);
+}
+
 Status Reader::unfilter_tile(
-    const std::string& name, Tile* tile, bool offsets) const {
+    const std::string& name,
+    Tile* tile,
+    bool offsets,
+    const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+    void* dest,
+    uint64_t dest_size) const {
   // Get a copy of the appropriate unfilter pipeline.
   FilterPipeline filters =
       (offsets ? array_schema_->cell_var_offsets_filters() :
@@ -1668,7 +2408,11 @@ Status Reader::unfilter_tile(
   RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
       &filters, array_->get_encryption_key()));
 
-  RETURN_NOT_OK(filters.run_reverse(tile));
+  filters.set_verify_checksums(verify_checksums(*tile));
+  if (dest != nullptr)
+    RETURN_NOT_OK(filters.run_reverse(tile, dest, dest_size));
+  else
+    RETURN_NOT_OK(filters.run_reverse(tile, ranges));
 
   tile->set_filtered(false);
 
@@ -1738,14 +2482,17 @@ Status Reader::init_read_state() {
       RETURN_NOT_OK(read_state_.partitioner_.set_result_budget(
           attr_name.c_str(), *buffer_size));
     } else {
+      // The partitioner estimates assume 64-bit offsets
+      auto buffer_off_size = *buffer_size * (64 / offsets_bitsize_);
       RETURN_NOT_OK(read_state_.partitioner_.set_result_budget(
-          attr_name.c_str(), *buffer_size, *buffer_var_size));
+          attr_name.c_str(), buffer_off_size, *buffer_var_size));
     }
   }
 
-  // Set memory budget
+  // Set memory budget, shared by the partitions processed in parallel
   RETURN_NOT_OK(read_state_.partitioner_.set_memory_budget(
-      memory_budget_, memory_budget_var_));
+      memory_budget_ / concurrent_partitions_,
+      memory_budget_var_ / concurrent_partitions_));
 
   read_state_.unsplittable_ = false;
   read_state_.overflowed_ = false;
@@ -1810,9 +2557,492 @@ Status Reader::init_tile(
   return Status::Ok();
 }
 
+Status Reader::partition_memory_size(uint64_t* size) {
+  auto& subarray = read_state_.partitioner_.current();
+  std::set<std::string> names;
+  for (const auto& it : buffers_)
+    names.insert(it.first);
+  if (!array_schema_->dense() || sparse_mode_) {
+    names.insert(constants::coords);
+    for (unsigned d = 0; d < array_schema_->dim_num(); ++d)
+      names.insert(array_schema_->dimension(d)->name());
+  }
+
+  *size = 0;
+  for (const auto& name : names) {
+    if (name != constants::coords && array_schema_->var_size(name)) {
+      uint64_t size_off = 0, size_val = 0;
+      RETURN_NOT_OK(
+          subarray.get_max_memory_size(name.c_str(), &size_off, &size_val));
+      *size += size_off + size_val;
+    } else {
+      uint64_t size_fixed = 0;
+      RETURN_NOT_OK(subarray.get_max_memory_size(name.c_str(), &size_fixed));
+      *size += size_fixed;
+    }
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::read_ahead() {
+  // Compute the next partition on a copy of the partitioner
+  auto partitioner = read_state_.partitioner_;
+  bool unsplittable = false;
+  RETURN_NOT_OK(partitioner.next(&unsplittable));
+  if (unsplittable) {
+    read_ahead_tiles_.clear();
+    return Status::Ok();
+  }
+  auto& subarray = partitioner.current();
+  RETURN_NOT_OK(subarray.compute_tile_overlap());
+  const auto& overlap = subarray.tile_overlap();
+
+  // The coordinates are read from the sparse fragments only
+  std::vector<std::string> names;
+  for (const auto& it : buffers_) {
+    if (it.first != constants::coords && !array_schema_->is_dim(it.first))
+      names.emplace_back(it.first);
+  }
+  names.emplace_back(constants::coords);
+  for (unsigned d = 0; d < array_schema_->dim_num(); ++d)
+    names.emplace_back(array_schema_->dimension(d)->name());
+
+  // Stage the tiles, keeping those fetched by the previous read-ahead
+  std::map<std::pair<std::string, uint64_t>, Buffer> tiles;
+  std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>> regions;
+  auto encryption_key = array_->encryption_key();
+  auto stage = [&](const URI& uri, uint64_t offset, uint64_t size) {
+    auto key = std::pair<std::string, uint64_t>(uri.to_string(), offset);
+    if (tiles.count(key) != 0)
+      return Status::Ok();
+    auto& buff = tiles[key];
+    auto it = read_ahead_tiles_.find(key);
+    if (it != read_ahead_tiles_.end() && it->second.size() == size) {
+      buff.swap(it->second);
+      return Status::Ok();
+    }
+    RETURN_NOT_OK(buff.realloc(size));
+    buff.set_size(size);
+    buff.reset_offset();
+    regions[uri].emplace_back(offset, buff.data(), size);
+    STATS_COUNTER_ADD(reader_num_tiles_read_ahead, 1);
+    STATS_COUNTER_ADD(reader_num_tile_bytes_read_ahead, size);
+    return Status::Ok();
+  };
+
+  auto fragment_num = fragment_metadata_.size();
+  for (const auto& name : names) {
+    bool is_coords = name == constants::coords || array_schema_->is_dim(name);
+    bool var_size =
+        name != constants::coords && array_schema_->var_size(name);
+    uint64_t size = 0, var_size_total = 0;
+    bool full = false;
+    for (unsigned f = 0; f < fragment_num && !full; ++f) {
+      auto fragment = fragment_metadata_[f];
+      auto format_version = fragment->format_version();
+      if (is_coords && fragment->dense())
+        continue;
+      if (name == constants::coords && format_version >= 5)
+        continue;
+      if (array_schema_->is_dim(name) && format_version < 5)
+        continue;
+
+      // Visits the tiles of the fragment that overlap the partition,
+      // until the budget is exhausted
+      auto visit = [&](uint64_t tile_idx) {
+        uint64_t offset, persisted_size;
+        RETURN_NOT_OK(
+            fragment->file_offset(*encryption_key, name, tile_idx, &offset));
+        RETURN_NOT_OK(fragment->persisted_tile_size(
+            *encryption_key, name, tile_idx, &persisted_size));
+        if (size + persisted_size > memory_budget_) {
+          full = true;
+          return Status::Ok();
+        }
+        if (var_size) {
+          uint64_t var_offset, var_persisted_size;
+          RETURN_NOT_OK(fragment->file_var_offset(
+              *encryption_key, name, tile_idx, &var_offset));
+          RETURN_NOT_OK(fragment->persisted_tile_var_size(
+              *encryption_key, name, tile_idx, &var_persisted_size));
+          if (var_size_total + var_persisted_size > memory_budget_var_) {
+            full = true;
+            return Status::Ok();
+          }
+          RETURN_NOT_OK(
+              stage(fragment->var_uri(name), var_offset, var_persisted_size));
+          var_size_total += var_persisted_size;
+        }
+        RETURN_NOT_OK(stage(fragment->uri(name), offset, persisted_size));
+        size += persisted_size;
+        return Status::Ok();
+      };
+
+      for (const auto& o : overlap[f]) {
+        for (auto tr = o.tile_ranges_.begin();
+             tr != o.tile_ranges_.end() && !full;
+             ++tr) {
+          for (uint64_t t = tr->first; t <= tr->second && !full; ++t)
+            RETURN_NOT_OK(visit(t));
+        }
+        for (auto t = o.tiles_.begin(); t != o.tiles_.end() && !full; ++t)
+          RETURN_NOT_OK(visit(t->first));
+        if (full)
+          break;
+      }
+    }
+  }
+
+  // Drop the previously staged tiles that the next partition does not need
+  read_ahead_tiles_.swap(tiles);
+
+  // Read ahead only if the memory is available right away
+  uint64_t staged_size = 0;
+  for (const auto& tile : read_ahead_tiles_)
+    staged_size += tile.second.size();
+  if (!read_ahead_reservation_.try_reserve(
+          storage_manager_->memory_broker(), staged_size)) {
+    read_ahead_tiles_.clear();
+    return Status::Ok();
+  }
+
+  // Enqueue all regions to be read.
+  for (const auto& item : regions) {
+    RETURN_NOT_OK(storage_manager_->vfs()->read_all(
+        item.first,
+        item.second,
+        storage_manager_->reader_thread_pool(),
+        &read_ahead_tasks_));
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::read_concurrent_partitions(bool* processed) {
+  *processed = false;
+
+  // Collect the partitions whose estimated results fit in the user
+  // buffers together. The estimates assume 64-bit offsets.
+  std::vector<std::string> names;
+  for (const auto& it : buffers_)
+    names.emplace_back(it.first);
+  auto name_num = names.size();
+  std::vector<Subarray> partitions;
+  std::vector<std::vector<uint64_t>> est_sizes;
+  std::vector<uint64_t> total_sizes(2 * name_num, 0);
+  auto partitioner = read_state_.partitioner_;
+  while (partitions.size() < concurrent_partitions_) {
+    if (!partitions.empty()) {
+      if (partitioner.done())
+        break;
+      bool unsplittable = false;
+      RETURN_NOT_OK(partitioner.next(&unsplittable));
+      if (unsplittable)
+        break;
+    }
+
+    auto& subarray = partitioner.current();
+    std::vector<uint64_t> sizes(2 * name_num, 0);
+    bool fits = true;
+    for (size_t n = 0; n < name_num; ++n) {
+      const auto& name = names[n];
+      const auto& buff = buffers_[name];
+      if (!array_schema_->var_size(name)) {
+        RETURN_NOT_OK(
+            subarray.get_est_result_size(name.c_str(), &sizes[2 * n]));
+      } else {
+        RETURN_NOT_OK(subarray.get_est_result_size(
+            name.c_str(), &sizes[2 * n], &sizes[2 * n + 1]));
+        sizes[2 * n] /= 64 / offsets_bitsize_;
+      }
+      fits &= total_sizes[2 * n] + sizes[2 * n] <= buff.original_buffer_size_;
+      fits &= total_sizes[2 * n + 1] + sizes[2 * n + 1] <=
+              buff.original_buffer_var_size_;
+    }
+    if (!fits)
+      break;
+
+    for (size_t i = 0; i < 2 * name_num; ++i)
+      total_sizes[i] += sizes[i];
+    partitions.emplace_back(subarray);
+    est_sizes.emplace_back(std::move(sizes));
+  }
+  auto partition_num = partitions.size();
+  if (partition_num < 2)
+    return Status::Ok();
+
+  // Split the user buffers into one region per partition, sharing the
+  // space left by the estimates evenly
+  std::vector<std::vector<uint64_t>> region_starts(
+      partition_num, std::vector<uint64_t>(2 * name_num, 0));
+  std::vector<std::vector<uint64_t>> region_sizes(
+      partition_num, std::vector<uint64_t>(2 * name_num, 0));
+  for (size_t n = 0; n < name_num; ++n) {
+    const auto& name = names[n];
+    const auto& buff = buffers_[name];
+    bool var_size = array_schema_->var_size(name);
+    uint64_t units[] = {
+        var_size ? offsets_bitsize_ / 8 : array_schema_->cell_size(name), 1};
+    uint64_t buffer_sizes[] = {buff.original_buffer_size_,
+                               buff.original_buffer_var_size_};
+    for (size_t b = 0; b < 2; ++b) {
+      auto i = 2 * n + b;
+      auto slack = (buffer_sizes[b] - total_sizes[i]) / partition_num;
+      uint64_t start = 0;
+      for (size_t p = 0; p < partition_num; ++p) {
+        auto size = est_sizes[p][i] + slack;
+        size -= size % units[b];
+        region_starts[p][i] = start;
+        region_sizes[p][i] = size;
+        start += size;
+      }
+    }
+  }
+
+  // Read each partition with a separate reader
+  std::vector<Reader> readers(partition_num);
+  for (size_t p = 0; p < partition_num; ++p) {
+    auto& reader = readers[p];
+    reader.set_storage_manager(storage_manager_);
+    reader.set_array(array_);
+    reader.set_array_schema(array_schema_);
+    reader.set_fragment_metadata(fragment_metadata_);
+    if (sparse_mode_)
+      RETURN_NOT_OK(reader.set_sparse_mode(true));
+    RETURN_NOT_OK(reader.set_subarray(partitions[p]));
+    for (size_t n = 0; n < name_num; ++n) {
+      const auto& name = names[n];
+      const auto& buff = buffers_[name];
+      auto buffer = (char*)buff.buffer_ + region_starts[p][2 * n];
+      auto buffer_size = &region_sizes[p][2 * n];
+      if (!array_schema_->var_size(name)) {
+        RETURN_NOT_OK(reader.set_buffer(name, buffer, buffer_size));
+      } else {
+        auto buffer_var = (char*)buff.buffer_var_ + region_starts[p][2 * n + 1];
+        RETURN_NOT_OK(reader.set_buffer(
+            name,
+            (uint64_t*)buffer,
+            buffer_size,
+            buffer_var,
+            &region_sizes[p][2 * n + 1]));
+      }
+    }
+    reader.concurrent_partitions_ = 1;
+    reader.parent_reservation_ = parent_reservation_;
+    RETURN_NOT_OK(reader.init(layout_));
+    reader.read_ahead_ = false;
+    reader.cache_results_ = false;
+  }
+  auto statuses = parallel_for(0, partition_num, [&readers](uint64_t p) {
+    return readers[p].read();
+  });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Keep the partitions up to the first one that was not read completely
+  size_t done_num = 0;
+  for (; done_num < partition_num; ++done_num) {
+    const auto& read_state = readers[done_num].read_state_;
+    if (read_state.overflowed_ || read_state.unsplittable_ ||
+        !read_state.done())
+      break;
+  }
+  if (done_num == 0)
+    return Status::Ok();
+
+  // Compact the results in order, rebasing the var-sized offsets
+  for (size_t n = 0; n < name_num; ++n) {
+    const auto& name = names[n];
+    const auto& buff = buffers_[name];
+    bool var_size = array_schema_->var_size(name);
+    uint64_t size = 0, size_var = 0;
+    for (size_t p = 0; p < done_num; ++p) {
+      auto dest = (char*)buff.buffer_ + size;
+      auto part_size = region_sizes[p][2 * n];
+      std::memmove(
+          dest, (char*)buff.buffer_ + region_starts[p][2 * n], part_size);
+      if (var_size) {
+        auto part_size_var = region_sizes[p][2 * n + 1];
+        if (offsets_bitsize_ == 64) {
+          auto offsets = (uint64_t*)dest;
+          for (uint64_t c = 0; c < part_size / sizeof(uint64_t); ++c)
+            offsets[c] += size_var;
+        } else {
+          if (size_var + part_size_var > UINT32_MAX)
+            return LOG_STATUS(Status::ReaderError(
+                "Cannot read partitions; Var-sized data do not fit in 32-bit "
+                "offsets (see config parameter 'sm.var_offsets.bitsize')"));
+          auto offsets = (uint32_t*)dest;
+          for (uint64_t c = 0; c < part_size / sizeof(uint32_t); ++c)
+            offsets[c] += (uint32_t)size_var;
+        }
+        std::memmove(
+            (char*)buff.buffer_var_ + size_var,
+            (char*)buff.buffer_var_ + region_starts[p][2 * n + 1],
+            part_size_var);
+        size_var += part_size_var;
+      }
+      size += part_size;
+    }
+    *buff.buffer_size_ = size;
+    if (var_size)
+      *buff.buffer_var_size_ = size_var;
+  }
+
+  // Move the partitioner to the last partition that was processed
+  for (size_t p = 1; p < done_num; ++p)
+    RETURN_NOT_OK(read_state_.next());
+  read_state_.overflowed_ = false;
+  read_state_.unsplittable_ = false;
+  *processed = true;
+  STATS_COUNTER_ADD(reader_num_concurrent_partitions, done_num);
+
+  return Status::Ok();
+}
+
+bool Reader::read_from_read_ahead(
+    const URI& uri, uint64_t offset, uint64_t size, Buffer* buffer) const {
+  auto it = read_ahead_tiles_.find(
+      std::pair<std::string, uint64_t>(uri.to_string(), offset));
+  if (it == read_ahead_tiles_.end() || it->second.size() != size)
+    return false;
+
+  buffer->swap(it->second);
+  buffer->reset_offset();
+  read_ahead_tiles_.erase(it);
+  STATS_COUNTER_ADD(reader_read_ahead_hits, 1);
+
+  return true;
+}
+
+Status Reader::read_next_partition() {
+  // Get next partition
+  if (!read_state_.unsplittable_)
+    RETURN_NOT_OK(read_state_.next());
+
+  // Handle empty array or empty/finished subarray
+  if (fragment_metadata_.empty()) {
+    zero_out_buffer_sizes();
+    return Status::Ok();
+  }
+
+  // Process several partitions at once while they fit the user buffers
+  while (concurrent_partitions_ > 1 && !read_state_.unsplittable_) {
+    bool processed = false;
+    RETURN_NOT_OK(read_concurrent_partitions(&processed));
+    if (!processed)
+      break;
+
+    if (!no_results() || read_state_.done())
+      return Status::Ok();
+
+    RETURN_NOT_OK(read_state_.next());
+  }
+
+  // Loop until you find results, or unsplittable, or done
+  do {
+    read_state_.overflowed_ = false;
+    reset_buffer_sizes();
+
+    // Reserve the memory of the partition for the duration of the read
+    MemoryReservation reservation;
+    RETURN_NOT_OK(reserve_partition_memory(&reservation));
+
+    // Perform read
+    if (array_schema_->dense() && !sparse_mode_) {
+      RETURN_NOT_OK(dense_read());
+    } else {
+      RETURN_NOT_OK(sparse_read());
+    }
+
+    // In the case of overflow, we need to split the current partition
+    // without advancing to the next partition
+    if (read_state_.overflowed_) {
+      zero_out_buffer_sizes();
+      RETURN_NOT_OK(read_state_.split_current());
+
+      if (read_state_.unsplittable_)
+        return Status::Ok();
+    } else {
+      bool no_results = this->no_results();
+
+      // Need to reset unsplittable if the results fit after all
+      if (!no_results)
+        read_state_.unsplittable_ = false;
+
+      if (!no_results || read_state_.done())
+        return Status::Ok();
+
+      RETURN_NOT_OK(read_state_.next());
+    }
+  } while (true);
+
+  return Status::Ok();
+}
+
+Status Reader::read_from_result_cache(const std::string& key, bool* hit) {
+  *hit = false;
+  Buffer buffer;
+  bool in_cache = false;
+  RETURN_NOT_OK(storage_manager_->read_from_query_result_cache(
+      key, &buffer, &in_cache));
+  if (!in_cache) {
+    STATS_COUNTER_ADD(sm_query_result_cache_misses, 1);
+    return Status::Ok();
+  }
+
+  // Locate the results of each buffer, checking that they fit. The results
+  // are stored as (size, data) pairs for the fixed and var-sized buffer of
+  // each name, in the order of `result_cache_key`.
+  auto names = buffer_names();
+  std::sort(names.begin(), names.end());
+  std::vector<std::pair<const void*, uint64_t>> results;
+  results.reserve(2 * names.size());
+  ConstBuffer cbuff(&buffer);
+  for (const auto& name : names) {
+    const auto& buff = buffers_[name];
+    for (unsigned i = 0; i < 2; ++i) {
+      uint64_t size = 0;
+      RETURN_NOT_OK(cbuff.read(&size, sizeof(size)));
+      if (size > cbuff.nbytes_left_to_read())
+        return LOG_STATUS(Status::ReaderError(
+            "Cannot read from query result cache; Invalid cached results"));
+      auto original_size = (i == 0) ? buff.original_buffer_size_ :
+                                      buff.original_buffer_var_size_;
+      if (size > original_size) {
+        // The results are recomputed, so this counts as a miss
+        STATS_COUNTER_ADD(sm_query_result_cache_misses, 1);
+        return Status::Ok();
+      }
+      results.emplace_back(cbuff.cur_data(), size);
+      cbuff.advance_offset(size);
+    }
+  }
+
+  // Copy the results into the user buffers
+  for (size_t n = 0; n < names.size(); ++n) {
+    const auto& buff = buffers_[names[n]];
+    const auto& fixed = results[2 * n];
+    std::memcpy(buff.buffer_, fixed.first, fixed.second);
+    *(buff.buffer_size_) = fixed.second;
+    if (buff.buffer_var_size_ != nullptr) {
+      const auto& var = results[2 * n + 1];
+      std::memcpy(buff.buffer_var_, var.first, var.second);
+      *(buff.buffer_var_size_) = var.second;
+    }
+  }
+  *hit = true;
+  STATS_COUNTER_ADD(sm_query_result_cache_hits, 1);
+
+  return Status::Ok();
+}
+
 Status Reader::read_tiles(
     const std::string& name,
     const std::vector<ResultTile*>& result_tiles) const {
+  STATS_FUNC_IN(reader_read_all_tiles);
+
   // Shortcut for empty tile vec
   if (result_tiles.empty())
     return Status::Ok();
@@ -1828,6 +3058,8 @@ Status Reader::read_tiles(
     RETURN_CANCEL_OR_ERROR(st);
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(reader_read_all_tiles);
 }
 
 Status Reader::read_tiles(
@@ -1897,7 +3129,14 @@ Status Reader::read_tiles(
         &cache_hit));
     if (cache_hit) {
       t.set_filtered(true);
+      t.set_from_cache(true);
       STATS_COUNTER_ADD(reader_attr_tile_cache_hits, 1);
+    } else if (read_from_read_ahead(
+                   tile_attr_uri,
+                   tile_attr_offset,
+                   tile_persisted_size,
+                   t.buffer())) {
+      t.set_filtered(true);
     } else {
       // Add the region of the fragment to be read.
       RETURN_NOT_OK(t.buffer()->realloc(tile_persisted_size));
@@ -1927,7 +3166,14 @@ Status Reader::read_tiles(
 
       if (cache_hit) {
         t_var.set_filtered(true);
+        t_var.set_from_cache(true);
         STATS_COUNTER_ADD(reader_attr_tile_cache_hits, 1);
+      } else if (read_from_read_ahead(
+                     tile_attr_var_uri,
+                     tile_attr_var_offset,
+                     tile_var_persisted_size,
+                     t_var.buffer())) {
+        t_var.set_filtered(true);
       } else {
         // Add the region of the fragment to be read.
         RETURN_NOT_OK(t_var.buffer()->realloc(tile_var_persisted_size));
@@ -1964,6 +3210,32 @@ Status Reader::read_tiles(
   return Status::Ok();
 }
 
+Status Reader::reserve_partition_memory(MemoryReservation* reservation) {
+  auto memory_broker = storage_manager_->memory_broker();
+  auto held =
+      (parent_reservation_ != nullptr) ? parent_reservation_->size() : 0;
+  uint64_t size = 0;
+  RETURN_NOT_OK(partition_memory_size(&size));
+
+  // Split the partition until its memory is available
+  if (memory_broker->policy() == MemoryBroker::Policy::SHRINK) {
+    while (true) {
+      if (reservation->try_reserve(memory_broker, size))
+        return Status::Ok();
+      RETURN_NOT_OK(read_state_.split_current());
+      if (read_state_.unsplittable_) {
+        // Read the current partition once its memory is released
+        read_state_.unsplittable_ = false;
+        break;
+      }
+      STATS_COUNTER_ADD(memory_broker_shrinks, 1);
+      RETURN_NOT_OK(partition_memory_size(&size));
+    }
+  }
+
+  return reservation->reserve(memory_broker, size, held);
+}
+
 void Reader::reset_buffer_sizes() {
   for (auto& it : buffers_) {
     *(it.second.buffer_size_) = it.second.original_buffer_size_;
@@ -1972,6 +3244,48 @@ void Reader::reset_buffer_sizes() {
   }
 }
 
+std::string Reader::result_cache_key() const {
+  // Every component is prefixed by its size, so that the key is unambiguous
+  std::string key;
+  auto append = [&key](const void* data, uint64_t size) {
+    key.append((const char*)&size, sizeof(size));
+    key.append((const char*)data, size);
+  };
+
+  const auto& array_uri = array_schema_->array_uri().to_string();
+  append(array_uri.data(), array_uri.size());
+  for (auto meta : fragment_metadata_) {
+    const auto& fragment_uri = meta->fragment_uri().to_string();
+    append(fragment_uri.data(), fragment_uri.size());
+    const auto& timestamp_range = meta->timestamp_range();
+    append(&timestamp_range.first, sizeof(timestamp_range.first));
+    append(&timestamp_range.second, sizeof(timestamp_range.second));
+  }
+
+  auto dim_num = array_schema_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    const auto& ranges = subarray_.ranges_for_dim(d);
+    uint64_t range_num = ranges.size();
+    append(&range_num, sizeof(range_num));
+    for (const auto& range : ranges)
+      append(range.data(), range.size());
+  }
+
+  auto names = buffer_names();
+  std::sort(names.begin(), names.end());
+  for (const auto& name : names) {
+    append(name.data(), name.size());
+    bool var_size = buffers_.find(name)->second.buffer_var_ != nullptr;
+    append(&var_size, sizeof(var_size));
+  }
+
+  append(&layout_, sizeof(layout_));
+  append(&sparse_mode_, sizeof(sparse_mode_));
+  append(&offsets_bitsize_, sizeof(offsets_bitsize_));
+
+  return key;
+}
+
 Status Reader::sort_result_coords(
     std::vector<ResultCoords>* result_coords, Layout layout) const {
   STATS_FUNC_IN(reader_sort_coords);
@@ -2035,7 +3349,8 @@ Status Reader::sparse_read() {
       continue;
 
     RETURN_CANCEL_OR_ERROR(read_tiles(name, result_tiles));
-    RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, result_tiles));
+    RETURN_CANCEL_OR_ERROR(
+        unfilter_tiles(name, result_tiles, &result_cell_slabs, stride));
     RETURN_CANCEL_OR_ERROR(copy_cells(name, stride, result_cell_slabs));
     clear_tiles(name, result_tiles);
   }
@@ -2045,6 +3360,21 @@ Status Reader::sparse_read() {
   STATS_FUNC_OUT(reader_sparse_read);
 }
 
+void Reader::wait_read_ahead() {
+  if (read_ahead_tasks_.empty())
+    return;
+
+  auto statuses = storage_manager_->reader_thread_pool()->wait_all_status(
+      read_ahead_tasks_);
+  read_ahead_tasks_.clear();
+  for (const auto& st : statuses) {
+    if (!st.ok()) {
+      read_ahead_tiles_.clear();
+      break;
+    }
+  }
+}
+
 void Reader::zero_out_buffer_sizes() {
   for (auto& buffer : buffers_) {
     if (buffer.second.buffer_size_ != nullptr)
@@ -2054,6 +3384,27 @@ void Reader::zero_out_buffer_sizes() {
   }
 }
 
+Status Reader::write_to_result_cache(const std::string& key) const {
+  // Store the results as (size, data) pairs for the fixed and var-sized
+  // buffer of each name, in the order of `result_cache_key`
+  auto names = buffer_names();
+  std::sort(names.begin(), names.end());
+  Buffer buffer;
+  for (const auto& name : names) {
+    const auto& buff = buffers_.find(name)->second;
+    uint64_t size = *(buff.buffer_size_);
+    RETURN_NOT_OK(buffer.write(&size, sizeof(size)));
+    RETURN_NOT_OK(buffer.write(buff.buffer_, size));
+    uint64_t var_size =
+        (buff.buffer_var_size_ != nullptr) ? *(buff.buffer_var_size_) : 0;
+    RETURN_NOT_OK(buffer.write(&var_size, sizeof(var_size)));
+    if (var_size > 0)
+      RETURN_NOT_OK(buffer.write(buff.buffer_var_, var_size));
+  }
+
+  return storage_manager_->write_to_query_result_cache(key, buffer);
+}
+
 bool Reader::sparse_tile_overwritten(
     unsigned frag_idx, uint64_t tile_idx) const {
   const auto& mbr = fragment_metadata_[frag_idx]->mbr(tile_idx);
@@ -2061,6 +3412,10 @@ bool Reader::sparse_tile_overwritten(
   auto fragment_num = (unsigned)fragment_metadata_.size();
   auto domain = array_schema_->domain();
 
+  // Look up the later dense fragments in the index, if there is one
+  if (fragment_index_ != nullptr)
+    return fragment_index_->covered_by_later_dense(frag_idx, mbr);
+
   for (unsigned f = frag_idx + 1; f < fragment_num; ++f) {
     if (fragment_metadata_[f]->dense() &&
         domain->covered(mbr, fragment_metadata_[f]->non_empty_domain()))
@@ -33,12 +33,16 @@
 #ifndef TILEDB_READER_H
 #define TILEDB_READER_H
 
+#include <atomic>
 #include <future>
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "tiledb/sm/array_schema/tile_domain.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/memory_broker.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/misc/uri.h"
@@ -53,6 +57,7 @@ namespace sm {
 
 class Array;
 class ArraySchema;
+class FragmentIndex;
 class FragmentMetadata;
 class StorageManager;
 class Tile;
@@ -149,13 +154,17 @@ class Reader {
 
   /**
    * Gets the estimated result size (in bytes) for the input fixed-sized
-   * attribute/dimension.
+   * attribute/dimension. If `sm.est_result_size_mode` is `tight`, the
+   * coordinates of the sparse tiles that partially overlap the subarray
+   * are read once to count the result cells exactly, and the estimate is
+   * an upper bound.
    */
   Status get_est_result_size(const char* name, uint64_t* size);
 
   /**
    * Gets the estimated result size (in bytes) for the input var-sized
-   * attribute/dimension.
+   * attribute/dimension (see the fixed-sized overload). The offsets size
+   * accounts for the configured offsets bitsize.
    */
   Status get_est_result_size(
       const char* name, uint64_t* size_off, uint64_t* size_val);
@@ -295,6 +304,13 @@ class Reader {
    */
   Status set_layout(Layout layout);
 
+  /**
+   * Sets the memory reservation held by the component running the query
+   * (e.g., the consolidator) while the query reserves its own memory (see
+   * `MemoryBroker::reserve`).
+   */
+  void set_parent_reservation(const MemoryReservation* reservation);
+
   /**
    * This is applicable only to dense arrays (errors out for sparse arrays),
    * and only in the case where the array is opened in a way that all its
@@ -466,6 +482,13 @@ class Reader {
   /** The fragment metadata. */
   std::vector<FragmentMetadata*> fragment_metadata_;
 
+  /**
+   * The index over the fragments of the array, shared with the other
+   * queries on the array. It is `nullptr` if the reader has no array, or if
+   * the array was reopened after the fragment metadata were set.
+   */
+  std::shared_ptr<const FragmentIndex> fragment_index_;
+
   /** The layout of the cells in the result of the subarray. */
   Layout layout_;
 
@@ -494,6 +517,78 @@ class Reader {
   /** The memory budget for the var-sized attributes. */
   uint64_t memory_budget_var_;
 
+  /**
+   * The size in bits (32 or 64) of the var-sized attribute offsets copied
+   * to the user buffers (see config parameter `sm.var_offsets.bitsize`).
+   */
+  uint32_t offsets_bitsize_;
+
+  /**
+   * The fraction of the unfiltered tiles whose checksums are verified (see
+   * config parameter `sm.checksum.verify_sample_rate`).
+   */
+  double checksum_sample_rate_;
+
+  /**
+   * If `true`, the checksums of tiles read from the tile cache are not
+   * verified (see config parameter `sm.checksum.skip_on_cache_hit`).
+   */
+  bool checksum_skip_on_cache_hit_;
+
+  /** The number of tiles considered so far for checksum sampling. */
+  mutable std::atomic<uint64_t> checksum_tile_num_;
+
+  /**
+   * If `true`, incomplete reads fetch the tiles of the next partition in
+   * the background (see config parameter `sm.read_ahead`).
+   */
+  bool read_ahead_;
+
+  /**
+   * The persisted tiles of the next partition fetched by read-ahead, keyed
+   * on the URI of their file and their offset in it. `read_tiles` moves the
+   * tiles it needs out of this map.
+   */
+  mutable std::map<std::pair<std::string, uint64_t>, Buffer>
+      read_ahead_tiles_;
+
+  /** The pending read tasks that fill `read_ahead_tiles_`. */
+  std::vector<std::future<Status>> read_ahead_tasks_;
+
+  /**
+   * The memory reserved for `read_ahead_tiles_`. It is released when the
+   * next read starts, as the staged tiles then become part of the memory
+   * reserved for the partition.
+   */
+  MemoryReservation read_ahead_reservation_;
+
+  /**
+   * The maximum number of partitions processed in parallel (see config
+   * parameter `sm.concurrent_partitions`). It is 0 until `init` reads it
+   * from the config, unless it was set beforehand, as for the readers of
+   * the individual partitions.
+   */
+  unsigned concurrent_partitions_;
+
+  /**
+   * If `true`, the results of the first submission of the query are looked
+   * up in and written to the query result cache of the storage manager (see
+   * config parameter `sm.query_result_cache_size`).
+   */
+  bool cache_results_;
+
+  /** `true` if the query has been submitted at least once. */
+  bool read_submitted_;
+
+  /** `true` if the last submission was served from the query result cache. */
+  bool served_from_result_cache_;
+
+  /**
+   * The memory reservation held by the component running the query, if
+   * any (see `set_parent_reservation`).
+   */
+  const MemoryReservation* parent_reservation_;
+
   /* ********************************* */
   /*           PRIVATE METHODS         */
   /* ********************************* */
@@ -613,6 +708,22 @@ class Reader {
       std::map<std::pair<unsigned, uint64_t>, size_t>* result_tile_map,
       std::vector<bool>* single_fragment);
 
+  /**
+   * Computes, for each result tile referenced by the input result cell
+   * slabs, the sorted and non-overlapping `[first, last]` ranges of cell
+   * positions that the slabs copy from the tile.
+   *
+   * @param stride See `copy_cells`.
+   * @param result_cell_slabs The result cell slabs.
+   * @param cell_ranges The cell ranges per result tile.
+   */
+  void compute_tile_cell_ranges(
+      uint64_t stride,
+      const std::vector<ResultCellSlab>& result_cell_slabs,
+      std::unordered_map<
+          const ResultTile*,
+          std::vector<std::pair<uint64_t, uint64_t>>>* cell_ranges) const;
+
   /**
    * Copies the cells for the input attribute and result cell slabs, into
    * the corresponding result buffers.
@@ -704,6 +815,17 @@ class Reader {
       const Subarray& subarray,
       std::map<const T*, ResultSpaceTile<T>>* result_space_tiles) const;
 
+  /**
+   * Counts, for each range of the subarray, the cells of the partially
+   * overlapping tiles of the sparse fragments that lie in the range, reading
+   * only the coordinate tiles. The counts are set to the subarray (see
+   * `Subarray::set_result_cell_nums`), which uses them to estimate the
+   * result size. Fragments whose counts are already set are skipped.
+   *
+   * @return Status
+   */
+  Status compute_result_cell_nums();
+
   /**
    * Computes the result coordinates from the sparse fragments.
    *
@@ -735,6 +857,25 @@ class Reader {
   template <class T>
   Status dense_read();
 
+  /**
+   * Fast path of `dense_read` for a subarray with a single range that
+   * coincides with space tile boundaries and lies entirely in the latest
+   * fragment overlapping it, which must be dense. The tiles of the
+   * fixed-sized attributes are then read whole: they are unfiltered
+   * directly into the user buffers when their cells are contiguous there
+   * (i.e., the layout matches the cell order of the array), or copied
+   * with a blocked transpose otherwise.
+   *
+   * @tparam T The domain type.
+   * @param subarray The subarray to read.
+   * @param done Set to `true` if the read was performed, or `false` if the
+   *     subarray does not qualify, or the results do not fit in the user
+   *     buffers, in which case nothing was read.
+   * @return Status
+   */
+  template <class T>
+  Status dense_read_aligned(Subarray& subarray, bool* done);
+
   /**
    * Fills the coordinate buffer with coordinates. Applicable only to dense
    * arrays when the user explicitly requests the coordinates to be
@@ -859,24 +1000,53 @@ class Reader {
    *
    * @param name Attribute/dimension whose tiles will be unfiltered
    * @param result_tiles Vector containing the tiles to be unfiltered
+   * @param result_cell_slabs If not `nullptr`, only the tile chunks holding
+   *     the cells of these result cell slabs are unfiltered.
+   * @param stride See `copy_cells`.
    * @return Status
    */
   Status unfilter_tiles(
       const std::string& name,
-      const std::vector<ResultTile*>& result_tiles) const;
+      const std::vector<ResultTile*>& result_tiles,
+      const std::vector<ResultCellSlab>* result_cell_slabs = nullptr,
+      uint64_t stride = UINT64_MAX) const;
+
+  /**
+   * Returns `true` if the checksums of the input tile must be verified upon
+   * unfiltering, following the checksum sampling configuration.
+   */
+  bool verify_checksums(const Tile& tile) const;
+
+  /**
+   * Returns `true` if the result size estimates must be tight, following
+   * the `sm.est_result_size_mode` configuration.
+   */
+  bool tight_est_result_size() const;
 
   /**
    * Runs the input tile for the input attribute or dimension through the
    * filter pipeline. The tile buffer is modified to contain the output of the
-   * pipeline.
+   * pipeline. The checksum filters verify the tile checksums as specified
+   * by `verify_checksums`.
    *
    * @param name The attribute/dimension the tile belong to.
    * @param tile The tile to be unfiltered.
    * @param offsets True if the tile to be unfiltered contains offsets for a
    *    var-sized attribute/dimension.
+   * @param ranges The `[start, end)` byte ranges of the tile to unfilter
+   *    (see `FilterPipeline::run_reverse`); empty for the whole tile.
+   * @param dest If not `nullptr`, the whole tile is unfiltered directly into
+   *    this memory region (of size `dest_size`) and `ranges` is ignored.
+   * @param dest_size The size of `dest`.
    * @return Status
    */
-  Status unfilter_tile(const std::string& name, Tile* tile, bool offsets) const;
+  Status unfilter_tile(
+      const std::string& name,
+      Tile* tile,
+      bool offsets,
+      const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+      void* dest = nullptr,
+      uint64_t dest_size = 0) const;
 
   /**
    * Gets all the result coordinates of the input tile into `result_coords`.
@@ -957,6 +1127,82 @@ class Reader {
       const std::vector<ResultTile*>& result_tiles,
       std::vector<std::future<Status>>* tasks) const;
 
+  /**
+   * Computes the maximum memory needed to read the current partition, over
+   * the attributes/dimensions with buffers and, for sparse reads, the
+   * coordinates.
+   *
+   * @param size The memory size in bytes.
+   * @return Status
+   */
+  Status partition_memory_size(uint64_t* size);
+
+  /**
+   * Fetches in the background the persisted tiles of the partition that
+   * follows the current one into `read_ahead_tiles_`, up to the memory
+   * budget of each attribute/dimension. The tiles that were already staged
+   * and overlap the next partition are kept, the rest are dropped.
+   *
+   * @return Status
+   */
+  Status read_ahead();
+
+  /**
+   * Moves the read-ahead tile with the input file URI, offset and size
+   * into `buffer`.
+   *
+   * @return `true` if the tile was staged by read-ahead.
+   */
+  bool read_from_read_ahead(
+      const URI& uri, uint64_t offset, uint64_t size, Buffer* buffer) const;
+
+  /**
+   * Processes the current partition along with the partitions that follow
+   * it in parallel, as long as their estimated results fit in the user
+   * buffers together. Each partition is read by a separate reader into a
+   * disjoint region of the user buffers, and the results of the partitions
+   * that were read completely are then compacted in order. The partitioner
+   * is advanced to the last of those partitions.
+   *
+   * @param processed Set to `false` if fewer than two partitions fit, or
+   *     the current partition could not be read completely. In that case
+   *     the partitioner is left unchanged and the current partition must
+   *     be read serially.
+   * @return Status
+   */
+  Status read_concurrent_partitions(bool* processed);
+
+  /**
+   * Performs a read on the next partition, splitting it as needed until
+   * it produces results or becomes unsplittable.
+   *
+   * @return Status
+   */
+  Status read_next_partition();
+
+  /**
+   * Copies the results of an identical earlier read from the query result
+   * cache into the user buffers. The results are not copied if they are not
+   * cached or do not fit in the user buffers. Only the reads served from
+   * the cache count as cache hits.
+   *
+   * @param key The key of the results (see `result_cache_key`).
+   * @param hit Set to `true` if the results were copied.
+   * @return Status
+   */
+  Status read_from_result_cache(const std::string& key, bool* hit);
+
+  /**
+   * Reserves the memory of the current partition on the memory broker of
+   * the storage manager. Under the shrink policy, the current partition is
+   * split until its memory is available, and if it becomes unsplittable
+   * the reservation waits for the memory.
+   *
+   * @param reservation The reservation to make.
+   * @return Status
+   */
+  Status reserve_partition_memory(MemoryReservation* reservation);
+
   /**
    * Resets the buffer sizes to the original buffer sizes. This is because
    * the read query may alter the buffer sizes to reflect the size of
@@ -964,6 +1210,15 @@ class Reader {
    */
   void reset_buffer_sizes();
 
+  /**
+   * Returns the key of the results of the query in the query result cache.
+   * It is formed by the array URI, the URIs and timestamps of the fragments,
+   * the subarray ranges, the attributes/dimensions with buffers, the layout
+   * and the offsets bitsize, so that the cached results of an array become
+   * unreachable once its fragments change.
+   */
+  std::string result_cache_key() const;
+
   /**
    * Sorts the input result coordinates according to the subarray layout.
    *
@@ -977,9 +1232,24 @@ class Reader {
   /** Performs a read on a sparse array. */
   Status sparse_read();
 
+  /**
+   * Waits for the pending read-ahead tasks. If any of them failed, all the
+   * read-ahead tiles are dropped, so that the tiles are read again on
+   * demand.
+   */
+  void wait_read_ahead();
+
   /** Zeroes out the user buffer sizes, indicating an empty result. */
   void zero_out_buffer_sizes();
 
+  /**
+   * Writes the results in the user buffers into the query result cache.
+   *
+   * @param key The key of the results (see `result_cache_key`).
+   * @return Status
+   */
+  Status write_to_result_cache(const std::string& key) const;
+
   /**
    * Returns true if the input tile's MBR of the input fragment is fully
    * covered by the non-empty domain of a more recent fragment.
@@ -54,26 +54,30 @@ struct ResultCoords {
    * the scope of those functions.
    */
   ResultTile* tile_;
-  /** The position of the coordinates in the tile. */
-  uint64_t pos_;
+  /**
+   * The position of the coordinates in the tile. It shares a word with
+   * `valid_`, which keeps the struct at 16 bytes; sparse reads allocate
+   * one instance per result cell.
+   */
+  uint64_t pos_ : 63;
   /** Whether this instance is "valid". */
-  bool valid_;
+  uint64_t valid_ : 1;
 
   /** Constructor. */
   ResultCoords(ResultTile* tile, uint64_t pos)
       : tile_(tile)
       , pos_(pos)
-      , valid_(true) {
+      , valid_(1) {
   }
 
   /** Invalidate this instance. */
   void invalidate() {
-    valid_ = false;
+    valid_ = 0;
   }
 
   /** Return true if this instance is valid. */
   bool valid() const {
-    return valid_;
+    return valid_ != 0;
   }
 
   /**
@@ -97,6 +101,10 @@ struct ResultCoords {
   }
 };
 
+static_assert(
+    sizeof(ResultCoords) == 2 * sizeof(uint64_t),
+    "ResultCoords is expected to be 16 bytes");
+
 }  // namespace sm
 }  // namespace tiledb
 
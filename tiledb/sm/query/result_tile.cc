@@ -205,7 +205,7 @@ Status ResultTile::read(
   auto buff_offset = 0;
   for (uint64_t c = 0; c < len; ++c) {
     for (unsigned d = 0; d < dim_num; ++d) {
-      auto coord_tile = coord_tiles_[d].second.first;
+      const auto& coord_tile = coord_tiles_[d].second.first;
       auto cell_size = coord_tile.cell_size();
       auto tile_offset = (pos + c) * cell_size;
       RETURN_NOT_OK(
@@ -35,6 +35,7 @@
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
@@ -67,6 +68,7 @@ Writer::Writer() {
   global_write_state_.reset(nullptr);
   initialized_ = false;
   layout_ = Layout::ROW_MAJOR;
+  parent_reservation_ = nullptr;
   storage_manager_ = nullptr;
 }
 
@@ -427,6 +429,10 @@ Status Writer::set_layout(Layout layout) {
   return Status::Ok();
 }
 
+void Writer::set_parent_reservation(const MemoryReservation* reservation) {
+  parent_reservation_ = reservation;
+}
+
 void Writer::set_storage_manager(StorageManager* storage_manager) {
   storage_manager_ = storage_manager;
 }
@@ -471,6 +477,19 @@ Status Writer::write() {
   if (check_coord_oob_)
     RETURN_NOT_OK(check_coord_oob());
 
+  // Reserve the memory of the tiles, which hold a copy of the cells
+  uint64_t memory_size = 0;
+  for (const auto& it : buffers_) {
+    memory_size += *it.second.buffer_size_;
+    if (it.second.buffer_var_size_ != nullptr)
+      memory_size += *it.second.buffer_var_size_;
+  }
+  auto held =
+      (parent_reservation_ != nullptr) ? parent_reservation_->size() : 0;
+  MemoryReservation reservation;
+  RETURN_NOT_OK(reservation.reserve(
+      storage_manager_->memory_broker(), memory_size, held));
+
   if (layout_ == Layout::COL_MAJOR || layout_ == Layout::ROW_MAJOR) {
     RETURN_NOT_OK(ordered_write());
   } else if (layout_ == Layout::UNORDERED) {
@@ -1047,9 +1066,13 @@ Status Writer::filter_tiles(
   // Filter all tiles
   auto tile_num = tiles->size();
   for (size_t i = 0; i < tile_num; ++i) {
-    RETURN_NOT_OK(filter_tile(name, &(*tiles)[i], var_size));
     if (var_size) {
+      // The values are filtered first, along with their still unfiltered
+      // offsets, so that the filters can find the cell boundaries.
+      RETURN_NOT_OK(filter_tile(name, &(*tiles)[i + 1], false, &(*tiles)[i]));
+      RETURN_NOT_OK(filter_tile(name, &(*tiles)[i], true));
       ++i;
+    } else {
       RETURN_NOT_OK(filter_tile(name, &(*tiles)[i], false));
     }
   }
@@ -1060,7 +1083,10 @@ Status Writer::filter_tiles(
 }
 
 Status Writer::filter_tile(
-    const std::string& name, Tile* tile, bool offsets) const {
+    const std::string& name,
+    Tile* tile,
+    bool offsets,
+    const Tile* offsets_tile) const {
   auto orig_size = tile->buffer()->size();
 
   // Get a copy of the appropriate filter pipeline.
@@ -1072,7 +1098,12 @@ Status Writer::filter_tile(
   RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
       &filters, array_->get_encryption_key()));
 
-  RETURN_NOT_OK(filters.run_forward(tile));
+  // Only the dictionary filter needs the chunks to hold whole cells; the
+  // other pipelines keep chunking var-sized tiles by size.
+  if (filters.get_filter<DictionaryFilter>() == nullptr)
+    offsets_tile = nullptr;
+
+  RETURN_NOT_OK(filters.run_forward(tile, offsets_tile));
 
   tile->set_filtered(true);
   tile->set_pre_filtered_size(orig_size);
@@ -38,6 +38,7 @@
 #include <unordered_map>
 
 #include "tiledb/sm/fragment/written_fragment_info.h"
+#include "tiledb/sm/misc/memory_broker.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/query/write_cell_slab_iter.h"
@@ -258,6 +259,13 @@ class Writer {
    */
   Status set_layout(Layout layout);
 
+  /**
+   * Sets the memory reservation held by the component running the query
+   * (e.g., the consolidator) while the query reserves its own memory (see
+   * `MemoryBroker::reserve`).
+   */
+  void set_parent_reservation(const MemoryReservation* reservation);
+
   /** Sets the storage manager. */
   void set_storage_manager(StorageManager* storage_manager);
 
@@ -357,6 +365,12 @@ class Writer {
    */
   Layout layout_;
 
+  /**
+   * The memory reservation held by the component running the query, if
+   * any (see `set_parent_reservation`).
+   */
+  const MemoryReservation* parent_reservation_;
+
   /** The storage manager. */
   StorageManager* storage_manager_;
 
@@ -542,9 +556,16 @@ class Writer {
    * @param tile The tile to be filtered.
    * @param offsets True if the tile to be filtered contains offsets for a
    *    var-sized attribute/dimension.
+   * @param offsets_tile The unfiltered offsets of the cells of `tile`, if
+   *    it stores var-sized values. They are used only by pipelines with a
+   *    dictionary filter, which need chunks aligned on cell boundaries.
    * @return Status
    */
-  Status filter_tile(const std::string& name, Tile* tile, bool offsets) const;
+  Status filter_tile(
+      const std::string& name,
+      Tile* tile,
+      bool offsets,
+      const Tile* offsets_tile = nullptr) const;
 
   /** Finalizes the global write state. */
   Status finalize_global_write_state();
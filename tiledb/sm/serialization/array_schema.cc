@@ -1081,7 +1081,9 @@ Status array_metadata_serialize(
     // Serialize
     ::capnp::MallocMessageBuilder message;
     auto builder = message.initRoot<capnp::ArrayMetadata>();
-    auto entries_builder = builder.initEntries(metadata->num());
+    uint64_t metadata_num;
+    RETURN_NOT_OK(metadata->num(&metadata_num));
+    auto entries_builder = builder.initEntries(metadata_num);
     size_t i = 0;
     for (auto it = metadata->begin(); it != metadata->end(); ++it) {
       auto entry_builder = entries_builder[i++];
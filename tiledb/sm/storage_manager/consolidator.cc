@@ -38,6 +38,7 @@
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/fragment/fragment_info.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
 #include "tiledb/sm/query/query.h"
@@ -113,7 +114,7 @@ Status Consolidator::consolidate_array_metadata(
       array_for_reads.close());
 
   // Swap the in-memory metadata between the two arrays.
-  // After that, the array for writes will store the (consolidated by
+  // After that, the array for writes will hold the (consolidated by
   // the way metadata loading works) metadata of the array for reads
   Metadata* metadata_r;
   RETURN_NOT_OK_ELSE(
@@ -126,12 +127,27 @@ Status Consolidator::consolidate_array_metadata(
   // Metadata uris to delete
   const auto to_delete = metadata_w->loaded_metadata_uris();
 
+  // Store the consolidated metadata in an indexed metadata file, so that
+  // readers can load only the items they access. The metadata of the array
+  // for writes are then cleared, so that closing it stores nothing.
+  // Indexed metadata files were introduced in format version 6, so the
+  // arrays of older versions keep storing their metadata on close.
+  if (array_for_writes.array_schema()->version() >= 6) {
+    auto st = storage_manager_->store_array_metadata_indexed(
+        array_uri, *array_for_writes.encryption_key(), metadata_w);
+    if (!st.ok()) {
+      array_for_reads.close();
+      array_for_writes.close();
+      return st;
+    }
+    metadata_w->clear();
+  }
+
   // Close arrays
   RETURN_NOT_OK_ELSE(array_for_reads.close(), array_for_writes.close());
   RETURN_NOT_OK(array_for_writes.close());
 
-  for (auto& uri : to_delete)
-    RETURN_NOT_OK(storage_manager_->vfs()->remove_file(uri));
+  RETURN_NOT_OK(storage_manager_->vfs()->remove_files(to_delete));
 
   return Status::Ok();
 }
@@ -344,9 +360,11 @@ Status Consolidator::consolidate(
       this->all_sparse(to_consolidate, 0, to_consolidate.size() - 1);
 
   // Prepare buffers
+  MemoryReservation reservation;
   std::vector<ByteVec> buffers;
   std::vector<uint64_t> buffer_sizes;
-  Status st = create_buffers(array_schema, all_sparse, &buffers, &buffer_sizes);
+  Status st = create_buffers(
+      array_schema, all_sparse, &reservation, &buffers, &buffer_sizes);
   if (!st.ok()) {
     array_for_reads.close();
     array_for_writes.close();
@@ -361,6 +379,7 @@ Status Consolidator::consolidate(
       &array_for_writes,
       all_sparse,
       union_non_empty_domains,
+      &reservation,
       &query_r,
       &query_w,
       new_fragment_uri);
@@ -473,6 +492,7 @@ Status Consolidator::copy_array(
 Status Consolidator::create_buffers(
     const ArraySchema* array_schema,
     bool sparse_mode,
+    MemoryReservation* reservation,
     std::vector<ByteVec>* buffers,
     std::vector<uint64_t>* buffer_sizes) {
   // For easy reference
@@ -485,14 +505,34 @@ Status Consolidator::create_buffers(
     buffer_num += (array_schema->attributes()[i]->var_size()) ? 2 : 1;
   buffer_num += (sparse) ? array_schema->dim_num() : 0;
 
+  // Reserve the memory of the buffers, shrinking them if allowed
+  auto memory_broker = storage_manager_->memory_broker();
+  auto buffer_size = config_.buffer_size_;
+  bool reserved = false;
+  if (memory_broker->policy() == MemoryBroker::Policy::SHRINK) {
+    auto min_buffer_size = config_.buffer_size_ / 8;
+    while (true) {
+      reserved =
+          reservation->try_reserve(memory_broker, buffer_num * buffer_size);
+      if (reserved || buffer_size / 2 < min_buffer_size)
+        break;
+      buffer_size /= 2;
+      STATS_COUNTER_ADD(memory_broker_shrinks, 1);
+    }
+  }
+  if (!reserved) {
+    RETURN_NOT_OK(
+        reservation->reserve(memory_broker, buffer_num * buffer_size));
+  }
+
   // Create buffers
   buffers->resize(buffer_num);
   buffer_sizes->resize(buffer_num);
 
   // Allocate space for each buffer
   for (unsigned int i = 0; i < buffer_num; ++i) {
-    (*buffers)[i].resize(config_.buffer_size_);
-    (*buffer_sizes)[i] = config_.buffer_size_;
+    (*buffers)[i].resize(buffer_size);
+    (*buffer_sizes)[i] = buffer_size;
   }
 
   // Success
@@ -504,6 +544,7 @@ Status Consolidator::create_queries(
     Array* array_for_writes,
     bool sparse_mode,
     const NDRange& subarray,
+    const MemoryReservation* reservation,
     Query** query_r,
     Query** query_w,
     URI* new_fragment_uri) {
@@ -517,6 +558,7 @@ Status Consolidator::create_queries(
   RETURN_NOT_OK((*query_r)->set_subarray_unsafe(subarray));
   if (array_for_reads->array_schema()->dense() && sparse_mode)
     RETURN_NOT_OK((*query_r)->set_sparse_mode(true));
+  (*query_r)->set_parent_reservation(reservation);
 
   // Get last fragment URI, which will be the URI of the consolidated fragment
   auto first = (*query_r)->first_fragment_uri();
@@ -528,6 +570,7 @@ Status Consolidator::create_queries(
   RETURN_NOT_OK((*query_w)->set_layout(Layout::GLOBAL_ORDER));
   if (array_for_reads->array_schema()->dense())
     RETURN_NOT_OK((*query_w)->set_subarray_unsafe(subarray));
+  (*query_w)->set_parent_reservation(reservation);
 
   return Status::Ok();
 }
@@ -536,10 +579,14 @@ Status Consolidator::delete_fragment_metadata(
     const URI& array_uri, const std::vector<URI>& fragments) {
   RETURN_NOT_OK(storage_manager_->array_xlock(array_uri));
 
-  for (auto& uri : fragments) {
-    auto meta_uri = uri.join_path(constants::fragment_metadata_filename);
-    RETURN_NOT_OK(storage_manager_->vfs()->remove_file(meta_uri));
-  }
+  std::vector<URI> meta_uris;
+  meta_uris.reserve(fragments.size());
+  for (auto& uri : fragments)
+    meta_uris.emplace_back(
+        uri.join_path(constants::fragment_metadata_filename));
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->vfs()->remove_files(meta_uris),
+      storage_manager_->array_xunlock(array_uri));
 
   RETURN_NOT_OK(storage_manager_->array_xunlock(array_uri));
 
@@ -547,10 +594,7 @@ Status Consolidator::delete_fragment_metadata(
 }
 
 Status Consolidator::delete_fragments(const std::vector<URI>& fragments) {
-  for (auto& uri : fragments)
-    RETURN_NOT_OK(storage_manager_->vfs()->remove_dir(uri));
-
-  return Status::Ok();
+  return storage_manager_->vfs()->remove_dirs(fragments);
 }
 
 Status Consolidator::delete_overwritten_fragments(
@@ -35,6 +35,7 @@
 
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/misc/memory_broker.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/storage_manager/open_array.h"
@@ -285,11 +286,16 @@ class Consolidator {
    *     in special sparse mode. This is ignored for sparse arrays.
    * @param buffers The buffers to be created.
    * @param buffer_sizes The corresponding buffer sizes.
+   * @param reservation The memory reserved for the buffers. Under the
+   *     shrink policy of the memory broker, the buffers are halved (down to
+   *     1/8 of `sm.consolidation.buffer_size`) until their memory is
+   *     available.
    * @return Status
    */
   Status create_buffers(
       const ArraySchema* array_schema,
       bool sparse_mode,
+      MemoryReservation* reservation,
       std::vector<ByteVec>* buffers,
       std::vector<uint64_t>* buffer_sizes);
 
@@ -306,6 +312,8 @@ class Consolidator {
    *     in special sparse mode. This is ignored for sparse arrays.
    * @param subarray The subarray to read from (the fragments to consolidate)
    *     and write to (the new fragment).
+   * @param reservation The memory reserved for the buffers, which the
+   *     queries hold while reserving their own memory.
    * @param query_r This query reads from the fragments to be consolidated.
    * @param query_w This query writes to the new consolidated fragment.
    * @param new_fragment_uri The URI of the new fragment to be created.
@@ -316,6 +324,7 @@ class Consolidator {
       Array* array_for_writes,
       bool sparse_mode,
       const NDRange& subarray,
+      const MemoryReservation* reservation,
       Query** query_r,
       Query** query_w,
       URI* new_fragment_uri);
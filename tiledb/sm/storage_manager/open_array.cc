@@ -116,6 +116,18 @@ FragmentMetadata* OpenArray::fragment_metadata(const URI& uri) const {
   return (it == fragment_metadata_set_.end()) ? nullptr : it->second;
 }
 
+bool OpenArray::is_listed_fragment(const URI& uri) const {
+  std::lock_guard<std::mutex> lock(local_mtx_);
+  return listed_fragments_.count(uri.to_string()) != 0;
+}
+
+void OpenArray::set_listed_fragments(const std::vector<URI>& fragment_uris) {
+  std::lock_guard<std::mutex> lock(local_mtx_);
+  listed_fragments_.clear();
+  for (const auto& uri : fragment_uris)
+    listed_fragments_.insert(uri.to_string());
+}
+
 std::shared_ptr<ConstBuffer> OpenArray::array_metadata(const URI& uri) const {
   std::lock_guard<std::mutex> lock(local_mtx_);
   auto it = array_metadata_.find(uri.to_string());
@@ -138,11 +150,17 @@ void OpenArray::set_array_schema(ArraySchema* array_schema) {
   array_schema_ = array_schema;
 }
 
-void OpenArray::insert_fragment_metadata(FragmentMetadata* metadata) {
+FragmentMetadata* OpenArray::insert_fragment_metadata(
+    FragmentMetadata* metadata) {
   std::lock_guard<std::mutex> lock(local_mtx_);
   assert(metadata != nullptr);
+  auto uri = metadata->fragment_uri().to_string();
+  auto it = fragment_metadata_set_.find(uri);
+  if (it != fragment_metadata_set_.end())
+    return it->second;
   fragment_metadata_.insert(metadata);
-  fragment_metadata_set_[metadata->fragment_uri().to_string()] = metadata;
+  fragment_metadata_set_[uri] = metadata;
+  return metadata;
 }
 
 void OpenArray::insert_array_metadata(
@@ -39,6 +39,8 @@
 #include <mutex>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "tiledb/sm/crypto/encryption_key_validation.h"
 #include "tiledb/sm/filesystem/filelock.h"
@@ -123,6 +125,19 @@ class OpenArray {
    */
   FragmentMetadata* fragment_metadata(const URI& uri) const;
 
+  /**
+   * Returns `true` if the input URI was found to be a fragment by the last
+   * listing of the array directory.
+   */
+  bool is_listed_fragment(const URI& uri) const;
+
+  /**
+   * Sets the fragment URIs found by the last listing of the array directory.
+   * Upon the next listing (e.g., when the array is reopened), only the
+   * URIs that are not in this set need to be checked for being fragments.
+   */
+  void set_listed_fragments(const std::vector<URI>& fragment_uris);
+
   /**
    * Returns the constant buffer storing the serialized array metadata
    * of the input URI, or `nullptr` if the array metadata do not exist.
@@ -142,8 +157,16 @@ class OpenArray {
    * Inserts the input fragment metadata. Note that all fragment
    * metadata must be sorted in ascending timestamp of creation.
    * This function will guarantee that the ordering is maintained.
+   *
+   * Since fragment metadata are loaded without holding the array mutex,
+   * the same fragment may be loaded concurrently by several opens. In
+   * that case, the metadata inserted first is kept and returned, and the
+   * caller is responsible for deleting the input `metadata`.
+   *
+   * @param metadata The fragment metadata to insert.
+   * @return The fragment metadata stored for the fragment URI.
    */
-  void insert_fragment_metadata(FragmentMetadata* metadata);
+  FragmentMetadata* insert_fragment_metadata(FragmentMetadata* metadata);
 
   /**
    * Inserts the input array metadata (serialized in a share constant
@@ -196,6 +219,9 @@ class OpenArray {
    */
   std::unordered_map<std::string, FragmentMetadata*> fragment_metadata_set_;
 
+  /** The fragment URI strings found by the last listing of the array. */
+  std::unordered_set<std::string> listed_fragments_;
+
   /**
    * A map of URI strings to array metadata. The map stores the serialized
    * (decompressed, decrypted) array metadata into constant buffers.
@@ -65,6 +65,8 @@ namespace sm {
 
 StorageManager::StorageManager() {
   tile_cache_ = nullptr;
+  fragment_metadata_cache_ = nullptr;
+  query_result_cache_ = nullptr;
   vfs_ = nullptr;
   cancellation_in_progress_ = false;
   queries_in_progress_ = 0;
@@ -77,6 +79,8 @@ StorageManager::~StorageManager() {
     cancel_all_tasks();
 
   delete tile_cache_;
+  delete fragment_metadata_cache_;
+  delete query_result_cache_;
 
   // Release all filelocks and delete all opened arrays for reads
   for (auto& open_array_it : open_arrays_for_reads_) {
@@ -208,25 +212,29 @@ Status StorageManager::array_open_for_reads(
   // Retrieve array schema
   *array_schema = open_array->array_schema();
 
+  // Unlock the array mutex. The fragment metadata are listed and loaded
+  // without holding it, so that concurrent opens and reopens of the same
+  // array do not wait on each other's storage requests. The open array
+  // entry is not deleted meanwhile, as its counter has been incremented.
+  open_array->mtx_unlock();
+
   // Determine which fragments to load
   std::vector<TimestampedURI> fragments_to_load;
   std::vector<URI> fragment_uris;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
-  RETURN_NOT_OK(get_sorted_uris(fragment_uris, timestamp, &fragments_to_load));
+  auto st = get_fragment_uris(array_uri, &fragment_uris, open_array);
+  if (st.ok())
+    st = get_sorted_uris(fragment_uris, timestamp, &fragments_to_load);
 
   // Get fragment metadata in the case of reads, if not fetched already
-  Status st = load_fragment_metadata(
-      open_array, encryption_key, fragments_to_load, fragment_metadata);
+  if (st.ok())
+    st = load_fragment_metadata(
+        open_array, encryption_key, fragments_to_load, fragment_metadata);
   if (!st.ok()) {
-    open_array->mtx_unlock();
     array_close_for_reads(array_uri);
     *array_schema = nullptr;
     return st;
   }
 
-  // Unlock the array mutex
-  open_array->mtx_unlock();
-
   // Note that we retain the (shared) lock on the array filelock
   return Status::Ok();
 
@@ -250,6 +258,9 @@ Status StorageManager::array_open_for_reads(
   // Retrieve array schema
   *array_schema = open_array->array_schema();
 
+  // Unlock the array mutex, as the fragment metadata are loaded without it
+  open_array->mtx_unlock();
+
   // Determine which fragments to load
   std::vector<TimestampedURI> fragments_to_load;
   for (const auto& fragment : fragments)
@@ -259,15 +270,11 @@ Status StorageManager::array_open_for_reads(
   Status st = load_fragment_metadata(
       open_array, encryption_key, fragments_to_load, fragment_metadata);
   if (!st.ok()) {
-    open_array->mtx_unlock();
     array_close_for_reads(array_uri);
     *array_schema = nullptr;
     return st;
   }
 
-  // Unlock the array mutex
-  open_array->mtx_unlock();
-
   // Note that we retain the (shared) lock on the array filelock
   return Status::Ok();
 
@@ -375,22 +382,23 @@ Status StorageManager::array_reopen(
     }
     RETURN_NOT_OK(it->second->set_encryption_key(encryption_key));
     open_array = it->second;
-
-    // Lock the array
-    open_array->mtx_lock();
   }
 
+  // The array mutex is not locked, as the open array entry is kept alive
+  // by the open array being reopened and fragment metadata loading is
+  // thread-safe. This way, a reopen does not block concurrent opens of the
+  // same array (see `array_open_for_reads`).
+
   // Determine which fragments to load
   std::vector<TimestampedURI> fragments_to_load;
   std::vector<URI> fragment_uris;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
+  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris, open_array));
   RETURN_NOT_OK(get_sorted_uris(fragment_uris, timestamp, &fragments_to_load));
 
   // Get fragment metadata in the case of reads, if not fetched already
   auto st = load_fragment_metadata(
       open_array, encryption_key, fragments_to_load, fragment_metadata);
   if (!st.ok()) {
-    open_array->mtx_unlock();
     array_close_for_reads(array_uri);
     *array_schema = nullptr;
     return st;
@@ -399,9 +407,6 @@ Status StorageManager::array_reopen(
   // Get the array schema
   *array_schema = open_array->array_schema();
 
-  // Unlock the mutexes
-  open_array->mtx_unlock();
-
   return st;
 
   STATS_FUNC_OUT(sm_array_reopen);
@@ -974,11 +979,35 @@ Status StorageManager::init(const Config* config) {
   RETURN_NOT_OK(
       config_.get<uint64_t>("sm.tile_cache_size", &tile_cache_size, &found));
   assert(found);
+  uint64_t fragment_metadata_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.fragment_metadata_cache_size",
+      &fragment_metadata_cache_size,
+      &found));
+  assert(found);
+  uint64_t query_result_cache_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.query_result_cache_size", &query_result_cache_size, &found));
+  assert(found);
+  uint64_t memory_limit = 0;
+  RETURN_NOT_OK(
+      config_.get<uint64_t>("sm.memory_limit", &memory_limit, &found));
+  assert(found);
+  const char* memory_limit_policy = nullptr;
+  RETURN_NOT_OK(config_.get("sm.memory_limit_policy", &memory_limit_policy));
 
   RETURN_NOT_OK(async_thread_pool_.init(num_async_threads));
   RETURN_NOT_OK(reader_thread_pool_.init(num_reader_threads));
   RETURN_NOT_OK(writer_thread_pool_.init(num_writer_threads));
   tile_cache_ = new LRUCache(tile_cache_size);
+  fragment_metadata_cache_ = new LRUCache(fragment_metadata_cache_size);
+  query_result_cache_ = new LRUCache(query_result_cache_size);
+
+  // The tile cache gives up memory to the queries when the limit is reached
+  RETURN_NOT_OK(memory_broker_.init(memory_limit, memory_limit_policy));
+  tile_cache_->set_memory_broker(&memory_broker_);
+  memory_broker_.set_reclaimer(
+      [this](uint64_t nbytes) { tile_cache_->reclaim(nbytes); });
 
   // GlobalState must be initialized before `vfs->init` because S3::init calls
   // GetGlobalState
@@ -1110,40 +1139,17 @@ Status StorageManager::load_array_metadata(
 }
 
 Status StorageManager::object_type(const URI& uri, ObjectType* type) const {
-  URI dir_uri = uri;
-  if (uri.is_s3() || uri.is_azure()) {
-    // Always add a trailing '/' in the S3/Azure case so that listing the URI as
-    // a directory will work as expected. Listing a non-directory object is not
-    // an error for S3/Azure.
-    auto uri_str = uri.to_string();
-    dir_uri =
-        URI(utils::parse::ends_with(uri_str, "/") ? uri_str : (uri_str + "/"));
-  } else {
-    // For non public cloud backends, listing a non-directory is an error.
-    bool is_dir = false;
-    RETURN_NOT_OK(vfs_->is_dir(uri, &is_dir));
-    if (!is_dir) {
-      *type = ObjectType::INVALID;
-      return Status::Ok();
-    }
+  URI dir_uri;
+  RETURN_NOT_OK(object_type_dir_uri(uri, &dir_uri));
+  if (dir_uri.is_invalid()) {
+    *type = ObjectType::INVALID;
+    return Status::Ok();
   }
 
   std::vector<URI> child_uris;
   RETURN_NOT_OK(vfs_->ls(dir_uri, &child_uris));
+  *type = object_type(child_uris);
 
-  for (const auto& child_uri : child_uris) {
-    auto uri_str = child_uri.to_string();
-    if (utils::parse::ends_with(uri_str, constants::group_filename)) {
-      *type = ObjectType::GROUP;
-      return Status::Ok();
-    } else if (utils::parse::ends_with(
-                   uri_str, constants::array_schema_filename)) {
-      *type = ObjectType::ARRAY;
-      return Status::Ok();
-    }
-  }
-
-  *type = ObjectType::INVALID;
   return Status::Ok();
 }
 
@@ -1166,11 +1172,11 @@ Status StorageManager::object_iter_begin(
   (*obj_iter)->recursive_ = true;
 
   // Include the uris that are TileDB objects in the iterator state
-  ObjectType obj_type;
-  for (auto& uri : uris) {
-    RETURN_NOT_OK_ELSE(object_type(uri, &obj_type), delete *obj_iter);
-    if (obj_type != ObjectType::INVALID) {
-      (*obj_iter)->objs_.push_back(uri);
+  std::vector<ObjectType> obj_types;
+  RETURN_NOT_OK_ELSE(object_types(uris, &obj_types), delete *obj_iter);
+  for (size_t i = 0; i < uris.size(); ++i) {
+    if (obj_types[i] != ObjectType::INVALID) {
+      (*obj_iter)->objs_.push_back(uris[i]);
       if (order == WalkOrder::POSTORDER)
         (*obj_iter)->expanded_.push_back(false);
     }
@@ -1198,11 +1204,11 @@ Status StorageManager::object_iter_begin(
   (*obj_iter)->recursive_ = false;
 
   // Include the uris that are TileDB objects in the iterator state
-  ObjectType obj_type;
-  for (auto& uri : uris) {
-    RETURN_NOT_OK(object_type(uri, &obj_type));
-    if (obj_type != ObjectType::INVALID)
-      (*obj_iter)->objs_.push_back(uri);
+  std::vector<ObjectType> obj_types;
+  RETURN_NOT_OK_ELSE(object_types(uris, &obj_types), delete *obj_iter);
+  for (size_t i = 0; i < uris.size(); ++i) {
+    if (obj_types[i] != ObjectType::INVALID)
+      (*obj_iter)->objs_.push_back(uris[i]);
   }
 
   return Status::Ok();
@@ -1246,11 +1252,11 @@ Status StorageManager::object_iter_next_postorder(
       obj_iter->expanded_.front() = true;
 
       // Push the new TileDB objects in the front of the iterator's list
-      ObjectType obj_type;
-      for (auto it = uris.rbegin(); it != uris.rend(); ++it) {
-        RETURN_NOT_OK(object_type(*it, &obj_type));
-        if (obj_type != ObjectType::INVALID) {
-          obj_iter->objs_.push_front(*it);
+      std::vector<ObjectType> obj_types;
+      RETURN_NOT_OK(object_types(uris, &obj_types));
+      for (size_t i = uris.size(); i-- > 0;) {
+        if (obj_types[i] != ObjectType::INVALID) {
+          obj_iter->objs_.push_front(uris[i]);
           obj_iter->expanded_.push_front(false);
         }
       }
@@ -1292,11 +1298,11 @@ Status StorageManager::object_iter_next_preorder(
   RETURN_NOT_OK(vfs_->ls(front_uri, &uris));
 
   // Push the new TileDB objects in the front of the iterator's list
-  ObjectType obj_type;
-  for (auto it = uris.rbegin(); it != uris.rend(); ++it) {
-    RETURN_NOT_OK(object_type(*it, &obj_type));
-    if (obj_type != ObjectType::INVALID)
-      obj_iter->objs_.push_front(*it);
+  std::vector<ObjectType> obj_types;
+  RETURN_NOT_OK(object_types(uris, &obj_types));
+  for (size_t i = uris.size(); i-- > 0;) {
+    if (obj_types[i] != ObjectType::INVALID)
+      obj_iter->objs_.push_front(uris[i]);
   }
 
   return Status::Ok();
@@ -1358,6 +1364,36 @@ Status StorageManager::read_from_cache(
   STATS_FUNC_OUT(sm_read_from_cache);
 }
 
+Status StorageManager::read_from_fragment_metadata_cache(
+    const std::string& key, Buffer* buffer, bool* in_cache) const {
+  RETURN_NOT_OK(fragment_metadata_cache_->read(key, buffer, in_cache));
+  buffer->reset_offset();
+
+  if (*in_cache) {
+    STATS_COUNTER_ADD(fragment_metadata_cache_read_hits, 1);
+    STATS_COUNTER_ADD(fragment_metadata_cached_bytes_copied, buffer->size());
+  } else {
+    STATS_COUNTER_ADD(fragment_metadata_cache_read_misses, 1);
+  }
+
+  return Status::Ok();
+}
+
+Status StorageManager::read_from_query_result_cache(
+    const std::string& key, Buffer* buffer, bool* in_cache) const {
+  RETURN_NOT_OK(query_result_cache_->read(key, buffer, in_cache));
+  buffer->reset_offset();
+
+  return Status::Ok();
+}
+
+Status StorageManager::evict_from_cache(const URI& uri, uint64_t offset) const {
+  std::stringstream key;
+  key << uri.to_string() << "+" << offset;
+  bool evicted;
+  return tile_cache_->invalidate(key.str(), &evicted);
+}
+
 Status StorageManager::read(
     const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const {
   RETURN_NOT_OK(buffer->realloc(nbytes));
@@ -1368,6 +1404,10 @@ Status StorageManager::read(
   return Status::Ok();
 }
 
+MemoryBroker* StorageManager::memory_broker() {
+  return &memory_broker_;
+}
+
 ThreadPool* StorageManager::reader_thread_pool() {
   return &reader_thread_pool_;
 }
@@ -1439,7 +1479,10 @@ Status StorageManager::store_array_metadata(
   // Create a metadata file name
   URI array_metadata_uri;
   RETURN_NOT_OK(new_array_metadata_uri(
-      array_uri, array_metadata->timestamp_range(), &array_metadata_uri));
+      array_uri,
+      array_metadata->timestamp_range(),
+      false,
+      &array_metadata_uri));
 
   // Write to file
   metadata_buff.reset_offset();
@@ -1462,6 +1505,64 @@ Status StorageManager::store_array_metadata(
   return st;
 }
 
+Status StorageManager::store_array_metadata_indexed(
+    const URI& array_uri,
+    const EncryptionKey& encryption_key,
+    Metadata* array_metadata) {
+  // Trivial case
+  if (array_metadata == nullptr)
+    return Status::Ok();
+
+  // Serialize the array metadata blocks
+  std::vector<Buffer> block_buffs;
+  std::vector<Metadata::BlockInfo> blocks;
+  RETURN_NOT_OK(array_metadata->serialize_blocks(
+      constants::array_metadata_block_size, &block_buffs, &blocks));
+
+  // Do nothing if there are no metadata to write
+  if (blocks.empty())
+    return Status::Ok();
+
+  // Create a metadata file name
+  URI array_metadata_uri;
+  RETURN_NOT_OK(new_array_metadata_uri(
+      array_uri,
+      array_metadata->timestamp_range(),
+      true,
+      &array_metadata_uri));
+
+  // Write the blocks, recording their offsets
+  TileIO tile_io(this, array_metadata_uri);
+  uint64_t offset = 0, nbytes;
+  for (size_t b = 0; b < blocks.size(); ++b) {
+    block_buffs[b].reset_offset();
+    Tile tile(
+        constants::generic_tile_datatype,
+        constants::generic_tile_cell_size,
+        0,
+        &block_buffs[b],
+        false);
+    RETURN_NOT_OK(tile_io.write_generic(&tile, encryption_key, &nbytes));
+    blocks[b].offset_ = offset;
+    offset += nbytes;
+  }
+
+  // Write the index and the footer with the index offset
+  Buffer index_buff;
+  RETURN_NOT_OK(Metadata::serialize_index(blocks, &index_buff));
+  index_buff.reset_offset();
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      &index_buff,
+      false);
+  RETURN_NOT_OK(tile_io.write_generic(&tile, encryption_key, &nbytes));
+  RETURN_NOT_OK(write(array_metadata_uri, &offset, sizeof(uint64_t)));
+
+  return close_file(array_metadata_uri);
+}
+
 Status StorageManager::close_file(const URI& uri) {
   return vfs_->close_file(uri);
 }
@@ -1528,6 +1629,45 @@ Status StorageManager::write_to_cache(
   STATS_FUNC_OUT(sm_write_to_cache);
 }
 
+Status StorageManager::write_to_fragment_metadata_cache(
+    const std::string& key, const Buffer& buffer) const {
+  // Do nothing if the section size is larger than the cache size
+  uint64_t object_size = buffer.size();
+  if (object_size > fragment_metadata_cache_->max_size())
+    return Status::Ok();
+
+  void* object = std::malloc(object_size);
+  if (object == nullptr)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot write to fragment metadata cache; Object memory allocation "
+        "failed"));
+  std::memcpy(object, buffer.data(), object_size);
+  RETURN_NOT_OK(
+      fragment_metadata_cache_->insert(key, object, object_size, false));
+  STATS_COUNTER_ADD(fragment_metadata_cache_inserts, 1);
+
+  return Status::Ok();
+}
+
+Status StorageManager::write_to_query_result_cache(
+    const std::string& key, const Buffer& buffer) const {
+  // Do nothing if the results are larger than the cache size
+  uint64_t object_size = buffer.size();
+  if (object_size > query_result_cache_->max_size())
+    return Status::Ok();
+
+  void* object = std::malloc(object_size);
+  if (object == nullptr)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot write to query result cache; Object memory allocation "
+        "failed"));
+  std::memcpy(object, buffer.data(), object_size);
+  RETURN_NOT_OK(query_result_cache_->insert(key, object, object_size));
+  STATS_COUNTER_ADD(sm_query_result_cache_inserts, 1);
+
+  return Status::Ok();
+}
+
 Status StorageManager::write(const URI& uri, Buffer* buffer) const {
   return vfs_->write(uri, buffer->data(), buffer->size());
 }
@@ -1600,22 +1740,45 @@ Status StorageManager::array_open_without_fragments(
 }
 
 Status StorageManager::get_fragment_uris(
-    const URI& array_uri, std::vector<URI>* fragment_uris) const {
+    const URI& array_uri,
+    std::vector<URI>* fragment_uris,
+    OpenArray* open_array) const {
   // Get all uris in the array directory
   std::vector<URI> uris;
   RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
 
   // Get only the fragment uris
   bool exists;
+  uint64_t checks_skipped = 0;
   for (auto& uri : uris) {
-    if (utils::parse::starts_with(uri.last_path_part(), "."))
+    std::string uri_str = uri.c_str();
+    if (uri_str.back() == '/')
+      uri_str.pop_back();
+    auto name = URI(uri_str).last_path_part();
+    if (utils::parse::starts_with(name, ".") ||
+        name == constants::array_schema_filename ||
+        name == constants::filelock_name ||
+        name == constants::array_metadata_folder_name)
+      continue;
+
+    if (open_array != nullptr && open_array->is_listed_fragment(uri)) {
+      fragment_uris->push_back(uri);
+      ++checks_skipped;
       continue;
+    }
 
     RETURN_NOT_OK(is_fragment(uri, &exists));
     if (exists)
       fragment_uris->push_back(uri);
   }
 
+  // Fragment directories that are not complete yet are not recorded, so
+  // that they are checked again by the next listing
+  if (open_array != nullptr)
+    open_array->set_listed_fragments(*fragment_uris);
+
+  STATS_COUNTER_ADD(sm_fragment_checks_skipped, checks_skipped);
+
   return Status::Ok();
 }
 
@@ -1669,11 +1832,49 @@ Status StorageManager::load_array_metadata(
   if (metadata == nullptr)
     return Status::Ok();
 
-  auto metadata_num = array_metadata_to_load.size();
+  // If the first array metadata file is indexed, only its index is loaded
+  // here, and its blocks are loaded on demand
+  std::shared_ptr<ConstBuffer> index_buff;
+  Metadata::BlockReader block_reader;
+  size_t first = 0;
+  if (!array_metadata_to_load.empty() &&
+      is_indexed_array_metadata(array_metadata_to_load[0].uri_)) {
+    auto index_uri = array_metadata_to_load[0].uri_;
+    RETURN_NOT_OK(load_array_metadata_index(
+        open_array, encryption_key, index_uri, &index_buff));
+    block_reader = [this, &encryption_key, index_uri](
+                       uint64_t offset, Buffer* buff) {
+      return load_array_metadata_block(encryption_key, index_uri, offset, buff);
+    };
+    first = 1;
+  }
+
+  auto metadata_num = array_metadata_to_load.size() - first;
   std::vector<std::shared_ptr<ConstBuffer>> metadata_buffs;
   metadata_buffs.resize(metadata_num);
+  std::vector<Buffer> indexed_buffs(metadata_num);
   auto statuses = parallel_for(0, metadata_num, [&](size_t m) {
-    const auto& uri = array_metadata_to_load[m].uri_;
+    const auto& uri = array_metadata_to_load[first + m].uri_;
+    if (is_indexed_array_metadata(uri)) {
+      // The metadata that follow the first file are loaded in full, so
+      // the blocks are concatenated in a single buffer
+      std::shared_ptr<ConstBuffer> file_index_buff;
+      RETURN_NOT_OK(load_array_metadata_index(
+          open_array, encryption_key, uri, &file_index_buff));
+      ConstBuffer cbuff(file_index_buff->data(), file_index_buff->size());
+      std::vector<Metadata::BlockInfo> blocks;
+      RETURN_NOT_OK(Metadata::deserialize_index(&cbuff, &blocks));
+      for (const auto& block : blocks) {
+        Buffer block_buff;
+        RETURN_NOT_OK(load_array_metadata_block(
+            encryption_key, uri, block.offset_, &block_buff));
+        RETURN_NOT_OK(
+            indexed_buffs[m].write(block_buff.data(), block_buff.size()));
+      }
+      metadata_buffs[m] = std::make_shared<ConstBuffer>(&indexed_buffs[m]);
+      return Status::Ok();
+    }
+
     auto metadata_buff = open_array->array_metadata(uri);
     if (metadata_buff == nullptr) {  // Array metadata does not exist - load it
       TileIO tile_io(this, uri);
@@ -1692,7 +1893,8 @@ Status StorageManager::load_array_metadata(
     RETURN_NOT_OK(st);
 
   // Deserialize metadata buffers
-  metadata->deserialize(metadata_buffs);
+  RETURN_NOT_OK(
+      metadata->deserialize(index_buff, block_reader, metadata_buffs));
 
   // Sets the loaded metadata URIs
   metadata->set_loaded_metadata_uris(array_metadata_to_load);
@@ -1700,6 +1902,56 @@ Status StorageManager::load_array_metadata(
   return Status::Ok();
 }
 
+Status StorageManager::load_array_metadata_index(
+    OpenArray* open_array,
+    const EncryptionKey& encryption_key,
+    const URI& uri,
+    std::shared_ptr<ConstBuffer>* index_buff) {
+  *index_buff = open_array->array_metadata(uri);
+  if (*index_buff != nullptr)
+    return Status::Ok();
+
+  // Get the index offset from the footer
+  uint64_t file_size;
+  RETURN_NOT_OK(vfs_->file_size(uri, &file_size));
+  if (file_size < sizeof(uint64_t))
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot load array metadata index; Invalid file size"));
+  Buffer footer_buff;
+  RETURN_NOT_OK(read(
+      uri, file_size - sizeof(uint64_t), &footer_buff, sizeof(uint64_t)));
+  uint64_t index_offset;
+  RETURN_NOT_OK(footer_buff.read(&index_offset, sizeof(uint64_t)));
+
+  auto buff = new Buffer();
+  RETURN_NOT_OK_ELSE(
+      load_array_metadata_block(encryption_key, uri, index_offset, buff),
+      delete buff);
+  *index_buff = std::make_shared<ConstBuffer>(buff);
+  open_array->insert_array_metadata(uri, *index_buff);
+
+  return Status::Ok();
+}
+
+Status StorageManager::load_array_metadata_block(
+    const EncryptionKey& encryption_key,
+    const URI& uri,
+    uint64_t offset,
+    Buffer* buff) {
+  TileIO tile_io(this, uri);
+  auto tile = (Tile*)nullptr;
+  RETURN_NOT_OK(tile_io.read_generic(&tile, offset, encryption_key));
+  buff->swap(*tile->buffer());
+  delete tile;
+
+  return Status::Ok();
+}
+
+bool StorageManager::is_indexed_array_metadata(const URI& uri) {
+  return utils::parse::ends_with(
+      uri.last_path_part(), constants::array_metadata_indexed_suffix);
+}
+
 Status StorageManager::load_fragment_metadata(
     OpenArray* open_array,
     const EncryptionKey& encryption_key,
@@ -1708,9 +1960,9 @@ Status StorageManager::load_fragment_metadata(
   // Load the metadata for each fragment, only if they are not already loaded
   auto fragment_num = fragments_to_load.size();
   fragment_metadata->resize(fragment_num);
-  uint32_t f_version;
   auto statuses = parallel_for(0, fragment_num, [&](size_t f) {
     const auto& sf = fragments_to_load[f];
+    uint32_t f_version;
     auto array_schema = open_array->array_schema();
     auto metadata = open_array->fragment_metadata(sf.uri_);
     if (metadata == nullptr) {  // Fragment metadata does not exist - load it
@@ -1734,7 +1986,13 @@ Status StorageManager::load_fragment_metadata(
       }
 
       RETURN_NOT_OK_ELSE(metadata->load(encryption_key), delete metadata);
-      open_array->insert_fragment_metadata(metadata);
+
+      // Another open may have loaded the same fragment concurrently
+      auto stored = open_array->insert_fragment_metadata(metadata);
+      if (stored != metadata) {
+        delete metadata;
+        metadata = stored;
+      }
     }
     (*fragment_metadata)[f] = metadata;
     return Status::Ok();
@@ -1786,6 +2044,7 @@ Status StorageManager::get_sorted_uris(
 Status StorageManager::new_array_metadata_uri(
     const URI& array_uri,
     const std::pair<uint64_t, uint64_t>& timestamp_range,
+    bool indexed,
     URI* new_uri) const {
   std::string uuid;
   RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
@@ -1793,12 +2052,70 @@ Status StorageManager::new_array_metadata_uri(
   std::stringstream ss;
   ss << "/__" << timestamp_range.first << "_" << timestamp_range.second << "_"
      << uuid;
+  if (indexed)
+    ss << constants::array_metadata_indexed_suffix;
   *new_uri = array_uri.join_path(constants::array_metadata_folder_name)
                  .join_path(ss.str());
 
   return Status::Ok();
 }
 
+Status StorageManager::object_types(
+    const std::vector<URI>& uris, std::vector<ObjectType>* types) const {
+  types->assign(uris.size(), ObjectType::INVALID);
+
+  // Find the URIs to list
+  std::vector<URI> dir_uris;
+  std::vector<size_t> dir_idx;
+  for (size_t i = 0; i < uris.size(); ++i) {
+    URI dir_uri;
+    RETURN_NOT_OK(object_type_dir_uri(uris[i], &dir_uri));
+    if (!dir_uri.is_invalid()) {
+      dir_uris.emplace_back(std::move(dir_uri));
+      dir_idx.emplace_back(i);
+    }
+  }
+
+  // List them in parallel
+  std::vector<std::vector<URI>> child_uris;
+  RETURN_NOT_OK(vfs_->ls_all(dir_uris, &child_uris));
+  for (size_t i = 0; i < dir_uris.size(); ++i)
+    (*types)[dir_idx[i]] = object_type(child_uris[i]);
+
+  return Status::Ok();
+}
+
+Status StorageManager::object_type_dir_uri(
+    const URI& uri, URI* dir_uri) const {
+  if (uri.is_s3() || uri.is_azure()) {
+    // Always add a trailing '/' in the S3/Azure case so that listing the URI as
+    // a directory will work as expected. Listing a non-directory object is not
+    // an error for S3/Azure.
+    auto uri_str = uri.to_string();
+    *dir_uri =
+        URI(utils::parse::ends_with(uri_str, "/") ? uri_str : (uri_str + "/"));
+  } else {
+    // For non public cloud backends, listing a non-directory is an error.
+    bool is_dir = false;
+    RETURN_NOT_OK(vfs_->is_dir(uri, &is_dir));
+    *dir_uri = is_dir ? uri : URI();
+  }
+
+  return Status::Ok();
+}
+
+ObjectType StorageManager::object_type(const std::vector<URI>& child_uris) {
+  for (const auto& child_uri : child_uris) {
+    auto uri_str = child_uri.to_string();
+    if (utils::parse::ends_with(uri_str, constants::group_filename))
+      return ObjectType::GROUP;
+    if (utils::parse::ends_with(uri_str, constants::array_schema_filename))
+      return ObjectType::ARRAY;
+  }
+
+  return ObjectType::INVALID;
+}
+
 Status StorageManager::set_default_tags() {
   const auto version = std::to_string(constants::library_version[0]) + "." +
                        std::to_string(constants::library_version[1]) + "." +
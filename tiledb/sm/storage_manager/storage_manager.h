@@ -49,6 +49,7 @@
 #include "tiledb/sm/filesystem/filelock.h"
 #include "tiledb/sm/fragment/fragment_info.h"
 #include "tiledb/sm/misc/cancelable_tasks.h"
+#include "tiledb/sm/misc/memory_broker.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
@@ -59,6 +60,7 @@ namespace sm {
 class Array;
 class ArraySchema;
 class Buffer;
+class ConstBuffer;
 class Consolidator;
 class EncryptionKey;
 class FragmentMetadata;
@@ -496,7 +498,9 @@ class StorageManager {
 
   /**
    * Loads the array metadata from persistent storage that were created
-   * at or before `timestamp`.
+   * at or before `timestamp`. The blocks of an indexed metadata file are
+   * loaded on demand with `encryption_key`, which must therefore outlive
+   * `metadata`.
    */
   Status load_array_metadata(
       const URI& array_uri,
@@ -629,6 +633,53 @@ class StorageManager {
       uint64_t nbytes,
       bool* in_cache) const;
 
+  /**
+   * Reads a section of a fragment metadata file (e.g., the footer, the R-tree
+   * or the tile offsets of an attribute) from the fragment metadata cache.
+   * Since fragments are immutable, the cached sections remain valid after
+   * the arrays that loaded them are closed.
+   *
+   * @param key The key of the section, formed by the fragment metadata URI
+   *     and the section.
+   * @param buffer The buffer the section is written into.
+   * @param in_cache This is set to `true` if the section is in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_from_fragment_metadata_cache(
+      const std::string& key, Buffer* buffer, bool* in_cache) const;
+
+  /**
+   * Reads the results of a read query from the query result cache. The
+   * cache holds the results of complete reads, so that identical reads on
+   * the same fragments do not recompute them.
+   *
+   * @param key The key of the results (see `Reader::result_cache_key`).
+   * @param buffer The buffer the results are written into.
+   * @param in_cache This is set to `true` if the results are in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_from_query_result_cache(
+      const std::string& key, Buffer* buffer, bool* in_cache) const;
+
+  /**
+   * Evicts the object with the input `uri` and `offset` key (see
+   * `read_from_cache`) from the cache, if it is cached. This is used to
+   * evict tiles that failed to unfilter, e.g., due to a checksum mismatch.
+   *
+   * @param uri The URI of the cached object.
+   * @param offset The offset of the cached object.
+   * @return Status.
+   */
+  Status evict_from_cache(const URI& uri, uint64_t offset) const;
+
+  /**
+   * Returns the broker that tracks the memory reserved by the queries, the
+   * consolidator and the tile cache of this storage manager.
+   */
+  MemoryBroker* memory_broker();
+
   /** Returns the Reader thread pool. */
   ThreadPool* reader_thread_pool();
 
@@ -679,6 +730,22 @@ class StorageManager {
       const EncryptionKey& encryption_key,
       Metadata* array_metadata);
 
+  /**
+   * Stores the array metadata into persistent storage as an indexed
+   * metadata file (see `Metadata`), whose blocks can be loaded on demand.
+   * The blocks of any indexed metadata file that was loaded into
+   * `array_metadata` must have been loaded.
+   *
+   * @param array_uri The URI of the array.
+   * @param encryption_key The encryption key to use.
+   * @param array_metadata The array metadata.
+   * @return Status
+   */
+  Status store_array_metadata_indexed(
+      const URI& array_uri,
+      const EncryptionKey& encryption_key,
+      Metadata* array_metadata);
+
   /** Closes a file, flushing its contents to persistent storage. */
   Status close_file(const URI& uri);
 
@@ -705,6 +772,30 @@ class StorageManager {
    */
   Status write_to_cache(const URI& uri, uint64_t offset, Buffer* buffer) const;
 
+  /**
+   * Writes a fragment metadata section into the fragment metadata cache (see
+   * `read_from_fragment_metadata_cache`), evicting the least recently used
+   * sections if the cache is full.
+   *
+   * @param key The key of the section.
+   * @param buffer The buffer whose contents will be cached.
+   * @return Status.
+   */
+  Status write_to_fragment_metadata_cache(
+      const std::string& key, const Buffer& buffer) const;
+
+  /**
+   * Writes the results of a read query into the query result cache (see
+   * `read_from_query_result_cache`), replacing any results with the same key
+   * and evicting the least recently used results if the cache is full.
+   *
+   * @param key The key of the results.
+   * @param buffer The buffer whose contents will be cached.
+   * @return Status.
+   */
+  Status write_to_query_result_cache(
+      const std::string& key, const Buffer& buffer) const;
+
   /**
    * Writes the contents of a buffer into a URI file.
    *
@@ -818,9 +909,24 @@ class StorageManager {
   /** Tags for the context object. */
   std::unordered_map<std::string, std::string> tags_;
 
+  /** The context-wide memory broker. */
+  MemoryBroker memory_broker_;
+
   /** A tile cache. */
   LRUCache* tile_cache_;
 
+  /**
+   * A cache of fragment metadata sections, which outlives the open arrays
+   * (see `read_from_fragment_metadata_cache`).
+   */
+  LRUCache* fragment_metadata_cache_;
+
+  /**
+   * A cache of the results of read queries (see
+   * `read_from_query_result_cache`).
+   */
+  LRUCache* query_result_cache_;
+
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
    * filesystem backend. Note that this is stateful.
@@ -855,9 +961,16 @@ class StorageManager {
   /** Decrement the count of in-progress queries. */
   void decrement_in_progress();
 
-  /** Retrieves all the fragment URI's of an array. */
+  /**
+   * Retrieves all the fragment URI's of an array. If `open_array` is not
+   * `nullptr`, the entries that its last listing found to be fragments are
+   * not checked again (fragments are never modified once they are visible),
+   * and the listing is recorded in `open_array` for the next call.
+   */
   Status get_fragment_uris(
-      const URI& array_uri, std::vector<URI>* fragment_uris) const;
+      const URI& array_uri,
+      std::vector<URI>* fragment_uris,
+      OpenArray* open_array = nullptr) const;
 
   /** Retrieves all the array metadata URI's of an array. */
   Status get_array_metadata_uris(
@@ -899,6 +1012,40 @@ class StorageManager {
       const std::vector<TimestampedURI>& array_metadata_to_load,
       Metadata* metadata);
 
+  /**
+   * Loads the index of an indexed array metadata file. The index is
+   * cached in binary form in `open_array`.
+   *
+   * @param open_array The open array object.
+   * @param encryption_key The encryption key to use.
+   * @param uri The URI of the indexed array metadata file.
+   * @param index_buff The index to be retrieved.
+   * @return Status
+   */
+  Status load_array_metadata_index(
+      OpenArray* open_array,
+      const EncryptionKey& encryption_key,
+      const URI& uri,
+      std::shared_ptr<ConstBuffer>* index_buff);
+
+  /**
+   * Loads the block at the input offset of an indexed array metadata file.
+   *
+   * @param encryption_key The encryption key to use.
+   * @param uri The URI of the indexed array metadata file.
+   * @param offset The offset of the block in the file.
+   * @param buff The buffer the block is loaded into.
+   * @return Status
+   */
+  Status load_array_metadata_block(
+      const EncryptionKey& encryption_key,
+      const URI& uri,
+      uint64_t offset,
+      Buffer* buff);
+
+  /** Returns true if the input URI is an indexed array metadata file. */
+  static bool is_indexed_array_metadata(const URI& uri);
+
   /**
    * Loads the fragment metadata of an open array given a vector of
    * fragment URIs `fragments_to_load`. If the fragment metadata
@@ -942,13 +1089,34 @@ class StorageManager {
 
   /**
    * Retrieves a new array metadata URI, incorporating the input timestamp
-   * range.
+   * range. If `indexed` is true, the URI is for an indexed metadata file.
    */
   Status new_array_metadata_uri(
       const URI& array_uri,
       const std::pair<uint64_t, uint64_t>& timestamp_range,
+      bool indexed,
       URI* new_uri) const;
 
+  /**
+   * Retrieves the TileDB object types of multiple URIs, listing the URIs
+   * in parallel.
+   *
+   * @param uris The URIs of the candidate TileDB objects.
+   * @param types The object types, in the order of `uris`.
+   * @return Status
+   */
+  Status object_types(
+      const std::vector<URI>& uris, std::vector<ObjectType>* types) const;
+
+  /**
+   * Prepares the URI to list in order to determine its TileDB object type.
+   * Sets `dir_uri` to an empty URI if the input cannot be an object.
+   */
+  Status object_type_dir_uri(const URI& uri, URI* dir_uri) const;
+
+  /** Returns the TileDB object type of a directory given its contents. */
+  static ObjectType object_type(const std::vector<URI>& child_uris);
+
   /** Sets default tag values on this StorageManager. */
   Status set_default_tags();
 };
@@ -37,11 +37,15 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/fragment/fragment_index.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/rtree/rtree.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iomanip>
 #include <sstream>
 
@@ -65,7 +69,8 @@ Subarray::Subarray(const Array* array)
 
 Subarray::Subarray(const Array* array, Layout layout)
     : array_(array)
-    , layout_(layout) {
+    , layout_(layout)
+    , fragment_metadata_(array->fragment_metadata()) {
   est_result_size_computed_ = false;
   tile_overlap_computed_ = false;
   add_default_ranges();
@@ -177,6 +182,7 @@ bool Subarray::coincides_with_tiles() const {
 template <class T>
 Subarray Subarray::crop_to_tile(const T* tile_coords, Layout layout) const {
   Subarray ret(array_, layout);
+  ret.fragment_metadata_ = fragment_metadata_;
   T new_range[2];
   bool overlaps;
 
@@ -277,6 +283,7 @@ Status Subarray::get_range_num(uint32_t dim_idx, uint64_t* range_num) const {
 
 Subarray Subarray::get_subarray(uint64_t start, uint64_t end) const {
   Subarray ret(array_, layout_);
+  ret.fragment_metadata_ = fragment_metadata_;
 
   auto start_coords = get_range_coords(start);
   auto end_coords = get_range_coords(end);
@@ -347,6 +354,21 @@ void Subarray::set_is_default(uint32_t dim_index, bool is_default) {
   is_default_[dim_index] = is_default;
 }
 
+const std::vector<FragmentMetadata*>& Subarray::fragment_metadata() const {
+  return fragment_metadata_;
+}
+
+void Subarray::set_fragment_metadata(
+    const std::vector<FragmentMetadata*>& fragment_metadata) {
+  if (fragment_metadata == fragment_metadata_)
+    return;
+
+  fragment_metadata_ = fragment_metadata;
+  est_result_size_computed_ = false;
+  tile_overlap_computed_ = false;
+  tile_overlap_.clear();
+}
+
 void Subarray::set_layout(Layout layout) {
   layout_ = layout;
 }
@@ -622,6 +644,8 @@ Status Subarray::split(
   assert(r2 != nullptr);
   *r1 = Subarray(array_, layout_);
   *r2 = Subarray(array_, layout_);
+  r1->fragment_metadata_ = fragment_metadata_;
+  r2->fragment_metadata_ = fragment_metadata_;
 
   auto dim_num = array_->array_schema()->dim_num();
 
@@ -652,6 +676,8 @@ Status Subarray::split(
   assert(r2 != nullptr);
   *r1 = Subarray(array_, layout_);
   *r2 = Subarray(array_, layout_);
+  r1->fragment_metadata_ = fragment_metadata_;
+  r2->fragment_metadata_ = fragment_metadata_;
 
   // For easy reference
   auto array_schema = array_->array_schema();
@@ -698,6 +724,17 @@ const std::vector<std::vector<TileOverlap>>& Subarray::tile_overlap() const {
   return tile_overlap_;
 }
 
+void Subarray::set_result_cell_nums(
+    unsigned frag_idx,
+    uint64_t range_idx,
+    std::vector<uint64_t>&& result_cell_nums) {
+  assert(tile_overlap_computed_);
+  auto& overlap = tile_overlap_[frag_idx][range_idx];
+  assert(result_cell_nums.size() == overlap.tiles_.size());
+  overlap.result_cell_nums_ = std::move(result_cell_nums);
+  est_result_size_computed_ = false;
+}
+
 template <class T>
 void Subarray::compute_tile_coords() {
   if (array_->array_schema()->tile_order() == Layout::ROW_MAJOR)
@@ -789,7 +826,6 @@ Status Subarray::compute_est_result_size() {
     est_result_size_vec.emplace_back(ResultSize{0.0, 0.0, 0, 0});
 
   // Compute estimated result in parallel over fragments and ranges
-  auto meta = array_->fragment_metadata();
   auto range_num = this->range_num();
 
   // Get attribute and dimension names
@@ -852,7 +888,8 @@ Status Subarray::compute_est_result_size(
   }
 
   // For easy reference
-  auto fragment_num = array_->fragment_metadata().size();
+  const auto& fragment_metadata = fragment_metadata_;
+  auto fragment_num = fragment_metadata.size();
   auto array_schema = array_->array_schema();
   auto domain = array_schema->domain();
   auto encryption_key = array_->encryption_key();
@@ -861,7 +898,7 @@ Status Subarray::compute_est_result_size(
   // Compute estimated result
   for (unsigned f = 0; f < fragment_num; ++f) {
     const auto& overlap = tile_overlap_[f][range_idx];
-    auto meta = array_->fragment_metadata()[f];
+    auto meta = fragment_metadata[f];
 
     // Parse tile ranges
     for (const auto& tr : overlap.tile_ranges_) {
@@ -879,17 +916,25 @@ Status Subarray::compute_est_result_size(
       }
     }
 
-    // Parse individual tiles
-    for (const auto& t : overlap.tiles_) {
-      auto tid = t.first;
-      auto ratio = t.second;
+    // Parse individual tiles. If the exact number of result cells of the
+    // tiles is known, the var-sized estimate is the whole var-sized tile of
+    // the tiles with results (an upper bound).
+    auto exact = !overlap.result_cell_nums_.empty();
+    for (size_t i = 0; i < overlap.tiles_.size(); ++i) {
+      auto tid = overlap.tiles_[i].first;
+      auto ratio = overlap.tiles_[i].second;
+      if (exact)
+        ratio = (double)overlap.result_cell_nums_[i] / meta->cell_num(tid);
       if (!var_size) {
         ret.size_fixed_ += meta->tile_size(name, tid) * ratio;
         ret.mem_size_fixed_ += meta->tile_size(name, tid);
       } else {
         ret.size_fixed_ += meta->tile_size(name, tid) * ratio;
         RETURN_NOT_OK(meta->tile_var_size(*encryption_key, name, tid, &size));
-        ret.size_var_ += size * ratio;
+        if (!exact)
+          ret.size_var_ += size * ratio;
+        else if (ratio > 0)
+          ret.size_var_ += size;
         ret.mem_size_fixed_ += meta->tile_size(name, tid);
         ret.mem_size_var_ += size;
       }
@@ -1033,12 +1078,14 @@ void Subarray::compute_tile_coords_row() {
 }
 
 Status Subarray::compute_tile_overlap() {
+  STATS_FUNC_IN(subarray_compute_tile_overlap);
+
   if (tile_overlap_computed_)
     return Status::Ok();
 
   compute_range_offsets();
   tile_overlap_.clear();
-  auto meta = array_->fragment_metadata();
+  const auto& meta = fragment_metadata_;
   auto fragment_num = meta.size();
   tile_overlap_.resize(fragment_num);
   auto range_num = this->range_num();
@@ -1047,9 +1094,30 @@ Status Subarray::compute_tile_overlap() {
 
   auto encryption_key = array_->encryption_key();
 
+  // Find the fragments that intersect each range with the fragment index
+  // of the array, if it indexes the same fragments
+  std::vector<std::vector<unsigned>> range_fragments;
+  auto fragment_index = array_->fragment_index();
+  if (fragment_index != nullptr &&
+      fragment_index->fragment_metadata() == meta) {
+    range_fragments.resize(range_num);
+    auto statuses = parallel_for(0, range_num, [&](uint64_t j) {
+      range_fragments[j] =
+          fragment_index->overlapping_fragments(this->ndrange(j));
+      return Status::Ok();
+    });
+    for (const auto& st : statuses)
+      RETURN_NOT_OK(st);
+  }
+
   // Compute estimated tile overlap in parallel over fragments and ranges
   auto statuses = parallel_for_2d(
       0, fragment_num, 0, range_num, [&](unsigned i, uint64_t j) {
+        if (!range_fragments.empty() &&
+            !std::binary_search(
+                range_fragments[j].begin(), range_fragments[j].end(), i))
+          return Status::Ok();  // No overlap
+
         if (meta[i]->dense()) {  // Dense fragment
           tile_overlap_[i][j] = get_tile_overlap(j, i);
         } else {  // Sparse fragment
@@ -1065,6 +1133,8 @@ Status Subarray::compute_tile_overlap() {
   tile_overlap_computed_ = true;
 
   return Status::Ok();
+
+  STATS_FUNC_OUT(subarray_compute_tile_overlap);
 }
 
 Subarray Subarray::clone() const {
@@ -1074,6 +1144,7 @@ Subarray Subarray::clone() const {
   clone.ranges_ = ranges_;
   clone.is_default_ = is_default_;
   clone.range_offsets_ = range_offsets_;
+  clone.fragment_metadata_ = fragment_metadata_;
   clone.tile_overlap_ = tile_overlap_;
   clone.est_result_size_computed_ = est_result_size_computed_;
   clone.tile_overlap_computed_ = tile_overlap_computed_;
@@ -1143,7 +1214,7 @@ TileOverlap Subarray::get_tile_overlap(uint64_t range_idx, unsigned fid) const {
   }
 
   // Get tile overlap from fragment
-  auto meta = array_->fragment_metadata()[fid];
+  auto meta = fragment_metadata_[fid];
   auto frag_overlap = meta->compute_overlapping_tile_ids_cov<T>(&range_cpy[0]);
 
   // Prepare ret. Contiguous tile ids with full overlap
@@ -1203,6 +1274,7 @@ void Subarray::swap(Subarray& subarray) {
   std::swap(ranges_, subarray.ranges_);
   std::swap(is_default_, subarray.is_default_);
   std::swap(range_offsets_, subarray.range_offsets_);
+  std::swap(fragment_metadata_, subarray.fragment_metadata_);
   std::swap(tile_overlap_, subarray.tile_overlap_);
   std::swap(est_result_size_computed_, subarray.est_result_size_computed_);
   std::swap(tile_overlap_computed_, subarray.tile_overlap_computed_);
@@ -50,6 +50,7 @@ namespace tiledb {
 namespace sm {
 
 class Array;
+class FragmentMetadata;
 
 enum class Layout : uint8_t;
 enum class QueryType : uint8_t;
@@ -346,6 +347,23 @@ class Subarray {
    */
   Subarray get_subarray(uint64_t start, uint64_t end) const;
 
+  /**
+   * Returns the fragment metadata the subarray computes its tile overlap
+   * and estimated result sizes for. This is a snapshot of the fragment
+   * metadata of the array taken upon construction, so it does not change
+   * if the array is reopened meanwhile. The subarrays derived from this
+   * one (e.g., partitions) share it.
+   */
+  const std::vector<FragmentMetadata*>& fragment_metadata() const;
+
+  /**
+   * Sets the fragment metadata the subarray is computed for (see
+   * `fragment_metadata()`), e.g., those a query was created with. The tile
+   * overlap and estimated result sizes are reset if they differ.
+   */
+  void set_fragment_metadata(
+      const std::vector<FragmentMetadata*>& fragment_metadata);
+
   /**
    * Set default indicator for dimension subarray. Used by serialization only
    * @param dim_index
@@ -444,6 +462,23 @@ class Subarray {
   /** Returns the tile overlap of the subarray. */
   const std::vector<std::vector<TileOverlap>>& tile_overlap() const;
 
+  /**
+   * Sets the exact number of cells of each partially overlapping tile of
+   * the input fragment that lie in the input range (see
+   * `TileOverlap::result_cell_nums_`). The result size estimation then uses
+   * these numbers instead of the overlap ratios, and the var-sized part of
+   * the estimate becomes an upper bound. The tile overlap must have been
+   * computed.
+   *
+   * @param frag_idx The fragment index.
+   * @param range_idx The range index.
+   * @param result_cell_nums One number per tile in `TileOverlap::tiles_`.
+   */
+  void set_result_cell_nums(
+      unsigned frag_idx,
+      uint64_t range_idx,
+      std::vector<uint64_t>&& result_cell_nums);
+
   /**
    * Compute `tile_coords_` and `tile_coords_map_`. The coordinates will
    * be sorted on the array tile order.
@@ -483,6 +518,12 @@ class Subarray {
   /** Important for computed an ND range index from a flat serialized index. */
   std::vector<uint64_t> range_offsets_;
 
+  /**
+   * The fragment metadata that `tile_overlap_` and `est_result_size_` are
+   * computed for (see `fragment_metadata()`).
+   */
+  std::vector<FragmentMetadata*> fragment_metadata_;
+
   /**
    * ``True`` if the estimated result size for all attributes/dimensions has
    * been computed.
@@ -37,6 +37,7 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/stats.h"
 
 #include <iomanip>
 
@@ -219,6 +220,8 @@ Status SubarrayPartitioner::get_memory_budget(
 }
 
 Status SubarrayPartitioner::next(bool* unsplittable) {
+  STATS_FUNC_IN(reader_next_subarray_partition);
+
   *unsplittable = false;
 
   if (done())
@@ -259,6 +262,8 @@ Status SubarrayPartitioner::next(bool* unsplittable) {
 
   // Must split a multi-range subarray slab
   return next_from_multi_range(unsplittable);
+
+  STATS_FUNC_OUT(reader_next_subarray_partition);
 }
 
 Status SubarrayPartitioner::set_result_budget(
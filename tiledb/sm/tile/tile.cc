@@ -48,6 +48,7 @@ Tile::Tile() {
   cell_size_ = 0;
   dim_num_ = 0;
   filtered_ = false;
+  from_cache_ = false;
   owns_buff_ = true;
   pre_filtered_size_ = 0;
   type_ = Datatype::INT32;
@@ -58,6 +59,7 @@ Tile::Tile(unsigned int dim_num)
   buffer_ = nullptr;
   cell_size_ = 0;
   filtered_ = false;
+  from_cache_ = false;
   owns_buff_ = true;
   pre_filtered_size_ = 0;
   type_ = Datatype::INT32;
@@ -73,6 +75,7 @@ Tile::Tile(
     , cell_size_(cell_size)
     , dim_num_(dim_num)
     , filtered_(false)
+    , from_cache_(false)
     , owns_buff_(owns_buff)
     , pre_filtered_size_(0)
     , type_(type) {
@@ -184,6 +187,7 @@ Tile Tile::clone(bool deep_copy) const {
   clone.dim_num_ = dim_num_;
   clone.filtered_ = filtered_;
   clone.format_version_ = format_version_;
+  clone.from_cache_ = from_cache_;
   clone.pre_filtered_size_ = pre_filtered_size_;
   clone.type_ = type_;
 
@@ -233,6 +237,10 @@ uint32_t Tile::format_version() const {
   return format_version_;
 }
 
+bool Tile::from_cache() const {
+  return from_cache_;
+}
+
 bool Tile::full() const {
   return (buffer_->size() != 0) &&
          (buffer_->offset() == buffer_->alloced_size());
@@ -283,6 +291,10 @@ void Tile::set_filtered(bool filtered) {
   filtered_ = filtered;
 }
 
+void Tile::set_from_cache(bool from_cache) {
+  from_cache_ = from_cache;
+}
+
 void Tile::set_offset(uint64_t offset) {
   buffer_->set_offset(offset);
 }
@@ -372,6 +384,7 @@ void Tile::swap(Tile& tile) {
   std::swap(dim_num_, tile.dim_num_);
   std::swap(filtered_, tile.filtered_);
   std::swap(format_version_, tile.format_version_);
+  std::swap(from_cache_, tile.from_cache_);
   std::swap(owns_buff_, tile.owns_buff_);
   std::swap(pre_filtered_size_, tile.pre_filtered_size_);
   std::swap(type_, tile.type_);
@@ -196,6 +196,12 @@ class Tile {
   /** Gets the format version number of the data in this Tile. */
   uint32_t format_version() const;
 
+  /**
+   * Returns `true` if the filtered tile data was read from the tile cache
+   * rather than from storage.
+   */
+  bool from_cache() const;
+
   /** Checks if the tile is full. */
   bool full() const;
 
@@ -236,6 +242,9 @@ class Tile {
   /** Set the filtered state of the tile. */
   void set_filtered(bool filtered);
 
+  /** Sets whether the filtered tile data was read from the tile cache. */
+  void set_from_cache(bool from_cache);
+
   /** Sets the tile offset. */
   void set_offset(uint64_t offset);
 
@@ -318,6 +327,9 @@ class Tile {
   /** The format version of the data in this tile. */
   uint32_t format_version_;
 
+  /** When `true`, the filtered data was read from the tile cache. */
+  bool from_cache_;
+
   /**
    * If *true* the tile object will delete *buff* upon
    * destruction, otherwise it will not delete it.
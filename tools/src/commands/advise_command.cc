@@ -0,0 +1,346 @@
+/**
+ * @file  advise_command.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the advise command.
+ */
+
+#include "commands/advise_command.h"
+#include "misc/common.h"
+#include "misc/values.h"
+
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/crypto/encryption_key.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/enums/query_type.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace tiledb {
+namespace cli {
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Returns the tile extents as strings, in dimension order. */
+std::vector<std::string> extent_strs(
+    const ArraySchema* schema, const std::vector<ByteVecValue>& extents) {
+  std::vector<std::string> result;
+  for (unsigned d = 0; d < schema->dim_num(); ++d) {
+    if (d >= extents.size() || extents[d].empty())
+      result.push_back("null");
+    else
+      result.push_back(schema->dimension(d)->coord_to_str(&extents[d][0]));
+  }
+  return result;
+}
+
+/** Writes the given uint64 values as a JSON array. */
+void write_json_array(std::ostream& os, const std::vector<uint64_t>& values) {
+  os << "[";
+  for (size_t i = 0; i < values.size(); ++i)
+    os << (i == 0 ? "" : ", ") << values[i];
+  os << "]";
+}
+
+/** Writes a tiling as a JSON object, indented by `indent` spaces. */
+void write_json_tiling(
+    std::ostream& os,
+    const ArraySchema* schema,
+    const TileAdvisor::Recommendation& rec,
+    const std::string& indent) {
+  auto extents = extent_strs(schema, rec.tile_extents_);
+  os << "{\n";
+  os << indent << "  \"tile_extents\": {";
+  for (unsigned d = 0; d < schema->dim_num(); ++d) {
+    os << (d == 0 ? "" : ", ") << "\""
+       << json_escape(schema->dimension(d)->name()) << "\": " << extents[d];
+  }
+  os << "},\n";
+  os << indent << "  \"capacity\": " << rec.capacity_ << ",\n";
+  os << indent << "  \"tile_cell_num\": " << rec.tile_cell_num_ << ",\n";
+  os << indent << "  \"max_tile_size\": " << rec.max_tile_size_ << ",\n";
+  os << indent << "  \"tile_num\": " << rec.tile_num_ << ",\n";
+  os << indent << "  \"metadata_size\": " << rec.metadata_size_ << ",\n";
+  os << indent << "  \"query_tile_num\": ";
+  write_json_array(os, rec.query_tile_num_);
+  os << ",\n";
+  os << indent << "  \"query_bytes\": ";
+  write_json_array(os, rec.query_bytes_);
+  os << ",\n";
+  os << indent << "  \"cost\": " << (uint64_t)rec.cost_ << "\n";
+  os << indent << "}";
+}
+
+}  // namespace
+
+clipp::group AdviseCommand::get_cli() {
+  using namespace clipp;
+  auto cli =
+      ((option("-a", "--array").required(true) & value("uri", array_uri_)) %
+           "URI of TileDB array to sample",
+       (option("-q", "--queries") & value("path", queries_path_)) %
+           "Path to JSON file with representative query subarrays",
+       (option("--apply") & value("uri", apply_uri_)) %
+           "Create an empty array with the recommended schema",
+       (option("--min-tile-size") & value("bytes", min_tile_size_)) %
+           "Minimum uncompressed tile size",
+       (option("--max-tile-size") & value("bytes", max_tile_size_)) %
+           "Maximum uncompressed tile size",
+       (option("--tile-overhead") & value("bytes", tile_overhead_)) %
+           "Cost of reading a tile, in bytes",
+       (option("-f", "--format") &
+        (required("text").set(format_, Format::Text) |
+         required("json").set(format_, Format::JSON))) %
+           "Report format (default text)",
+       (option("-o", "--output") & value("path", output_path_)) %
+           "Path to write the report");
+  return cli;
+}
+
+void AdviseCommand::run() {
+  StorageManager sm;
+  THROW_NOT_OK(sm.init(nullptr));
+
+  // Open the array
+  URI uri(array_uri_);
+  Array array(uri, &sm);
+  THROW_NOT_OK(
+      array.open(QueryType::READ, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+  const auto schema = array.array_schema();
+
+  TileAdvisor advisor(schema);
+  if (min_tile_size_ != 0 || max_tile_size_ != 0) {
+    advisor.set_tile_size_limits(
+        min_tile_size_,
+        max_tile_size_ != 0 ? max_tile_size_ : UINT64_MAX);
+  }
+  if (tile_overhead_ != 0)
+    advisor.set_tile_overhead(tile_overhead_);
+  sample_fragments(&array, &advisor);
+  if (!queries_path_.empty())
+    add_queries(JSONValue::parse_file(queries_path_), schema, &advisor);
+
+  TileAdvisor::Recommendation cur, rec;
+  THROW_NOT_OK(advisor.evaluate(&cur));
+  THROW_NOT_OK(advisor.recommend(&rec));
+
+  // Optionally create a new array with the recommended tiling
+  if (!apply_uri_.empty()) {
+    ArraySchema new_schema(schema);
+    THROW_NOT_OK(TileAdvisor::apply(rec, &new_schema));
+    EncryptionKey enc_key;
+    THROW_NOT_OK(
+        enc_key.set_key(EncryptionType::NO_ENCRYPTION, nullptr, 0));
+    THROW_NOT_OK(sm.array_create(URI(apply_uri_), &new_schema, enc_key));
+  }
+
+  if (output_path_.empty()) {
+    if (format_ == Format::JSON)
+      write_json(std::cout, schema, cur, rec);
+    else
+      write_text(std::cout, schema, cur, rec);
+  } else {
+    std::ofstream os(output_path_, std::ios::out | std::ios::trunc);
+    if (format_ == Format::JSON)
+      write_json(os, schema, cur, rec);
+    else
+      write_text(os, schema, cur, rec);
+  }
+
+  THROW_NOT_OK(array.close());
+}
+
+void AdviseCommand::sample_fragments(
+    Array* array, TileAdvisor* advisor) const {
+  const auto schema = array->array_schema();
+  auto fragment_metadata = array->fragment_metadata();
+  EncryptionKey enc_key;
+
+  uint64_t total_cell_num = 0;
+  for (const auto& f : fragment_metadata) {
+    uint64_t cell_num = 0;
+    auto tile_num = f->tile_num();
+    for (uint64_t t = 0; t < tile_num; ++t)
+      cell_num += f->cell_num(t);
+    THROW_NOT_OK(advisor->add_cells(cell_num, f->non_empty_domain()));
+    total_cell_num += cell_num;
+  }
+  if (total_cell_num == 0)
+    return;
+
+  // Measure the average cell size and compression ratio of each attribute
+  for (const auto* attr : schema->attributes()) {
+    const auto& name = attr->name();
+    uint64_t persisted_size = 0, in_memory_size = 0;
+    for (const auto& f : fragment_metadata) {
+      auto tile_num = f->tile_num();
+      for (uint64_t t = 0; t < tile_num; ++t) {
+        uint64_t size = 0;
+        THROW_NOT_OK(f->persisted_tile_size(enc_key, name, t, &size));
+        persisted_size += size;
+        in_memory_size += f->tile_size(name, t);
+        if (attr->var_size()) {
+          THROW_NOT_OK(f->persisted_tile_var_size(enc_key, name, t, &size));
+          persisted_size += size;
+          THROW_NOT_OK(f->tile_var_size(enc_key, name, t, &size));
+          in_memory_size += size;
+        }
+      }
+    }
+    if (in_memory_size == 0)
+      continue;
+    advisor->set_cell_size(name, (double)in_memory_size / total_cell_num);
+    advisor->set_compression_ratio(
+        name, (double)persisted_size / in_memory_size);
+  }
+}
+
+void AdviseCommand::add_queries(
+    const JSONValue& desc,
+    const ArraySchema* schema,
+    TileAdvisor* advisor) const {
+  auto dim_num = schema->dim_num();
+  for (const auto& query : desc.at("queries").as_array()) {
+    // Collect the ranges of each dimension (the whole domain if missing)
+    std::vector<std::vector<Range>> dim_ranges(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      const auto dim = schema->dimension(d);
+      if (!query.has(dim->name())) {
+        dim_ranges[d].push_back(dim->domain());
+        continue;
+      }
+      for (const auto& range : query.at(dim->name()).as_array()) {
+        const auto& r = range.as_array();
+        if (r.size() != 2)
+          throw std::invalid_argument(
+              "Cannot add query; Ranges must be given as [start, end]");
+        std::vector<uint8_t> bytes;
+        append_value(dim->type(), r[0].as_number(), &bytes);
+        append_value(dim->type(), r[1].as_number(), &bytes);
+        dim_ranges[d].emplace_back(&bytes[0], bytes.size());
+      }
+    }
+
+    // Add one query per range combination
+    std::vector<size_t> idx(dim_num, 0);
+    for (bool done = false; !done;) {
+      NDRange subarray(dim_num);
+      for (unsigned d = 0; d < dim_num; ++d)
+        subarray[d] = dim_ranges[d][idx[d]];
+      THROW_NOT_OK(advisor->add_query(subarray));
+
+      done = true;
+      for (unsigned d = dim_num; d-- > 0;) {
+        if (++idx[d] < dim_ranges[d].size()) {
+          done = false;
+          break;
+        }
+        idx[d] = 0;
+      }
+    }
+  }
+}
+
+void AdviseCommand::write_text(
+    std::ostream& os,
+    const ArraySchema* schema,
+    const TileAdvisor::Recommendation& cur,
+    const TileAdvisor::Recommendation& rec) const {
+  auto print_tiling = [&](const std::string& title,
+                          const TileAdvisor::Recommendation& r) {
+    auto extents = extent_strs(schema, r.tile_extents_);
+    os << title << ":" << std::endl;
+    if (schema->dense()) {
+      os << "  Tile extents:";
+      for (unsigned d = 0; d < schema->dim_num(); ++d)
+        os << " " << schema->dimension(d)->name() << "=" << extents[d];
+      os << std::endl;
+    } else {
+      os << "  Capacity: " << r.capacity_ << std::endl;
+    }
+    os << "  Cells per tile: " << r.tile_cell_num_ << std::endl;
+    os << "  Largest tile size: " << r.max_tile_size_ << " bytes" << std::endl;
+    os << "  Number of tiles: " << r.tile_num_ << std::endl;
+    os << "  Fragment metadata size: " << r.metadata_size_ << " bytes"
+       << std::endl;
+    for (size_t q = 0; q < r.query_tile_num_.size(); ++q) {
+      os << "  Query " << q << ": " << r.query_tile_num_[q] << " tiles, "
+         << r.query_bytes_[q] << " bytes" << std::endl;
+    }
+    os << "  Projected cost: " << (uint64_t)r.cost_ << " bytes" << std::endl;
+  };
+
+  os << "Array URI: " << array_uri_ << std::endl;
+  print_tiling("Current tiling", cur);
+  print_tiling("Recommended tiling", rec);
+  if (!rec.filter_notes_.empty()) {
+    os << "Filters:" << std::endl;
+    for (const auto& note : rec.filter_notes_)
+      os << "  " << note.first << ": " << note.second << std::endl;
+  }
+  if (!apply_uri_.empty())
+    os << "Created array " << apply_uri_ << " with the recommended tiling."
+       << std::endl;
+}
+
+void AdviseCommand::write_json(
+    std::ostream& os,
+    const ArraySchema* schema,
+    const TileAdvisor::Recommendation& cur,
+    const TileAdvisor::Recommendation& rec) const {
+  os << "{\n";
+  os << "  \"array\": \"" << json_escape(array_uri_) << "\",\n";
+  os << "  \"current\": ";
+  write_json_tiling(os, schema, cur, "  ");
+  os << ",\n";
+  os << "  \"recommended\": ";
+  write_json_tiling(os, schema, rec, "  ");
+  os << ",\n";
+  os << "  \"filters\": {";
+  for (size_t i = 0; i < rec.filter_notes_.size(); ++i) {
+    const auto& note = rec.filter_notes_[i];
+    os << (i == 0 ? "\n" : ",\n") << "    \"" << json_escape(note.first)
+       << "\": \"" << json_escape(note.second) << "\"";
+  }
+  os << (rec.filter_notes_.empty() ? "}" : "\n  }");
+  if (!apply_uri_.empty())
+    os << ",\n  \"created\": \"" << json_escape(apply_uri_) << "\"";
+  os << "\n}" << std::endl;
+}
+
+}  // namespace cli
+}  // namespace tiledb
@@ -0,0 +1,133 @@
+/**
+ * @file  advise_command.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the advise command.
+ */
+
+#ifndef TILEDB_CLI_ADVISE_COMMAND_H
+#define TILEDB_CLI_ADVISE_COMMAND_H
+
+#include "commands/command.h"
+#include "misc/json.h"
+
+#include "tiledb/sm/array_schema/tile_advisor.h"
+
+#include <string>
+
+namespace tiledb {
+namespace sm {
+class Array;
+class ArraySchema;
+}  // namespace sm
+
+namespace cli {
+
+/**
+ * Command that samples the fragments of an existing array and recommends
+ * tile extents (dense) or a tile capacity (sparse) for a set of
+ * representative queries, optionally creating a new empty array with the
+ * recommended schema.
+ */
+class AdviseCommand : public Command {
+ public:
+  /** Get the CLI for this command instance. */
+  clipp::group get_cli();
+
+  /** Runs this advise command. */
+  void run();
+
+ private:
+  /** Output formats of the report. */
+  enum class Format { Text, JSON };
+
+  /** Array to sample. */
+  std::string array_uri_;
+
+  /** Path to the JSON file with the representative queries. */
+  std::string queries_path_;
+
+  /** URI of the array to create with the recommended schema, if any. */
+  std::string apply_uri_;
+
+  /** Path to write the report (stdout if empty). */
+  std::string output_path_;
+
+  /** Report format. */
+  Format format_ = Format::Text;
+
+  /** Minimum uncompressed tile size in bytes (0 for the default). */
+  uint64_t min_tile_size_ = 0;
+
+  /** Maximum uncompressed tile size in bytes (0 for the default). */
+  uint64_t max_tile_size_ = 0;
+
+  /** Fixed cost in bytes of reading a tile (0 for the default). */
+  uint64_t tile_overhead_ = 0;
+
+  /**
+   * Adds the cell counts, non-empty domains, cell sizes and compression
+   * ratios of the array fragments to the advisor.
+   */
+  void sample_fragments(sm::Array* array, sm::TileAdvisor* advisor) const;
+
+  /**
+   * Adds the queries of the JSON file to the advisor. Subarrays with
+   * several ranges per dimension add one query per range combination.
+   */
+  void add_queries(
+      const JSONValue& desc,
+      const sm::ArraySchema* schema,
+      sm::TileAdvisor* advisor) const;
+
+  /**
+   * Writes the text report to the given stream.
+   *
+   * @param os The output stream.
+   * @param schema The schema of the sampled array.
+   * @param cur The costs of the current tiling.
+   * @param rec The recommended tiling.
+   */
+  void write_text(
+      std::ostream& os,
+      const sm::ArraySchema* schema,
+      const sm::TileAdvisor::Recommendation& cur,
+      const sm::TileAdvisor::Recommendation& rec) const;
+
+  /** Writes the JSON report to the given stream (see `write_text`). */
+  void write_json(
+      std::ostream& os,
+      const sm::ArraySchema* schema,
+      const sm::TileAdvisor::Recommendation& cur,
+      const sm::TileAdvisor::Recommendation& rec) const;
+};
+
+}  // namespace cli
+}  // namespace tiledb
+
+#endif
@@ -50,6 +50,14 @@ void HelpCommand::run(const std::map<std::string, clipp::group>& group_help) {
     description = "Displays help about a specific command.";
   } else if (command_ == "info") {
     description = "Displays information about a TileDB array.";
+  } else if (command_ == "profile") {
+    description =
+        "Runs a query described in a JSON file against a TileDB array and "
+        "reports where the time was spent.";
+  } else if (command_ == "advise") {
+    description =
+        "Recommends tile extents or capacity for a TileDB array, given "
+        "representative queries.";
   } else if (command_ == "all") {
     description =
         "Command-line interface for performing common TileDB tasks. Choose a "
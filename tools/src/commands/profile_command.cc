@@ -0,0 +1,595 @@
+/**
+ * @file  profile_command.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the profile command.
+ */
+
+#include "commands/profile_command.h"
+#include "misc/common.h"
+#include "misc/values.h"
+
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/config/config.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/encryption_type.h"
+#include "tiledb/sm/enums/query_status.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/query/query.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace tiledb {
+namespace cli {
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Default size in bytes of each query buffer. */
+const uint64_t default_buffer_size = 10 * 1024 * 1024;
+
+/** Returns `ns` in seconds. */
+double to_sec(uint64_t ns) {
+  return ns / 1e9;
+}
+
+}  // namespace
+
+clipp::group ProfileCommand::get_cli() {
+  using namespace clipp;
+  auto cli =
+      ((option("-a", "--array").required(true) & value("uri", array_uri_)) %
+           "URI of TileDB array",
+       (option("-q", "--query").required(true) & value("path", query_path_)) %
+           "Path to JSON file describing the query",
+       (option("-f", "--format") &
+        (required("text").set(format_, Format::Text) |
+         required("json").set(format_, Format::JSON))) %
+           "Report format (default text)",
+       (option("-o", "--output") & value("path", output_path_)) %
+           "Path to write the report");
+  return cli;
+}
+
+void ProfileCommand::run() {
+  auto desc = JSONValue::parse_file(query_path_);
+  run_query(desc);
+
+  if (output_path_.empty()) {
+    if (format_ == Format::JSON)
+      write_json(std::cout);
+    else
+      write_text(std::cout);
+  } else {
+    std::ofstream os(output_path_, std::ios::out | std::ios::trunc);
+    if (format_ == Format::JSON)
+      write_json(os);
+    else
+      write_text(os);
+  }
+}
+
+void ProfileCommand::run_query(const JSONValue& desc) {
+  // Parse the query type and layout
+  if (desc.has("type")) {
+    auto type_str = desc.at("type").as_string();
+    std::transform(type_str.begin(), type_str.end(), type_str.begin(), ::toupper);
+    THROW_NOT_OK(query_type_enum(type_str, &query_type_));
+  }
+  if (desc.has("layout"))
+    THROW_NOT_OK(layout_enum(desc.at("layout").as_string(), &layout_));
+
+  // Initialize the storage manager with the given config
+  Config config;
+  if (desc.has("config")) {
+    for (const auto& kv : desc.at("config").as_object())
+      THROW_NOT_OK(config.set(kv.first, kv.second.as_string()));
+  }
+  StorageManager sm;
+  THROW_NOT_OK(sm.init(&config));
+
+  // Open the array for reading. Writes are replayed by writing back the
+  // cells of the described read as a new fragment, so they also start with
+  // a (non-profiled) read.
+  URI uri(array_uri_);
+  Array array(uri, &sm);
+  if (desc.has("timestamp")) {
+    auto timestamp = static_cast<uint64_t>(desc.at("timestamp").as_number());
+    THROW_NOT_OK(array.open(
+        QueryType::READ,
+        timestamp,
+        EncryptionType::NO_ENCRYPTION,
+        nullptr,
+        0));
+  } else {
+    THROW_NOT_OK(
+        array.open(QueryType::READ, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+  }
+
+  auto names = buffer_names(desc, &array);
+  std::map<std::string, QueryBuffer> buffers;
+  alloc_buffers(desc, names, &buffers);
+
+  Query query(&sm, &array);
+  THROW_NOT_OK(query.set_layout(layout_));
+  set_subarray(desc, &query);
+  set_buffers(&buffers, &query);
+
+  if (query_type_ == QueryType::READ) {
+    stats::all_stats.reset();
+    stats::all_stats.set_enabled(true);
+    auto start = std::chrono::steady_clock::now();
+    submit_read(&sm, &query, &buffers, &submits_);
+    total_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    stats::all_stats.set_enabled(false);
+    THROW_NOT_OK(array.close());
+    return;
+  }
+
+  // Read the cells to be written back
+  uint64_t read_submits = 0;
+  submit_read(&sm, &query, &buffers, &read_submits);
+  if (read_submits > 1) {
+    THROW_NOT_OK(array.close());
+    throw std::runtime_error(
+        "Cannot replay write; The cells to write do not fit in the buffers, "
+        "increase \"buffer_size\"");
+  }
+  bool dense = array.array_schema()->dense();
+  THROW_NOT_OK(array.close());
+
+  Array write_array(uri, &sm);
+  THROW_NOT_OK(write_array.open(
+      QueryType::WRITE, EncryptionType::NO_ENCRYPTION, nullptr, 0));
+  Query write_query(&sm, &write_array);
+  if (dense) {
+    // Dense writes take a single-range subarray in the read layout
+    THROW_NOT_OK(write_query.set_layout(layout_));
+    if (desc.has("subarray")) {
+      std::vector<uint8_t> subarray;
+      auto schema = write_array.array_schema();
+      for (unsigned d = 0; d < schema->dim_num(); ++d) {
+        const auto dim = schema->dimension(d);
+        const auto& ranges = desc.at("subarray").at(dim->name()).as_array();
+        if (ranges.size() != 1)
+          throw std::invalid_argument(
+              "Cannot replay write; Dense writes require a single range per "
+              "dimension");
+        const auto& range = ranges[0].as_array();
+        append_value(dim->type(), range.at(0).as_number(), &subarray);
+        append_value(dim->type(), range.at(1).as_number(), &subarray);
+      }
+      THROW_NOT_OK(write_query.set_subarray(subarray.data()));
+    }
+  } else {
+    THROW_NOT_OK(write_query.set_layout(
+        layout_ == Layout::GLOBAL_ORDER ? Layout::GLOBAL_ORDER :
+                                          Layout::UNORDERED));
+  }
+  set_buffers(&buffers, &write_query);
+  for (const auto& b : buffers)
+    result_bytes_[b.first] = b.second.offsets_size + b.second.values_size;
+
+  stats::all_stats.reset();
+  stats::all_stats.set_enabled(true);
+  auto start = std::chrono::steady_clock::now();
+  THROW_NOT_OK(sm.query_submit(&write_query));
+  THROW_NOT_OK(write_query.finalize());
+  total_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+  stats::all_stats.set_enabled(false);
+  submits_ = 1;
+
+  THROW_NOT_OK(write_array.close());
+}
+
+std::vector<std::string> ProfileCommand::buffer_names(
+    const JSONValue& desc, const Array* array) const {
+  const auto schema = array->array_schema();
+  std::vector<std::string> names;
+  if (desc.has("attributes")) {
+    for (const auto& name : desc.at("attributes").as_array())
+      names.push_back(name.as_string());
+  } else {
+    for (const auto attr : schema->attributes())
+      names.push_back(attr->name());
+    if (!schema->dense()) {
+      for (unsigned d = 0; d < schema->dim_num(); ++d)
+        names.push_back(schema->dimension(d)->name());
+    }
+  }
+
+  for (const auto& name : names) {
+    if (!schema->is_attr(name) && !schema->is_dim(name))
+      throw std::invalid_argument(
+          "Unknown attribute or dimension '" + name + "'");
+    if (schema->dense() && schema->is_dim(name) &&
+        query_type_ == QueryType::WRITE)
+      throw std::invalid_argument(
+          "Cannot replay write; Coordinates cannot be written to dense "
+          "arrays");
+  }
+
+  return names;
+}
+
+void ProfileCommand::alloc_buffers(
+    const JSONValue& desc,
+    const std::vector<std::string>& names,
+    std::map<std::string, QueryBuffer>* buffers) const {
+  uint64_t buffer_size = default_buffer_size;
+  if (desc.has("buffer_size"))
+    buffer_size = static_cast<uint64_t>(desc.at("buffer_size").as_number());
+
+  for (const auto& name : names) {
+    uint64_t size = buffer_size;
+    if (desc.has("buffer_sizes") && desc.at("buffer_sizes").has(name))
+      size =
+          static_cast<uint64_t>(desc.at("buffer_sizes").at(name).as_number());
+
+    auto& buffer = (*buffers)[name];
+    buffer.values.resize(size);
+    buffer.values_size = size;
+    buffer.offsets_size = 0;
+  }
+}
+
+void ProfileCommand::set_subarray(const JSONValue& desc, Query* query) const {
+  if (!desc.has("subarray"))
+    return;
+
+  // The subarray maps dimension names to lists of [start, end] ranges
+  const auto schema = query->array_schema();
+  for (const auto& kv : desc.at("subarray").as_object()) {
+    const auto dim = schema->dimension(kv.first);
+    if (dim == nullptr)
+      throw std::invalid_argument(
+          "Cannot set subarray; Unknown dimension '" + kv.first + "'");
+    if (dim->var_size())
+      throw std::invalid_argument(
+          "Cannot set subarray; Ranges on var-sized dimensions are not "
+          "supported");
+
+    unsigned dim_idx = 0;
+    while (schema->dimension(dim_idx)->name() != kv.first)
+      ++dim_idx;
+
+    for (const auto& r : kv.second.as_array()) {
+      const auto& range = r.as_array();
+      if (range.size() != 2)
+        throw std::invalid_argument(
+            "Cannot set subarray; Ranges must be [start, end] pairs");
+      std::vector<uint8_t> start, end;
+      append_value(dim->type(), range[0].as_number(), &start);
+      append_value(dim->type(), range[1].as_number(), &end);
+      THROW_NOT_OK(
+          query->add_range(dim_idx, start.data(), end.data(), nullptr));
+    }
+  }
+}
+
+void ProfileCommand::set_buffers(
+    std::map<std::string, QueryBuffer>* buffers, Query* query) const {
+  const auto schema = query->array_schema();
+  for (auto& kv : *buffers) {
+    auto& buffer = kv.second;
+    if (schema->var_size(kv.first)) {
+      // Offsets are sized for one value byte per cell at most
+      if (buffer.offsets.empty()) {
+        buffer.offsets.resize(
+            std::max<uint64_t>(1, buffer.values.size() / sizeof(uint64_t)));
+        buffer.offsets_size = buffer.offsets.size() * sizeof(uint64_t);
+      }
+      THROW_NOT_OK(query->set_buffer(
+          kv.first,
+          buffer.offsets.data(),
+          &buffer.offsets_size,
+          buffer.values.data(),
+          &buffer.values_size));
+    } else {
+      THROW_NOT_OK(query->set_buffer(
+          kv.first, buffer.values.data(), &buffer.values_size));
+    }
+  }
+}
+
+void ProfileCommand::submit_read(
+    StorageManager* sm,
+    Query* query,
+    std::map<std::string, QueryBuffer>* buffers,
+    uint64_t* submits) {
+  *submits = 0;
+  do {
+    // Reset the buffer sizes to the allocated sizes
+    for (auto& kv : *buffers) {
+      kv.second.values_size = kv.second.values.size();
+      kv.second.offsets_size = kv.second.offsets.size() * sizeof(uint64_t);
+    }
+
+    THROW_NOT_OK(sm->query_submit(query));
+    (*submits)++;
+
+    uint64_t bytes = 0;
+    for (const auto& kv : *buffers) {
+      result_bytes_[kv.first] += kv.second.values_size + kv.second.offsets_size;
+      bytes += kv.second.values_size;
+    }
+
+    if (query->status() == QueryStatus::INCOMPLETE && bytes == 0)
+      throw std::runtime_error(
+          "Query cannot make progress; Increase \"buffer_size\"");
+  } while (query->status() == QueryStatus::INCOMPLETE);
+}
+
+std::vector<ProfileCommand::Phase> ProfileCommand::phases() const {
+  const auto& s = stats::all_stats;
+#define PHASE(name, stat) \
+  Phase { name, s.stat##_total_ns, s.stat##_call_count }
+
+  std::vector<Phase> result;
+  if (query_type_ == QueryType::READ) {
+    result = {
+        PHASE("Subarray partitioning", reader_next_subarray_partition),
+        PHASE("R-tree tile overlap", subarray_compute_tile_overlap),
+        PHASE("Result tile computation", reader_compute_overlapping_tiles),
+        PHASE("Tile I/O", reader_read_all_tiles),
+        PHASE("Unfiltering", reader_unfilter_tiles),
+        PHASE("Result cell slab computation", reader_compute_cell_ranges),
+        PHASE("Dense coordinate filling", reader_fill_coords),
+        PHASE("Coordinate sorting", reader_sort_coords),
+        PHASE("Coordinate deduplication", reader_dedup_coords),
+        PHASE("Fixed-sized cell copying", reader_copy_fixed_cells),
+        PHASE("Var-sized cell copying", reader_copy_var_cells),
+    };
+  } else {
+    result = {
+        PHASE("Coordinate sorting", writer_sort_coords),
+        PHASE("Coordinate duplicate checks", writer_check_coord_dups),
+        PHASE("Coordinate duplicate checks", writer_check_coord_dups_global),
+        PHASE("Coordinate deduplication", writer_compute_coord_dups),
+        PHASE("Coordinate deduplication", writer_compute_coord_dups_global),
+        PHASE("Cell range computation", writer_compute_write_cell_ranges),
+        PHASE("Tile preparation", writer_prepare_tiles_fixed),
+        PHASE("Tile preparation", writer_prepare_tiles_var),
+        PHASE("Tile preparation", writer_prepare_tiles_ordered),
+        PHASE("Tile preparation", writer_prepare_full_tiles_fixed),
+        PHASE("Tile preparation", writer_prepare_full_tiles_var),
+        PHASE("Filtering", writer_filter_tiles),
+        PHASE("Tile I/O", writer_write_all_tiles),
+        PHASE("Fragment creation", writer_create_fragment),
+    };
+  }
+#undef PHASE
+
+  // Merge phases with the same name (e.g. the global-order variants)
+  std::vector<Phase> merged;
+  for (const auto& p : result) {
+    auto it = std::find_if(merged.begin(), merged.end(), [&](const Phase& m) {
+      return m.name == p.name;
+    });
+    if (it == merged.end()) {
+      merged.push_back(p);
+    } else {
+      it->ns += p.ns;
+      it->calls += p.calls;
+    }
+  }
+
+  return merged;
+}
+
+std::vector<ProfileCommand::Phase> ProfileCommand::filter_phases() const {
+  const auto& s = stats::all_stats;
+#define PHASE(name, stat) \
+  Phase { name, s.stat##_total_ns, s.stat##_call_count }
+
+  std::vector<Phase> result;
+  if (query_type_ == QueryType::READ) {
+    result = {
+        PHASE("GZIP", compressor_gzip_decompress),
+        PHASE("ZSTD", compressor_zstd_decompress),
+        PHASE("LZ4", compressor_lz4_decompress),
+        PHASE("RLE", compressor_rle_decompress),
+        PHASE("BZIP2", compressor_bzip_decompress),
+        PHASE("DOUBLE_DELTA", compressor_dd_decompress),
+        PHASE("BIT_WIDTH_REDUCTION", filter_bit_width_reduction_reverse),
+        PHASE("BITSHUFFLE", filter_bitshuffle_reverse),
+        PHASE("BYTESHUFFLE", filter_byteshuffle_reverse),
+        PHASE("POSITIVE_DELTA", filter_positive_delta_reverse),
+        PHASE("DICTIONARY", filter_dictionary_reverse),
+        PHASE("OFFSETS_DELTA", filter_offsets_delta_reverse),
+        PHASE("FRAME_OF_REFERENCE", filter_frame_of_reference_reverse),
+        PHASE("XOR", filter_xor_reverse),
+        PHASE("CHECKSUM_MD5", crypto_md5),
+        PHASE("CHECKSUM_SHA256", crypto_sha256),
+        PHASE("CHECKSUM_CRC32C", filter_checksum_crc32c_reverse),
+        PHASE("AES256GCM", crypto_decrypt_aes256gcm),
+    };
+  } else {
+    result = {
+        PHASE("GZIP", compressor_gzip_compress),
+        PHASE("ZSTD", compressor_zstd_compress),
+        PHASE("LZ4", compressor_lz4_compress),
+        PHASE("RLE", compressor_rle_compress),
+        PHASE("BZIP2", compressor_bzip_compress),
+        PHASE("DOUBLE_DELTA", compressor_dd_compress),
+        PHASE("BIT_WIDTH_REDUCTION", filter_bit_width_reduction_forward),
+        PHASE("BITSHUFFLE", filter_bitshuffle_forward),
+        PHASE("BYTESHUFFLE", filter_byteshuffle_forward),
+        PHASE("POSITIVE_DELTA", filter_positive_delta_forward),
+        PHASE("DICTIONARY", filter_dictionary_forward),
+        PHASE("OFFSETS_DELTA", filter_offsets_delta_forward),
+        PHASE("FRAME_OF_REFERENCE", filter_frame_of_reference_forward),
+        PHASE("XOR", filter_xor_forward),
+        PHASE("CHECKSUM_MD5", crypto_md5),
+        PHASE("CHECKSUM_SHA256", crypto_sha256),
+        PHASE("CHECKSUM_CRC32C", filter_checksum_crc32c_forward),
+        PHASE("AES256GCM", crypto_encrypt_aes256gcm),
+    };
+  }
+#undef PHASE
+
+  // Only report the filters that ran
+  result.erase(
+      std::remove_if(
+          result.begin(),
+          result.end(),
+          [](const Phase& p) { return p.calls == 0; }),
+      result.end());
+
+  return result;
+}
+
+void ProfileCommand::write_text(std::ostream& os) const {
+  const auto& s = stats::all_stats;
+  auto pct = [this](uint64_t ns) {
+    return total_ns_ == 0 ? 0.0 : 100.0 * ns / total_ns_;
+  };
+  auto print_phase = [&](const Phase& p) {
+    os << "  " << std::left << std::setw(36) << p.name << std::right
+       << std::fixed << std::setprecision(6) << std::setw(12) << to_sec(p.ns)
+       << std::setprecision(1) << std::setw(9) << pct(p.ns) << "%"
+       << std::setw(10) << p.calls << std::endl;
+  };
+
+  os << "Array URI: " << array_uri_ << std::endl;
+  os << "Query: " << query_type_str(query_type_) << ", "
+     << layout_str(layout_) << std::endl;
+  os << "Submits: " << submits_ << " (" << (submits_ - 1) << " incomplete)"
+     << std::endl;
+  os << "Total time: " << std::fixed << std::setprecision(6)
+     << to_sec(total_ns_) << " s" << std::endl;
+  os << std::endl;
+
+  os << "  " << std::left << std::setw(36) << "Phase" << std::right
+     << std::setw(12) << "Time (s)" << std::setw(10) << "% total"
+     << std::setw(10) << "Calls" << std::endl;
+  for (const auto& p : phases())
+    print_phase(p);
+
+  auto filters = filter_phases();
+  if (!filters.empty()) {
+    os << std::endl << "  Filters" << std::endl;
+    for (const auto& p : filters)
+      print_phase(p);
+  }
+
+  os << std::endl;
+  if (query_type_ == QueryType::READ) {
+    os << "Tile bytes read: " << s.counter_reader_num_tile_bytes_read
+       << std::endl;
+    os << "VFS read requests: " << s.vfs_read_call_count << " ("
+       << s.counter_vfs_read_total_bytes << " bytes)" << std::endl;
+    uint64_t hits = s.counter_reader_attr_tile_cache_hits;
+    uint64_t touched = s.counter_reader_num_attr_tiles_touched;
+    os << "Tile cache hit ratio: " << hits << " / " << touched;
+    if (touched > 0)
+      os << " (" << std::setprecision(1) << (100.0 * hits / touched) << "%)";
+    os << std::endl;
+    os << "Result bytes:" << std::endl;
+  } else {
+    os << "Tiles written: " << s.counter_writer_num_attr_tiles_written
+       << std::endl;
+    os << "Bytes before / after filtering: "
+       << s.counter_writer_num_bytes_before_filtering << " / "
+       << s.counter_writer_num_bytes_written << std::endl;
+    os << "VFS write requests: " << s.vfs_write_call_count << std::endl;
+    os << "Input bytes:" << std::endl;
+  }
+  for (const auto& kv : result_bytes_)
+    os << "  " << kv.first << ": " << kv.second << std::endl;
+}
+
+void ProfileCommand::write_json(std::ostream& os) const {
+  const auto& s = stats::all_stats;
+  auto print_phases = [&](const std::vector<Phase>& phases) {
+    for (size_t i = 0; i < phases.size(); ++i) {
+      os << "    { \"name\": \"" << phases[i].name
+         << "\", \"ns\": " << phases[i].ns
+         << ", \"calls\": " << phases[i].calls << " }"
+         << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+  };
+
+  os << "{\n";
+  os << "  \"array\": \"" << json_escape(array_uri_) << "\",\n";
+  os << "  \"query_type\": \"" << query_type_str(query_type_) << "\",\n";
+  os << "  \"layout\": \"" << layout_str(layout_) << "\",\n";
+  os << "  \"submits\": " << submits_ << ",\n";
+  os << "  \"incomplete_submits\": " << (submits_ - 1) << ",\n";
+  os << "  \"total_ns\": " << total_ns_ << ",\n";
+  os << "  \"phases\": [\n";
+  print_phases(phases());
+  os << "  ],\n";
+  os << "  \"filters\": [\n";
+  print_phases(filter_phases());
+  os << "  ],\n";
+  if (query_type_ == QueryType::READ) {
+    os << "  \"io\": { \"tile_bytes_read\": "
+       << s.counter_reader_num_tile_bytes_read
+       << ", \"vfs_read_requests\": " << s.vfs_read_call_count
+       << ", \"vfs_bytes_read\": " << s.counter_vfs_read_total_bytes
+       << " },\n";
+    os << "  \"tile_cache\": { \"hits\": "
+       << s.counter_reader_attr_tile_cache_hits
+       << ", \"tiles_touched\": " << s.counter_reader_num_attr_tiles_touched
+       << " },\n";
+  } else {
+    os << "  \"io\": { \"tiles_written\": "
+       << s.counter_writer_num_attr_tiles_written
+       << ", \"bytes_before_filtering\": "
+       << s.counter_writer_num_bytes_before_filtering
+       << ", \"bytes_written\": " << s.counter_writer_num_bytes_written
+       << ", \"vfs_write_requests\": " << s.vfs_write_call_count << " },\n";
+  }
+  os << "  \"buffer_bytes\": {";
+  size_t i = 0;
+  for (const auto& kv : result_bytes_) {
+    os << (i++ == 0 ? " " : ", ") << "\"" << json_escape(kv.first)
+       << "\": " << kv.second;
+  }
+  os << " }\n";
+  os << "}" << std::endl;
+}
+
+}  // namespace cli
+}  // namespace tiledb
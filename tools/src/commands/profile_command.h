@@ -0,0 +1,183 @@
+/**
+ * @file  profile_command.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the profile command.
+ */
+
+#ifndef TILEDB_CLI_PROFILE_COMMAND_H
+#define TILEDB_CLI_PROFILE_COMMAND_H
+
+#include "commands/command.h"
+#include "misc/json.h"
+
+#include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/enums/query_type.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+class Array;
+class Query;
+class StorageManager;
+}  // namespace sm
+
+namespace cli {
+
+/**
+ * Command that replays a query described in a JSON file against an array
+ * and prints a breakdown of where the time was spent.
+ */
+class ProfileCommand : public Command {
+ public:
+  /** Get the CLI for this command instance. */
+  clipp::group get_cli();
+
+  /** Runs this profile command. */
+  void run();
+
+ private:
+  /** Output formats of the report. */
+  enum class Format { Text, JSON };
+
+  /** A timed phase of the query, taken from the internal statistics. */
+  struct Phase {
+    /** Description of the phase. */
+    std::string name;
+    /** Total time spent in the phase, in nanoseconds. */
+    uint64_t ns;
+    /** Number of times the phase was entered. */
+    uint64_t calls;
+  };
+
+  /** User buffers for one attribute/dimension. */
+  struct QueryBuffer {
+    /** Offsets for var-sized attributes/dimensions. */
+    std::vector<uint64_t> offsets;
+    /** Fixed-sized values, or var-sized values. */
+    std::vector<uint8_t> values;
+    /** Size in bytes of `offsets` set on / returned by the query. */
+    uint64_t offsets_size;
+    /** Size in bytes of `values` set on / returned by the query. */
+    uint64_t values_size;
+  };
+
+  /** Array to profile. */
+  std::string array_uri_;
+
+  /** Path to the JSON query description. */
+  std::string query_path_;
+
+  /** Path to write the report (stdout if empty). */
+  std::string output_path_;
+
+  /** Report format. */
+  Format format_ = Format::Text;
+
+  /** Query type parsed from the query description. */
+  sm::QueryType query_type_ = sm::QueryType::READ;
+
+  /** Layout parsed from the query description. */
+  sm::Layout layout_ = sm::Layout::ROW_MAJOR;
+
+  /** Number of times `submit` was called on the profiled query. */
+  uint64_t submits_ = 0;
+
+  /** Wall-clock time of the profiled query, in nanoseconds. */
+  uint64_t total_ns_ = 0;
+
+  /** Result (read) or input (write) bytes per attribute/dimension. */
+  std::map<std::string, uint64_t> result_bytes_;
+
+  /**
+   * Opens the array, sets up the query from the description and submits it
+   * until completion.
+   */
+  void run_query(const JSONValue& desc);
+
+  /**
+   * Returns the names of the attributes/dimensions to set buffers for: the
+   * "attributes" entry of the description if present, otherwise all
+   * attributes plus the dimensions for sparse arrays.
+   */
+  std::vector<std::string> buffer_names(
+      const JSONValue& desc, const sm::Array* array) const;
+
+  /**
+   * Allocates the buffers for the given names, using the "buffer_size" and
+   * "buffer_sizes" entries of the description.
+   */
+  void alloc_buffers(
+      const JSONValue& desc,
+      const std::vector<std::string>& names,
+      std::map<std::string, QueryBuffer>* buffers) const;
+
+  /** Sets the "subarray" entry of the description on the query. */
+  void set_subarray(const JSONValue& desc, sm::Query* query) const;
+
+  /** Sets the given buffers on the query. */
+  void set_buffers(
+      std::map<std::string, QueryBuffer>* buffers, sm::Query* query) const;
+
+  /**
+   * Submits the read query until it completes.
+   *
+   * @param sm Storage manager.
+   * @param query Query to submit.
+   * @param buffers Query buffers; on return, their sizes reflect the results
+   *     of the last submission.
+   * @param submits Set to the number of submissions.
+   *
+   * @note The result sizes of all submissions are added to `result_bytes_`.
+   */
+  void submit_read(
+      sm::StorageManager* sm,
+      sm::Query* query,
+      std::map<std::string, QueryBuffer>* buffers,
+      uint64_t* submits);
+
+  /** Returns the phases relevant to the query type. */
+  std::vector<Phase> phases() const;
+
+  /** Returns the filter phases relevant to the query type. */
+  std::vector<Phase> filter_phases() const;
+
+  /** Writes the text report to the given stream. */
+  void write_text(std::ostream& os) const;
+
+  /** Writes the JSON report to the given stream. */
+  void write_json(std::ostream& os) const;
+};
+
+}  // namespace cli
+}  // namespace tiledb
+
+#endif
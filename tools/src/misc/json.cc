@@ -0,0 +1,298 @@
+/**
+ * @file  json.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines a minimal JSON reader used for CLI input files.
+ */
+
+#include "misc/json.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace tiledb {
+namespace cli {
+
+/* ********************************* */
+/*              PARSER               */
+/* ********************************* */
+
+class JSONValue::Parser {
+ public:
+  explicit Parser(const std::string& text)
+      : text_(text)
+      , pos_(0) {
+  }
+
+  JSONValue parse_document() {
+    JSONValue value = parse_value();
+    skip_whitespace();
+    if (pos_ != text_.size())
+      error("unexpected trailing characters");
+    return value;
+  }
+
+ private:
+  const std::string& text_;
+  size_t pos_;
+
+  void error(const std::string& msg) const {
+    throw std::invalid_argument(
+        "JSON parse error at offset " + std::to_string(pos_) + ": " + msg);
+  }
+
+  void skip_whitespace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' ||
+            text_[pos_] == '\r'))
+      ++pos_;
+  }
+
+  char peek() {
+    skip_whitespace();
+    if (pos_ >= text_.size())
+      error("unexpected end of input");
+    return text_[pos_];
+  }
+
+  void expect(char c) {
+    if (peek() != c)
+      error(std::string("expected '") + c + "'");
+    ++pos_;
+  }
+
+  void expect_literal(const std::string& literal) {
+    if (text_.compare(pos_, literal.size(), literal) != 0)
+      error("invalid literal");
+    pos_ += literal.size();
+  }
+
+  JSONValue parse_value() {
+    JSONValue value;
+    char c = peek();
+    if (c == '{') {
+      value.type_ = Type::Object;
+      ++pos_;
+      if (peek() == '}') {
+        ++pos_;
+        return value;
+      }
+      do {
+        if (peek() != '"')
+          error("expected object key");
+        std::string key = parse_string();
+        expect(':');
+        value.object_[key] = parse_value();
+        c = peek();
+        ++pos_;
+      } while (c == ',');
+      if (c != '}')
+        error("expected ',' or '}'");
+    } else if (c == '[') {
+      value.type_ = Type::Array;
+      ++pos_;
+      if (peek() == ']') {
+        ++pos_;
+        return value;
+      }
+      do {
+        value.array_.push_back(parse_value());
+        c = peek();
+        ++pos_;
+      } while (c == ',');
+      if (c != ']')
+        error("expected ',' or ']'");
+    } else if (c == '"') {
+      value.type_ = Type::String;
+      value.string_ = parse_string();
+    } else if (c == 't') {
+      expect_literal("true");
+      value.type_ = Type::Bool;
+      value.bool_ = true;
+    } else if (c == 'f') {
+      expect_literal("false");
+      value.type_ = Type::Bool;
+      value.bool_ = false;
+    } else if (c == 'n') {
+      expect_literal("null");
+    } else {
+      const char* start = text_.c_str() + pos_;
+      char* end = nullptr;
+      value.number_ = std::strtod(start, &end);
+      if (end == start)
+        error("invalid value");
+      value.type_ = Type::Number;
+      pos_ += static_cast<size_t>(end - start);
+    }
+    return value;
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string result;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char c = text_[pos_++];
+      if (c != '\\') {
+        result.push_back(c);
+        continue;
+      }
+      if (pos_ >= text_.size())
+        break;
+      c = text_[pos_++];
+      switch (c) {
+        case 'b':
+          result.push_back('\b');
+          break;
+        case 'f':
+          result.push_back('\f');
+          break;
+        case 'n':
+          result.push_back('\n');
+          break;
+        case 'r':
+          result.push_back('\r');
+          break;
+        case 't':
+          result.push_back('\t');
+          break;
+        case 'u':
+          // Only ASCII escapes are supported.
+          if (pos_ + 4 > text_.size())
+            error("invalid unicode escape");
+          result.push_back(static_cast<char>(
+              std::strtol(text_.substr(pos_, 4).c_str(), nullptr, 16)));
+          pos_ += 4;
+          break;
+        default:
+          result.push_back(c);
+          break;
+      }
+    }
+    if (pos_ >= text_.size())
+      error("unterminated string");
+    ++pos_;
+    return result;
+  }
+};
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+JSONValue::JSONValue()
+    : type_(Type::Null)
+    , bool_(false)
+    , number_(0) {
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+JSONValue JSONValue::parse(const std::string& text) {
+  Parser parser(text);
+  return parser.parse_document();
+}
+
+JSONValue JSONValue::parse_file(const std::string& path) {
+  std::ifstream is(path);
+  if (!is)
+    throw std::runtime_error("Cannot open file '" + path + "'");
+  std::stringstream ss;
+  ss << is.rdbuf();
+  return parse(ss.str());
+}
+
+JSONValue::Type JSONValue::type() const {
+  return type_;
+}
+
+bool JSONValue::has(const std::string& key) const {
+  return type_ == Type::Object && object_.count(key) > 0;
+}
+
+const JSONValue& JSONValue::at(const std::string& key) const {
+  check_type(Type::Object);
+  auto it = object_.find(key);
+  if (it == object_.end())
+    throw std::invalid_argument("JSON object has no key '" + key + "'");
+  return it->second;
+}
+
+bool JSONValue::as_bool() const {
+  check_type(Type::Bool);
+  return bool_;
+}
+
+double JSONValue::as_number() const {
+  check_type(Type::Number);
+  return number_;
+}
+
+const std::string& JSONValue::as_string() const {
+  check_type(Type::String);
+  return string_;
+}
+
+const std::vector<JSONValue>& JSONValue::as_array() const {
+  check_type(Type::Array);
+  return array_;
+}
+
+const std::map<std::string, JSONValue>& JSONValue::as_object() const {
+  check_type(Type::Object);
+  return object_;
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+void JSONValue::check_type(Type type) const {
+  static const char* names[] = {
+      "null", "boolean", "number", "string", "array", "object"};
+  if (type_ != type)
+    throw std::invalid_argument(
+        std::string("JSON value is not of type ") +
+        names[static_cast<int>(type)]);
+}
+
+std::string json_escape(const std::string& s) {
+  std::string result;
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      result.push_back('\\');
+    result.push_back(c);
+  }
+  return result;
+}
+
+}  // namespace cli
+}  // namespace tiledb
@@ -0,0 +1,135 @@
+/**
+ * @file  json.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares a minimal JSON reader used for CLI input files.
+ */
+
+#ifndef TILEDB_CLI_JSON_H
+#define TILEDB_CLI_JSON_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tiledb {
+namespace cli {
+
+/**
+ * A parsed JSON value. This only supports what the CLI needs for reading
+ * small description files; it is not a general purpose JSON library.
+ */
+class JSONValue {
+ public:
+  /** The JSON value types. */
+  enum class Type { Null, Bool, Number, String, Array, Object };
+
+  /** Constructs a null value. */
+  JSONValue();
+
+  /**
+   * Parses the given JSON document.
+   *
+   * @param text The JSON text.
+   * @return The parsed value.
+   * @throws std::invalid_argument if the text is not valid JSON.
+   */
+  static JSONValue parse(const std::string& text);
+
+  /**
+   * Reads and parses the JSON document in the given local file.
+   *
+   * @param path Path of the file.
+   * @return The parsed value.
+   * @throws std::runtime_error if the file cannot be read, or
+   *     std::invalid_argument if it is not valid JSON.
+   */
+  static JSONValue parse_file(const std::string& path);
+
+  /** Returns the type of this value. */
+  Type type() const;
+
+  /** Returns true if this is an object containing the given key. */
+  bool has(const std::string& key) const;
+
+  /**
+   * Returns the value of the given key of this object.
+   *
+   * @throws std::invalid_argument if this is not an object or the key is
+   *     missing.
+   */
+  const JSONValue& at(const std::string& key) const;
+
+  /** Returns the boolean value (throws if not a boolean). */
+  bool as_bool() const;
+
+  /** Returns the numeric value (throws if not a number). */
+  double as_number() const;
+
+  /** Returns the string value (throws if not a string). */
+  const std::string& as_string() const;
+
+  /** Returns the array elements (throws if not an array). */
+  const std::vector<JSONValue>& as_array() const;
+
+  /** Returns the object members (throws if not an object). */
+  const std::map<std::string, JSONValue>& as_object() const;
+
+ private:
+  /** Helper class holding the parsing state. */
+  class Parser;
+
+  /** The type of the value. */
+  Type type_;
+
+  /** Value if this is a boolean. */
+  bool bool_;
+
+  /** Value if this is a number. */
+  double number_;
+
+  /** Value if this is a string. */
+  std::string string_;
+
+  /** Elements if this is an array. */
+  std::vector<JSONValue> array_;
+
+  /** Members if this is an object. */
+  std::map<std::string, JSONValue> object_;
+
+  /** Throws if the type of this value is not `type`. */
+  void check_type(Type type) const;
+};
+
+/** Escapes a string for inclusion in JSON output. */
+std::string json_escape(const std::string& s);
+
+}  // namespace cli
+}  // namespace tiledb
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file  values.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines helpers for converting CLI input values to TileDB
+ * datatypes.
+ */
+
+#include "misc/values.h"
+
+#include "tiledb/sm/enums/datatype.h"
+
+#include <stdexcept>
+
+namespace tiledb {
+namespace cli {
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Appends `value` converted to the given type to `out`. */
+template <class T>
+void append_value(double value, std::vector<uint8_t>* out) {
+  auto v = static_cast<T>(value);
+  auto bytes = reinterpret_cast<const uint8_t*>(&v);
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+}  // namespace
+
+void append_value(Datatype type, double value, std::vector<uint8_t>* out) {
+  switch (type) {
+    case Datatype::INT8:
+      return append_value<int8_t>(value, out);
+    case Datatype::UINT8:
+      return append_value<uint8_t>(value, out);
+    case Datatype::INT16:
+      return append_value<int16_t>(value, out);
+    case Datatype::UINT16:
+      return append_value<uint16_t>(value, out);
+    case Datatype::INT32:
+      return append_value<int32_t>(value, out);
+    case Datatype::UINT32:
+      return append_value<uint32_t>(value, out);
+    case Datatype::INT64:
+      return append_value<int64_t>(value, out);
+    case Datatype::UINT64:
+      return append_value<uint64_t>(value, out);
+    case Datatype::FLOAT32:
+      return append_value<float>(value, out);
+    case Datatype::FLOAT64:
+      return append_value<double>(value, out);
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      return append_value<int64_t>(value, out);
+    default:
+      throw std::invalid_argument(
+          "Cannot convert value; Unsupported datatype " +
+          datatype_str(type));
+  }
+}
+
+}  // namespace cli
+}  // namespace tiledb
@@ -0,0 +1,58 @@
+/**
+ * @file  values.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares helpers for converting CLI input values to TileDB
+ * datatypes.
+ */
+
+#ifndef TILEDB_CLI_VALUES_H
+#define TILEDB_CLI_VALUES_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+enum class Datatype : uint8_t;
+}  // namespace sm
+
+namespace cli {
+
+/**
+ * Appends `value` converted to the given datatype to `out`.
+ *
+ * @throws std::invalid_argument if the datatype is not a numeric or datetime
+ *     type.
+ */
+void append_value(sm::Datatype type, double value, std::vector<uint8_t>* out);
+
+}  // namespace cli
+}  // namespace tiledb
+
+#endif